@@ -30,6 +30,7 @@
         UMOCK_C_NULL_ARGUMENT, \
         UMOCK_C_INVALID_PAIRED_CALLS, \
         UMOCK_C_REGISTER_TYPE_FAILED, \
+        UMOCK_C_INVALID_REPEAT_COUNT, \
         UMOCK_C_ERROR
 
 MU_DEFINE_ENUM(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
@@ -59,6 +60,25 @@ typedef void(*ON_UMOCK_C_ERROR)(UMOCK_C_ERROR_CODE error_code);
 #define EXPECTED_CALL(call) \
     MU_C2(umock_c_expected_,call)
 
+/* Codes_SRS_UMOCK_C_LIB_01_239: [ UNORDERED_EXPECTED_CALLS shall record that the expected calls recorded by the statements passed to it can happen in any order with respect to each other. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_242: [ If opening or closing the group of unordered calls fails, the on_error callback shall be called with UMOCK_C_ERROR. ]*/
+#define UNORDERED_EXPECTED_CALLS(...) \
+    do \
+    { \
+        if (umock_c_begin_unordered_expected_calls() != 0) \
+        { \
+            umock_c_indicate_error(UMOCK_C_ERROR); \
+        } \
+        else \
+        { \
+            __VA_ARGS__ \
+            if (umock_c_end_unordered_expected_calls() != 0) \
+            { \
+                umock_c_indicate_error(UMOCK_C_ERROR); \
+            } \
+        } \
+    } while (0)
+
 #define DECLARE_UMOCK_POINTER_TYPE_FOR_TYPE(value_type, alias) \
     char* MU_C3(stringify_func_,alias,ptr)(const value_type** value) \
     { \
@@ -102,6 +122,10 @@ int umock_c_init(ON_UMOCK_C_ERROR on_umock_c_error);
 int umock_c_init_with_lock_factory(ON_UMOCK_C_ERROR on_umock_c_error, UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params);
 void umock_c_deinit(void);
 void umock_c_reset_all_calls(void);
+int umock_c_enable_call_arena(void);
+int umock_c_enable_per_thread_call_recording(void);
+int umock_c_begin_unordered_expected_calls(void);
+int umock_c_end_unordered_expected_calls(void);
 const char* umock_c_get_actual_calls(void);
 const char* umock_c_get_expected_calls(void);
 UMOCKCALLRECORDER_HANDLE umock_c_get_call_recorder(void);
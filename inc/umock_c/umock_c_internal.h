@@ -19,8 +19,10 @@
 #include "umock_c/umock_c.h"
 #include "umock_c/umock_log.h"
 #include "umock_c/umockalloc.h"
+#include "umock_c/umockatomic.h"
 #include "umock_c/umockcallpairs.h"
 #include "umock_c/umockstring.h"
+#include "umock_c/umockstringbuilder.h"
 #include "umock_c/umockautoignoreargs.h"
 
 // For gcc build that causes a false negative
@@ -71,7 +73,24 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 #define GET_USED_ARGUMENT_TYPE(mock_call, arg_name, arg_type) \
     mock_call->MU_C2(override_argument_type_,arg_name) != NULL ? mock_call->MU_C2(override_argument_type_,arg_name) : #arg_type
 
-#define COPY_ARG_TO_MOCK_STRUCT(arg_type, arg_name) umocktypes_copy(#arg_type, (void*)&mock_call_data->arg_name, (void*)&arg_name);
+/* the handlers for the argument and return types of a mock are resolved once (see get_mock_type_handlers_{name}) and called directly.
+   If a type could not be resolved (or an argument type was overridden) the call goes through the umocktypes string API. */
+/* marks the handlers of a mock as being resolved by some thread, umocktypes_get_generation never gets to this value */
+#define MOCK_TYPE_HANDLERS_RESOLVING UINT64_MAX
+#define DECLARE_TYPE_HANDLERS_FOR_ARG(arg_type, arg_name) const UMOCKTYPE_HANDLERS* MU_C2(arg_type_handlers_,arg_name);
+#define RESOLVE_TYPE_HANDLERS_FOR_ARG(arg_type, arg_name) mock_type_handlers.MU_C2(arg_type_handlers_,arg_name) = umocktypes_get_handlers(#arg_type);
+
+#define GET_USED_ARGUMENT_TYPE_HANDLERS(mock_call, arg_name) \
+    ((mock_call->MU_C2(override_argument_type_,arg_name) != NULL) ? NULL : mock_type_handlers->MU_C2(arg_type_handlers_,arg_name))
+
+#define UMOCK_TYPE_HANDLERS_STRINGIFY(type_handlers, type, value) \
+    (((type_handlers) != NULL) ? (type_handlers)->stringify_func(value) : umocktypes_stringify(type, value))
+#define UMOCK_TYPE_HANDLERS_COPY(type_handlers, type, destination, source) \
+    (((type_handlers) != NULL) ? (type_handlers)->copy_func(destination, source) : umocktypes_copy(type, destination, source))
+#define UMOCK_TYPE_HANDLERS_FREE(type_handlers, type, value) \
+    (((type_handlers) != NULL) ? (type_handlers)->free_func(value) : umocktypes_free(type, value))
+
+#define COPY_ARG_TO_MOCK_STRUCT(arg_type, arg_name) UMOCK_TYPE_HANDLERS_COPY(mock_type_handlers->MU_C2(arg_type_handlers_,arg_name), #arg_type, (void*)&mock_call_data->arg_name, (void*)&arg_name);
 #define DECLARE_MOCK_CALL_STRUCT_STACK(arg_type, arg_name) arg_type arg_name;
 #define MARK_ARG_AS_NOT_IGNORED(arg_type, arg_name) mock_call_data->MU_C2(is_ignored_, arg_name) = ARG_IS_NOT_IGNORED;
 #define CLEAR_VALIDATE_ARG_VALUE(arg_type, arg_name) mock_call_data->MU_C2(validate_arg_value_pointer_, arg_name) = NULL;
@@ -82,7 +101,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
     MU_C2(mock_call_data->out_arg_buffer_,arg_name).bytes = NULL; \
     mock_call_data->out_arg_buffers[COUNT_OF(mock_call_data->out_arg_buffers) - MU_DIV2(count)] = &MU_C2(mock_call_data->out_arg_buffer_,arg_name);
 #define CLEAR_VALIDATE_ARG_BUFFERS(count, arg_type, arg_name) mock_call_data->validate_arg_buffers[COUNT_OF(mock_call_data->validate_arg_buffers) - MU_DIV2(count)].bytes = NULL;
-#define FREE_ARG_VALUE(count, arg_type, arg_name) umocktypes_free(GET_USED_ARGUMENT_TYPE(typed_mock_call_data, arg_name, arg_type), (void*)&typed_mock_call_data->arg_name);
+#define FREE_ARG_VALUE(count, arg_type, arg_name) UMOCK_TYPE_HANDLERS_FREE(GET_USED_ARGUMENT_TYPE_HANDLERS(typed_mock_call_data, arg_name), GET_USED_ARGUMENT_TYPE(typed_mock_call_data, arg_name, arg_type), (void*)&typed_mock_call_data->arg_name);
 #define FREE_OUT_ARG_BUFFERS(count, arg_type, arg_name) umockalloc_free(typed_mock_call_data->out_arg_buffers[COUNT_OF(typed_mock_call_data->out_arg_buffers) - MU_DIV2(count)]->bytes);
 #define FREE_VALIDATE_ARG_BUFFERS(count, arg_type, arg_name) umockalloc_free(typed_mock_call_data->validate_arg_buffers[COUNT_OF(typed_mock_call_data->validate_arg_buffers) - MU_DIV2(count)].bytes);
 #define FREE_OVERRIDE_ARGUMENT_TYPE(count, arg_type, arg_name) umockalloc_free(typed_mock_call_data->MU_C2(override_argument_type_, arg_name));
@@ -99,7 +118,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 #define COPY_CAPTURE_ARG_VALUE(arg_type, arg_name) \
     result->MU_C2(capture_arg_value_pointer_, arg_name) = typed_mock_call_data->MU_C2(capture_arg_value_pointer_, arg_name);
 
-#define COPY_ARG_VALUE(arg_type, arg_name) umocktypes_copy(GET_USED_ARGUMENT_TYPE(typed_mock_call_data, arg_name, arg_type), (void*)&result->arg_name, (void*)&typed_mock_call_data->arg_name);
+#define COPY_ARG_VALUE(arg_type, arg_name) UMOCK_TYPE_HANDLERS_COPY(GET_USED_ARGUMENT_TYPE_HANDLERS(typed_mock_call_data, arg_name), GET_USED_ARGUMENT_TYPE(typed_mock_call_data, arg_name, arg_type), (void*)&result->arg_name, (void*)&typed_mock_call_data->arg_name);
 #define COPY_OUT_ARG_BUFFERS(count, arg_type, arg_name) \
     result->out_arg_buffers[COUNT_OF(result->out_arg_buffers) - MU_DIV2(count)] = &result->MU_C2(out_arg_buffer_,arg_name); \
     result->out_arg_buffers[COUNT_OF(result->out_arg_buffers) - MU_DIV2(count)]->length = typed_mock_call_data->out_arg_buffers[COUNT_OF(typed_mock_call_data->out_arg_buffers) - MU_DIV2(count)]->length; \
@@ -151,30 +170,29 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 #define STRINGIFY_ARGS_DECLARE_RESULT_VAR(count, arg_type, arg_name) \
     char* MU_C2(arg_name,_stringified) \
     = (MU_C2(typed_mock_call_data->validate_arg_value_pointer_, arg_name) != NULL) ? \
-      umocktypes_stringify(MU_TOSTRING(arg_type), (void*)MU_C2(typed_mock_call_data->validate_arg_value_pointer_, arg_name)) : \
+      UMOCK_TYPE_HANDLERS_STRINGIFY(mock_type_handlers->MU_C2(arg_type_handlers_,arg_name), MU_TOSTRING(arg_type), (void*)MU_C2(typed_mock_call_data->validate_arg_value_pointer_, arg_name)) : \
       ((typed_mock_call_data->validate_arg_buffers[COUNT_OF(typed_mock_call_data->out_arg_buffers) - MU_DIV2(count)].bytes != NULL) ? \
         umockc_stringify_buffer(typed_mock_call_data->validate_arg_buffers[COUNT_OF(typed_mock_call_data->validate_arg_buffers) - MU_DIV2(count)].bytes, typed_mock_call_data->validate_arg_buffers[COUNT_OF(typed_mock_call_data->validate_arg_buffers) - MU_DIV2(count)].length) : \
-        umocktypes_stringify(MU_TOSTRING(arg_type), (void*)&typed_mock_call_data->arg_name));
+        UMOCK_TYPE_HANDLERS_STRINGIFY(mock_type_handlers->MU_C2(arg_type_handlers_,arg_name), MU_TOSTRING(arg_type), (void*)&typed_mock_call_data->arg_name));
 
 #define STRINGIFY_ARGS_CHECK_ARG_STRINGIFY_SUCCESS(arg_type, arg_name) if (MU_C2(arg_name,_stringified) == NULL) is_error = 1;
 #define STRINGIFY_ARGS_DECLARE_ARG_STRING_LENGTH(arg_type, arg_name) size_t MU_C2(arg_name,_stringified_length) = strlen(MU_C2(arg_name,_stringified));
 #define STRINGIFY_ARGS_COUNT_LENGTH(arg_type, arg_name) args_string_length += MU_C2(arg_name,_stringified_length);
 #define STRINGIFY_ARGS_FREE_STRINGIFIED_ARG(arg_type, arg_name) umockalloc_free(MU_C2(arg_name,_stringified));
-#define STRINGIFY_ARGS_COPY_ARG_STRING(arg_type, arg_name) \
-    if (arg_index > 0) \
+#define STRINGIFY_ARGS_APPEND_ARG_STRING(arg_type, arg_name) \
+    if ((is_error == 0) && \
+        (((arg_index > 0) && (umockstringbuilder_append_char(&string_builder, ',') != 0)) || \
+         (umockstringbuilder_append(&string_builder, MU_C2(arg_name,_stringified), MU_C2(arg_name,_stringified_length)) != 0))) \
     { \
-        result[current_pos] = ','; \
-        current_pos++; \
+        is_error = 1; \
     } \
-    (void)memcpy(result + current_pos, MU_C2(arg_name,_stringified), MU_C2(arg_name,_stringified_length) + 1); \
-    current_pos += MU_C2(arg_name, _stringified_length); \
     arg_index++;
 
 /* Codes_SRS_UMOCK_C_LIB_01_096: [If the content of the code under test buffer and the buffer supplied to ValidateArgumentBuffer does not match then this should be treated as a mismatch in argument comparison for that argument.]*/
 #define ARE_EQUAL_FOR_ARG(count, arg_type, arg_name) \
     if (result && \
-        (((typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].bytes != NULL) && (memcmp(*((void**)&typed_right->arg_name), typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].bytes, typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].length) != 0)) \
-        || ((typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].bytes != NULL) && (memcmp(*((void**)&typed_left->arg_name), typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].bytes, typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].length) != 0))) \
+        (((typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].bytes != NULL) && (umockc_validate_argument_buffer(typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].bytes, *((void**)&typed_right->arg_name), typed_left->validate_arg_buffers[COUNT_OF(typed_left->validate_arg_buffers) - MU_DIV2(count)].length) == 0)) \
+        || ((typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].bytes != NULL) && (umockc_validate_argument_buffer(typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].bytes, *((void**)&typed_left->arg_name), typed_right->validate_arg_buffers[COUNT_OF(typed_right->validate_arg_buffers) - MU_DIV2(count)].length) == 0))) \
         ) \
     { \
         result = 0; \
@@ -200,7 +218,33 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
         { \
             right_value = (void*)&typed_right->arg_name; \
         } \
-        result = umocktypes_are_equal(GET_USED_ARGUMENT_TYPE(typed_left, arg_name, arg_type), left_value, right_value); \
+        const UMOCKTYPE_HANDLERS* arg_type_handlers = GET_USED_ARGUMENT_TYPE_HANDLERS(typed_left, arg_name); \
+        if (arg_type_handlers == NULL) \
+        { \
+            result = umocktypes_are_equal(GET_USED_ARGUMENT_TYPE(typed_left, arg_name, arg_type), left_value, right_value); \
+        } \
+        else if (left_value == right_value) \
+        { \
+            result = 1; \
+        } \
+        else \
+        { \
+            /* same result mapping as umocktypes_are_equal: anything other than 0 or 1 is an error */ \
+            result = arg_type_handlers->are_equal_func(left_value, right_value); \
+            if ((result != 0) && (result != 1)) \
+            { \
+                UMOCK_LOG("Underlying compare failed for type %s.", GET_USED_ARGUMENT_TYPE(typed_left, arg_name, arg_type)); \
+                result = -1; \
+            } \
+        } \
+    }
+
+/* Codes_SRS_UMOCK_C_LIB_01_243: [ When the buffers do not match, the first unexpected actual call shall be followed in the actual calls string by the offset of the first differing byte and the bytes of both buffers around it, rather than the full buffers. ]*/
+#define STRINGIFY_MISMATCH_FOR_ARG(count, arg_type, arg_name) \
+    if ((result == NULL) && \
+        (typed_expected->validate_arg_buffers[COUNT_OF(typed_expected->validate_arg_buffers) - MU_DIV2(count)].bytes != NULL)) \
+    { \
+        result = umockc_stringify_argument_buffer_mismatch(MU_TOSTRING(arg_name), typed_expected->validate_arg_buffers[COUNT_OF(typed_expected->validate_arg_buffers) - MU_DIV2(count)].bytes, *((void**)&typed_actual->arg_name), typed_expected->validate_arg_buffers[COUNT_OF(typed_expected->validate_arg_buffers) - MU_DIV2(count)].length); \
     }
 
 #define DECLARE_MOCK_CALL_MODIFIER(name, ...) \
@@ -383,6 +427,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
     } \
 
 /* Codes_SRS_UMOCK_C_LIB_01_084: [The SetReturn call modifier shall record that when an actual call is matched with the specific expected call, it shall return the result value to the code under test.] */
+/* Codes_SRS_UMOCK_C_LIB_01_246: [ SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn and CaptureArgumentValue_{arg_name} shall mark the expected call as handing values back to the actual call that matches it by calling umockcall_set_has_call_results. ]*/
 #define IMPLEMENT_SET_RETURN_FUNCTION(return_type, name, ...) \
     MU_C2(mock_call_modifier_,name) MU_C2(set_return_func_,name)(return_type return_value) \
     { \
@@ -396,7 +441,8 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
         else \
         { \
             mock_call_data->return_value_set = RETURN_VALUE_SET; \
-            if (umocktypes_copy(#return_type, (void*)&mock_call_data->return_value, (void*)&return_value) != 0) \
+            (void)umockcall_set_has_call_results(umock_c_get_last_expected_call(), 1); \
+            if (UMOCK_TYPE_HANDLERS_COPY(MU_C2(get_mock_type_handlers_, name)()->return_type_handlers, #return_type, (void*)&mock_call_data->return_value, (void*)&return_value) != 0) \
             { \
                 UMOCK_LOG("Could not copy return value of type %s.", MU_TOSTRING(return_type)); \
                 umock_c_indicate_error(UMOCK_C_ERROR); \
@@ -419,7 +465,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
         else \
         { \
             mock_call_data->fail_return_value_set = FAIL_RETURN_VALUE_SET; \
-            if (umocktypes_copy(#return_type, (void*)&mock_call_data->fail_return_value, (void*)&return_value) != 0) \
+            if (UMOCK_TYPE_HANDLERS_COPY(MU_C2(get_mock_type_handlers_, name)()->return_type_handlers, #return_type, (void*)&mock_call_data->fail_return_value, (void*)&return_value) != 0) \
             { \
                 UMOCK_LOG("Could not copy fail return value of type %s.", MU_TOSTRING(return_type)); \
                 umock_c_indicate_error(UMOCK_C_ERROR); \
@@ -436,6 +482,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 /* Codes_SRS_UMOCK_C_LIB_01_092: [If bytes is NULL or length is 0, umock_c shall raise an error with the code UMOCK_C_INVALID_ARGUMENT_BUFFER.] */
 /* Codes_SRS_UMOCK_C_LIB_01_089: [The buffers for previous CopyOutArgumentBuffer calls shall be freed.]*/
 /* Codes_SRS_UMOCK_C_LIB_01_133: [ If several calls to CopyOutArgumentBuffer are made, only the last buffer shall be kept. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_246: [ SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn and CaptureArgumentValue_{arg_name} shall mark the expected call as handing values back to the actual call that matches it by calling umockcall_set_has_call_results. ]*/
 #define IMPLEMENT_COPY_OUT_ARGUMENT_BUFFER_FUNCTION(return_type, name, ...) \
     MU_C2(mock_call_modifier_, name) MU_C2(copy_out_argument_buffer_func_, name)(size_t index, const void* bytes, size_t length) \
     { \
@@ -472,6 +519,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
                 { \
                     (void)memcpy(arg_buffer->bytes, bytes, length); \
                     arg_buffer->length = length; \
+                    (void)umockcall_set_has_call_results(umock_c_get_last_expected_call(), 1); \
                     mock_call_modifier.IgnoreArgument(index); \
                 } \
             } \
@@ -484,6 +532,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 /* Codes_SRS_UMOCK_C_LIB_01_156: [ If several calls to CopyOutArgumentBuffer are made, only the last buffer shall be kept. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_155: [ The memory shall be copied. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_158: [ If bytes is NULL or length is 0, umock_c shall raise an error with the code UMOCK_C_INVALID_ARGUMENT_BUFFER. ] */
+/* Codes_SRS_UMOCK_C_LIB_01_246: [ SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn and CaptureArgumentValue_{arg_name} shall mark the expected call as handing values back to the actual call that matches it by calling umockcall_set_has_call_results. ]*/
 #define IMPLEMENT_COPY_OUT_ARGUMENT_BUFFER_BY_NAME_FUNCTION(name, arg_type, arg_name) \
     MU_C2(mock_call_modifier_,name) MU_C4(copy_out_argument_buffer_func_,name,_,arg_name)(const void* bytes, size_t length) \
     { \
@@ -515,6 +564,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
                 { \
                     (void)memcpy(arg_buffer->bytes, bytes, length); \
                     arg_buffer->length = length; \
+                    (void)umockcall_set_has_call_results(umock_c_get_last_expected_call(), 1); \
                     MU_C2(mock_call_modifier.IgnoreArgument_, arg_name)(); \
                 } \
             } \
@@ -616,9 +666,52 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
         return mock_call_modifier; \
     } \
 
+#define IMPLEMENT_REPEAT_COUNT_FUNCTIONS_DECL(return_type, name, ...) \
+    MU_C2(mock_call_modifier_,name) MU_C2(times_func_,name)(size_t call_count); \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_least_func_,name)(size_t call_count); \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_most_func_,name)(size_t call_count); \
+
+/* Codes_SRS_UMOCK_C_LIB_01_238: [ If setting the repeat count of the last expected call fails, umock_c shall raise an error with the code UMOCK_C_INVALID_REPEAT_COUNT. ]*/
+#define IMPLEMENT_SET_REPEAT_COUNT_FUNCTION(return_type, name, ...) \
+    static MU_C2(mock_call_modifier_,name) MU_C2(set_repeat_count_func_,name)(size_t min_repeat_count, size_t max_repeat_count) \
+    { \
+        UMOCKCALL_HANDLE last_expected_call = umock_c_get_last_expected_call(); \
+        DECLARE_MOCK_CALL_MODIFIER(name) \
+        if (last_expected_call == NULL) \
+        { \
+            UMOCK_LOG("Cannot get last expected call."); \
+            umock_c_indicate_error(UMOCK_C_ERROR); \
+        } \
+        else if (umockcall_set_repeat_count(last_expected_call, min_repeat_count, max_repeat_count) != 0) \
+        { \
+            UMOCK_LOG("Cannot set the repeat count on the last expected call."); \
+            umock_c_indicate_error(UMOCK_C_INVALID_REPEAT_COUNT); \
+        } \
+        return mock_call_modifier; \
+    } \
+
+/* Codes_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_235: [ The AtLeast call modifier shall record that the expected call shall be matched by at least call_count actual calls. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_236: [ The AtMost call modifier shall record that the expected call shall be matched by at most call_count actual calls. ]*/
+#define IMPLEMENT_REPEAT_COUNT_FUNCTIONS_IMPL(return_type, name, ...) \
+    IMPLEMENT_SET_REPEAT_COUNT_FUNCTION(return_type, name, __VA_ARGS__) \
+    MU_C2(mock_call_modifier_,name) MU_C2(times_func_,name)(size_t call_count) \
+    { \
+        return MU_C2(set_repeat_count_func_,name)(call_count, call_count); \
+    } \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_least_func_,name)(size_t call_count) \
+    { \
+        return MU_C2(set_repeat_count_func_,name)(call_count, UMOCKCALL_UNLIMITED_REPEAT_COUNT); \
+    } \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_most_func_,name)(size_t call_count) \
+    { \
+        return MU_C2(set_repeat_count_func_,name)(0, call_count); \
+    } \
+
 /* Codes_SRS_UMOCK_C_LIB_01_223: [ The CaptureReturn call modifier shall copy the return value that is being returned to the code under test when an actual call is matched with the expected call. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_224: [ If CaptureReturn is called multiple times for the same call, an error shall be indicated with the code UMOCK_C_CAPTURE_RETURN_ALREADY_USED. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_182: [ If captured_return_value is NULL, umock_c shall raise an error with the code UMOCK_C_NULL_ARGUMENT. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_246: [ SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn and CaptureArgumentValue_{arg_name} shall mark the expected call as handing values back to the actual call that matches it by calling umockcall_set_has_call_results. ]*/
 #define IMPLEMENT_CAPTURE_RETURN_FUNCTION(return_type, name, ...) \
     MU_C2(mock_call_modifier_,name) MU_C2(capture_return_func_,name)(return_type* captured_return_value) \
     { \
@@ -646,6 +739,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
                 else \
                 { \
                     mock_call_data->captured_return_value = captured_return_value; \
+                    (void)umockcall_set_has_call_results(umock_c_get_last_expected_call(), 1); \
                 } \
             } \
         } \
@@ -754,6 +848,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
 
 /* Codes_SRS_UMOCK_C_LIB_01_209: [ The CaptureArgumentValue_{arg_name} shall copy the value of the argument at the time of the call to arg_value. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_211: [ The CaptureArgumentValue_{arg_name} shall not change the how the argument is validated. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_246: [ SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn and CaptureArgumentValue_{arg_name} shall mark the expected call as handing values back to the actual call that matches it by calling umockcall_set_has_call_results. ]*/
 #define IMPLEMENT_CAPTURE_ARGUMENT_VALUE_BY_NAME_FUNCTION(name, arg_type, arg_name) \
     MU_C2(mock_call_modifier_,name) MU_C4(capture_argument_value_func_,name,_,arg_name)(arg_type* arg_value) \
     { \
@@ -774,6 +869,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
             else \
             { \
                 mock_call_data->MU_C2(capture_arg_value_pointer_, arg_name) = (void*)arg_value; \
+                (void)umockcall_set_has_call_results(umock_c_get_last_expected_call(), 1); \
             } \
         } \
         return mock_call_modifier; \
@@ -818,8 +914,10 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
     MU_C2(mock_call_modifier_,name) MU_C2(function_prefix,name)(MU_IF(MU_COUNT_ARG(__VA_ARGS__),,void) MU_FOR_EACH_2_COUNTED(ARG_IN_SIGNATURE, __VA_ARGS__)) \
     { \
         UMOCKCALL_HANDLE mock_call; \
-        MU_C2(mock_call_,name)* mock_call_data = (MU_C2(mock_call_,name)*)umockalloc_malloc(sizeof(MU_C2(mock_call_,name))); \
+        const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)(); \
+        MU_C2(mock_call_,name)* mock_call_data = (MU_C2(mock_call_,name)*)umockalloc_call_malloc(sizeof(MU_C2(mock_call_,name))); \
         DECLARE_MOCK_CALL_MODIFIER(name) \
+        (void)mock_type_handlers; \
         MU_FOR_EACH_2(COPY_ARG_TO_MOCK_STRUCT, __VA_ARGS__) \
         MU_IF(args_ignored, MU_FOR_EACH_2(MARK_ARG_AS_IGNORED, __VA_ARGS__), MU_FOR_EACH_2(MARK_ARG_AS_NOT_IGNORED, __VA_ARGS__)) \
         MU_FOR_EACH_2_COUNTED(CLEAR_OUT_ARG_BUFFERS, __VA_ARGS__) \
@@ -832,7 +930,7 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
             mock_call_data->captured_return_value = NULL; \
             mock_call_data->fail_return_value_set = FAIL_RETURN_VALUE_NOT_SET; \
         ,) \
-        mock_call = umockcall_create(#name, mock_call_data, MU_C2(mock_call_data_copy_func_,name), MU_C2(mock_call_data_free_func_,name), MU_C2(mock_call_data_stringify_,name), MU_C2(mock_call_data_are_equal_,name)); \
+        mock_call = umockcall_create_with_static_function_name(MOCK_CALL_METADATA_FUNCTION_NAME(MU_C2(mock_call_metadata_,name)), mock_call_data, MU_C2(mock_call_data_copy_func_,name), MU_C2(mock_call_data_free_func_,name), MU_C2(mock_call_data_stringify_,name), MU_C2(mock_call_data_are_equal_,name)); \
         if (mock_call == NULL) \
         { \
             UMOCK_LOG("Failed creating mock call."); \
@@ -840,8 +938,13 @@ typedef int(*TRACK_DESTROY_FUNC_TYPE)(PAIRED_HANDLES* paired_handles, const void
         } \
         else \
         { \
-            (void)umock_c_add_expected_call(mock_call); \
+            /* the call is complete before it is added, as actual calls from other threads can match it right away */ \
             (void)umockcall_set_call_can_fail(mock_call, MU_IF(IS_NOT_VOID(return_type), 1, 0)); \
+            (void)umockcall_set_stringify_mismatch(mock_call, MU_C2(mock_call_data_stringify_mismatch_,name)); \
+            if (umock_c_add_expected_call(mock_call) != 0) \
+            { \
+                umockcall_destroy(mock_call); \
+            } \
         } \
         return mock_call_modifier; \
     } \
@@ -941,6 +1044,11 @@ typedef struct MOCK_CALL_METADATA_TAG
     const MOCK_CALL_ARG_METADATA* args;
 } MOCK_CALL_METADATA;
 
+/* the function name in the metadata is unique for each mock, so calls can reference it instead of copying it
+(this cannot be written inline in the mock macros, as their "name" argument would replace the member name) */
+#define MOCK_CALL_METADATA_FUNCTION_NAME(metadata) \
+    ((metadata).name)
+
 #define UNUSED_ARG(arg_type, arg_name) \
     (void)arg_name;
 
@@ -948,22 +1056,61 @@ typedef struct MOCK_CALL_METADATA_TAG
 /* Codes_SRS_UMOCK_C_LIB_01_207: [ IGNORED_ARG shall be defined to 0 so that it can be used for numeric and pointer type arguments. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_221: [ IGNORED_STRUCT_ARG(struct_type) shall expand to a zero initialized value of struct_type in order to allow automatically ignoring structure type arguments. ]*/
 #define AUTO_IGNORE_ARG(arg_type, arg_name) \
-    if (umockautoignoreargs_is_call_argument_ignored(call_as_string, arg_index++, &is_ignored) != 0) \
+    if (ignored_args[arg_index++]) \
     { \
-        UMOCK_LOG("Failed parsing argument %s value from the call.", MU_TOSTRING(arg_name)); \
+        result.MU_C2(IgnoreArgument_, arg_name)(); \
     } \
-    else \
+
+/* number of STRICT_EXPECTED_CALL sites for which each mock caches the ignored arguments mask on each thread */
+#define UMOCK_C_AUTO_IGNORE_ARGS_CACHE_SIZE 8
+
+/* Codes_SRS_UMOCK_C_LIB_01_230: [ The ignored arguments mask of a STRICT_EXPECTED_CALL site shall be computed by parsing the call string only the first time the call site is executed on a thread and shall then be cached, keyed by the address of the call string literal. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_231: [ When more call sites than the cache can hold are used for the same mock, the oldest cached call site shall be replaced. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_232: [ If parsing the call string fails, no arguments shall be automatically ignored and the result shall not be cached. ]*/
+/* Codes_SRS_UMOCK_C_LIB_01_248: [ The cache shall be kept per thread, so that threads setting expectations on the same mock at the same time never read or replace each other's cached masks. ]*/
+#define AUTO_IGNORE_ARGS(...) \
     { \
-        if (is_ignored) \
+        static UMOCK_THREAD_LOCAL const char* cached_call_strings[UMOCK_C_AUTO_IGNORE_ARGS_CACHE_SIZE]; \
+        static UMOCK_THREAD_LOCAL int cached_ignored_args[UMOCK_C_AUTO_IGNORE_ARGS_CACHE_SIZE][MU_DIV2(MU_COUNT_ARG(__VA_ARGS__))]; \
+        static UMOCK_THREAD_LOCAL size_t next_cache_slot; \
+        const int* ignored_args = NULL; \
+        size_t arg_index = 0; \
+        size_t cache_slot; \
+        for (cache_slot = 0; cache_slot < UMOCK_C_AUTO_IGNORE_ARGS_CACHE_SIZE; cache_slot++) \
+        { \
+            if (cached_call_strings[cache_slot] == call_as_string) \
+            { \
+                ignored_args = cached_ignored_args[cache_slot]; \
+                break; \
+            } \
+        } \
+        if (ignored_args == NULL) \
         { \
-            result.MU_C2(IgnoreArgument_, arg_name)(); \
+            cache_slot = next_cache_slot; \
+            next_cache_slot = (next_cache_slot + 1) % UMOCK_C_AUTO_IGNORE_ARGS_CACHE_SIZE; \
+            cached_call_strings[cache_slot] = NULL; \
+            if (umockautoignoreargs_get_ignored_mask(call_as_string, MU_DIV2(MU_COUNT_ARG(__VA_ARGS__)), cached_ignored_args[cache_slot]) != 0) \
+            { \
+                UMOCK_LOG("Failed parsing the argument values from the call %s.", call_as_string); \
+            } \
+            else \
+            { \
+                cached_call_strings[cache_slot] = call_as_string; \
+                ignored_args = cached_ignored_args[cache_slot]; \
+            } \
+        } \
+        if (ignored_args != NULL) \
+        { \
+            MU_FOR_EACH_2(AUTO_IGNORE_ARG, __VA_ARGS__) \
         } \
     } \
 
+#define NO_AUTO_IGNORE_ARGS(...)
+
 #define COPY_CAPTURED_ARGUMENT_VALUE(arg_type, arg_name) \
     if (matched_call_data->MU_C2(capture_arg_value_pointer_,arg_name) != NULL) \
     { \
-        if (umocktypes_copy(#arg_type, (void*)matched_call_data->MU_C2(capture_arg_value_pointer_,arg_name), (void*)&arg_name) != 0) \
+        if (UMOCK_TYPE_HANDLERS_COPY(mock_type_handlers->MU_C2(arg_type_handlers_,arg_name), #arg_type, (void*)matched_call_data->MU_C2(capture_arg_value_pointer_,arg_name), (void*)&arg_name) != 0) \
         { \
             UMOCK_LOG("Could not copy captured argument value of type %s.", MU_TOSTRING(arg_type)); \
             umock_c_indicate_error(UMOCK_C_ERROR); \
@@ -1052,6 +1199,9 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(capture_return_func_type_,name))(return_type* captured_return_value); \
     ,) \
     typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(ignore_all_calls_func_type_,name))(void); \
+    typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(times_func_type_,name))(size_t call_count); \
+    typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(at_least_func_type_,name))(size_t call_count); \
+    typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(at_most_func_type_,name))(size_t call_count); \
     MU_IF(MU_COUNT_ARG(__VA_ARGS__), \
         typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(ignore_all_arguments_func_type_,name))(void); \
         typedef struct MU_C2(_mock_call_modifier_,name) (*MU_C2(validate_all_arguments_func_type_,name))(void); \
@@ -1065,6 +1215,9 @@ IMPL        1             x             in all cases of IMPL the returns cannot
     typedef struct MU_C2(_mock_call_modifier_,name) \
     { \
         MU_C2(ignore_all_calls_func_type_,name) IgnoreAllCalls; \
+        MU_C2(times_func_type_,name) Times; \
+        MU_C2(at_least_func_type_,name) AtLeast; \
+        MU_C2(at_most_func_type_,name) AtMost; \
         MU_IF(IS_NOT_VOID(return_type),MU_C2(set_return_func_type_,name) SetReturn; \
         MU_C2(set_fail_return_func_type_,name) SetFailReturn; \
         MU_C2(call_cannot_fail_func_type_,name) CallCannotFail; \
@@ -1079,6 +1232,9 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         ,) \
     } MU_C2(mock_call_modifier_,name); \
     MU_C2(mock_call_modifier_,name) MU_C2(ignore_all_calls_func_,name)(void); \
+    MU_C2(mock_call_modifier_,name) MU_C2(times_func_,name)(size_t call_count); \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_least_func_,name)(size_t call_count); \
+    MU_C2(mock_call_modifier_,name) MU_C2(at_most_func_,name)(size_t call_count); \
     MU_IF(IS_NOT_VOID(return_type), \
         MU_C2(mock_call_modifier_,name) MU_C2(set_return_func_,name)(return_type return_value); \
         MU_C2(mock_call_modifier_,name) MU_C2(set_fail_return_func_,name)(return_type return_value); \
@@ -1136,14 +1292,23 @@ IMPL        1             x             in all cases of IMPL the returns cannot
             )\
         ) \
     } MU_C2(mock_call_, name); \
+    typedef struct MU_C2(_mock_type_handlers_, name) \
+    { \
+        volatile uint64_t generation; \
+        MU_IF(IS_NOT_VOID(return_type), const UMOCKTYPE_HANDLERS* return_type_handlers;,) \
+        MU_FOR_EACH_2(DECLARE_TYPE_HANDLERS_FOR_ARG, __VA_ARGS__) \
+    } MU_C2(mock_type_handlers_, name); \
+    const MU_C2(mock_type_handlers_, name)* MU_C2(get_mock_type_handlers_, name)(void); \
     typedef MU_C2(mock_call_modifier_,name) (*MU_C3(auto_ignore_args_function_,name,_type))(MU_C2(mock_call_modifier_,name) call_modifier, const char* call_as_string); \
     MU_C2(mock_call_modifier_,name) MU_C2(auto_ignore_args_function_,name)(MU_C2(mock_call_modifier_,name) call_modifier, const char* call_as_string); \
     MU_C3(auto_ignore_args_function_,name,_type) MU_C2(get_auto_ignore_args_function_,name)(MU_IF(MU_COUNT_ARG(__VA_ARGS__),,void) MU_FOR_EACH_2_COUNTED(ARG_IN_SIGNATURE, __VA_ARGS__)); \
     char* MU_C2(mock_call_data_stringify_,name)(void* mock_call_data); \
     int MU_C2(mock_call_data_are_equal_,name)(void* left, void* right); \
+    char* MU_C2(mock_call_data_stringify_mismatch_,name)(void* expected, void* actual); \
     void MU_C2(mock_call_data_free_func_,name)(void* mock_call_data); \
     void* MU_C2(mock_call_data_copy_func_,name)(void* mock_call_data); \
     IMPLEMENT_IGNORE_ALL_CALLS_FUNCTION_DECL(return_type, name, __VA_ARGS__) \
+    IMPLEMENT_REPEAT_COUNT_FUNCTIONS_DECL(return_type, name, __VA_ARGS__) \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_HOOK_DECL(return_type, name, __VA_ARGS__); \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_FAIL_RETURN_DECL(return_type, name, __VA_ARGS__); \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_RETURN_DECL(return_type, name, __VA_ARGS__); \
@@ -1195,6 +1360,26 @@ IMPL        1             x             in all cases of IMPL the returns cannot
     MU_IF(MU_COUNT_ARG(__VA_ARGS__),\
         };  \
     ,) \
+    /* Codes_SRS_UMOCK_C_LIB_01_226: [ The handlers for the argument types and the return type of a mock shall be resolved only once and reused for as long as umocktypes_get_generation returns the same value. ]*/ \
+    /* Codes_SRS_UMOCK_C_LIB_01_244: [ When several threads make the first call to a mock, only one of them shall resolve the handlers and publish them with a release store of the generation, the other threads shall wait until the generation is published. ]*/ \
+    const MU_C2(mock_type_handlers_, name)* MU_C2(get_mock_type_handlers_, name)(void) \
+    { \
+        static MU_C2(mock_type_handlers_, name) mock_type_handlers = { 0 }; \
+        uint64_t generation = (uint64_t)umocktypes_get_generation(); \
+        uint64_t published_generation = umockatomic_load_uint64(&mock_type_handlers.generation); \
+        while (published_generation != generation) \
+        { \
+            if ((published_generation != MOCK_TYPE_HANDLERS_RESOLVING) && \
+                umockatomic_compare_exchange_uint64(&mock_type_handlers.generation, published_generation, MOCK_TYPE_HANDLERS_RESOLVING)) \
+            { \
+                MU_IF(IS_NOT_VOID(return_type), mock_type_handlers.return_type_handlers = umocktypes_get_handlers(#return_type);,) \
+                MU_FOR_EACH_2(RESOLVE_TYPE_HANDLERS_FOR_ARG, __VA_ARGS__) \
+                umockatomic_store_uint64(&mock_type_handlers.generation, generation); \
+            } \
+            published_generation = umockatomic_load_uint64(&mock_type_handlers.generation); \
+        } \
+        return &mock_type_handlers; \
+    } \
     void MU_C2(fill_mock_call_modifier_,name)(MU_C2(mock_call_modifier_,name)* mock_call_modifier) \
     { \
         MU_IF(IS_NOT_VOID(return_type), \
@@ -1217,15 +1402,15 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         ,) \
         MU_FOR_EACH_2_KEEP_1(COPY_CAPTURE_ARGUMENT_VALUE_BY_NAME_TO_MODIFIER, name, __VA_ARGS__) \
         mock_call_modifier->IgnoreAllCalls = MU_C2(ignore_all_calls_func_,name); \
+        mock_call_modifier->Times = MU_C2(times_func_,name); \
+        mock_call_modifier->AtLeast = MU_C2(at_least_func_,name); \
+        mock_call_modifier->AtMost = MU_C2(at_most_func_,name); \
     } \
     MU_C2(mock_call_modifier_,name) MU_C2(auto_ignore_args_function_,name)(MU_C2(mock_call_modifier_,name) call_modifier, const char* call_as_string) \
     { \
         MU_C2(mock_call_modifier_,name) result = call_modifier; \
-        MU_IF(MU_COUNT_ARG(__VA_ARGS__), \
-        int is_ignored; \
-        int arg_index = 1; ,) \
         (void)call_as_string; \
-        MU_FOR_EACH_2(AUTO_IGNORE_ARG, __VA_ARGS__) \
+        MU_IF(MU_COUNT_ARG(__VA_ARGS__), AUTO_IGNORE_ARGS, NO_AUTO_IGNORE_ARGS)(__VA_ARGS__) \
         return result; \
     } \
     MU_C3(auto_ignore_args_function_,name,_type) MU_C2(get_auto_ignore_args_function_,name)(MU_IF(MU_COUNT_ARG(__VA_ARGS__),,void) MU_FOR_EACH_2_COUNTED(ARG_IN_SIGNATURE, __VA_ARGS__)) \
@@ -1236,7 +1421,8 @@ IMPL        1             x             in all cases of IMPL the returns cannot
     char* MU_C2(mock_call_data_stringify_,name)(void* mock_call_data) \
     { \
         char* result; \
-        MU_IF(MU_COUNT_ARG(__VA_ARGS__), MU_C2(mock_call_,name)* typed_mock_call_data = (MU_C2(mock_call_,name)*)mock_call_data;,) \
+        MU_IF(MU_COUNT_ARG(__VA_ARGS__), MU_C2(mock_call_,name)* typed_mock_call_data = (MU_C2(mock_call_,name)*)mock_call_data; \
+        const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)();,) \
         int is_error = 0; \
         size_t args_string_length = 0; \
         MU_FOR_EACH_2_COUNTED(STRINGIFY_ARGS_DECLARE_RESULT_VAR, __VA_ARGS__) \
@@ -1249,23 +1435,28 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         } \
         else \
         { \
+            UMOCKSTRINGBUILDER string_builder; \
             MU_FOR_EACH_2(STRINGIFY_ARGS_DECLARE_ARG_STRING_LENGTH, __VA_ARGS__) \
             MU_FOR_EACH_2(STRINGIFY_ARGS_COUNT_LENGTH, __VA_ARGS__) \
             MU_IF(MU_COUNT_ARG(__VA_ARGS__),  args_string_length += MU_COUNT_ARG(__VA_ARGS__) - 1;,) \
-            result = (char*)umockalloc_malloc(args_string_length + 1); \
-            if (result != NULL) \
+            umockstringbuilder_init(&string_builder); \
+            if (umockstringbuilder_reserve(&string_builder, args_string_length) != 0) \
             { \
-                if (args_string_length == 0) \
-                { \
-                    result[0] = '\0'; \
-                } \
-                else \
-                { \
-                    MU_IF(MU_COUNT_ARG(__VA_ARGS__), \
-                    size_t current_pos = 0; \
-                    size_t arg_index = 0; \
-                    MU_FOR_EACH_2(STRINGIFY_ARGS_COPY_ARG_STRING, __VA_ARGS__), ) \
-                } \
+                is_error = 1; \
+            } \
+            MU_IF(MU_COUNT_ARG(__VA_ARGS__), \
+            { \
+                size_t arg_index = 0; \
+                MU_FOR_EACH_2(STRINGIFY_ARGS_APPEND_ARG_STRING, __VA_ARGS__) \
+            }, ) \
+            if (is_error != 0) \
+            { \
+                umockstringbuilder_deinit(&string_builder); \
+                result = NULL; \
+            } \
+            else \
+            { \
+                result = umockstringbuilder_detach(&string_builder); \
             } \
         } \
         MU_FOR_EACH_2(STRINGIFY_ARGS_FREE_STRINGIFIED_ARG, __VA_ARGS__) \
@@ -1289,34 +1480,52 @@ IMPL        1             x             in all cases of IMPL the returns cannot
             { \
                 MU_C2(mock_call_,name)* typed_left = (MU_C2(mock_call_,name)*)left; \
                 MU_C2(mock_call_,name)* typed_right = (MU_C2(mock_call_,name)*)right; \
+                const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)(); \
                 MU_FOR_EACH_2_COUNTED(ARE_EQUAL_FOR_ARG, __VA_ARGS__) \
             }, ) \
         } \
         return result; \
     } \
+    char* MU_C2(mock_call_data_stringify_mismatch_,name)(void* expected, void* actual) \
+    { \
+        char* result = NULL; \
+        MU_IF(MU_COUNT_ARG(__VA_ARGS__), \
+        { \
+            MU_C2(mock_call_,name)* typed_expected = (MU_C2(mock_call_,name)*)expected; \
+            MU_C2(mock_call_,name)* typed_actual = (MU_C2(mock_call_,name)*)actual; \
+            MU_FOR_EACH_2_COUNTED(STRINGIFY_MISMATCH_FOR_ARG, __VA_ARGS__) \
+        }, \
+        (void)expected; \
+        (void)actual;) \
+        return result; \
+    } \
     void MU_C2(mock_call_data_free_func_,name)(void* mock_call_data) \
     { \
         MU_C2(mock_call_,name)* typed_mock_call_data = (MU_C2(mock_call_,name)*)mock_call_data; \
+        const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)(); \
+        (void)mock_type_handlers; \
         MU_FOR_EACH_2_COUNTED(FREE_ARG_VALUE, __VA_ARGS__) \
         MU_FOR_EACH_2_COUNTED(FREE_OUT_ARG_BUFFERS, __VA_ARGS__) \
         MU_FOR_EACH_2_COUNTED(FREE_VALIDATE_ARG_BUFFERS, __VA_ARGS__) \
         MU_FOR_EACH_2_COUNTED(FREE_OVERRIDE_ARGUMENT_TYPE, __VA_ARGS__) \
         MU_IF(IS_NOT_VOID(return_type),if (typed_mock_call_data->return_value_set == RETURN_VALUE_SET) \
         { \
-            umocktypes_free(MU_TOSTRING(return_type), (void*)&typed_mock_call_data->return_value); \
+            UMOCK_TYPE_HANDLERS_FREE(mock_type_handlers->return_type_handlers, MU_TOSTRING(return_type), (void*)&typed_mock_call_data->return_value); \
         } \
         if (typed_mock_call_data->fail_return_value_set == FAIL_RETURN_VALUE_SET) \
         { \
-            umocktypes_free(MU_TOSTRING(return_type), (void*)&typed_mock_call_data->fail_return_value); \
+            UMOCK_TYPE_HANDLERS_FREE(mock_type_handlers->return_type_handlers, MU_TOSTRING(return_type), (void*)&typed_mock_call_data->fail_return_value); \
         },) \
         umockalloc_free(typed_mock_call_data); \
     } \
     void* MU_C2(mock_call_data_copy_func_,name)(void* mock_call_data) \
     { \
         MU_C2(mock_call_,name)* result = (MU_C2(mock_call_,name)*)umockalloc_malloc(sizeof(MU_C2(mock_call_,name))); \
+        const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)(); \
         MU_IF(MU_COUNT_ARG(__VA_ARGS__), MU_C2(mock_call_,name)* typed_mock_call_data = (MU_C2(mock_call_,name)*)mock_call_data;,) \
         MU_IF(IS_NOT_VOID(return_type), MU_C2(mock_call_,name)* typed_mock_call_data_result = (MU_C2(mock_call_,name)*)mock_call_data;,) \
         (void)mock_call_data; \
+        (void)mock_type_handlers; \
         MU_FOR_EACH_2(COPY_IGNORE_ARG, __VA_ARGS__) \
         MU_FOR_EACH_2(COPY_ARG_VALUE, __VA_ARGS__) \
         MU_FOR_EACH_2_COUNTED(COPY_OUT_ARG_BUFFERS, __VA_ARGS__) \
@@ -1329,12 +1538,12 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         result->fail_return_value_set = typed_mock_call_data_result->fail_return_value_set; \
         if (typed_mock_call_data_result->return_value_set == RETURN_VALUE_SET) \
         { \
-            umocktypes_copy(MU_TOSTRING(return_type), (void*)&result->return_value, (void*)&typed_mock_call_data_result->return_value); \
+            UMOCK_TYPE_HANDLERS_COPY(mock_type_handlers->return_type_handlers, MU_TOSTRING(return_type), (void*)&result->return_value, (void*)&typed_mock_call_data_result->return_value); \
         } \
         result->captured_return_value = typed_mock_call_data_result->captured_return_value; \
         if (typed_mock_call_data_result->fail_return_value_set == FAIL_RETURN_VALUE_SET) \
         { \
-            umocktypes_copy(MU_TOSTRING(return_type), (void*)&result->fail_return_value, (void*)&typed_mock_call_data_result->fail_return_value); \
+            UMOCK_TYPE_HANDLERS_COPY(mock_type_handlers->return_type_handlers, MU_TOSTRING(return_type), (void*)&result->fail_return_value, (void*)&typed_mock_call_data_result->fail_return_value); \
         },) \
         return result; \
     } \
@@ -1358,6 +1567,7 @@ IMPL        1             x             in all cases of IMPL the returns cannot
     ,) \
     MU_FOR_EACH_2_KEEP_1(IMPLEMENT_CAPTURE_ARGUMENT_VALUE_BY_NAME_FUNCTION, name, __VA_ARGS__) \
     IMPLEMENT_IGNORE_ALL_CALLS_FUNCTION_IMPL(return_type, name, __VA_ARGS__) \
+    IMPLEMENT_REPEAT_COUNT_FUNCTIONS_IMPL(return_type, name, __VA_ARGS__) \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_HOOK_IMPL(return_type, name, __VA_ARGS__) \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_FAIL_RETURN_IMPL(return_type, name, __VA_ARGS__) \
     IMPLEMENT_REGISTER_GLOBAL_MOCK_RETURN_IMPL(return_type, name, __VA_ARGS__) \
@@ -1395,7 +1605,9 @@ IMPL        1             x             in all cases of IMPL the returns cannot
             (void)used_paired_handles_local_C8417226_7442_49B4_BBB9_9CA816A21EB7;,) \
         MU_IF(IS_NOT_VOID(return_type),return_type result_C8417226_7442_49B4_BBB9_9CA816A21EB7 = MU_C2(get_mock_call_return_values_,name)()->success_value;,) \
         MU_C2(mock_call_,name)* matched_call_data; \
-        MU_C2(mock_call_,name)* mock_call_data = (MU_C2(mock_call_,name)*)umockalloc_malloc(sizeof(MU_C2(mock_call_,name))); \
+        const MU_C2(mock_type_handlers_,name)* mock_type_handlers = MU_C2(get_mock_type_handlers_,name)(); \
+        MU_C2(mock_call_,name)* mock_call_data = (MU_C2(mock_call_,name)*)umockalloc_call_malloc(sizeof(MU_C2(mock_call_,name))); \
+        (void)mock_type_handlers; \
         MU_FOR_EACH_2(COPY_ARG_TO_MOCK_STRUCT, __VA_ARGS__) \
         MU_FOR_EACH_2(MARK_ARG_AS_NOT_IGNORED, __VA_ARGS__) \
         MU_FOR_EACH_2_COUNTED(CLEAR_OUT_ARG_BUFFERS, __VA_ARGS__) \
@@ -1406,7 +1618,7 @@ IMPL        1             x             in all cases of IMPL the returns cannot
         MU_IF(IS_NOT_VOID(return_type),mock_call_data->return_value_set = RETURN_VALUE_NOT_SET; \
         mock_call_data->captured_return_value = NULL; \
         mock_call_data->fail_return_value_set = FAIL_RETURN_VALUE_NOT_SET;,) \
-        mock_call = umockcall_create(#name, mock_call_data, MU_C2(mock_call_data_copy_func_,name), MU_C2(mock_call_data_free_func_,name), MU_C2(mock_call_data_stringify_,name), MU_C2(mock_call_data_are_equal_,name)); \
+        mock_call = umockcall_create_with_static_function_name(MOCK_CALL_METADATA_FUNCTION_NAME(MU_C2(mock_call_metadata_,name)), mock_call_data, MU_C2(mock_call_data_copy_func_,name), MU_C2(mock_call_data_free_func_,name), MU_C2(mock_call_data_stringify_,name), MU_C2(mock_call_data_are_equal_,name)); \
         if (mock_call == NULL) \
         { \
             MU_IF(IS_NOT_VOID(return_type),COPY_RETURN_VALUE(return_type, name),) \
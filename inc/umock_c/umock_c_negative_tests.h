@@ -10,10 +10,24 @@
 #include <stddef.h>
 #endif
 
+#include "macro_utils/macro_utils.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define UMOCK_C_NEGATIVE_TESTS_RESULT_VALUES \
+    UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, \
+    UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED, \
+    UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED, \
+    UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST
+
+MU_DEFINE_ENUM(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_VALUES)
+
+    /* test_body runs in a worker process: it shall report a failure by returning a non-zero value and not by asserting */
+    typedef int(*UMOCK_C_NEGATIVE_TESTS_TEST_BODY)(void* context, size_t index);
+    typedef void(*UMOCK_C_NEGATIVE_TESTS_ON_RESULT)(void* context, size_t index, UMOCK_C_NEGATIVE_TESTS_RESULT result, const char* expected_calls, const char* actual_calls);
+
     int umock_c_negative_tests_init(void);
     void umock_c_negative_tests_deinit(void);
     void umock_c_negative_tests_snapshot(void);
@@ -21,6 +35,11 @@ extern "C" {
     void umock_c_negative_tests_fail_call(size_t index);
     size_t umock_c_negative_tests_call_count(void);
     int umock_c_negative_tests_can_call_fail(size_t index);
+    size_t umock_c_negative_tests_next_failable_index(size_t index);
+#if defined(__unix__) || defined(__APPLE__)
+    /* only available on platforms that have fork (the UNIX builds, see CMakeLists.txt) */
+    int umock_c_negative_tests_run_parallel(size_t worker_count, UMOCK_C_NEGATIVE_TESTS_TEST_BODY test_body, void* test_body_context, UMOCK_C_NEGATIVE_TESTS_ON_RESULT on_result, void* on_result_context);
+#endif
 
 #ifdef __cplusplus
 }
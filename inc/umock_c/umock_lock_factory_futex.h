@@ -0,0 +1,20 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef UMOCK_LOCK_FACTORY_FUTEX_H
+#define UMOCK_LOCK_FACTORY_FUTEX_H
+
+#include "umock_c/umock_lock_if.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* Linux only: a reader/writer lock that spins adaptively and then sleeps on a futex, to be passed to umock_c_init_with_lock_factory */
+    UMOCK_C_LOCK_HANDLE umock_lock_factory_futex_create_lock(void* params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMOCK_LOCK_FACTORY_FUTEX_H */
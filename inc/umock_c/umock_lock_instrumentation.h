@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef UMOCK_LOCK_INSTRUMENTATION_H
+#define UMOCK_LOCK_INSTRUMENTATION_H
+
+#ifdef __cplusplus
+#include <cstdint>
+#else
+#include <stdint.h>
+#endif
+
+#include "umock_c/umock_lock_if.h"
+#include "umock_c/umock_lock_factory.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* bucket 0 counts durations under 2 ns, bucket i counts durations in [2^i, 2^(i+1)) ns, the last bucket also counts everything longer */
+#define UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT 32
+
+    typedef struct UMOCK_LOCK_INSTRUMENTATION_TAG* UMOCK_LOCK_INSTRUMENTATION_HANDLE;
+
+    typedef struct UMOCK_LOCK_INSTRUMENTATION_MODE_STATS_TAG
+    {
+        uint64_t acquire_count;
+        uint64_t total_wait_ns;
+        uint64_t max_wait_ns;
+        uint64_t wait_histogram[UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT];
+        uint64_t release_count;
+        uint64_t total_hold_ns;
+        uint64_t max_hold_ns;
+        uint64_t hold_histogram[UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT];
+    } UMOCK_LOCK_INSTRUMENTATION_MODE_STATS;
+
+    typedef struct UMOCK_LOCK_INSTRUMENTATION_STATS_TAG
+    {
+        UMOCK_LOCK_INSTRUMENTATION_MODE_STATS shared;
+        UMOCK_LOCK_INSTRUMENTATION_MODE_STATS exclusive;
+    } UMOCK_LOCK_INSTRUMENTATION_STATS;
+
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE umock_lock_instrumentation_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params);
+    void umock_lock_instrumentation_destroy(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation);
+
+    /* lock factory to be passed to umock_c_init_with_lock_factory, params is the UMOCK_LOCK_INSTRUMENTATION_HANDLE */
+    UMOCK_C_LOCK_HANDLE umock_lock_instrumentation_create_lock(void* params);
+
+    int umock_lock_instrumentation_get_stats(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation, UMOCK_LOCK_INSTRUMENTATION_STATS* stats);
+    void umock_lock_instrumentation_reset_stats(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMOCK_LOCK_INSTRUMENTATION_H */
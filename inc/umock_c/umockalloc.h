@@ -10,6 +10,8 @@
 #include <stddef.h>
 #endif
 
+#include "umock_c/umock_lock_factory.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,7 +21,23 @@ void* umockalloc_calloc(size_t nmemb, size_t size);
 void* umockalloc_realloc(void* ptr, size_t size);
 void umockalloc_free(void* ptr);
 
+typedef struct UMOCKALLOC_ARENA_TAG* UMOCKALLOC_ARENA_HANDLE;
+
+UMOCKALLOC_ARENA_HANDLE umockalloc_arena_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params);
+void umockalloc_arena_destroy(UMOCKALLOC_ARENA_HANDLE arena);
+void* umockalloc_arena_malloc(UMOCKALLOC_ARENA_HANDLE arena, size_t size);
+int umockalloc_arena_owns(UMOCKALLOC_ARENA_HANDLE arena, const void* ptr);
+void umockalloc_arena_reset(UMOCKALLOC_ARENA_HANDLE arena);
+
+void umockalloc_set_call_arena(UMOCKALLOC_ARENA_HANDLE arena);
+void* umockalloc_call_malloc(size_t size);
+
+void umockc_set_stringify_buffer_truncation(size_t edge_byte_count);
 char* umockc_stringify_buffer(const void* bytes, size_t length);
+int umockc_compare_buffers(const void* left, const void* right, size_t length, size_t* first_difference_offset);
+char* umockc_stringify_buffer_difference(const void* expected, const void* actual, size_t length, size_t first_difference_offset);
+int umockc_validate_argument_buffer(const void* expected, const void* actual, size_t length);
+char* umockc_stringify_argument_buffer_mismatch(const char* argument_name, const void* expected, const void* actual, size_t length);
 
 #ifdef __cplusplus
 }
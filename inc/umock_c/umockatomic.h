@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef UMOCKATOMIC_H
+#define UMOCKATOMIC_H
+
+#include <stdint.h>
+
+/* storage class for the per thread state kept by umock_c */
+#if defined(_MSC_VER)
+#define UMOCK_THREAD_LOCAL __declspec(thread)
+#elif defined(__cplusplus)
+#define UMOCK_THREAD_LOCAL thread_local
+#else
+#define UMOCK_THREAD_LOCAL _Thread_local
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* loads have acquire semantics, stores have release semantics, the read-modify-write operations are sequentially consistent */
+uint64_t umockatomic_increment_uint64(volatile uint64_t* value);
+uint64_t umockatomic_add_uint64(volatile uint64_t* value, uint64_t addend);
+uint64_t umockatomic_load_uint64(volatile uint64_t* value);
+void umockatomic_store_uint64(volatile uint64_t* value, uint64_t new_value);
+int umockatomic_compare_exchange_uint64(volatile uint64_t* value, uint64_t expected_value, uint64_t new_value);
+void umockatomic_max_uint64(volatile uint64_t* value, uint64_t candidate);
+void* umockatomic_load_pointer(void* volatile* value);
+void umockatomic_store_pointer(void* volatile* value, void* new_value);
+int umockatomic_compare_exchange_pointer(void* volatile* value, void* expected_value, void* new_value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMOCKATOMIC_H */
@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 int umockautoignoreargs_is_call_argument_ignored(const char* call, size_t argument_index, int* is_argument_ignored);
+int umockautoignoreargs_get_ignored_mask(const char* call, size_t argument_count, int* is_argument_ignored);
 
 #ifdef __cplusplus
 }
@@ -10,28 +10,45 @@
 #include <stddef.h>
 #endif
 
+#include "umock_c/umockstringbuilder.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+    /* used as max_repeat_count when a call can be repeated any number of times */
+#define UMOCKCALL_UNLIMITED_REPEAT_COUNT ((size_t)-1)
+
     typedef struct UMOCKCALL_TAG* UMOCKCALL_HANDLE;
     typedef void*(*UMOCKCALL_DATA_COPY_FUNC)(void* umockcall_data);
     typedef void(*UMOCKCALL_DATA_FREE_FUNC)(void* umockcall_data);
     typedef char*(*UMOCKCALL_DATA_STRINGIFY_FUNC)(void* umockcall_data);
     typedef int(*UMOCKCALL_DATA_ARE_EQUAL_FUNC)(void* left, void* right);
+    typedef char*(*UMOCKCALL_DATA_STRINGIFY_MISMATCH_FUNC)(void* expected_umockcall_data, void* actual_umockcall_data);
 
     UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal);
+    UMOCKCALL_HANDLE umockcall_create_with_static_function_name(const char* function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal);
     void umockcall_destroy(UMOCKCALL_HANDLE umockcall);
     int umockcall_are_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right);
     char* umockcall_stringify(UMOCKCALL_HANDLE umockcall);
+    int umockcall_stringify_append(UMOCKCALL_HANDLE umockcall, UMOCKSTRINGBUILDER* string_builder);
+    char* umockcall_stringify_mismatch(UMOCKCALL_HANDLE expected_umockcall, UMOCKCALL_HANDLE actual_umockcall);
     void* umockcall_get_call_data(UMOCKCALL_HANDLE umockcall);
     UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall);
+    UMOCKCALL_HANDLE umockcall_share(UMOCKCALL_HANDLE umockcall);
+    int umockcall_is_shared(UMOCKCALL_HANDLE umockcall);
     int umockcall_set_fail_call(UMOCKCALL_HANDLE umockcall, int fail_call);
     int umockcall_get_fail_call(UMOCKCALL_HANDLE umockcall);
     int umockcall_set_ignore_all_calls(UMOCKCALL_HANDLE umockcall, int ignore_all_calls);
     int umockcall_get_ignore_all_calls(UMOCKCALL_HANDLE umockcall);
     int umockcall_set_call_can_fail(UMOCKCALL_HANDLE umockcall, int call_can_fail);
     int umockcall_get_call_can_fail(UMOCKCALL_HANDLE umockcall);
+    int umockcall_set_has_call_results(UMOCKCALL_HANDLE umockcall, int has_call_results);
+    int umockcall_get_has_call_results(UMOCKCALL_HANDLE umockcall);
+    int umockcall_set_stringify_mismatch(UMOCKCALL_HANDLE umockcall, UMOCKCALL_DATA_STRINGIFY_MISMATCH_FUNC umockcall_data_stringify_mismatch);
+    int umockcall_set_repeat_count(UMOCKCALL_HANDLE umockcall, size_t min_repeat_count, size_t max_repeat_count);
+    int umockcall_get_repeat_count(UMOCKCALL_HANDLE umockcall, size_t* min_repeat_count, size_t* max_repeat_count);
+    int umockcall_get_function_name_hash(UMOCKCALL_HANDLE umockcall, size_t* function_name_hash);
 
 #ifdef __cplusplus
 }
@@ -20,10 +20,21 @@ typedef struct PAIRED_HANDLE_TAG
     char* handle_type;
 } PAIRED_HANDLE;
 
+/* slot in the hash set used for handles whose type is compared as a pointer value, a count of 0 marks an empty slot */
+typedef struct POINTER_PAIRED_HANDLE_TAG
+{
+    void* handle_value;
+    size_t count;
+} POINTER_PAIRED_HANDLE;
+
 typedef struct PAIRED_HANDLES_TAG
 {
     PAIRED_HANDLE* paired_handles;
     size_t paired_handle_count;
+    size_t paired_handle_capacity;
+    POINTER_PAIRED_HANDLE* pointer_handles;
+    size_t pointer_handle_used_slot_count;
+    size_t pointer_handle_capacity;
 } PAIRED_HANDLES;
 
 int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, const void* handle, const char* handle_type, size_t handle_type_size);
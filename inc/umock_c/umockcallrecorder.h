@@ -22,6 +22,7 @@ extern "C" {
     UMOCKCALLRECORDER_HANDLE umockcallrecorder_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params);
     void umockcallrecorder_destroy(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
     int umockcallrecorder_reset_all_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
+    int umockcallrecorder_reserve(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t expected_call_count, size_t actual_call_count);
     int umockcallrecorder_add_expected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call);
     int umockcallrecorder_add_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call, UMOCKCALL_HANDLE* matched_call);
     const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
@@ -31,6 +32,9 @@ extern "C" {
     int umockcallrecorder_get_expected_call_count(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t* expected_call_count);
     int umockcallrecorder_fail_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index);
     int umockcallrecorder_can_call_fail(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index, int* can_call_fail);
+    int umockcallrecorder_enable_per_thread_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
+    int umockcallrecorder_begin_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
+    int umockcallrecorder_end_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef UMOCKSTRINGBUILDER_H
+#define UMOCKSTRINGBUILDER_H
+
+#ifdef __cplusplus
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct UMOCKSTRINGBUILDER_TAG
+{
+    char* buffer;
+    size_t length;
+    size_t capacity;
+} UMOCKSTRINGBUILDER;
+
+void umockstringbuilder_init(UMOCKSTRINGBUILDER* string_builder);
+void umockstringbuilder_deinit(UMOCKSTRINGBUILDER* string_builder);
+void umockstringbuilder_clear(UMOCKSTRINGBUILDER* string_builder);
+int umockstringbuilder_reserve(UMOCKSTRINGBUILDER* string_builder, size_t additional_length);
+int umockstringbuilder_append(UMOCKSTRINGBUILDER* string_builder, const char* source, size_t source_length);
+int umockstringbuilder_append_string(UMOCKSTRINGBUILDER* string_builder, const char* source);
+int umockstringbuilder_append_char(UMOCKSTRINGBUILDER* string_builder, char c);
+const char* umockstringbuilder_get_string(UMOCKSTRINGBUILDER* string_builder);
+char* umockstringbuilder_detach(UMOCKSTRINGBUILDER* string_builder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMOCKSTRINGBUILDER_H */
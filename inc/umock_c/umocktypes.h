@@ -26,6 +26,14 @@ extern "C" {
     typedef void(*UMOCKTYPE_FREE_FUNC)(void* value);
     typedef int(*UMOCKTYPE_ARE_EQUAL_FUNC)(const void* left, const void* right);
 
+    typedef struct UMOCKTYPE_HANDLERS_TAG
+    {
+        UMOCKTYPE_STRINGIFY_FUNC stringify_func;
+        UMOCKTYPE_COPY_FUNC copy_func;
+        UMOCKTYPE_FREE_FUNC free_func;
+        UMOCKTYPE_ARE_EQUAL_FUNC are_equal_func;
+    } UMOCKTYPE_HANDLERS;
+
     int umocktypes_init(void);
     void umocktypes_deinit(void);
     int umocktypes_register_type(const char* type, UMOCKTYPE_STRINGIFY_FUNC stringify_func, UMOCKTYPE_ARE_EQUAL_FUNC are_equal_func, UMOCKTYPE_COPY_FUNC copy_func, UMOCKTYPE_FREE_FUNC free_func);
@@ -36,6 +44,10 @@ extern "C" {
     int umocktypes_copy(const char* type, void* destination, const void* source);
     void umocktypes_free(const char* type, void* value);
 
+    /* resolved handlers can be kept (and called directly) for as long as umocktypes_get_generation returns the same value */
+    const UMOCKTYPE_HANDLERS* umocktypes_get_handlers(const char* type);
+    size_t umocktypes_get_generation(void);
+
     /* This is a convenience macro that allows registering a type by simply specifying the name and a function_postfix*/
 #define REGISTER_TYPE(type, function_postfix) \
         umocktypes_register_type(MU_TOSTRING(type), (UMOCKTYPE_STRINGIFY_FUNC)MU_C2(umocktypes_stringify_, function_postfix), \
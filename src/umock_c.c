@@ -7,6 +7,7 @@
 
 #include "umock_c/umock_c.h"
 #include "umock_c/umock_lock_factory.h"
+#include "umock_c/umockalloc.h"
 #include "umock_c/umockcall.h"
 #include "umock_c/umocktypes.h"
 #include "umock_c/umocktypes_c.h"
@@ -23,6 +24,9 @@ MU_DEFINE_ENUM_STRINGS(UMOCK_C_STATE, UMOCK_C_STATE_VALUES);
 static ON_UMOCK_C_ERROR on_umock_c_error_function;
 static UMOCK_C_STATE umock_c_state = UMOCK_C_STATE_NOT_INITIALIZED;
 static UMOCKCALLRECORDER_HANDLE umock_call_recorder = NULL;
+static UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC umock_c_lock_factory_create_lock = NULL;
+static void* umock_c_lock_factory_create_lock_params = NULL;
+static UMOCKALLOC_ARENA_HANDLE call_arena = NULL;
 
 int internal_init_with_lock_factory(ON_UMOCK_C_ERROR on_umock_c_error, UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
 {
@@ -80,6 +84,9 @@ int internal_init_with_lock_factory(ON_UMOCK_C_ERROR on_umock_c_error, UMOCK_C_L
                 /* Codes_SRS_UMOCK_C_01_006: [ The on_umock_c_error callback shall be stored to be used for later error callbacks. ]*/
                 on_umock_c_error_function = on_umock_c_error;
 
+                umock_c_lock_factory_create_lock = lock_factory_create_lock;
+                umock_c_lock_factory_create_lock_params = lock_factory_create_lock_params;
+
                 /* Codes_SRS_UMOCK_C_01_001: [umock_c_init shall initialize the umock library.] */
                 umock_c_state = UMOCK_C_STATE_INITIALIZED;
 
@@ -118,6 +125,14 @@ void umock_c_deinit(void)
         /* Codes_SRS_UMOCK_C_01_009: [ umock_c_deinit shall free the call recorder created in umock_c_init. ]*/
         umockcallrecorder_destroy(umock_call_recorder);
 
+        if (call_arena != NULL)
+        {
+            /* Codes_SRS_UMOCK_C_01_051: [ If the call arena was enabled, umock_c_deinit shall stop using it by calling umockalloc_set_call_arena with NULL and destroy it by calling umockalloc_arena_destroy. ]*/
+            umockalloc_set_call_arena(NULL);
+            umockalloc_arena_destroy(call_arena);
+            call_arena = NULL;
+        }
+
         /* Codes_SRS_UMOCK_C_01_008: [ umock_c_deinit shall deinitialize the umock types by calling umocktypes_deinit. ]*/
         umocktypes_deinit();
 
@@ -136,7 +151,130 @@ void umock_c_reset_all_calls(void)
             /* Codes_SRS_UMOCK_C_01_025: [ If the underlying umockcallrecorder_reset_all_calls fails, the on_umock_c_error callback shall be triggered with UMOCK_C_RESET_CALLS_ERROR. ]*/
             umock_c_indicate_error(UMOCK_C_RESET_CALLS_ERROR);
         }
+
+        if (call_arena != NULL)
+        {
+            /* Codes_SRS_UMOCK_C_01_050: [ If the call arena was enabled, umock_c_reset_all_calls shall release all the memory allocated from it by calling umockalloc_arena_reset after resetting the call recorder. ]*/
+            /* Codes_SRS_UMOCK_C_LIB_01_228: [ The memory in the arena shall be released at once when umock_c_reset_all_calls is called. ]*/
+            umockalloc_arena_reset(call_arena);
+        }
+    }
+}
+
+int umock_c_enable_call_arena(void)
+{
+    int result;
+
+    if (umock_c_state != UMOCK_C_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCK_C_01_046: [ If the module is not initialized, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot enable the call arena, umock_c not initialized.");
+        result = __LINE__;
+    }
+    else if (call_arena != NULL)
+    {
+        /* Codes_SRS_UMOCK_C_01_047: [ If the call arena is already enabled, umock_c_enable_call_arena shall return 0. ]*/
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_01_045: [ umock_c_enable_call_arena shall create an arena by calling umockalloc_arena_create, passing the lock factory given to umock_c_init_with_lock_factory (if any). ]*/
+        call_arena = umockalloc_arena_create(umock_c_lock_factory_create_lock, umock_c_lock_factory_create_lock_params);
+        if (call_arena == NULL)
+        {
+            /* Codes_SRS_UMOCK_C_01_049: [ If umockalloc_arena_create fails, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+            UMOCK_LOG("umock_c: Cannot create the call arena.");
+            result = __LINE__;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCK_C_01_048: [ umock_c_enable_call_arena shall set the arena as the call arena by calling umockalloc_set_call_arena and return 0. ]*/
+            /* Codes_SRS_UMOCK_C_LIB_01_227: [ After umock_c_enable_call_arena succeeds, the call objects created for expected and actual calls shall be allocated from an arena (bump allocator). ]*/
+            umockalloc_set_call_arena(call_arena);
+            result = 0;
+        }
     }
+
+    return result;
+}
+
+int umock_c_enable_per_thread_call_recording(void)
+{
+    int result;
+
+    if (umock_c_state != UMOCK_C_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCK_C_01_053: [ If the module is not initialized, umock_c_enable_per_thread_call_recording shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot enable per thread call recording, umock_c not initialized.");
+        result = __LINE__;
+    }
+    /* Codes_SRS_UMOCK_C_01_052: [ umock_c_enable_per_thread_call_recording shall enable recording the actual calls per thread by calling umockcallrecorder_enable_per_thread_actual_calls on the call recorder created in umock_c_init. ]*/
+    else if (umockcallrecorder_enable_per_thread_actual_calls(umock_call_recorder) != 0)
+    {
+        /* Codes_SRS_UMOCK_C_01_055: [ If umockcallrecorder_enable_per_thread_actual_calls fails, umock_c_enable_per_thread_call_recording shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot enable per thread call recording on the call recorder.");
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_01_054: [ On success, umock_c_enable_per_thread_call_recording shall return 0. ]*/
+        /* Codes_SRS_UMOCK_C_LIB_01_233: [ After umock_c_enable_per_thread_call_recording succeeds, actual calls made from different threads shall not contend on a common lock, and shall be ordered by the moment each call was recorded. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int umock_c_begin_unordered_expected_calls(void)
+{
+    int result;
+
+    if (umock_c_state != UMOCK_C_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCK_C_01_056: [ If the module is not initialized, umock_c_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot begin unordered expected calls, umock_c not initialized.");
+        result = __LINE__;
+    }
+    /* Codes_SRS_UMOCK_C_01_057: [ umock_c_begin_unordered_expected_calls shall open an unordered group by calling umockcallrecorder_begin_unordered_expected_calls on the call recorder created in umock_c_init. ]*/
+    else if (umockcallrecorder_begin_unordered_expected_calls(umock_call_recorder) != 0)
+    {
+        /* Codes_SRS_UMOCK_C_01_058: [ If umockcallrecorder_begin_unordered_expected_calls fails, umock_c_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot begin unordered expected calls on the call recorder.");
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_01_059: [ On success, umock_c_begin_unordered_expected_calls shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+int umock_c_end_unordered_expected_calls(void)
+{
+    int result;
+
+    if (umock_c_state != UMOCK_C_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCK_C_01_060: [ If the module is not initialized, umock_c_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot end unordered expected calls, umock_c not initialized.");
+        result = __LINE__;
+    }
+    /* Codes_SRS_UMOCK_C_01_061: [ umock_c_end_unordered_expected_calls shall close the open unordered group by calling umockcallrecorder_end_unordered_expected_calls on the call recorder created in umock_c_init. ]*/
+    else if (umockcallrecorder_end_unordered_expected_calls(umock_call_recorder) != 0)
+    {
+        /* Codes_SRS_UMOCK_C_01_062: [ If umockcallrecorder_end_unordered_expected_calls fails, umock_c_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c: Cannot end unordered expected calls on the call recorder.");
+        result = __LINE__;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_01_063: [ On success, umock_c_end_unordered_expected_calls shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
 }
 
 int umock_c_add_expected_call(UMOCKCALL_HANDLE mock_call)
@@ -153,6 +291,12 @@ int umock_c_add_expected_call(UMOCKCALL_HANDLE mock_call)
     {
         /* Codes_SRS_UMOCK_C_01_019: [ umock_c_add_expected_call shall add an expected call by calling umockcallrecorder_add_expected_call on the call recorder created in umock_c_init. ]*/
         result = umockcallrecorder_add_expected_call(umock_call_recorder, mock_call);
+        if (result != 0)
+        {
+            /* Codes_SRS_UMOCK_C_01_064: [ If umockcallrecorder_add_expected_call fails, umock_c_add_expected_call shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return a non-zero value. ]*/
+            UMOCK_LOG("umock_c: Cannot add the expected call.");
+            umock_c_indicate_error(UMOCK_C_ERROR);
+        }
     }
 
     return result;
@@ -191,6 +335,12 @@ const char* umock_c_get_expected_calls(void)
     {
         /* Codes_SRS_UMOCK_C_01_015: [ umock_c_get_expected_calls shall return the string for the recorded expected calls by calling umockcallrecorder_get_expected_calls on the call recorder created in umock_c_init. ]*/
         result = umockcallrecorder_get_expected_calls(umock_call_recorder);
+        if (result == NULL)
+        {
+            /* Codes_SRS_UMOCK_C_01_065: [ If umockcallrecorder_get_expected_calls fails, umock_c_get_expected_calls shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return NULL. ]*/
+            UMOCK_LOG("umock_c: Cannot get the expected calls.");
+            umock_c_indicate_error(UMOCK_C_ERROR);
+        }
     }
 
     return result;
@@ -210,6 +360,12 @@ const char* umock_c_get_actual_calls(void)
     {
         /* Codes_SRS_UMOCK_C_01_013: [ umock_c_get_actual_calls shall return the string for the recorded actual calls by calling umockcallrecorder_get_actual_calls on the call recorder created in umock_c_init. ]*/
         result = umockcallrecorder_get_actual_calls(umock_call_recorder);
+        if (result == NULL)
+        {
+            /* Codes_SRS_UMOCK_C_01_066: [ If umockcallrecorder_get_actual_calls fails, umock_c_get_actual_calls shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return NULL. ]*/
+            UMOCK_LOG("umock_c: Cannot get the actual calls.");
+            umock_c_indicate_error(UMOCK_C_ERROR);
+        }
     }
 
     return result;
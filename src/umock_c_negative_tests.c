@@ -7,10 +7,15 @@
 
 #include "umock_c/umock_c_negative_tests.h"
 #include "umock_c/umock_c.h"
+#include "umock_c/umockalloc.h"
 #include "umock_c/umockcallrecorder.h"
 #include "umock_c/umock_log.h"
 
 static UMOCKCALLRECORDER_HANDLE snapshot_call_recorder;
+/* indices of the snapshot expected calls that can fail, sorted, computed once per snapshot so that test loops can skip the other indices without touching the recorder */
+static size_t* failable_indices;
+static size_t failable_index_count;
+static size_t snapshot_call_count;
 typedef enum UMOCK_C_NEGATIVE_TESTS_STATE_TAG
 {
     UMOCK_C_NEGATIVE_TESTS_STATE_NOT_INITIALIZED,
@@ -52,10 +57,86 @@ void umock_c_negative_tests_deinit(void)
             snapshot_call_recorder = NULL;
         }
 
+        if (failable_indices != NULL)
+        {
+            umockalloc_free(failable_indices);
+            failable_indices = NULL;
+        }
+
+        failable_index_count = 0;
+        snapshot_call_count = 0;
+
         umock_c_negative_tests_state = UMOCK_C_NEGATIVE_TESTS_STATE_NOT_INITIALIZED;
     }
 }
 
+static int get_failable_indices(UMOCKCALLRECORDER_HANDLE call_recorder, size_t* call_count, size_t** indices, size_t* index_count)
+{
+    int result;
+
+    if (umockcallrecorder_get_expected_call_count(call_recorder, call_count) != 0)
+    {
+        UMOCK_LOG("umock_c_negative_tests_snapshot: Getting the expected call count from the recorder failed.");
+        result = MU_FAILURE;
+    }
+    else if (*call_count == 0)
+    {
+        *indices = NULL;
+        *index_count = 0;
+        result = 0;
+    }
+    else
+    {
+        size_t* new_indices = (size_t*)umockalloc_malloc(sizeof(size_t) * *call_count);
+        if (new_indices == NULL)
+        {
+            UMOCK_LOG("umock_c_negative_tests_snapshot: Cannot allocate memory for %zu failable indices.", *call_count);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            size_t count = 0;
+            size_t i;
+
+            for (i = 0; i < *call_count; i++)
+            {
+                int can_call_fail;
+                if (umockcallrecorder_can_call_fail(call_recorder, i, &can_call_fail) != 0)
+                {
+                    UMOCK_LOG("umock_c_negative_tests_snapshot: Cannot get whether call %zu can fail.", i);
+                    break;
+                }
+
+                if (can_call_fail)
+                {
+                    new_indices[count] = i;
+                    count++;
+                }
+            }
+
+            if (i < *call_count)
+            {
+                umockalloc_free(new_indices);
+                result = MU_FAILURE;
+            }
+            else
+            {
+                if (count == 0)
+                {
+                    umockalloc_free(new_indices);
+                    new_indices = NULL;
+                }
+
+                *indices = new_indices;
+                *index_count = count;
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
 /* Codes_SRS_UMOCK_C_LIB_01_167: [ umock_c_negative_tests_snapshot shall take a snapshot of the current setup of expected calls (a.k.a happy path). ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_168: [ If umock_c_negative_tests_snapshot is called without the module being initialized, it shall do nothing. ]*/
 /* Codes_SRS_UMOCK_C_LIB_01_169: [ All errors shall be reported by calling the umock_c on error function. ]*/
@@ -89,12 +170,35 @@ void umock_c_negative_tests_snapshot(void)
             }
             else
             {
-                if (snapshot_call_recorder != NULL)
+                size_t new_call_count;
+                size_t* new_failable_indices;
+                size_t new_failable_index_count;
+
+                /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_048: [ umock_c_negative_tests_snapshot shall compute the sorted list of failable indices of the copy by calling umockcallrecorder_get_expected_call_count and then umockcallrecorder_can_call_fail for each expected call. ]*/
+                if (get_failable_indices(new_call_recorder, &new_call_count, &new_failable_indices, &new_failable_index_count) != 0)
                 {
-                    umockcallrecorder_destroy(snapshot_call_recorder);
+                    /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_049: [ If computing the failable indices fails, umock_c_negative_tests_snapshot shall destroy the copy, keep the previous snapshot and indicate the error via the umock error callback with error code UMOCK_C_ERROR. ]*/
+                    UMOCK_LOG("umock_c_negative_tests_snapshot: Error computing the failable indices.");
+                    umockcallrecorder_destroy(new_call_recorder);
+                    umock_c_indicate_error(UMOCK_C_ERROR);
                 }
+                else
+                {
+                    if (snapshot_call_recorder != NULL)
+                    {
+                        umockcallrecorder_destroy(snapshot_call_recorder);
+                    }
+
+                    if (failable_indices != NULL)
+                    {
+                        umockalloc_free(failable_indices);
+                    }
 
-                snapshot_call_recorder = new_call_recorder;
+                    snapshot_call_recorder = new_call_recorder;
+                    snapshot_call_count = new_call_count;
+                    failable_indices = new_failable_indices;
+                    failable_index_count = new_failable_index_count;
+                }
             }
         }
     }
@@ -237,4 +341,46 @@ int umock_c_negative_tests_can_call_fail(size_t index)
     return can_call_fail;
 }
 
+size_t umock_c_negative_tests_next_failable_index(size_t index)
+{
+    size_t result;
 
+    if (umock_c_negative_tests_state != UMOCK_C_NEGATIVE_TESTS_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_053: [ If the module was not previously initialized, umock_c_negative_tests_next_failable_index shall return 0. ]*/
+        UMOCK_LOG("umock_c_negative_tests_next_failable_index: Not initialized.");
+        result = 0;
+    }
+    else if (snapshot_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_054: [ If no call has been made to umock_c_negative_tests_snapshot, umock_c_negative_tests_next_failable_index shall return 0 and indicate the error via the umock error callback with error code UMOCK_C_ERROR. ]*/
+        UMOCK_LOG("umock_c_negative_tests_next_failable_index: No snapshot, use umock_c_negative_tests_snapshot.");
+        umock_c_indicate_error(UMOCK_C_ERROR);
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_052: [ umock_c_negative_tests_next_failable_index shall only use the failable indices computed by umock_c_negative_tests_snapshot, without calling into the call recorder. ]*/
+        size_t low = 0;
+        size_t high = failable_index_count;
+
+        while (low < high)
+        {
+            size_t middle = low + ((high - low) / 2);
+            if (failable_indices[middle] < index)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_050: [ umock_c_negative_tests_next_failable_index shall return the smallest index greater than or equal to index of an expected call in the snapshot that can fail. ]*/
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_051: [ If there is no such index, umock_c_negative_tests_next_failable_index shall return the number of expected calls in the snapshot. ]*/
+        result = (low < failable_index_count) ? failable_indices[low] : snapshot_call_count;
+    }
+
+    return result;
+}
@@ -0,0 +1,440 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umock_c.h"
+#include "umock_c/umockalloc.h"
+#include "umock_c/umockstringbuilder.h"
+#include "umock_c/umock_log.h"
+
+/* Each worker is a forked copy of the test process, so it starts with the same umock_c state (including the negative tests snapshot)
+and can replay failure indices without affecting the other workers. Workers take the indices worker_index, worker_index + worker_count, ...
+and write one report per index on their pipe. The parent reads all pipes and calls on_result in index order, so the reported results
+do not depend on how the workers were scheduled. */
+
+#define READ_CHUNK_SIZE 4096
+
+/* the workers are forked from the same executable, so the header can be sent as is */
+typedef struct INDEX_REPORT_HEADER_TAG
+{
+    size_t index;
+    int result;
+    size_t expected_calls_size;
+    size_t actual_calls_size;
+} INDEX_REPORT_HEADER;
+
+typedef struct WORKER_TAG
+{
+    pid_t pid;
+    int read_fd;
+    UMOCKSTRINGBUILDER reports;
+} WORKER;
+
+typedef struct INDEX_RESULT_TAG
+{
+    UMOCK_C_NEGATIVE_TESTS_RESULT result;
+    const char* expected_calls;
+    const char* actual_calls;
+} INDEX_RESULT;
+
+static int write_all(int fd, const void* buffer, size_t size)
+{
+    int result = 0;
+    const char* current = (const char*)buffer;
+
+    while (size > 0)
+    {
+        ssize_t written = write(fd, current, size);
+        if (written < 0)
+        {
+            if (errno != EINTR)
+            {
+                result = MU_FAILURE;
+                break;
+            }
+        }
+        else
+        {
+            current += written;
+            size -= (size_t)written;
+        }
+    }
+
+    return result;
+}
+
+static int write_index_report(int fd, size_t index, UMOCK_C_NEGATIVE_TESTS_RESULT index_result)
+{
+    int result;
+    INDEX_REPORT_HEADER header;
+    const char* expected_calls = "";
+    const char* actual_calls = "";
+
+    if (index_result != UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED)
+    {
+        expected_calls = umock_c_get_expected_calls();
+        actual_calls = umock_c_get_actual_calls();
+        if (expected_calls == NULL)
+        {
+            expected_calls = "";
+        }
+        if (actual_calls == NULL)
+        {
+            actual_calls = "";
+        }
+    }
+
+    header.index = index;
+    header.result = (int)index_result;
+    header.expected_calls_size = strlen(expected_calls) + 1;
+    header.actual_calls_size = strlen(actual_calls) + 1;
+
+    if ((write_all(fd, &header, sizeof(header)) != 0) ||
+        (write_all(fd, expected_calls, header.expected_calls_size) != 0) ||
+        (write_all(fd, actual_calls, header.actual_calls_size) != 0))
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+static void run_worker(int write_fd, size_t worker_index, size_t worker_count, size_t call_count, UMOCK_C_NEGATIVE_TESTS_TEST_BODY test_body, void* test_body_context)
+{
+    int exit_code = 0;
+    size_t i;
+
+    /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_036: [ Each worker shall handle the failure indices worker_index, worker_index + worker_count, ... up to the call count. ]*/
+    for (i = worker_index; i < call_count; i += worker_count)
+    {
+        UMOCK_C_NEGATIVE_TESTS_RESULT index_result;
+
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_037: [ For each index the worker shall determine whether the call can fail by calling umock_c_negative_tests_next_failable_index. ]*/
+        if (umock_c_negative_tests_next_failable_index(i) != i)
+        {
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_038: [ If the call cannot fail, the worker shall report the index as UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED without resetting the calls and without calling test_body. ]*/
+            index_result = UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_039: [ Otherwise the worker shall call umock_c_negative_tests_reset, then umock_c_negative_tests_fail_call for the index and then call test_body, passing test_body_context and the index as arguments. ]*/
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_040: [ The index shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED if test_body returns 0 and as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED otherwise. ]*/
+            index_result = (test_body(test_body_context, i) == 0) ? UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED : UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED;
+        }
+
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_041: [ The worker shall write the index, its result and the strings returned by umock_c_get_expected_calls and umock_c_get_actual_calls to its pipe. ]*/
+        if (write_index_report(write_fd, i, index_result) != 0)
+        {
+            exit_code = 1;
+            break;
+        }
+    }
+
+    (void)close(write_fd);
+
+    /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_042: [ When done, the worker shall terminate by calling _exit, without returning to the caller of umock_c_negative_tests_run_parallel. ]*/
+    _exit(exit_code);
+}
+
+static void stop_workers(WORKER* workers, size_t worker_count)
+{
+    size_t i;
+
+    for (i = 0; i < worker_count; i++)
+    {
+        (void)kill(workers[i].pid, SIGKILL);
+    }
+}
+
+static int read_worker_reports(WORKER* workers, size_t worker_count)
+{
+    int result = 0;
+    struct pollfd* poll_fds = (struct pollfd*)umockalloc_malloc(sizeof(struct pollfd) * worker_count);
+    if (poll_fds == NULL)
+    {
+        UMOCK_LOG("umock_c_negative_tests_run_parallel: Cannot allocate memory for the poll descriptors.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        size_t open_count = worker_count;
+        size_t i;
+
+        for (i = 0; i < worker_count; i++)
+        {
+            poll_fds[i].fd = workers[i].read_fd;
+            poll_fds[i].events = POLLIN;
+        }
+
+        while (open_count > 0)
+        {
+            if (poll(poll_fds, (nfds_t)worker_count, -1) < 0)
+            {
+                if (errno != EINTR)
+                {
+                    UMOCK_LOG("umock_c_negative_tests_run_parallel: poll failed, errno=%d.", errno);
+                    result = MU_FAILURE;
+                    break;
+                }
+            }
+            else
+            {
+                for (i = 0; i < worker_count; i++)
+                {
+                    if ((poll_fds[i].fd >= 0) &&
+                        ((poll_fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0))
+                    {
+                        char chunk[READ_CHUNK_SIZE];
+                        ssize_t read_size = read(poll_fds[i].fd, chunk, sizeof(chunk));
+                        if (read_size > 0)
+                        {
+                            if (umockstringbuilder_append(&workers[i].reports, chunk, (size_t)read_size) != 0)
+                            {
+                                UMOCK_LOG("umock_c_negative_tests_run_parallel: Cannot store the reports of worker %zu.", i);
+                                result = MU_FAILURE;
+                                break;
+                            }
+                        }
+                        else if ((read_size == 0) || (errno != EINTR))
+                        {
+                            /* the worker closed its end of the pipe (or the pipe broke), whatever it did not report is lost */
+                            poll_fds[i].fd = -1;
+                            open_count--;
+                        }
+                    }
+                }
+
+                if (result != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        umockalloc_free(poll_fds);
+    }
+
+    return result;
+}
+
+static void collect_worker_reports(WORKER* worker, INDEX_RESULT* index_results, size_t call_count)
+{
+    size_t position = 0;
+
+    /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_044: [ Indices for which no complete report was received shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST. ]*/
+    while (worker->reports.length - position >= sizeof(INDEX_REPORT_HEADER))
+    {
+        INDEX_REPORT_HEADER header;
+        (void)memcpy(&header, worker->reports.buffer + position, sizeof(header));
+
+        if ((header.index >= call_count) ||
+            (header.expected_calls_size == 0) ||
+            (header.actual_calls_size == 0) ||
+            (worker->reports.length - position - sizeof(header) < header.expected_calls_size) ||
+            (worker->reports.length - position - sizeof(header) - header.expected_calls_size < header.actual_calls_size))
+        {
+            /* truncated report, the worker died while writing it */
+            break;
+        }
+
+        /* the strings are NULL terminated in the report, so they are used in place */
+        index_results[header.index].result = (UMOCK_C_NEGATIVE_TESTS_RESULT)header.result;
+        index_results[header.index].expected_calls = worker->reports.buffer + position + sizeof(header);
+        index_results[header.index].actual_calls = index_results[header.index].expected_calls + header.expected_calls_size;
+
+        position += sizeof(header) + header.expected_calls_size + header.actual_calls_size;
+    }
+}
+
+static size_t get_default_worker_count(void)
+{
+    long online_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return (online_processors > 0) ? (size_t)online_processors : 1;
+}
+
+static int run_workers(size_t worker_count, size_t call_count, UMOCK_C_NEGATIVE_TESTS_TEST_BODY test_body, void* test_body_context, UMOCK_C_NEGATIVE_TESTS_ON_RESULT on_result, void* on_result_context)
+{
+    int result;
+    WORKER* workers = (WORKER*)umockalloc_calloc(worker_count, sizeof(WORKER));
+    if (workers == NULL)
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_047: [ If any error occurs, umock_c_negative_tests_run_parallel shall stop all the workers and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c_negative_tests_run_parallel: Cannot allocate memory for %zu workers.", worker_count);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        size_t started_count;
+        size_t i;
+
+        /* buffered output would otherwise be written once by the parent and once by each worker */
+        (void)fflush(NULL);
+
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_035: [ umock_c_negative_tests_run_parallel shall start worker_count worker processes by calling fork, each having a pipe to report its results to the parent. ]*/
+        for (started_count = 0; started_count < worker_count; started_count++)
+        {
+            int pipe_fds[2];
+
+            if (pipe(pipe_fds) != 0)
+            {
+                UMOCK_LOG("umock_c_negative_tests_run_parallel: pipe failed, errno=%d.", errno);
+                break;
+            }
+            else
+            {
+                pid_t pid = fork();
+                if (pid < 0)
+                {
+                    UMOCK_LOG("umock_c_negative_tests_run_parallel: fork failed, errno=%d.", errno);
+                    (void)close(pipe_fds[0]);
+                    (void)close(pipe_fds[1]);
+                    break;
+                }
+                else if (pid == 0)
+                {
+                    for (i = 0; i < started_count; i++)
+                    {
+                        (void)close(workers[i].read_fd);
+                    }
+                    (void)close(pipe_fds[0]);
+
+                    run_worker(pipe_fds[1], started_count, worker_count, call_count, test_body, test_body_context);
+                }
+                else
+                {
+                    (void)close(pipe_fds[1]);
+                    workers[started_count].pid = pid;
+                    workers[started_count].read_fd = pipe_fds[0];
+                    umockstringbuilder_init(&workers[started_count].reports);
+                }
+            }
+        }
+
+        if (started_count < worker_count)
+        {
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_047: [ If any error occurs, umock_c_negative_tests_run_parallel shall stop all the workers and return a non-zero value. ]*/
+            stop_workers(workers, started_count);
+            result = MU_FAILURE;
+        }
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_043: [ umock_c_negative_tests_run_parallel shall read the reports of all workers concurrently until each worker closes its pipe. ]*/
+        else if (read_worker_reports(workers, worker_count) != 0)
+        {
+            stop_workers(workers, worker_count);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            INDEX_RESULT* index_results = (INDEX_RESULT*)umockalloc_malloc(sizeof(INDEX_RESULT) * call_count);
+            if (index_results == NULL)
+            {
+                UMOCK_LOG("umock_c_negative_tests_run_parallel: Cannot allocate memory for %zu results.", call_count);
+                result = MU_FAILURE;
+            }
+            else
+            {
+                for (i = 0; i < call_count; i++)
+                {
+                    index_results[i].result = UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST;
+                    index_results[i].expected_calls = "";
+                    index_results[i].actual_calls = "";
+                }
+
+                for (i = 0; i < worker_count; i++)
+                {
+                    collect_worker_reports(&workers[i], index_results, call_count);
+                }
+
+                /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+                result = 0;
+                for (i = 0; i < call_count; i++)
+                {
+                    /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_045: [ If on_result is not NULL, after all workers closed their pipes umock_c_negative_tests_run_parallel shall call on_result for each index in increasing index order, passing on_result_context, the index, its result and the reported expected and actual calls. ]*/
+                    if (on_result != NULL)
+                    {
+                        on_result(on_result_context, i, index_results[i].result, index_results[i].expected_calls, index_results[i].actual_calls);
+                    }
+
+                    if ((index_results[i].result == UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED) ||
+                        (index_results[i].result == UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST))
+                    {
+                        result = MU_FAILURE;
+                    }
+                }
+
+                umockalloc_free(index_results);
+            }
+        }
+
+        for (i = 0; i < started_count; i++)
+        {
+            (void)close(workers[i].read_fd);
+            while ((waitpid(workers[i].pid, NULL, 0) < 0) && (errno == EINTR))
+            {
+            }
+            umockstringbuilder_deinit(&workers[i].reports);
+        }
+
+        umockalloc_free(workers);
+    }
+
+    return result;
+}
+
+int umock_c_negative_tests_run_parallel(size_t worker_count, UMOCK_C_NEGATIVE_TESTS_TEST_BODY test_body, void* test_body_context, UMOCK_C_NEGATIVE_TESTS_ON_RESULT on_result, void* on_result_context)
+{
+    int result;
+
+    if (test_body == NULL)
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_030: [ If test_body is NULL, umock_c_negative_tests_run_parallel shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_c_negative_tests_run_parallel: NULL test_body.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_031: [ umock_c_negative_tests_run_parallel shall obtain the number of failure indices by calling umock_c_negative_tests_call_count. ]*/
+        size_t call_count = umock_c_negative_tests_call_count();
+        if (call_count == 0)
+        {
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_032: [ If there are no failure indices (which is also the case when the module is not initialized or no snapshot was taken), umock_c_negative_tests_run_parallel shall return 0 without starting any worker. ]*/
+            result = 0;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_033: [ If worker_count is 0, umock_c_negative_tests_run_parallel shall use the number of online processors as the worker count. ]*/
+            if (worker_count == 0)
+            {
+                worker_count = get_default_worker_count();
+            }
+
+            /* Codes_SRS_UMOCK_C_NEGATIVE_TESTS_01_034: [ The worker count shall be capped to the number of failure indices. ]*/
+            if (worker_count > call_count)
+            {
+                worker_count = call_count;
+            }
+
+            result = run_workers(worker_count, call_count, test_body, test_body_context, on_result, on_result_context);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,260 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umockalloc.h"
+#include "umock_c/umock_log.h"
+#include "umock_c/umock_lock_if.h"               // for UMOCK_C_LOCK_HANDLE
+#include "umock_c/umock_lock_factory_futex.h"
+
+/* the whole lock is one 32 bit word: the writer bit, the waiters bit and the count of readers */
+#define LOCK_STATE_WRITER ((uint32_t)0x80000000)
+#define LOCK_STATE_WAITERS ((uint32_t)0x40000000)
+#define LOCK_STATE_READERS_MASK ((uint32_t)0x3FFFFFFF)
+
+/* upper bound for the number of times an acquire spins before sleeping on the futex */
+#define MAX_SPIN_COUNT 100
+
+/* the spin estimate is kept in 1/16ths of a spin, so that averaging in acquires that did not spin brings it all the way down to 0 */
+#define SPIN_ESTIMATE_FRACTION_BITS 4
+
+typedef struct UMOCK_C_LOCK_FUTEX_TAG
+{
+    UMOCK_C_LOCK_IF lock_if;
+    _Atomic uint32_t state;
+    /* running average of the spins that were needed to acquire the lock (in 1/16ths of a spin), it drives how long the next acquire spins */
+    atomic_int spin_estimate;
+} UMOCK_C_LOCK_FUTEX;
+
+static void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void futex_wait(_Atomic uint32_t* state, uint32_t expected_state)
+{
+    /* returns right away when state no longer holds expected_state, the caller re-reads the state in all cases */
+    (void)syscall(SYS_futex, (uint32_t*)state, FUTEX_WAIT_PRIVATE, expected_state, NULL, NULL, 0);
+}
+
+static void futex_wake_all(_Atomic uint32_t* state)
+{
+    if (syscall(SYS_futex, (uint32_t*)state, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0) < 0)
+    {
+        UMOCK_LOG("futex wake failed");
+    }
+}
+
+static int can_acquire(uint32_t state, int is_exclusive)
+{
+    return is_exclusive ?
+        ((state & (LOCK_STATE_WRITER | LOCK_STATE_READERS_MASK)) == 0) :
+        (((state & LOCK_STATE_WRITER) == 0) && ((state & LOCK_STATE_READERS_MASK) < LOCK_STATE_READERS_MASK));
+}
+
+static void acquire(UMOCK_C_LOCK_FUTEX* umock_c_lock_futex, int is_exclusive)
+{
+    uint32_t acquired_increment = is_exclusive ? LOCK_STATE_WRITER : 1;
+    int spin_estimate = atomic_load_explicit(&umock_c_lock_futex->spin_estimate, memory_order_relaxed);
+    int estimated_spins = spin_estimate >> SPIN_ESTIMATE_FRACTION_BITS;
+    int max_spin_count = (estimated_spins * 2 + 10 < MAX_SPIN_COUNT) ? estimated_spins * 2 + 10 : MAX_SPIN_COUNT;
+    int spin_count = 0;
+    int has_slept = 0;
+    uint32_t state = atomic_load_explicit(&umock_c_lock_futex->state, memory_order_relaxed);
+
+    while (1)
+    {
+        if (can_acquire(state, is_exclusive))
+        {
+            if (atomic_compare_exchange_weak_explicit(&umock_c_lock_futex->state, &state, state + acquired_increment, memory_order_acquire, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (spin_count < max_spin_count)
+        {
+            spin_count++;
+            cpu_relax();
+            state = atomic_load_explicit(&umock_c_lock_futex->state, memory_order_relaxed);
+        }
+        else if (((state & LOCK_STATE_WAITERS) == 0) &&
+            !atomic_compare_exchange_weak_explicit(&umock_c_lock_futex->state, &state, state | LOCK_STATE_WAITERS, memory_order_relaxed, memory_order_relaxed))
+        {
+            /* the state changed, look at it again before going to sleep */
+        }
+        else
+        {
+            futex_wait(&umock_c_lock_futex->state, state | LOCK_STATE_WAITERS);
+            has_slept = 1;
+            state = atomic_load_explicit(&umock_c_lock_futex->state, memory_order_relaxed);
+        }
+    }
+
+    if (has_slept)
+    {
+        /* spinning did not pay off, the spins were wasted on top of the sleep, so the next acquires spin less */
+        spin_estimate /= 2;
+    }
+    else
+    {
+        /* the lock was released while spinning (or was free), the next acquires spin about as long as this one needed */
+        spin_estimate += ((spin_count << SPIN_ESTIMATE_FRACTION_BITS) - spin_estimate) / 8;
+    }
+    atomic_store_explicit(&umock_c_lock_futex->spin_estimate, spin_estimate, memory_order_relaxed);
+}
+
+static void release(UMOCK_C_LOCK_FUTEX* umock_c_lock_futex, int is_exclusive)
+{
+    uint32_t state = atomic_load_explicit(&umock_c_lock_futex->state, memory_order_relaxed);
+    uint32_t new_state;
+    int is_held;
+
+    do
+    {
+        is_held = is_exclusive ?
+            ((state & LOCK_STATE_WRITER) != 0) :
+            ((state & LOCK_STATE_READERS_MASK) != 0);
+        if (!is_held)
+        {
+            UMOCK_LOG("Lock released in %s mode while not being held in that mode", is_exclusive ? "exclusive" : "shared");
+            break;
+        }
+
+        new_state = state - (is_exclusive ? LOCK_STATE_WRITER : 1);
+        if ((new_state & (LOCK_STATE_WRITER | LOCK_STATE_READERS_MASK)) == 0)
+        {
+            /* the last holder lets all the sleepers retry */
+            new_state &= ~LOCK_STATE_WAITERS;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&umock_c_lock_futex->state, &state, new_state, memory_order_release, memory_order_relaxed));
+
+    if (is_held &&
+        ((state & LOCK_STATE_WAITERS) != 0) &&
+        ((new_state & LOCK_STATE_WAITERS) == 0))
+    {
+        futex_wake_all(&umock_c_lock_futex->state);
+    }
+}
+
+static void umock_lock_futex_acquire_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_005: [ If lock is NULL, umock_lock_futex_acquire_shared shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_006: [ umock_lock_futex_acquire_shared shall increment the readers count in the lock state if no writer holds the lock. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_007: [ While a writer holds the lock, umock_lock_futex_acquire_shared shall spin for a number of iterations derived from the spins needed by previous acquires and then set the waiters bit and wait on the lock state by calling syscall with SYS_futex and FUTEX_WAIT_PRIVATE. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_018: [ An acquire that waited on the lock state shall halve the spin estimate of the lock, any other acquire shall move the spin estimate an eighth of the way towards the number of spins it needed. ]*/
+        acquire((UMOCK_C_LOCK_FUTEX*)lock, 0);
+    }
+}
+
+static void umock_lock_futex_release_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_008: [ If lock is NULL, umock_lock_futex_release_shared shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_009: [ umock_lock_futex_release_shared shall decrement the readers count in the lock state. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_010: [ If the last holder releases the lock and the waiters bit is set, the waiters bit shall be cleared and all the waiters shall be woken by calling syscall with SYS_futex and FUTEX_WAKE_PRIVATE. ]*/
+        release((UMOCK_C_LOCK_FUTEX*)lock, 0);
+    }
+}
+
+static void umock_lock_futex_acquire_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_011: [ If lock is NULL, umock_lock_futex_acquire_exclusive shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_012: [ umock_lock_futex_acquire_exclusive shall set the writer bit in the lock state if neither a writer nor readers hold the lock. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_013: [ While the lock is held, umock_lock_futex_acquire_exclusive shall spin for a number of iterations derived from the spins needed by previous acquires and then set the waiters bit and wait on the lock state by calling syscall with SYS_futex and FUTEX_WAIT_PRIVATE. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_018: [ An acquire that waited on the lock state shall halve the spin estimate of the lock, any other acquire shall move the spin estimate an eighth of the way towards the number of spins it needed. ]*/
+        acquire((UMOCK_C_LOCK_FUTEX*)lock, 1);
+    }
+}
+
+static void umock_lock_futex_release_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_014: [ If lock is NULL, umock_lock_futex_release_exclusive shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_015: [ umock_lock_futex_release_exclusive shall clear the writer bit in the lock state. ]*/
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_010: [ If the last holder releases the lock and the waiters bit is set, the waiters bit shall be cleared and all the waiters shall be woken by calling syscall with SYS_futex and FUTEX_WAKE_PRIVATE. ]*/
+        release((UMOCK_C_LOCK_FUTEX*)lock, 1);
+    }
+}
+
+static void umock_lock_futex_destroy(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_016: [ If lock is NULL, umock_lock_futex_destroy shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_017: [ umock_lock_futex_destroy shall free the memory associated with the lock. ]*/
+        umockalloc_free((UMOCK_C_LOCK_FUTEX*)lock);
+    }
+}
+
+UMOCK_C_LOCK_HANDLE umock_lock_factory_futex_create_lock(void* params)
+{
+    UMOCK_C_LOCK_HANDLE result;
+    UMOCK_C_LOCK_FUTEX* umock_c_lock_futex;
+
+    (void)params;
+
+    /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_001: [ umock_lock_factory_futex_create_lock shall allocate memory for the lock. ]*/
+    umock_c_lock_futex = umockalloc_malloc(sizeof(UMOCK_C_LOCK_FUTEX));
+    if (umock_c_lock_futex == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_004: [ If any error occurs, umock_lock_factory_futex_create_lock shall fail and return NULL. ]*/
+        UMOCK_LOG("umockalloc_malloc(%zu) failed", sizeof(UMOCK_C_LOCK_FUTEX));
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_002: [ umock_lock_factory_futex_create_lock shall initialize the lock state to not held and the spin estimate to 0. ]*/
+        atomic_init(&umock_c_lock_futex->state, 0);
+        atomic_init(&umock_c_lock_futex->spin_estimate, 0);
+
+        /* Codes_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_003: [ umock_lock_factory_futex_create_lock shall return a lock handle that has the function pointers set to umock_lock_futex_acquire_shared, umock_lock_futex_release_shared, umock_lock_futex_acquire_exclusive, umock_lock_futex_release_exclusive and umock_lock_futex_destroy. ]*/
+        umock_c_lock_futex->lock_if.acquire_shared = umock_lock_futex_acquire_shared;
+        umock_c_lock_futex->lock_if.release_shared = umock_lock_futex_release_shared;
+        umock_c_lock_futex->lock_if.acquire_exclusive = umock_lock_futex_acquire_exclusive;
+        umock_c_lock_futex->lock_if.release_exclusive = umock_lock_futex_release_exclusive;
+        umock_c_lock_futex->lock_if.destroy = umock_lock_futex_destroy;
+
+        result = &umock_c_lock_futex->lock_if;
+    }
+
+    return result;
+}
@@ -0,0 +1,423 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#endif
+
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umockalloc.h"
+#include "umock_c/umockatomic.h"
+#include "umock_c/umock_log.h"
+#include "umock_c/umock_lock_if.h"
+#include "umock_c/umock_lock_factory.h"
+#include "umock_c/umock_lock_instrumentation.h"
+
+/* how many shared acquisitions a thread can hold at the same time and still get their hold time measured */
+#define MAX_SHARED_HOLDS_PER_THREAD 8
+
+typedef struct UMOCK_LOCK_INSTRUMENTATION_TAG
+{
+    UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock;
+    void* lock_factory_create_lock_params;
+    /* every field is only accessed with the umockatomic functions, so that recording does not serialize the threads going through the instrumented locks */
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+} UMOCK_LOCK_INSTRUMENTATION;
+
+typedef struct UMOCK_C_LOCK_INSTRUMENTED_TAG
+{
+    UMOCK_C_LOCK_IF lock_if;
+    UMOCK_LOCK_INSTRUMENTATION* instrumentation;
+    UMOCK_C_LOCK_HANDLE inner_lock;
+    /* only written and read by the thread holding inner_lock exclusively */
+    uint64_t exclusive_acquire_time_ns;
+} UMOCK_C_LOCK_INSTRUMENTED;
+
+typedef struct SHARED_HOLD_TAG
+{
+    const UMOCK_C_LOCK_INSTRUMENTED* lock;
+    uint64_t acquire_time_ns;
+} SHARED_HOLD;
+
+/* several threads can hold a lock in shared mode, so the acquire time of a shared hold is kept by the thread that holds it */
+static UMOCK_THREAD_LOCAL SHARED_HOLD shared_holds[MAX_SHARED_HOLDS_PER_THREAD];
+static UMOCK_THREAD_LOCAL size_t shared_hold_count;
+
+static uint64_t get_time_ns(void)
+{
+    uint64_t result;
+#if defined(_MSC_VER)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+
+    if (!QueryPerformanceCounter(&counter) ||
+        !QueryPerformanceFrequency(&frequency))
+    {
+        UMOCK_LOG("QueryPerformanceCounter failed");
+        result = 0;
+    }
+    else
+    {
+        /* split in seconds and the rest, so that the conversion to ns does not overflow */
+        result = ((uint64_t)counter.QuadPart / (uint64_t)frequency.QuadPart) * 1000000000 +
+            ((uint64_t)counter.QuadPart % (uint64_t)frequency.QuadPart) * 1000000000 / (uint64_t)frequency.QuadPart;
+    }
+#else
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    {
+        UMOCK_LOG("clock_gettime failed");
+        result = 0;
+    }
+    else
+    {
+        result = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+    }
+#endif
+
+    return result;
+}
+
+static uint64_t get_duration_ns(uint64_t start_time_ns, uint64_t end_time_ns)
+{
+    /* the clock does not go back, but a failed clock read gives 0, which is counted as no time spent */
+    return (end_time_ns > start_time_ns) ? (end_time_ns - start_time_ns) : 0;
+}
+
+static size_t get_histogram_bucket(uint64_t duration_ns)
+{
+    size_t result = 0;
+
+    while ((duration_ns >= 2) && (result < UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT - 1))
+    {
+        duration_ns >>= 1;
+        result++;
+    }
+
+    return result;
+}
+
+static void record_wait(UMOCK_LOCK_INSTRUMENTATION_MODE_STATS* mode_stats, uint64_t wait_ns)
+{
+    (void)umockatomic_increment_uint64(&mode_stats->acquire_count);
+    (void)umockatomic_add_uint64(&mode_stats->total_wait_ns, wait_ns);
+    umockatomic_max_uint64(&mode_stats->max_wait_ns, wait_ns);
+    (void)umockatomic_increment_uint64(&mode_stats->wait_histogram[get_histogram_bucket(wait_ns)]);
+}
+
+static void record_hold(UMOCK_LOCK_INSTRUMENTATION_MODE_STATS* mode_stats, uint64_t hold_ns)
+{
+    (void)umockatomic_increment_uint64(&mode_stats->release_count);
+    (void)umockatomic_add_uint64(&mode_stats->total_hold_ns, hold_ns);
+    umockatomic_max_uint64(&mode_stats->max_hold_ns, hold_ns);
+    (void)umockatomic_increment_uint64(&mode_stats->hold_histogram[get_histogram_bucket(hold_ns)]);
+}
+
+static void copy_mode_stats(UMOCK_LOCK_INSTRUMENTATION_MODE_STATS* destination, UMOCK_LOCK_INSTRUMENTATION_MODE_STATS* source)
+{
+    size_t i;
+
+    destination->acquire_count = umockatomic_load_uint64(&source->acquire_count);
+    destination->total_wait_ns = umockatomic_load_uint64(&source->total_wait_ns);
+    destination->max_wait_ns = umockatomic_load_uint64(&source->max_wait_ns);
+    destination->release_count = umockatomic_load_uint64(&source->release_count);
+    destination->total_hold_ns = umockatomic_load_uint64(&source->total_hold_ns);
+    destination->max_hold_ns = umockatomic_load_uint64(&source->max_hold_ns);
+    for (i = 0; i < UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        destination->wait_histogram[i] = umockatomic_load_uint64(&source->wait_histogram[i]);
+        destination->hold_histogram[i] = umockatomic_load_uint64(&source->hold_histogram[i]);
+    }
+}
+
+static void clear_mode_stats(UMOCK_LOCK_INSTRUMENTATION_MODE_STATS* mode_stats)
+{
+    size_t i;
+
+    umockatomic_store_uint64(&mode_stats->acquire_count, 0);
+    umockatomic_store_uint64(&mode_stats->total_wait_ns, 0);
+    umockatomic_store_uint64(&mode_stats->max_wait_ns, 0);
+    umockatomic_store_uint64(&mode_stats->release_count, 0);
+    umockatomic_store_uint64(&mode_stats->total_hold_ns, 0);
+    umockatomic_store_uint64(&mode_stats->max_hold_ns, 0);
+    for (i = 0; i < UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        umockatomic_store_uint64(&mode_stats->wait_histogram[i], 0);
+        umockatomic_store_uint64(&mode_stats->hold_histogram[i], 0);
+    }
+}
+
+static void umock_lock_instrumented_acquire_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_013: [ If lock is NULL, umock_lock_instrumented_acquire_shared shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = (UMOCK_C_LOCK_INSTRUMENTED*)lock;
+        uint64_t acquired_time_ns;
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_014: [ umock_lock_instrumented_acquire_shared shall acquire the wrapped lock in shared mode and measure how long that took. ]*/
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_034: [ Times shall be read from a monotonic clock: clock_gettime with CLOCK_MONOTONIC, or QueryPerformanceCounter on Windows. ]*/
+        uint64_t start_time_ns = get_time_ns();
+        instrumented_lock->inner_lock->acquire_shared(instrumented_lock->inner_lock);
+        acquired_time_ns = get_time_ns();
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_015: [ umock_lock_instrumented_acquire_shared shall increment the shared acquire count and add the wait time to the shared wait total, maximum and histogram. ]*/
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+        record_wait(&instrumented_lock->instrumentation->stats.shared, get_duration_ns(start_time_ns, acquired_time_ns));
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_016: [ umock_lock_instrumented_acquire_shared shall remember the acquire time for the calling thread, unless the calling thread already holds MAX_SHARED_HOLDS_PER_THREAD shared acquisitions. ]*/
+        if (shared_hold_count < MAX_SHARED_HOLDS_PER_THREAD)
+        {
+            shared_holds[shared_hold_count].lock = instrumented_lock;
+            shared_holds[shared_hold_count].acquire_time_ns = acquired_time_ns;
+            shared_hold_count++;
+        }
+    }
+}
+
+static void umock_lock_instrumented_release_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_017: [ If lock is NULL, umock_lock_instrumented_release_shared shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = (UMOCK_C_LOCK_INSTRUMENTED*)lock;
+        uint64_t release_time_ns = get_time_ns();
+        size_t i = shared_hold_count;
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_018: [ umock_lock_instrumented_release_shared shall release the wrapped lock in shared mode. ]*/
+        instrumented_lock->inner_lock->release_shared(instrumented_lock->inner_lock);
+
+        /* the most recent shared hold of this lock by this thread is the one being released */
+        while ((i > 0) && (shared_holds[i - 1].lock != instrumented_lock))
+        {
+            i--;
+        }
+
+        if (i > 0)
+        {
+            uint64_t acquire_time_ns = shared_holds[i - 1].acquire_time_ns;
+
+            (void)memmove(&shared_holds[i - 1], &shared_holds[i], (shared_hold_count - i) * sizeof(SHARED_HOLD));
+            shared_hold_count--;
+
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_019: [ If the calling thread remembered an acquire time for the lock, umock_lock_instrumented_release_shared shall increment the shared release count and add the time elapsed since the acquire to the shared hold total, maximum and histogram. ]*/
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+            record_hold(&instrumented_lock->instrumentation->stats.shared, get_duration_ns(acquire_time_ns, release_time_ns));
+        }
+    }
+}
+
+static void umock_lock_instrumented_acquire_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_020: [ If lock is NULL, umock_lock_instrumented_acquire_exclusive shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = (UMOCK_C_LOCK_INSTRUMENTED*)lock;
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_021: [ umock_lock_instrumented_acquire_exclusive shall acquire the wrapped lock in exclusive mode and measure how long that took. ]*/
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_034: [ Times shall be read from a monotonic clock: clock_gettime with CLOCK_MONOTONIC, or QueryPerformanceCounter on Windows. ]*/
+        uint64_t start_time_ns = get_time_ns();
+        instrumented_lock->inner_lock->acquire_exclusive(instrumented_lock->inner_lock);
+        instrumented_lock->exclusive_acquire_time_ns = get_time_ns();
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_022: [ umock_lock_instrumented_acquire_exclusive shall increment the exclusive acquire count and add the wait time to the exclusive wait total, maximum and histogram. ]*/
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+        record_wait(&instrumented_lock->instrumentation->stats.exclusive, get_duration_ns(start_time_ns, instrumented_lock->exclusive_acquire_time_ns));
+    }
+}
+
+static void umock_lock_instrumented_release_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_023: [ If lock is NULL, umock_lock_instrumented_release_exclusive shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = (UMOCK_C_LOCK_INSTRUMENTED*)lock;
+        uint64_t hold_ns = get_duration_ns(instrumented_lock->exclusive_acquire_time_ns, get_time_ns());
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_024: [ umock_lock_instrumented_release_exclusive shall release the wrapped lock in exclusive mode. ]*/
+        instrumented_lock->inner_lock->release_exclusive(instrumented_lock->inner_lock);
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_025: [ umock_lock_instrumented_release_exclusive shall increment the exclusive release count and add the time elapsed since the exclusive acquire to the exclusive hold total, maximum and histogram. ]*/
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+        record_hold(&instrumented_lock->instrumentation->stats.exclusive, hold_ns);
+    }
+}
+
+static void umock_lock_instrumented_destroy(UMOCK_C_LOCK_HANDLE lock)
+{
+    if (lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_026: [ If lock is NULL, umock_lock_instrumented_destroy shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_HANDLE lock=%p", lock);
+    }
+    else
+    {
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = (UMOCK_C_LOCK_INSTRUMENTED*)lock;
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_027: [ umock_lock_instrumented_destroy shall destroy the wrapped lock and free the memory associated with the lock. ]*/
+        instrumented_lock->inner_lock->destroy(instrumented_lock->inner_lock);
+        umockalloc_free(instrumented_lock);
+    }
+}
+
+UMOCK_LOCK_INSTRUMENTATION_HANDLE umock_lock_instrumentation_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
+{
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE result;
+
+    if (lock_factory_create_lock == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_001: [ If lock_factory_create_lock is NULL, umock_lock_instrumentation_create shall fail and return NULL. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock=NULL, void* lock_factory_create_lock_params=%p",
+            lock_factory_create_lock_params);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_002: [ umock_lock_instrumentation_create shall allocate memory for the instrumentation. ]*/
+        result = umockalloc_malloc(sizeof(UMOCK_LOCK_INSTRUMENTATION));
+        if (result == NULL)
+        {
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_005: [ If any error occurs, umock_lock_instrumentation_create shall fail and return NULL. ]*/
+            UMOCK_LOG("umockalloc_malloc(%zu) failed", sizeof(UMOCK_LOCK_INSTRUMENTATION));
+        }
+        else
+        {
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_004: [ umock_lock_instrumentation_create shall store lock_factory_create_lock and lock_factory_create_lock_params and set all the statistics to 0. ]*/
+            result->lock_factory_create_lock = lock_factory_create_lock;
+            result->lock_factory_create_lock_params = lock_factory_create_lock_params;
+            (void)memset(&result->stats, 0, sizeof(result->stats));
+        }
+    }
+
+    return result;
+}
+
+void umock_lock_instrumentation_destroy(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation)
+{
+    if (instrumentation == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_006: [ If instrumentation is NULL, umock_lock_instrumentation_destroy shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation=%p", instrumentation);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_007: [ umock_lock_instrumentation_destroy shall free the memory associated with the instrumentation. ]*/
+        umockalloc_free(instrumentation);
+    }
+}
+
+UMOCK_C_LOCK_HANDLE umock_lock_instrumentation_create_lock(void* params)
+{
+    UMOCK_C_LOCK_HANDLE result;
+
+    if (params == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_008: [ If params is NULL, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+        UMOCK_LOG("Invalid arguments: void* params=%p", params);
+        result = NULL;
+    }
+    else
+    {
+        UMOCK_LOCK_INSTRUMENTATION* instrumentation = (UMOCK_LOCK_INSTRUMENTATION*)params;
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_009: [ umock_lock_instrumentation_create_lock shall allocate memory for the lock. ]*/
+        UMOCK_C_LOCK_INSTRUMENTED* instrumented_lock = umockalloc_malloc(sizeof(UMOCK_C_LOCK_INSTRUMENTED));
+        if (instrumented_lock == NULL)
+        {
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_012: [ If any error occurs, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+            UMOCK_LOG("umockalloc_malloc(%zu) failed", sizeof(UMOCK_C_LOCK_INSTRUMENTED));
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_010: [ umock_lock_instrumentation_create_lock shall create the wrapped lock by calling the lock factory that was passed to umock_lock_instrumentation_create. ]*/
+            instrumented_lock->inner_lock = instrumentation->lock_factory_create_lock(instrumentation->lock_factory_create_lock_params);
+            if (instrumented_lock->inner_lock == NULL)
+            {
+                /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_012: [ If any error occurs, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+                UMOCK_LOG("Cannot create the wrapped lock");
+                umockalloc_free(instrumented_lock);
+                result = NULL;
+            }
+            else
+            {
+                instrumented_lock->instrumentation = instrumentation;
+                instrumented_lock->exclusive_acquire_time_ns = 0;
+
+                /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_011: [ umock_lock_instrumentation_create_lock shall return a lock handle that has the function pointers set to umock_lock_instrumented_acquire_shared, umock_lock_instrumented_release_shared, umock_lock_instrumented_acquire_exclusive, umock_lock_instrumented_release_exclusive and umock_lock_instrumented_destroy. ]*/
+                instrumented_lock->lock_if.acquire_shared = umock_lock_instrumented_acquire_shared;
+                instrumented_lock->lock_if.release_shared = umock_lock_instrumented_release_shared;
+                instrumented_lock->lock_if.acquire_exclusive = umock_lock_instrumented_acquire_exclusive;
+                instrumented_lock->lock_if.release_exclusive = umock_lock_instrumented_release_exclusive;
+                instrumented_lock->lock_if.destroy = umock_lock_instrumented_destroy;
+
+                result = &instrumented_lock->lock_if;
+            }
+        }
+    }
+
+    return result;
+}
+
+int umock_lock_instrumentation_get_stats(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation, UMOCK_LOCK_INSTRUMENTATION_STATS* stats)
+{
+    int result;
+
+    if ((instrumentation == NULL) ||
+        (stats == NULL))
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_028: [ If instrumentation or stats is NULL, umock_lock_instrumentation_get_stats shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation=%p, UMOCK_LOCK_INSTRUMENTATION_STATS* stats=%p",
+            instrumentation, stats);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_029: [ umock_lock_instrumentation_get_stats shall copy the statistics of all the locks created with instrumentation to stats, reading each of them atomically. ]*/
+        copy_mode_stats(&stats->shared, &instrumentation->stats.shared);
+        copy_mode_stats(&stats->exclusive, &instrumentation->stats.exclusive);
+
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_030: [ On success umock_lock_instrumentation_get_stats shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
+
+void umock_lock_instrumentation_reset_stats(UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation)
+{
+    if (instrumentation == NULL)
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_031: [ If instrumentation is NULL, umock_lock_instrumentation_reset_stats shall return. ]*/
+        UMOCK_LOG("Invalid arguments: UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation=%p", instrumentation);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCK_LOCK_INSTRUMENTATION_01_032: [ umock_lock_instrumentation_reset_stats shall atomically set each of the statistics to 0. ]*/
+        clear_mode_stats(&instrumentation->stats.shared);
+        clear_mode_stats(&instrumentation->stats.exclusive);
+    }
+}
@@ -4,7 +4,62 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+
 #include "umock_c/umockalloc.h"
+#include "umock_c/umock_lock_if.h"
+#include "umock_c/umock_log.h"
+
+/* every block and every allocation in an arena starts at a multiple of this */
+typedef union UMOCKALLOC_ARENA_ALIGNMENT_TAG
+{
+    long double long_double_value;
+    long long long_long_value;
+    double double_value;
+    void* pointer_value;
+    void(*function_pointer_value)(void);
+} UMOCKALLOC_ARENA_ALIGNMENT;
+
+#define ARENA_ALIGN(size) ((((size) + sizeof(UMOCKALLOC_ARENA_ALIGNMENT) - 1) / sizeof(UMOCKALLOC_ARENA_ALIGNMENT)) * sizeof(UMOCKALLOC_ARENA_ALIGNMENT))
+
+/* each allocation is preceded by its size, so that umockalloc_realloc can move it out of the arena */
+#define ARENA_ALLOCATION_HEADER_SIZE ARENA_ALIGN(sizeof(size_t))
+
+#define ARENA_INITIAL_BLOCK_SIZE (16 * 1024)
+
+typedef struct UMOCKALLOC_ARENA_BLOCK_TAG
+{
+    struct UMOCKALLOC_ARENA_BLOCK_TAG* next;
+    unsigned char* memory;
+    size_t size;
+    size_t used;
+} UMOCKALLOC_ARENA_BLOCK;
+
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN(sizeof(UMOCKALLOC_ARENA_BLOCK))
+
+typedef struct UMOCKALLOC_ARENA_TAG
+{
+    /* the most recently allocated (and largest) block is first */
+    UMOCKALLOC_ARENA_BLOCK* blocks;
+    size_t next_block_size;
+    UMOCK_C_LOCK_HANDLE lock;
+} UMOCKALLOC_ARENA;
+
+static UMOCKALLOC_ARENA_HANDLE call_arena = NULL;
+
+/* 0 when buffers are stringified in full, otherwise the number of bytes shown at each end of a longer buffer */
+static size_t stringify_buffer_edge_byte_count = 0;
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+/* each byte is stringified as "0xHH " */
+#define STRINGIFIED_BYTE_LENGTH 5
+
+/* a differing buffer is scanned in blocks of this size to find the block with the first difference */
+#define COMPARE_BUFFERS_BLOCK_SIZE 256
+
+/* number of bytes shown on each side of the first difference when reporting differing buffers */
+#define BUFFER_DIFFERENCE_WINDOW 8
 
 void* umockalloc_malloc(size_t size)
 {
@@ -20,49 +75,379 @@ void* umockalloc_calloc(size_t nmemb, size_t size)
     return calloc(nmemb, size);
 }
 
+static int internal_arena_owns(UMOCKALLOC_ARENA_HANDLE arena, const void* ptr)
+{
+    int result = 0;
+    UMOCKALLOC_ARENA_BLOCK* block;
+
+    for (block = arena->blocks; block != NULL; block = block->next)
+    {
+        if (((const unsigned char*)ptr >= block->memory) &&
+            ((const unsigned char*)ptr < block->memory + block->size))
+        {
+            result = 1;
+            break;
+        }
+    }
+
+    return result;
+}
+
+static int is_call_arena_memory(const void* ptr)
+{
+    int result;
+
+    if ((call_arena == NULL) ||
+        (ptr == NULL))
+    {
+        result = 0;
+    }
+    else
+    {
+        result = umockalloc_arena_owns(call_arena, ptr);
+    }
+
+    return result;
+}
+
 void* umockalloc_realloc(void* ptr, size_t size)
 {
-    /* Codes_SRS_UMOCKALLOC_01_003: [ umockalloc_realloc shall call realloc, while passing the ptr and size arguments to realloc. ] */
-    /* Codes_SRS_UMOCKALLOC_01_004: [ umockalloc_realloc shall return the result of realloc. ]*/
-    return realloc(ptr, size);
+    void* result;
+
+    if (is_call_arena_memory(ptr))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_020: [ If ptr was allocated from the call arena, umockalloc_realloc shall allocate a new block of size bytes by calling malloc, copy the contents of the arena memory to it and return it. ]*/
+        size_t old_size = *(const size_t*)((const unsigned char*)ptr - ARENA_ALLOCATION_HEADER_SIZE);
+        result = malloc(size);
+        if (result == NULL)
+        {
+            UMOCK_LOG("umockalloc_realloc: Cannot move %zu bytes out of the call arena.", size);
+        }
+        else
+        {
+            (void)memcpy(result, ptr, (old_size < size) ? old_size : size);
+        }
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKALLOC_01_003: [ umockalloc_realloc shall call realloc, while passing the ptr and size arguments to realloc. ] */
+        /* Codes_SRS_UMOCKALLOC_01_004: [ umockalloc_realloc shall return the result of realloc. ]*/
+        result = realloc(ptr, size);
+    }
+
+    return result;
 }
 
 void umockalloc_free(void* ptr)
 {
-    /* Codes_SRS_UMOCKALLOC_01_005: [ umockalloc_free shall call free, while passing the ptr argument to free. ]*/
-    free(ptr);
+    if (is_call_arena_memory(ptr))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_021: [ If ptr was allocated from the call arena, umockalloc_free shall do nothing. ]*/
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKALLOC_01_005: [ umockalloc_free shall call free, while passing the ptr argument to free. ]*/
+        free(ptr);
+    }
 }
 
-char* umockc_stringify_buffer(const void* bytes, size_t length)
+UMOCKALLOC_ARENA_HANDLE umockalloc_arena_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
 {
-    size_t string_length = 2 + (4 * length);
-    char* result;
-    if (length > 1)
+    /* Codes_SRS_UMOCKALLOC_01_008: [ umockalloc_arena_create shall allocate memory for a new arena and on success return a non-NULL handle to it. ]*/
+    UMOCKALLOC_ARENA_HANDLE result = (UMOCKALLOC_ARENA_HANDLE)malloc(sizeof(UMOCKALLOC_ARENA));
+    if (result == NULL)
+    {
+        /* Codes_SRS_UMOCKALLOC_01_009: [ If any error occurs, umockalloc_arena_create shall fail and return NULL. ]*/
+        UMOCK_LOG("umockalloc_arena_create: Cannot allocate memory for the arena.");
+    }
+    else
+    {
+        result->blocks = NULL;
+        result->next_block_size = ARENA_INITIAL_BLOCK_SIZE;
+
+        /* Codes_SRS_UMOCKALLOC_01_010: [ If lock_factory_create_lock is not NULL, umockalloc_arena_create shall call it to create the lock used to serialize access to the arena. ]*/
+        if (lock_factory_create_lock == NULL)
+        {
+            result->lock = NULL;
+        }
+        else
+        {
+            result->lock = lock_factory_create_lock(lock_factory_create_lock_params);
+            if (result->lock == NULL)
+            {
+                /* Codes_SRS_UMOCKALLOC_01_009: [ If any error occurs, umockalloc_arena_create shall fail and return NULL. ]*/
+                UMOCK_LOG("umockalloc_arena_create: Cannot create the arena lock.");
+                free(result);
+                result = NULL;
+            }
+        }
+    }
+
+    return result;
+}
+
+void umockalloc_arena_destroy(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    /* Codes_SRS_UMOCKALLOC_01_012: [ If arena is NULL, umockalloc_arena_destroy shall do nothing. ]*/
+    if (arena != NULL)
     {
-        string_length += length - 1;
+        /* Codes_SRS_UMOCKALLOC_01_011: [ umockalloc_arena_destroy shall free all the memory blocks of the arena, the lock (if any) and the arena itself. ]*/
+        while (arena->blocks != NULL)
+        {
+            UMOCKALLOC_ARENA_BLOCK* next_block = arena->blocks->next;
+            free(arena->blocks);
+            arena->blocks = next_block;
+        }
+
+        if (arena->lock != NULL)
+        {
+            arena->lock->destroy(arena->lock);
+        }
+
+        free(arena);
     }
+}
 
-    result = (char*)umockalloc_malloc(string_length + 1);
-    if (result != NULL)
+void* umockalloc_arena_malloc(UMOCKALLOC_ARENA_HANDLE arena, size_t size)
+{
+    void* result;
+
+    if ((arena == NULL) ||
+        (size > ((size_t)-1) - ARENA_ALLOCATION_HEADER_SIZE - ARENA_BLOCK_HEADER_SIZE - sizeof(UMOCKALLOC_ARENA_ALIGNMENT)))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_014: [ If arena is NULL or size is too large, umockalloc_arena_malloc shall fail and return NULL. ]*/
+        UMOCK_LOG("umockalloc_arena_malloc: Invalid arguments: arena = %p, size = %zu.", arena, size);
+        result = NULL;
+    }
+    else
     {
-        size_t i;
+        size_t needed = ARENA_ALLOCATION_HEADER_SIZE + ARENA_ALIGN(size);
 
-        result[0] = '[';
-        for (i = 0; i < length; i++)
+        if (arena->lock != NULL)
         {
-            if (sprintf(result + 1 + (i * 5), "0x%02X ", ((const unsigned char*)bytes)[i]) < 0)
+            arena->lock->acquire_exclusive(arena->lock);
+        }
+
+        if ((arena->blocks == NULL) ||
+            (arena->blocks->size - arena->blocks->used < needed))
+        {
+            /* Codes_SRS_UMOCKALLOC_01_015: [ When the current block does not have room for size bytes, umockalloc_arena_malloc shall allocate a new block by calling malloc, at least twice as large as the previous one. ]*/
+            size_t block_size = (arena->next_block_size < needed) ? needed : arena->next_block_size;
+            UMOCKALLOC_ARENA_BLOCK* new_block = (UMOCKALLOC_ARENA_BLOCK*)malloc(ARENA_BLOCK_HEADER_SIZE + block_size);
+            if (new_block == NULL)
+            {
+                UMOCK_LOG("umockalloc_arena_malloc: Cannot allocate arena block of %zu bytes.", block_size);
+            }
+            else
             {
-                break;
+                new_block->memory = (unsigned char*)new_block + ARENA_BLOCK_HEADER_SIZE;
+                new_block->size = block_size;
+                new_block->used = 0;
+                new_block->next = arena->blocks;
+                arena->blocks = new_block;
+
+                if (block_size <= ((size_t)-1) / 4)
+                {
+                    arena->next_block_size = block_size * 2;
+                }
             }
         }
 
-        if (i < length)
+        if ((arena->blocks == NULL) ||
+            (arena->blocks->size - arena->blocks->used < needed))
         {
-            umockalloc_free(result);
+            /* Codes_SRS_UMOCKALLOC_01_016: [ If allocating a new block fails, umockalloc_arena_malloc shall fail and return NULL. ]*/
             result = NULL;
         }
         else
         {
+            /* Codes_SRS_UMOCKALLOC_01_013: [ umockalloc_arena_malloc shall return a pointer to size bytes taken from the current block of the arena. ]*/
+            unsigned char* allocation = arena->blocks->memory + arena->blocks->used;
+            *(size_t*)allocation = size;
+            arena->blocks->used += needed;
+            result = allocation + ARENA_ALLOCATION_HEADER_SIZE;
+        }
+
+        if (arena->lock != NULL)
+        {
+            arena->lock->release_exclusive(arena->lock);
+        }
+    }
+
+    return result;
+}
+
+int umockalloc_arena_owns(UMOCKALLOC_ARENA_HANDLE arena, const void* ptr)
+{
+    int result;
+
+    if ((arena == NULL) ||
+        (ptr == NULL))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_018: [ If arena or ptr is NULL, umockalloc_arena_owns shall return 0. ]*/
+        result = 0;
+    }
+    else
+    {
+        if (arena->lock != NULL)
+        {
+            arena->lock->acquire_shared(arena->lock);
+        }
+
+        /* Codes_SRS_UMOCKALLOC_01_017: [ umockalloc_arena_owns shall return 1 if ptr points inside one of the blocks of the arena and 0 otherwise. ]*/
+        result = internal_arena_owns(arena, ptr);
+
+        if (arena->lock != NULL)
+        {
+            arena->lock->release_shared(arena->lock);
+        }
+    }
+
+    return result;
+}
+
+void umockalloc_arena_reset(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    /* Codes_SRS_UMOCKALLOC_01_022: [ If arena is NULL, umockalloc_arena_reset shall do nothing. ]*/
+    if (arena != NULL)
+    {
+        if (arena->lock != NULL)
+        {
+            arena->lock->acquire_exclusive(arena->lock);
+        }
+
+        /* Codes_SRS_UMOCKALLOC_01_019: [ umockalloc_arena_reset shall release all the memory allocated from the arena at once, keeping only the most recently allocated block for reuse. ]*/
+        if (arena->blocks != NULL)
+        {
+            while (arena->blocks->next != NULL)
+            {
+                UMOCKALLOC_ARENA_BLOCK* next_block = arena->blocks->next->next;
+                free(arena->blocks->next);
+                arena->blocks->next = next_block;
+            }
+
+            arena->blocks->used = 0;
+        }
+
+        if (arena->lock != NULL)
+        {
+            arena->lock->release_exclusive(arena->lock);
+        }
+    }
+}
+
+void umockalloc_set_call_arena(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    /* Codes_SRS_UMOCKALLOC_01_023: [ umockalloc_set_call_arena shall set arena as the arena used by umockalloc_call_malloc. A NULL arena turns off the arena mode. ]*/
+    call_arena = arena;
+}
+
+void* umockalloc_call_malloc(size_t size)
+{
+    void* result;
+
+    if (call_arena != NULL)
+    {
+        /* Codes_SRS_UMOCKALLOC_01_024: [ If a call arena was set, umockalloc_call_malloc shall allocate size bytes from it by calling umockalloc_arena_malloc. ]*/
+        result = umockalloc_arena_malloc(call_arena, size);
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKALLOC_01_025: [ Otherwise umockalloc_call_malloc shall behave like umockalloc_malloc. ]*/
+        result = malloc(size);
+    }
+
+    return result;
+}
+
+void umockc_set_stringify_buffer_truncation(size_t edge_byte_count)
+{
+    /* Codes_SRS_UMOCKALLOC_01_030: [ umockc_set_stringify_buffer_truncation shall set the number of bytes that umockc_stringify_buffer shows at each end of a buffer that is longer than twice that number. An edge_byte_count of 0 turns off the truncation. ]*/
+    stringify_buffer_edge_byte_count = edge_byte_count;
+}
+
+static char* append_stringified_bytes(char* destination, const unsigned char* bytes, size_t length)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        destination[0] = '0';
+        destination[1] = 'x';
+        destination[2] = hex_digits[bytes[i] >> 4];
+        destination[3] = hex_digits[bytes[i] & 0x0F];
+        destination[4] = ' ';
+        destination += STRINGIFIED_BYTE_LENGTH;
+    }
+
+    return destination;
+}
+
+char* umockc_stringify_buffer(const void* bytes, size_t length)
+{
+    char* result;
+    size_t edge_byte_count = stringify_buffer_edge_byte_count;
+    /* the first and last shown bytes (all of them when not truncating) */
+    size_t leading_byte_count;
+    size_t trailing_byte_count;
+    /* at most length, as each shown end is at most half of the buffer */
+    size_t shown_byte_count;
+    char truncation_marker[64];
+    int truncation_marker_length;
+
+    if ((edge_byte_count == 0) ||
+        (length / 2 < edge_byte_count) ||
+        (length - edge_byte_count <= edge_byte_count))
+    {
+        leading_byte_count = length;
+        trailing_byte_count = 0;
+        truncation_marker_length = 0;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKALLOC_01_031: [ If a truncation was set with umockc_set_stringify_buffer_truncation and length is more than twice edge_byte_count, only the first and the last edge_byte_count bytes shall be stringified, separated by a ...(length bytes)... marker. ]*/
+        leading_byte_count = edge_byte_count;
+        trailing_byte_count = edge_byte_count;
+        truncation_marker_length = sprintf(truncation_marker, "...(%zu bytes)... ", length);
+    }
+    shown_byte_count = leading_byte_count + trailing_byte_count;
+
+    if (truncation_marker_length < 0)
+    {
+        UMOCK_LOG("umockc_stringify_buffer: Cannot format the truncation marker.");
+        result = NULL;
+    }
+    else if (shown_byte_count > (((size_t)-1) - 2 - (size_t)truncation_marker_length) / STRINGIFIED_BYTE_LENGTH)
+    {
+        /* Codes_SRS_UMOCKALLOC_01_029: [ If the length of the resulting string does not fit in a size_t, umockc_stringify_buffer shall fail and return NULL. ]*/
+        UMOCK_LOG("umockc_stringify_buffer: Buffer of %zu bytes is too large to stringify.", length);
+        result = NULL;
+    }
+    else
+    {
+        /* the space after the last byte is replaced by the closing bracket */
+        size_t string_length = (shown_byte_count == 0) ? 2 : 1 + (STRINGIFIED_BYTE_LENGTH * shown_byte_count) + (size_t)truncation_marker_length;
+
+        /* Codes_SRS_UMOCKALLOC_01_026: [ umockc_stringify_buffer shall allocate a string by calling umockalloc_malloc and fill it with the length bytes pointed to by bytes, each formatted as 0x followed by 2 uppercase hex digits, separated by spaces and enclosed in square brackets. ]*/
+        result = (char*)umockalloc_malloc(string_length + 1);
+        if (result == NULL)
+        {
+            /* Codes_SRS_UMOCKALLOC_01_028: [ If allocating memory fails, umockc_stringify_buffer shall fail and return NULL. ]*/
+            UMOCK_LOG("umockc_stringify_buffer: Cannot allocate memory for the stringified buffer.");
+        }
+        else
+        {
+            char* position;
+
+            result[0] = '[';
+            /* Codes_SRS_UMOCKALLOC_01_027: [ The hex digits shall be taken from a lookup table rather than formatted with sprintf for each byte. ]*/
+            position = append_stringified_bytes(result + 1, (const unsigned char*)bytes, leading_byte_count);
+            if (trailing_byte_count > 0)
+            {
+                (void)memcpy(position, truncation_marker, (size_t)truncation_marker_length);
+                (void)append_stringified_bytes(position + truncation_marker_length, (const unsigned char*)bytes + (length - trailing_byte_count), trailing_byte_count);
+            }
+
             result[string_length - 1] = ']';
             result[string_length] = '\0';
         }
@@ -70,3 +455,191 @@ char* umockc_stringify_buffer(const void* bytes, size_t length)
 
     return result;
 }
+
+int umockc_compare_buffers(const void* left, const void* right, size_t length, size_t* first_difference_offset)
+{
+    int result;
+
+    if ((left == NULL) || (right == NULL) || (first_difference_offset == NULL))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_035: [ If left, right or first_difference_offset is NULL, umockc_compare_buffers shall fail and return a negative value. ]*/
+        UMOCK_LOG("umockc_compare_buffers: Invalid arguments: left = %p, right = %p, first_difference_offset = %p.", left, right, first_difference_offset);
+        result = -1;
+    }
+    /* Codes_SRS_UMOCKALLOC_01_032: [ umockc_compare_buffers shall compare the length bytes pointed to by left and right by calling memcmp and return 0 if they are equal. ]*/
+    else if (memcmp(left, right, length) == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        const unsigned char* left_bytes = (const unsigned char*)left;
+        const unsigned char* right_bytes = (const unsigned char*)right;
+        size_t offset = 0;
+
+        /* Codes_SRS_UMOCKALLOC_01_034: [ The first difference shall be located by comparing blocks of bytes with memcmp and then the bytes of the first differing block. ]*/
+        while ((length - offset > COMPARE_BUFFERS_BLOCK_SIZE) &&
+            (memcmp(left_bytes + offset, right_bytes + offset, COMPARE_BUFFERS_BLOCK_SIZE) == 0))
+        {
+            offset += COMPARE_BUFFERS_BLOCK_SIZE;
+        }
+
+        while (left_bytes[offset] == right_bytes[offset])
+        {
+            offset++;
+        }
+
+        /* Codes_SRS_UMOCKALLOC_01_033: [ Otherwise umockc_compare_buffers shall set first_difference_offset to the offset of the first byte that differs and return 1. ]*/
+        *first_difference_offset = offset;
+        result = 1;
+    }
+
+    return result;
+}
+
+char* umockc_stringify_buffer_difference(const void* expected, const void* actual, size_t length, size_t first_difference_offset)
+{
+    char* result;
+
+    if ((expected == NULL) || (actual == NULL) || (first_difference_offset >= length))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_038: [ If expected or actual is NULL or first_difference_offset is not less than length, umockc_stringify_buffer_difference shall fail and return NULL. ]*/
+        UMOCK_LOG("umockc_stringify_buffer_difference: Invalid arguments: expected = %p, actual = %p, length = %zu, first_difference_offset = %zu.", expected, actual, length, first_difference_offset);
+        result = NULL;
+    }
+    else
+    {
+        size_t window_start = (first_difference_offset > BUFFER_DIFFERENCE_WINDOW) ? first_difference_offset - BUFFER_DIFFERENCE_WINDOW : 0;
+        size_t window_end = (length - first_difference_offset > BUFFER_DIFFERENCE_WINDOW) ? first_difference_offset + BUFFER_DIFFERENCE_WINDOW + 1 : length;
+        size_t window_length = window_end - window_start;
+        char header[128];
+        int header_length = sprintf(header, "differs at offset %zu of %zu, bytes %zu to %zu: expected [", first_difference_offset, length, window_start, window_end - 1);
+
+        if (header_length < 0)
+        {
+            UMOCK_LOG("umockc_stringify_buffer_difference: Cannot format the difference header.");
+            result = NULL;
+        }
+        else
+        {
+            /* header, expected window, "] actual [", actual window, "]" (the space after the last byte of each window is dropped) */
+            size_t string_length = (size_t)header_length + (2 * STRINGIFIED_BYTE_LENGTH * window_length) - 2 + (sizeof("] actual [") - 1) + 1;
+
+            /* Codes_SRS_UMOCKALLOC_01_036: [ umockc_stringify_buffer_difference shall allocate by calling umockalloc_malloc a string that contains first_difference_offset, length and the bytes of expected and actual from 8 bytes before up to 8 bytes after first_difference_offset (limited to the buffer), each stringified like umockc_stringify_buffer does. ]*/
+            result = (char*)umockalloc_malloc(string_length + 1);
+            if (result == NULL)
+            {
+                /* Codes_SRS_UMOCKALLOC_01_037: [ If allocating memory fails, umockc_stringify_buffer_difference shall fail and return NULL. ]*/
+                UMOCK_LOG("umockc_stringify_buffer_difference: Cannot allocate memory for the stringified difference.");
+            }
+            else
+            {
+                char* position;
+
+                (void)memcpy(result, header, (size_t)header_length);
+                position = append_stringified_bytes(result + header_length, (const unsigned char*)expected + window_start, window_length) - 1;
+                (void)memcpy(position, "] actual [", sizeof("] actual [") - 1);
+                position = append_stringified_bytes(position + sizeof("] actual [") - 1, (const unsigned char*)actual + window_start, window_length) - 1;
+                position[0] = ']';
+                position[1] = '\0';
+            }
+        }
+    }
+
+    return result;
+}
+
+int umockc_validate_argument_buffer(const void* expected, const void* actual, size_t length)
+{
+    int result;
+    size_t first_difference_offset;
+
+    if (actual == NULL)
+    {
+        /* Codes_SRS_UMOCKALLOC_01_040: [ If actual is NULL, umockc_validate_argument_buffer shall return 0. ]*/
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKALLOC_01_039: [ umockc_validate_argument_buffer shall compare the length bytes of expected and actual by calling umockc_compare_buffers and return 1 if they are equal. ]*/
+        /* Codes_SRS_UMOCKALLOC_01_041: [ If the buffers differ, umockc_validate_argument_buffer shall return 0 without allocating memory or logging. ]*/
+        /* Codes_SRS_UMOCKALLOC_01_042: [ If comparing the buffers fails, umockc_validate_argument_buffer shall return 0. ]*/
+        result = (umockc_compare_buffers(expected, actual, length, &first_difference_offset) == 0) ? 1 : 0;
+    }
+
+    return result;
+}
+
+char* umockc_stringify_argument_buffer_mismatch(const char* argument_name, const void* expected, const void* actual, size_t length)
+{
+    char* result;
+
+    if ((argument_name == NULL) || (expected == NULL))
+    {
+        /* Codes_SRS_UMOCKALLOC_01_046: [ If argument_name or expected is NULL, umockc_stringify_argument_buffer_mismatch shall fail and return NULL. ]*/
+        UMOCK_LOG("umockc_stringify_argument_buffer_mismatch: Invalid arguments: argument_name = %p, expected = %p.", argument_name, expected);
+        result = NULL;
+    }
+    else
+    {
+        size_t argument_name_length = strlen(argument_name);
+        char* difference;
+        const char* reason;
+        const char* reason_prefix = "";
+        size_t first_difference_offset;
+
+        if (actual == NULL)
+        {
+            /* Codes_SRS_UMOCKALLOC_01_044: [ If actual is NULL, umockc_stringify_argument_buffer_mismatch shall return a string that names argument_name and says that the argument is NULL. ]*/
+            difference = NULL;
+            reason = "the argument is NULL";
+        }
+        else if (umockc_compare_buffers(expected, actual, length, &first_difference_offset) != 1)
+        {
+            /* Codes_SRS_UMOCKALLOC_01_045: [ If the buffers are equal, umockc_stringify_argument_buffer_mismatch shall return NULL. ]*/
+            difference = NULL;
+            reason = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKALLOC_01_043: [ If the buffers differ, umockc_stringify_argument_buffer_mismatch shall return a string allocated by calling umockalloc_malloc that names argument_name and contains the difference obtained by calling umockc_stringify_buffer_difference. ]*/
+            difference = umockc_stringify_buffer_difference(expected, actual, length, first_difference_offset);
+            reason = difference;
+            reason_prefix = "the buffer ";
+        }
+
+        if (reason == NULL)
+        {
+            result = NULL;
+        }
+        else
+        {
+            /* "ValidateArgumentBuffer mismatch for argument ", argument_name, ": ", reason_prefix, reason */
+            size_t reason_length = strlen(reason);
+            size_t reason_prefix_length = strlen(reason_prefix);
+            size_t prefix_length = sizeof("ValidateArgumentBuffer mismatch for argument ") - 1;
+
+            result = (char*)umockalloc_malloc(prefix_length + argument_name_length + 2 + reason_prefix_length + reason_length + 1);
+            if (result == NULL)
+            {
+                /* Codes_SRS_UMOCKALLOC_01_047: [ If allocating memory fails, umockc_stringify_argument_buffer_mismatch shall fail and return NULL. ]*/
+                UMOCK_LOG("umockc_stringify_argument_buffer_mismatch: Cannot allocate memory for the mismatch string.");
+            }
+            else
+            {
+                (void)memcpy(result, "ValidateArgumentBuffer mismatch for argument ", prefix_length);
+                (void)memcpy(result + prefix_length, argument_name, argument_name_length);
+                (void)memcpy(result + prefix_length + argument_name_length, ": ", 2);
+                (void)memcpy(result + prefix_length + argument_name_length + 2, reason_prefix, reason_prefix_length);
+                (void)memcpy(result + prefix_length + argument_name_length + 2 + reason_prefix_length, reason, reason_length + 1);
+            }
+        }
+
+        if (difference != NULL)
+        {
+            umockalloc_free(difference);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#endif
+
+#include "umock_c/umockatomic.h"
+
+uint64_t umockatomic_increment_uint64(volatile uint64_t* value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_001: [ umockatomic_increment_uint64 shall atomically increment value and return the incremented value. ]*/
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedIncrement64((volatile LONG64*)value);
+#else
+    return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+#endif
+}
+
+uint64_t umockatomic_add_uint64(volatile uint64_t* value, uint64_t addend)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_002: [ umockatomic_add_uint64 shall atomically add addend to value and return the resulting value. ]*/
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedAdd64((volatile LONG64*)value, (LONG64)addend);
+#else
+    return __atomic_add_fetch(value, addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+uint64_t umockatomic_load_uint64(volatile uint64_t* value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_003: [ umockatomic_load_uint64 shall atomically read value with acquire semantics and return it. ]*/
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64*)value, 0, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void umockatomic_store_uint64(volatile uint64_t* value, uint64_t new_value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_004: [ umockatomic_store_uint64 shall atomically write new_value to value with release semantics. ]*/
+#if defined(_MSC_VER)
+    (void)InterlockedExchange64((volatile LONG64*)value, (LONG64)new_value);
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+int umockatomic_compare_exchange_uint64(volatile uint64_t* value, uint64_t expected_value, uint64_t new_value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_005: [ If value is equal to expected_value, umockatomic_compare_exchange_uint64 shall atomically replace it with new_value and return a non-zero value. ]*/
+    /* Codes_SRS_UMOCKATOMIC_01_006: [ Otherwise umockatomic_compare_exchange_uint64 shall leave value unchanged and return 0. ]*/
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64*)value, (LONG64)new_value, (LONG64)expected_value) == expected_value;
+#else
+    return __atomic_compare_exchange_n(value, &expected_value, new_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void umockatomic_max_uint64(volatile uint64_t* value, uint64_t candidate)
+{
+    uint64_t current_value = umockatomic_load_uint64(value);
+
+    /* Codes_SRS_UMOCKATOMIC_01_007: [ umockatomic_max_uint64 shall replace value with candidate if candidate is greater, by retrying an atomic compare-exchange until it succeeds or value is not smaller than candidate anymore. ]*/
+    while ((current_value < candidate) &&
+        !umockatomic_compare_exchange_uint64(value, current_value, candidate))
+    {
+        current_value = umockatomic_load_uint64(value);
+    }
+}
+
+void* umockatomic_load_pointer(void* volatile* value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_008: [ umockatomic_load_pointer shall atomically read value with acquire semantics and return it. ]*/
+#if defined(_MSC_VER)
+    return InterlockedCompareExchangePointer(value, NULL, NULL);
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void umockatomic_store_pointer(void* volatile* value, void* new_value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_009: [ umockatomic_store_pointer shall atomically write new_value to value with release semantics. ]*/
+#if defined(_MSC_VER)
+    (void)InterlockedExchangePointer(value, new_value);
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+int umockatomic_compare_exchange_pointer(void* volatile* value, void* expected_value, void* new_value)
+{
+    /* Codes_SRS_UMOCKATOMIC_01_010: [ If value is equal to expected_value, umockatomic_compare_exchange_pointer shall atomically replace it with new_value and return a non-zero value. ]*/
+    /* Codes_SRS_UMOCKATOMIC_01_011: [ Otherwise umockatomic_compare_exchange_pointer shall leave value unchanged and return 0. ]*/
+#if defined(_MSC_VER)
+    return InterlockedCompareExchangePointer(value, new_value, expected_value) == expected_value;
+#else
+    return __atomic_compare_exchange_n(value, &expected_value, new_value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
@@ -16,226 +16,215 @@ static const char ignore_struct_arg_string[] = "IGNORED_STRUCT_ARG";
 
 #define PARSER_STACK_DEPTH 256
 
-/* Codes_SRS_UMOCKAUTOIGNOREARGS_01_001: [ umockautoignoreargs_is_call_argument_ignored shall determine whether argument argument_index shall be ignored or not. ]*/
-int umockautoignoreargs_is_call_argument_ignored(const char* call, size_t argument_index, int* is_argument_ignored)
+static bool is_ignored_argument_value(const char* argument)
 {
-    int result;
+    return
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_007: [ If the argument value is IGNORED_ARG then is_argument_ignored shall be set to 1. ]*/
+        (strncmp(argument, ignore_arg_string, sizeof(ignore_arg_string) - 1) == 0) ||
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_012: [ If the argument value starts with IGNORED_STRUCT_ARG then is_argument_ignored shall be set to 1. ]*/
+        (strncmp(argument, ignore_struct_arg_string, sizeof(ignore_struct_arg_string) - 1) == 0);
+}
 
-    if (
-        (call == NULL) ||
-        (is_argument_ignored == NULL)
-        )
-    {
-        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_002: [ If call or is_argument_ignored is NULL, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
-        result = MU_FAILURE;
-    }
-    else
+/* returns the first character after the opening parenthesis of the rightmost parenthesis set in call, NULL if such a set cannot be formed */
+static const char* find_argument_list(const char* call)
+{
+    const char* result = NULL;
+    size_t i = strlen(call);
+    size_t paren_scope_count = 0;
+
+    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_010: [ umockautoignoreargs_is_call_argument_ignored shall look for the arguments as being the string contained in the scope of the rightmost parenthesis set in call. ]*/
+    while (i > 0)
     {
-        // find where the args start
-        size_t call_string_len = strlen(call);
-        size_t i = call_string_len;
-        size_t paren_scope_count = 0;
-        bool is_error = false;
-
-        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_010: [ umockautoignoreargs_is_call_argument_ignored shall look for the arguments as being the string contained in the scope of the rightmost parenthesis set in call. ]*/
-        do
+        i--;
+
+        if (call[i] == ')')
         {
-            i--;
-            
-            if (call[i] == ')')
+            paren_scope_count++;
+        }
+        else if (call[i] == '(')
+        {
+            if (paren_scope_count == 0)
             {
-                paren_scope_count++;
+                break;
             }
-            else if (call[i] == '(')
+            else
             {
+                paren_scope_count--;
                 if (paren_scope_count == 0)
                 {
-                    // error
-                    is_error = true;
+                    // found the start of the args
+                    result = &call[i + 1];
                     break;
                 }
-                else
-                {
-                    paren_scope_count--;
-                    if (paren_scope_count == 0)
-                    {
-                        // found the start of the args
-                        break;
-                    }
-                }
             }
-        } while (i > 0);
+        }
+    }
 
-        if (
-            (is_error) ||
-            /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_011: [ If a valid scope of the rightmost parenthesis set cannot be formed (imbalanced parenthesis for example), umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
-            (paren_scope_count > 0)
-            )
+    return result;
+}
+
+/* moves past the argument starting at cur_pos, returns the position of the comma ending it or NULL if the argument is the last one or cannot be parsed */
+static const char* skip_argument(const char* cur_pos)
+{
+    unsigned char parser_stack[PARSER_STACK_DEPTH];
+    size_t parser_stack_index = 0;
+    const char* result = NULL;
+
+    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_003: [ umockautoignoreargs_is_call_argument_ignored shall parse the call string as a function call: function_name(arg1, arg2, ...). ]*/
+    while (*cur_pos != '\0')
+    {
+        if ((*cur_pos == ',') && (parser_stack_index == 0))
         {
-            UMOCK_LOG("Invalid call string: %s", call);
-            result = MU_FAILURE;
+            result = cur_pos;
+            break;
         }
-        else
+        else if ((*cur_pos == '(') || (*cur_pos == '{'))
         {
-            const char* cur_pos = &call[i];
+            if (parser_stack_index == PARSER_STACK_DEPTH)
+            {
+                break;
+            }
 
-            if (cur_pos == NULL)
+            parser_stack[parser_stack_index] = (*cur_pos == '(') ? 1 : 2;
+            parser_stack_index++;
+        }
+        else if ((*cur_pos == ')') || (*cur_pos == '}'))
+        {
+            if (parser_stack_index == 0)
             {
-                /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_004: [ If umockautoignoreargs_is_call_argument_ignored fails parsing the call argument it shall fail and return a non-zero value. ]*/
-                result = MU_FAILURE;
+                /* end of the argument list */
+                break;
             }
-            else
+
+            if (parser_stack[parser_stack_index - 1] == ((*cur_pos == ')') ? 1 : 2))
             {
-                size_t argument_count = 1;
-                unsigned char argument_found = 0;
+                parser_stack_index--;
+            }
+        }
+
+        cur_pos++;
+    }
+
+    return result;
+}
+
+/* fills is_argument_ignored for the arguments first_argument ... first_argument + argument_count - 1 (1 based), walking the call string once */
+static int get_ignored_arguments(const char* call, size_t first_argument, size_t argument_count, int* is_argument_ignored)
+{
+    int result;
+    const char* cur_pos = find_argument_list(call);
+
+    if (cur_pos == NULL)
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_011: [ If a valid scope of the rightmost parenthesis set cannot be formed (imbalanced parenthesis for example), umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("Invalid call string: %s", call);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        size_t last_argument = first_argument + argument_count - 1;
+        size_t current_argument = 1;
 
-                /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_009: [ If the number of arguments parsed from call is less than argument_index, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
+        while (cur_pos != NULL)
+        {
+            /* clear out all spaces */
+            while ((*cur_pos != '\0') && isspace((unsigned char)*cur_pos))
+            {
                 cur_pos++;
+            }
 
-                while (*cur_pos != '\0')
-                {
-                    /* clear out all spaces */
-                    while ((*cur_pos != '\0') && isspace(*cur_pos))
-                    {
-                        cur_pos++;
-                    }
-
-                    if (*cur_pos != '\0')
-                    {
-                        if (*cur_pos == ')')
-                        {
-                            /* no more args and we did not get to the arg we wanted */
-                            /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_009: [ If the number of arguments parsed from call is less than argument_index, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
-                            result = MU_FAILURE;
-                            break;
-                        }
-                        else
-                        {
-                            if (argument_count == argument_index)
-                            {
-                                if (
-                                    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_007: [ If the argument value is IGNORED_ARG then is_argument_ignored shall be set to 1. ]*/
-                                    (strncmp(cur_pos, ignore_arg_string, sizeof(ignore_arg_string) - 1) == 0) ||
-                                    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_012: [ If the argument value starts with IGNORED_STRUCT_ARG then is_argument_ignored shall be set to 1. ]*/
-                                    (strncmp(cur_pos, ignore_struct_arg_string, sizeof(ignore_struct_arg_string) - 1) == 0)
-                                    )
-                                {
-                                    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_005: [ If umockautoignoreargs_is_call_argument_ignored was able to parse the argument_indexth argument it shall succeed and return 0, while writing whether the argument is ignored in the is_argument_ignored output argument. ]*/
-                                    *is_argument_ignored = 1;
-                                }
-                                else
-                                {
-                                    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_008: [ If the argument value is any other value then is_argument_ignored shall be set to 0. ]*/
-                                    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_005: [ If umockautoignoreargs_is_call_argument_ignored was able to parse the argument_indexth argument it shall succeed and return 0, while writing whether the argument is ignored in the is_argument_ignored output argument. ]*/
-                                    *is_argument_ignored = 0;
-                                }
-
-                                argument_found = 1;
-                                break;
-                            }
-                            else
-                            {
-                                unsigned char parser_stack[PARSER_STACK_DEPTH];
-                                size_t parser_stack_index = 0;
-                                int parse_error = 0;
-
-                                /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_003: [ umockautoignoreargs_is_call_argument_ignored shall parse the call string as a function call: function_name(arg1, arg2, ...). ]*/
-                                while (
-                                    (*cur_pos != '\0') &&
-                                    ((*cur_pos != ',') || (parser_stack_index > 0))
-                                    )
-                                {
-                                    if (*cur_pos == '(')
-                                    {
-                                        if (parser_stack_index == PARSER_STACK_DEPTH)
-                                        {
-                                            /* error*/
-                                            parse_error = 1;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            parser_stack[parser_stack_index] = 1;
-                                            parser_stack_index++;
-                                        }
-                                    }
-                                    if (*cur_pos == ')')
-                                    {
-                                        if (parser_stack_index == 0)
-                                        {
-                                            /* error*/
-                                            parse_error = 1;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            if (parser_stack[parser_stack_index - 1] == 1)
-                                            {
-                                                parser_stack_index--;
-                                            }
-                                        }
-                                    }
-                                    if (*cur_pos == '{')
-                                    {
-                                        if (parser_stack_index == PARSER_STACK_DEPTH)
-                                        {
-                                            /* error*/
-                                            parse_error = 1;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            parser_stack[parser_stack_index] = 2;
-                                            parser_stack_index++;
-                                        }
-                                    }
-                                    if (*cur_pos == '}')
-                                    {
-                                        if (parser_stack_index == 0)
-                                        {
-                                            /* error*/
-                                            parse_error = 1;
-                                            break;
-                                        }
-                                        else
-                                        {
-                                            if (parser_stack[parser_stack_index - 1] == 2)
-                                            {
-                                                parser_stack_index--;
-                                            }
-                                        }
-                                    }
-
-                                    cur_pos++;
-                                }
-
-                                if (
-                                    (*cur_pos == '\0') ||
-                                    parse_error
-                                    )
-                                {
-                                    break;
-                                }
-                                else
-                                {
-                                    argument_count++;
-                                    cur_pos++;
-                                }
-                            }
-                        }
-                    }
-                }
+            if ((*cur_pos == '\0') || (*cur_pos == ')'))
+            {
+                /* no more args and we did not get to the args we wanted */
+                break;
+            }
 
-                if (argument_found)
-                {
-                    result = 0;
-                }
-                else
-                {
-                    result = MU_FAILURE;
-                }
+            if (current_argument >= first_argument)
+            {
+                /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_008: [ If the argument value is any other value then is_argument_ignored shall be set to 0. ]*/
+                is_argument_ignored[current_argument - first_argument] = is_ignored_argument_value(cur_pos) ? 1 : 0;
+            }
+
+            if (current_argument == last_argument)
+            {
+                break;
+            }
+
+            cur_pos = skip_argument(cur_pos);
+            if (cur_pos != NULL)
+            {
+                cur_pos++;
+                current_argument++;
             }
         }
+
+        if ((cur_pos == NULL) || (current_argument != last_argument) || (*cur_pos == '\0') || (*cur_pos == ')'))
+        {
+            /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_004: [ If umockautoignoreargs_is_call_argument_ignored fails parsing the call argument it shall fail and return a non-zero value. ]*/
+            /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_009: [ If the number of arguments parsed from call is less than argument_index, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/* Codes_SRS_UMOCKAUTOIGNOREARGS_01_001: [ umockautoignoreargs_is_call_argument_ignored shall determine whether argument argument_index shall be ignored or not. ]*/
+int umockautoignoreargs_is_call_argument_ignored(const char* call, size_t argument_index, int* is_argument_ignored)
+{
+    int result;
+
+    if (
+        (call == NULL) ||
+        (is_argument_ignored == NULL)
+        )
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_002: [ If call or is_argument_ignored is NULL, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
+        result = MU_FAILURE;
+    }
+    else if (argument_index == 0)
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_009: [ If the number of arguments parsed from call is less than argument_index, umockautoignoreargs_is_call_argument_ignored shall fail and return a non-zero value. ]*/
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_005: [ If umockautoignoreargs_is_call_argument_ignored was able to parse the argument_indexth argument it shall succeed and return 0, while writing whether the argument is ignored in the is_argument_ignored output argument. ]*/
+        result = get_ignored_arguments(call, argument_index, 1, is_argument_ignored);
+    }
+
+    return result;
+}
+
+/* Codes_SRS_UMOCKAUTOIGNOREARGS_01_013: [ umockautoignoreargs_get_ignored_mask shall determine for each of the first argument_count arguments of call whether it shall be ignored, parsing call only once. ]*/
+int umockautoignoreargs_get_ignored_mask(const char* call, size_t argument_count, int* is_argument_ignored)
+{
+    int result;
+
+    if (
+        (call == NULL) ||
+        (argument_count == 0) ||
+        (is_argument_ignored == NULL)
+        )
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_014: [ If call or is_argument_ignored is NULL or argument_count is 0, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockautoignoreargs_get_ignored_mask: Invalid arguments call=%p, argument_count=%zu, is_argument_ignored=%p.", (const void*)call, argument_count, (void*)is_argument_ignored);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_016: [ umockautoignoreargs_get_ignored_mask shall parse call with the same rules as umockautoignoreargs_is_call_argument_ignored. ]*/
+    else if (get_ignored_arguments(call, 1, argument_count, is_argument_ignored) != 0)
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_017: [ If parsing call fails or call has less than argument_count arguments, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKAUTOIGNOREARGS_01_015: [ On success, umockautoignoreargs_get_ignored_mask shall set is_argument_ignored[i] to 1 if argument i + 1 is ignored (as for umockautoignoreargs_is_call_argument_ignored) and to 0 otherwise, and return 0. ]*/
+        result = 0;
     }
 
     return result;
@@ -2,28 +2,43 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "macro_utils/macro_utils.h" 
 
 #include "umock_c/umockcall.h"
 #include "umock_c/umockalloc.h"
+#include "umock_c/umockstringbuilder.h"
 #include "umock_c/umock_log.h"
 
 typedef struct UMOCKCALL_TAG
 {
-    char* function_name;
+    const char* function_name;
     void* umockcall_data;
     UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy;
     UMOCKCALL_DATA_FREE_FUNC umockcall_data_free;
     UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify;
     UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal;
+    /* optional, describes why an actual call does not match the call when it is an expected call */
+    UMOCKCALL_DATA_STRINGIFY_MISMATCH_FUNC umockcall_data_stringify_mismatch;
     unsigned int fail_call : 1;
     unsigned int ignore_all_calls : 1;
     unsigned int call_can_fail : 1;
+    /* set when the call, used as an expected call, hands values back to the actual call that matches it */
+    unsigned int has_call_results : 1;
+    /* set when function_name is a static string that is referenced instead of being owned by the call */
+    unsigned int has_static_function_name : 1;
+    /* set for calls made by umockcall_clone, which are never allocated from the call arena and thus can be shared */
+    unsigned int is_clone : 1;
+    /* number of actual calls that have to (min) and can (max) match the call when it is an expected call */
+    size_t min_repeat_count;
+    size_t max_repeat_count;
+    /* number of owners of the call, each of them releases its reference with umockcall_destroy */
+    size_t ref_count;
 } UMOCKCALL;
 
-UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal)
+static UMOCKCALL_HANDLE internal_create(const char* function_name, int has_static_function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal)
 {
     UMOCKCALL* result;
 
@@ -35,6 +50,7 @@ UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_dat
         (umockcall_data_are_equal == NULL))
     {
         /* Codes_SRS_UMOCKCALL_01_003: [ If any of the arguments are NULL, umockcall_create shall fail and return NULL. ] */
+        /* Codes_SRS_UMOCKCALL_01_058: [ If any of the arguments are NULL, umockcall_create_with_static_function_name shall fail and return NULL. ] */
         UMOCK_LOG("umockcall: Cannot create call, invalid arguments: function_name = %p, umockcall_data = %p, umockcall_data_free = %p, umockcall_data_stringify = %p, umockcall_data_are_equal = %p.",
             function_name, umockcall_data, umockcall_data_free, umockcall_data_stringify, umockcall_data_are_equal);
         result = NULL;
@@ -42,29 +58,54 @@ UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_dat
     else
     {
         /* Codes_SRS_UMOCKCALL_01_001: [ umockcall_create shall create a new instance of a umock call and on success it shall return a non-NULL handle to it. ] */
-        result = (UMOCKCALL*)umockalloc_malloc(sizeof(UMOCKCALL));
+        /* Codes_SRS_UMOCKCALL_01_056: [ The memory for the umock call instance and its function name shall be allocated by calling umockalloc_call_malloc, so that it comes from the call arena when one is in use. ] */
+        result = (UMOCKCALL*)umockalloc_call_malloc(sizeof(UMOCKCALL));
         /* Codes_SRS_UMOCKCALL_01_002: [ If allocating memory for the umock call instance fails, umockcall_create shall return NULL. ] */
+        /* Codes_SRS_UMOCKCALL_01_059: [ If allocating memory for the umock call instance fails, umockcall_create_with_static_function_name shall return NULL. ] */
         if (result != NULL)
         {
-            size_t function_name_length = strlen(function_name);
-            result->function_name = (char*)umockalloc_malloc(function_name_length + 1);
-            if (result->function_name == NULL)
+            if (has_static_function_name)
             {
-                /* Codes_SRS_UMOCKCALL_01_002: [ If allocating memory for the umock call instance fails, umockcall_create shall return NULL. ] */
-                UMOCK_LOG("umockcall: Cannot allocate memory for the call function name.");
-                umockalloc_free(result);
-                result = NULL;
+                /* Codes_SRS_UMOCKCALL_01_057: [ umockcall_create_with_static_function_name shall create a new umock call instance like umockcall_create, but it shall keep a reference to function_name instead of copying it. ] */
+                result->function_name = function_name;
             }
             else
             {
-                (void)memcpy(result->function_name, function_name, function_name_length + 1);
+                size_t function_name_length = strlen(function_name);
+                char* function_name_copy = (char*)umockalloc_call_malloc(function_name_length + 1);
+                if (function_name_copy == NULL)
+                {
+                    /* Codes_SRS_UMOCKCALL_01_002: [ If allocating memory for the umock call instance fails, umockcall_create shall return NULL. ] */
+                    UMOCK_LOG("umockcall: Cannot allocate memory for the call function name.");
+                    umockalloc_free(result);
+                    result = NULL;
+                }
+                else
+                {
+                    (void)memcpy(function_name_copy, function_name, function_name_length + 1);
+                    result->function_name = function_name_copy;
+                }
+            }
+
+            if (result != NULL)
+            {
+                result->has_static_function_name = (has_static_function_name != 0) ? 1 : 0;
                 result->umockcall_data = umockcall_data;
                 result->umockcall_data_copy = umockcall_data_copy;
                 result->umockcall_data_free = umockcall_data_free;
                 result->umockcall_data_stringify = umockcall_data_stringify;
                 result->umockcall_data_are_equal = umockcall_data_are_equal;
+                /* Codes_SRS_UMOCKCALL_01_095: [ umockcall_create and umockcall_create_with_static_function_name shall create the call without a stringify mismatch function. ]*/
+                result->umockcall_data_stringify_mismatch = NULL;
                 result->fail_call = 0;
                 result->ignore_all_calls = 0;
+                /* Codes_SRS_UMOCKCALL_01_093: [ umockcall_create and umockcall_create_with_static_function_name shall set has_call_results to 0. ]*/
+                result->has_call_results = 0;
+                result->is_clone = 0;
+                /* Codes_SRS_UMOCKCALL_01_077: [ umockcall_create and umockcall_create_with_static_function_name shall set the minimum and maximum repeat counts of the call to 1. ]*/
+                result->min_repeat_count = 1;
+                result->max_repeat_count = 1;
+                result->ref_count = 1;
             }
         }
     }
@@ -72,18 +113,51 @@ UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_dat
     return result;
 }
 
+UMOCKCALL_HANDLE umockcall_create(const char* function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal)
+{
+    return internal_create(function_name, 0, umockcall_data, umockcall_data_copy, umockcall_data_free, umockcall_data_stringify, umockcall_data_are_equal);
+}
+
+UMOCKCALL_HANDLE umockcall_create_with_static_function_name(const char* function_name, void* umockcall_data, UMOCKCALL_DATA_COPY_FUNC umockcall_data_copy, UMOCKCALL_DATA_FREE_FUNC umockcall_data_free, UMOCKCALL_DATA_STRINGIFY_FUNC umockcall_data_stringify, UMOCKCALL_DATA_ARE_EQUAL_FUNC umockcall_data_are_equal)
+{
+    return internal_create(function_name, 1, umockcall_data, umockcall_data_copy, umockcall_data_free, umockcall_data_stringify, umockcall_data_are_equal);
+}
+
 void umockcall_destroy(UMOCKCALL_HANDLE umockcall)
 {
     /* Codes_SRS_UMOCKCALL_01_005: [ If the umockcall argument is NULL then umockcall_destroy shall do nothing. ]*/
-    if (umockcall != NULL)
+    /* Codes_SRS_UMOCKCALL_01_074: [ umockcall_destroy shall release one reference to the call and shall free the call only when the last reference is released. ]*/
+    if ((umockcall != NULL) &&
+        (--umockcall->ref_count == 0))
     {
         /* Codes_SRS_UMOCKCALL_01_004: [ umockcall_destroy shall free a previously allocated umock call instance. ] */
         umockcall->umockcall_data_free(umockcall->umockcall_data);
-        umockalloc_free(umockcall->function_name);
+        if (!umockcall->has_static_function_name)
+        {
+            /* Codes_SRS_UMOCKCALL_01_060: [ umockcall_destroy shall not free the function name of a call created with umockcall_create_with_static_function_name. ]*/
+            umockalloc_free((void*)umockcall->function_name);
+        }
         umockalloc_free(umockcall);
     }
 }
 
+static int are_function_names_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right)
+{
+    int result;
+
+    if (left->has_static_function_name && right->has_static_function_name)
+    {
+        /* Codes_SRS_UMOCKCALL_01_061: [ If both calls were created with umockcall_create_with_static_function_name, the function names shall be compared by comparing their pointers. ]*/
+        result = (left->function_name == right->function_name) ? 1 : 0;
+    }
+    else
+    {
+        result = (strcmp(left->function_name, right->function_name) == 0) ? 1 : 0;
+    }
+
+    return result;
+}
+
 /* Codes_SRS_UMOCKCALL_01_006: [ umockcall_are_equal shall compare the two mock calls and return whether they are equal or not. ] */
 int umockcall_are_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right)
 {
@@ -106,7 +180,7 @@ int umockcall_are_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right)
             /* Codes_SRS_UMOCKCALL_01_014: [ If the two calls have different are_equal functions that have been passed to umockcall_create then the calls shall be considered different and 0 shall be returned. ] */
             result = 0;
         }
-        else if (strcmp(left->function_name, right->function_name) != 0)
+        else if (!are_function_names_equal(left, right))
         {
             /* Codes_SRS_UMOCKCALL_01_025: [ If the function name does not match for the 2 calls, umockcall_are_equal shall return 0. ]*/
             result = 0;
@@ -147,36 +221,79 @@ char* umockcall_stringify(UMOCKCALL_HANDLE umockcall)
         result = NULL;
     }
     else
+    {
+        UMOCKSTRINGBUILDER string_builder;
+        umockstringbuilder_init(&string_builder);
+
+        /* Codes_SRS_UMOCKCALL_01_063: [ umockcall_stringify shall build the string by calling umockcall_stringify_append with an empty string builder. ]*/
+        if (umockcall_stringify_append(umockcall, &string_builder) != 0)
+        {
+            /* Codes_SRS_UMOCKCALL_01_020: [ If the underlying umockcall_data_stringify call fails, umockcall_stringify shall fail and return NULL. ]*/
+            /* Codes_SRS_UMOCKCALL_01_021: [ If not enough memory can be allocated for the string to be returned, umockcall_stringify shall fail and return NULL. ]*/
+            UMOCK_LOG("umockcall: stringify append failed.");
+            umockstringbuilder_deinit(&string_builder);
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKCALL_01_016: [ umockcall_stringify shall return a string representation of the mock call in the form "[function_name(arguments)]". ] */
+            /* Codes_SRS_UMOCKCALL_01_018: [ The returned string shall be a newly allocated string and it is to be freed by the caller. ]*/
+            result = umockstringbuilder_detach(&string_builder);
+        }
+    }
+
+    return result;
+}
+
+int umockcall_stringify_append(UMOCKCALL_HANDLE umockcall, UMOCKSTRINGBUILDER* string_builder)
+{
+    int result;
+
+    if ((umockcall == NULL) ||
+        (string_builder == NULL))
+    {
+        /* Codes_SRS_UMOCKCALL_01_065: [ If umockcall or string_builder is NULL, umockcall_stringify_append shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcall: Invalid arguments in stringify append: umockcall = %p, string_builder = %p.", (void*)umockcall, (void*)string_builder);
+        result = MU_FAILURE;
+    }
+    else
     {
         /* Codes_SRS_UMOCKCALL_01_019: [ To obtain the arguments string, umockcall_stringify shall call the umockcall_data_stringify function passed to umockcall_create and pass to it the umockcall_data pointer (also given in umockcall_create). ]*/
         char* stringified_args = umockcall->umockcall_data_stringify(umockcall->umockcall_data);
         if (stringified_args == NULL)
         {
-            /* Codes_SRS_UMOCKCALL_01_020: [ If the underlying umockcall_data_stringify call fails, umockcall_stringify shall fail and return NULL. ]*/
+            /* Codes_SRS_UMOCKCALL_01_066: [ If the underlying umockcall_data_stringify call fails, umockcall_stringify_append shall fail and return a non-zero value. ]*/
             UMOCK_LOG("umockcall: umockcall data stringify failed.");
-            result = NULL;
+            result = MU_FAILURE;
         }
         else
         {
-            /* Codes_SRS_UMOCKCALL_01_016: [ umockcall_stringify shall return a string representation of the mock call in the form "[function_name(arguments)]". ] */
+            size_t original_length = string_builder->length;
             size_t function_name_length = strlen(umockcall->function_name);
             size_t stringified_args_length = strlen(stringified_args);
 
+            /* Codes_SRS_UMOCKCALL_01_064: [ umockcall_stringify_append shall append the string representation of the mock call in the form "[function_name(arguments)]" to string_builder and on success return 0. ]*/
             /* 4 because () and [] */
-            size_t call_length = function_name_length + stringified_args_length + 4;
-
-            /* Codes_SRS_UMOCKCALL_01_018: [ The returned string shall be a newly allocated string and it is to be freed by the caller. ]*/
-            result = (char*)umockalloc_malloc(call_length + 1);
-            /* Codes_SRS_UMOCKCALL_01_021: [ If not enough memory can be allocated for the string to be returned, umockcall_stringify shall fail and return NULL. ]*/
-            if (result != NULL)
+            if ((function_name_length > SIZE_MAX - stringified_args_length - 4) ||
+                (umockstringbuilder_reserve(string_builder, function_name_length + stringified_args_length + 4) != 0) ||
+                (umockstringbuilder_append_char(string_builder, '[') != 0) ||
+                (umockstringbuilder_append(string_builder, umockcall->function_name, function_name_length) != 0) ||
+                (umockstringbuilder_append_char(string_builder, '(') != 0) ||
+                (umockstringbuilder_append(string_builder, stringified_args, stringified_args_length) != 0) ||
+                (umockstringbuilder_append(string_builder, ")]", 2) != 0))
             {
-                result[0] = '[';
-                (void)memcpy(&result[1], umockcall->function_name, function_name_length);
-                result[function_name_length + 1] = '(';
-                (void)memcpy(&result[function_name_length + 2], stringified_args, stringified_args_length);
-                result[function_name_length + stringified_args_length + 2] = ')';
-                result[function_name_length + stringified_args_length + 3] = ']';
-                result[function_name_length + stringified_args_length + 4] = '\0';
+                /* Codes_SRS_UMOCKCALL_01_067: [ If appending to string_builder fails, umockcall_stringify_append shall fail, leave the string in string_builder unchanged and return a non-zero value. ]*/
+                UMOCK_LOG("umockcall: Cannot append stringified call.");
+                string_builder->length = original_length;
+                if (string_builder->buffer != NULL)
+                {
+                    string_builder->buffer[original_length] = '\0';
+                }
+                result = MU_FAILURE;
+            }
+            else
+            {
+                result = 0;
             }
 
             /* Codes_SRS_UMOCKCALL_01_030: [ umockcall_stringify shall free the string obtained from umockcall_data_stringify. ]*/
@@ -187,6 +304,33 @@ char* umockcall_stringify(UMOCKCALL_HANDLE umockcall)
     return result;
 }
 
+char* umockcall_stringify_mismatch(UMOCKCALL_HANDLE expected_umockcall, UMOCKCALL_HANDLE actual_umockcall)
+{
+    char* result;
+
+    if ((expected_umockcall == NULL) ||
+        (actual_umockcall == NULL))
+    {
+        /* Codes_SRS_UMOCKCALL_01_100: [ If expected_umockcall or actual_umockcall is NULL, umockcall_stringify_mismatch shall return NULL. ]*/
+        UMOCK_LOG("umockcall: Invalid arguments in stringify mismatch: expected_umockcall = %p, actual_umockcall = %p.", (void*)expected_umockcall, (void*)actual_umockcall);
+        result = NULL;
+    }
+    else if ((expected_umockcall->umockcall_data_stringify_mismatch == NULL) ||
+        (expected_umockcall->umockcall_data_are_equal != actual_umockcall->umockcall_data_are_equal) ||
+        !are_function_names_equal(expected_umockcall, actual_umockcall))
+    {
+        /* Codes_SRS_UMOCKCALL_01_101: [ If expected_umockcall has no stringify mismatch function, or the 2 calls have different are_equal functions or function names, umockcall_stringify_mismatch shall return NULL. ]*/
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_099: [ umockcall_stringify_mismatch shall call the stringify mismatch function of expected_umockcall, passing to it the call data of expected_umockcall and actual_umockcall, and return its result. ]*/
+        result = expected_umockcall->umockcall_data_stringify_mismatch(expected_umockcall->umockcall_data, actual_umockcall->umockcall_data);
+    }
+
+    return result;
+}
+
 void* umockcall_get_call_data(UMOCKCALL_HANDLE umockcall)
 {
     void* umockcall_data;
@@ -219,6 +363,7 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
     }
     else
     {
+        /* Codes_SRS_UMOCK_C_LIB_01_229: [ Copies of calls (for example the ones made by the negative tests snapshot) shall not be allocated from the arena. ]*/
         result = (UMOCKCALL*)umockalloc_malloc(sizeof(UMOCKCALL));
         if (result == NULL)
         {
@@ -227,19 +372,33 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
         }
         else
         {
-            size_t function_name_length = strlen(umockcall->function_name);
-            result->function_name = (char*)umockalloc_malloc(function_name_length + 1);
-            if (result->function_name == NULL)
+            if (umockcall->has_static_function_name)
             {
-                /* Codes_SRS_UMOCKCALL_01_036: [ If allocating memory for the function name fails, umockcall_clone shall return NULL. ]*/
-                UMOCK_LOG("umockcall_clone: Failed allocating memory for new copied call function name.");
-                umockalloc_free(result);
-                result = NULL;
+                /* Codes_SRS_UMOCKCALL_01_062: [ If umockcall was created with umockcall_create_with_static_function_name, umockcall_clone shall reference the same function name instead of copying it. ]*/
+                result->function_name = umockcall->function_name;
             }
             else
             {
-                /* Codes_SRS_UMOCKCALL_01_035: [ umockcall_clone shall copy also the function name. ]*/
-                (void)memcpy(result->function_name, umockcall->function_name, function_name_length + 1);
+                size_t function_name_length = strlen(umockcall->function_name);
+                char* function_name_copy = (char*)umockalloc_malloc(function_name_length + 1);
+                if (function_name_copy == NULL)
+                {
+                    /* Codes_SRS_UMOCKCALL_01_036: [ If allocating memory for the function name fails, umockcall_clone shall return NULL. ]*/
+                    UMOCK_LOG("umockcall_clone: Failed allocating memory for new copied call function name.");
+                    umockalloc_free(result);
+                    result = NULL;
+                }
+                else
+                {
+                    /* Codes_SRS_UMOCKCALL_01_035: [ umockcall_clone shall copy also the function name. ]*/
+                    (void)memcpy(function_name_copy, umockcall->function_name, function_name_length + 1);
+                    result->function_name = function_name_copy;
+                }
+            }
+
+            if (result != NULL)
+            {
+                result->has_static_function_name = umockcall->has_static_function_name;
 
                 /* Codes_SRS_UMOCKCALL_01_033: [ The call data shall be cloned by calling the umockcall_data_copy function passed in umockcall_create and passing as argument the umockcall_data value passed in umockcall_create. ]*/
                 result->umockcall_data = umockcall->umockcall_data_copy(umockcall->umockcall_data);
@@ -247,7 +406,10 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
                 {
                     /* Codes_SRS_UMOCKCALL_01_034: [ If umockcall_data_copy fails then umockcall_clone shall return NULL. ]*/
                     UMOCK_LOG("umockcall_clone: Failed copying call data.");
-                    umockalloc_free(result->function_name);
+                    if (!result->has_static_function_name)
+                    {
+                        umockalloc_free((void*)result->function_name);
+                    }
                     umockalloc_free(result);
                     result = NULL;
                 }
@@ -258,9 +420,18 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
                     result->umockcall_data_copy = umockcall->umockcall_data_copy;
                     result->umockcall_data_free = umockcall->umockcall_data_free;
                     result->umockcall_data_stringify = umockcall->umockcall_data_stringify;
+                    /* Codes_SRS_UMOCKCALL_01_098: [ umockcall_clone shall also copy the stringify mismatch function. ]*/
+                    result->umockcall_data_stringify_mismatch = umockcall->umockcall_data_stringify_mismatch;
                     result->ignore_all_calls = umockcall->ignore_all_calls;
                     result->call_can_fail = umockcall->call_can_fail;
+                    /* Codes_SRS_UMOCKCALL_01_094: [ umockcall_clone shall also copy has_call_results. ]*/
+                    result->has_call_results = umockcall->has_call_results;
                     result->fail_call = umockcall->fail_call;
+                    /* Codes_SRS_UMOCKCALL_01_084: [ umockcall_clone shall also copy the minimum and maximum repeat counts. ]*/
+                    result->min_repeat_count = umockcall->min_repeat_count;
+                    result->max_repeat_count = umockcall->max_repeat_count;
+                    result->is_clone = 1;
+                    result->ref_count = 1;
                 }
             }
         }
@@ -269,6 +440,56 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
     return result;
 }
 
+UMOCKCALL_HANDLE umockcall_share(UMOCKCALL_HANDLE umockcall)
+{
+    UMOCKCALL_HANDLE result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_071: [ If umockcall is NULL, umockcall_share shall fail and return NULL. ]*/
+        UMOCK_LOG("umockcall_share: NULL umockcall.");
+        result = NULL;
+    }
+    else if (umockcall->is_clone)
+    {
+        /* Codes_SRS_UMOCKCALL_01_068: [ umockcall_share shall return a handle to a call equal to umockcall, owned by the caller and released by calling umockcall_destroy. ]*/
+        /* Codes_SRS_UMOCKCALL_01_069: [ If umockcall was created by umockcall_clone, umockcall_share shall add a reference to it and return umockcall. ]*/
+        umockcall->ref_count++;
+        result = umockcall;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_070: [ Otherwise umockcall_share shall return a copy of the call obtained by calling umockcall_clone. ]*/
+        result = umockcall_clone(umockcall);
+        if (result == NULL)
+        {
+            /* Codes_SRS_UMOCKCALL_01_072: [ If umockcall_clone fails, umockcall_share shall fail and return NULL. ]*/
+            UMOCK_LOG("umockcall_share: Cannot clone call.");
+        }
+    }
+
+    return result;
+}
+
+int umockcall_is_shared(UMOCKCALL_HANDLE umockcall)
+{
+    int result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_076: [ If umockcall is NULL, umockcall_is_shared shall return -1. ]*/
+        UMOCK_LOG("umockcall_is_shared: NULL umockcall.");
+        result = -1;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_075: [ umockcall_is_shared shall return 1 if umockcall has more than one owner and 0 otherwise. ]*/
+        result = (umockcall->ref_count > 1) ? 1 : 0;
+    }
+
+    return result;
+}
+
 int umockcall_set_fail_call(UMOCKCALL_HANDLE umockcall, int fail_call)
 {
     int result;
@@ -435,4 +656,160 @@ int umockcall_get_call_can_fail(UMOCKCALL_HANDLE umockcall)
     return result;
 }
 
+int umockcall_set_has_call_results(UMOCKCALL_HANDLE umockcall, int has_call_results)
+{
+    int result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_089: [ If umockcall is NULL, umockcall_set_has_call_results shall return -1. ]*/
+        UMOCK_LOG("umockcall_set_has_call_results: NULL umockcall.");
+        result = -1;
+    }
+    else
+    {
+        switch (has_call_results)
+        {
+        default:
+            /* Codes_SRS_UMOCKCALL_01_090: [ If a value different than 0 and 1 is passed as has_call_results, umockcall_set_has_call_results shall return -1. ]*/
+            UMOCK_LOG("umockcall_set_has_call_results: Invalid has_call_results value: %d.", has_call_results);
+            result = -1;
+            break;
+        case 0:
+            /* Codes_SRS_UMOCKCALL_01_088: [ umockcall_set_has_call_results shall store the has_call_results value, associating it with the umockcall call instance, and on success return 0. ]*/
+            umockcall->has_call_results = 0;
+            result = 0;
+            break;
+        case 1:
+            /* Codes_SRS_UMOCKCALL_01_088: [ umockcall_set_has_call_results shall store the has_call_results value, associating it with the umockcall call instance, and on success return 0. ]*/
+            umockcall->has_call_results = 1;
+            result = 0;
+            break;
+        }
+    }
+
+    return result;
+}
+
+int umockcall_get_has_call_results(UMOCKCALL_HANDLE umockcall)
+{
+    int result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_092: [ If umockcall is NULL, umockcall_get_has_call_results shall return -1. ]*/
+        UMOCK_LOG("umockcall_get_has_call_results: NULL umockcall.");
+        result = -1;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_091: [ umockcall_get_has_call_results shall retrieve the has_call_results value, associated with the umockcall call instance. ]*/
+        result = umockcall->has_call_results ? 1 : 0;
+    }
+
+    return result;
+}
+
+int umockcall_set_stringify_mismatch(UMOCKCALL_HANDLE umockcall, UMOCKCALL_DATA_STRINGIFY_MISMATCH_FUNC umockcall_data_stringify_mismatch)
+{
+    int result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_097: [ If umockcall is NULL, umockcall_set_stringify_mismatch shall return -1. ]*/
+        UMOCK_LOG("umockcall_set_stringify_mismatch: NULL umockcall.");
+        result = -1;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_096: [ umockcall_set_stringify_mismatch shall store umockcall_data_stringify_mismatch, associating it with the umockcall call instance, and on success return 0. ]*/
+        umockcall->umockcall_data_stringify_mismatch = umockcall_data_stringify_mismatch;
+        result = 0;
+    }
+
+    return result;
+}
+
+int umockcall_set_repeat_count(UMOCKCALL_HANDLE umockcall, size_t min_repeat_count, size_t max_repeat_count)
+{
+    int result;
+
+    if (umockcall == NULL)
+    {
+        /* Codes_SRS_UMOCKCALL_01_080: [ If umockcall is NULL, umockcall_set_repeat_count shall return a non-zero value. ]*/
+        UMOCK_LOG("umockcall_set_repeat_count: NULL umockcall.");
+        result = MU_FAILURE;
+    }
+    else if ((max_repeat_count == 0) ||
+        (min_repeat_count > max_repeat_count))
+    {
+        /* Codes_SRS_UMOCKCALL_01_081: [ If max_repeat_count is 0 or min_repeat_count is greater than max_repeat_count, umockcall_set_repeat_count shall return a non-zero value. ]*/
+        UMOCK_LOG("umockcall_set_repeat_count: Invalid repeat count: min_repeat_count = %zu, max_repeat_count = %zu.", min_repeat_count, max_repeat_count);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_078: [ umockcall_set_repeat_count shall store the min_repeat_count and max_repeat_count values, associating them with the umockcall call instance. ]*/
+        umockcall->min_repeat_count = min_repeat_count;
+        umockcall->max_repeat_count = max_repeat_count;
+
+        /* Codes_SRS_UMOCKCALL_01_079: [ On success umockcall_set_repeat_count shall return 0. ]*/
+        result = 0;
+    }
+
+    return result;
+}
 
+int umockcall_get_repeat_count(UMOCKCALL_HANDLE umockcall, size_t* min_repeat_count, size_t* max_repeat_count)
+{
+    int result;
+
+    if ((umockcall == NULL) ||
+        (min_repeat_count == NULL) ||
+        (max_repeat_count == NULL))
+    {
+        /* Codes_SRS_UMOCKCALL_01_083: [ If any of the arguments is NULL, umockcall_get_repeat_count shall return a non-zero value. ]*/
+        UMOCK_LOG("umockcall_get_repeat_count: Invalid arguments: umockcall = %p, min_repeat_count = %p, max_repeat_count = %p.", (void*)umockcall, (void*)min_repeat_count, (void*)max_repeat_count);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_082: [ umockcall_get_repeat_count shall retrieve the min_repeat_count and max_repeat_count values associated with the umockcall call instance and on success return 0. ]*/
+        *min_repeat_count = umockcall->min_repeat_count;
+        *max_repeat_count = umockcall->max_repeat_count;
+        result = 0;
+    }
+
+    return result;
+}
+
+int umockcall_get_function_name_hash(UMOCKCALL_HANDLE umockcall, size_t* function_name_hash)
+{
+    int result;
+
+    if ((umockcall == NULL) ||
+        (function_name_hash == NULL))
+    {
+        /* Codes_SRS_UMOCKCALL_01_087: [ If any of the arguments is NULL, umockcall_get_function_name_hash shall return a non-zero value. ]*/
+        UMOCK_LOG("umockcall_get_function_name_hash: Invalid arguments: umockcall = %p, function_name_hash = %p.", (void*)umockcall, (void*)function_name_hash);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALL_01_085: [ umockcall_get_function_name_hash shall compute the FNV-1a hash of the function name of umockcall, store it in function_name_hash and on success return 0. ]*/
+        /* Codes_SRS_UMOCKCALL_01_086: [ Calls with equal function names shall have equal hashes. ]*/
+        const char* function_name = umockcall->function_name;
+        size_t hash = (size_t)2166136261U;
+        while (*function_name != '\0')
+        {
+            hash ^= (unsigned char)*function_name;
+            hash *= (size_t)16777619U;
+            function_name++;
+        }
+
+        *function_name_hash = hash;
+        result = 0;
+    }
+
+    return result;
+}
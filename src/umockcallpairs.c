@@ -3,6 +3,7 @@
 
 #include <string.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "macro_utils/macro_utils.h" 
 
@@ -10,10 +11,201 @@
 #include "umock_c/umockalloc.h"
 #include "umock_c/umock_log.h"
 #include "umock_c/umocktypes.h"
+#include "umock_c/umocktypes_c.h"
+
+/* number of entries allocated the first time the paired handles array is grown */
+#define INITIAL_PAIRED_HANDLES_CAPACITY 4
+
+static void free_paired_handles_if_empty(PAIRED_HANDLES* paired_handles)
+{
+    if (paired_handles->paired_handle_count == 0)
+    {
+        umockalloc_free(paired_handles->paired_handles);
+        paired_handles->paired_handles = NULL;
+        paired_handles->paired_handle_capacity = 0;
+    }
+}
+
+/* number of slots allocated the first time the pointer handles hash set is grown (must be a power of 2) */
+#define INITIAL_POINTER_HANDLES_CAPACITY 16
+
+static int is_pointer_handle_type(const char* handle_type, size_t handle_type_size)
+{
+    /* the void* handlers compare and copy the pointer bits and free nothing, which the hash set can do inline */
+    const UMOCKTYPE_HANDLERS* handlers = umocktypes_get_handlers(handle_type);
+    return (handle_type_size == sizeof(void*)) &&
+        (handlers != NULL) &&
+        (handlers->are_equal_func == (UMOCKTYPE_ARE_EQUAL_FUNC)umocktypes_are_equal_void_ptr) &&
+        (handlers->copy_func == (UMOCKTYPE_COPY_FUNC)umocktypes_copy_void_ptr) &&
+        (handlers->free_func == (UMOCKTYPE_FREE_FUNC)umocktypes_free_void_ptr);
+}
+
+static size_t get_pointer_handle_hash(const void* handle_value)
+{
+    /* mix the upper bits into the lower ones, handles often differ only in their middle bits */
+    uintptr_t hash = (uintptr_t)handle_value;
+#if UINTPTR_MAX > 0xFFFFFFFF
+    hash ^= hash >> 32;
+#endif
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return (size_t)hash;
+}
+
+/* returns the slot holding handle_value or the empty slot where handle_value would be inserted */
+static size_t find_pointer_handle_slot(const POINTER_PAIRED_HANDLE* pointer_handles, size_t capacity, const void* handle_value)
+{
+    size_t slot = get_pointer_handle_hash(handle_value) & (capacity - 1);
+
+    while ((pointer_handles[slot].count > 0) &&
+        (pointer_handles[slot].handle_value != handle_value))
+    {
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    return slot;
+}
+
+static int grow_pointer_handles(PAIRED_HANDLES* paired_handles)
+{
+    int result;
+    size_t new_capacity = (paired_handles->pointer_handle_capacity == 0) ? INITIAL_POINTER_HANDLES_CAPACITY : paired_handles->pointer_handle_capacity * 2;
+
+    if (new_capacity <= paired_handles->pointer_handle_capacity)
+    {
+        UMOCK_LOG("umockcallpairs: pointer handles capacity overflow");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        POINTER_PAIRED_HANDLE* new_pointer_handles = (POINTER_PAIRED_HANDLE*)umockalloc_calloc(new_capacity, sizeof(POINTER_PAIRED_HANDLE));
+        if (new_pointer_handles == NULL)
+        {
+            UMOCK_LOG("umockcallpairs: Cannot allocate %zu pointer handle slots", new_capacity);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            size_t i;
+
+            for (i = 0; i < paired_handles->pointer_handle_capacity; i++)
+            {
+                if (paired_handles->pointer_handles[i].count > 0)
+                {
+                    new_pointer_handles[find_pointer_handle_slot(new_pointer_handles, new_capacity, paired_handles->pointer_handles[i].handle_value)] = paired_handles->pointer_handles[i];
+                }
+            }
+
+            umockalloc_free(paired_handles->pointer_handles);
+            paired_handles->pointer_handles = new_pointer_handles;
+            paired_handles->pointer_handle_capacity = new_capacity;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static int track_create_pointer_handle(PAIRED_HANDLES* paired_handles, const void* handle)
+{
+    int result;
+    void* handle_value;
+    size_t slot = 0;
+
+    (void)memcpy(&handle_value, handle, sizeof(handle_value));
+    if (paired_handles->pointer_handle_capacity > 0)
+    {
+        slot = find_pointer_handle_slot(paired_handles->pointer_handles, paired_handles->pointer_handle_capacity, handle_value);
+    }
+
+    if ((paired_handles->pointer_handle_capacity > 0) &&
+        (paired_handles->pointer_handles[slot].count > 0))
+    {
+        /* Codes_SRS_UMOCKCALLPAIRS_01_018: [ If the same pointer handle value is already tracked, umockcallpairs_track_create_paired_call shall increment the count kept for it. ]*/
+        paired_handles->pointer_handles[slot].count++;
+        result = 0;
+    }
+    /* Codes_SRS_UMOCKCALLPAIRS_01_019: [ The hash set shall be grown to double its capacity whenever adding a new handle value would make more than half of its slots used. ]*/
+    else if (((paired_handles->pointer_handle_used_slot_count + 1) * 2 > paired_handles->pointer_handle_capacity) &&
+        (grow_pointer_handles(paired_handles) != 0))
+    {
+        /* Codes_SRS_UMOCKCALLPAIRS_01_020: [ If growing the hash set fails, umockcallpairs_track_create_paired_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: Cannot grow the pointer handles hash set");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        slot = find_pointer_handle_slot(paired_handles->pointer_handles, paired_handles->pointer_handle_capacity, handle_value);
+        paired_handles->pointer_handles[slot].handle_value = handle_value;
+        paired_handles->pointer_handles[slot].count = 1;
+        paired_handles->pointer_handle_used_slot_count++;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int track_destroy_pointer_handle(PAIRED_HANDLES* paired_handles, const void* handle)
+{
+    int result;
+    void* handle_value;
+    size_t slot;
+
+    (void)memcpy(&handle_value, handle, sizeof(handle_value));
+    slot = find_pointer_handle_slot(paired_handles->pointer_handles, paired_handles->pointer_handle_capacity, handle_value);
+    if (paired_handles->pointer_handles[slot].count == 0)
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLPAIRS_01_022: [ If the handle value is found in the hash set, umockcallpairs_track_destroy_paired_call shall decrement its count, remove it from the hash set when the count reaches 0 and return 0. ]*/
+        paired_handles->pointer_handles[slot].count--;
+        if (paired_handles->pointer_handles[slot].count == 0)
+        {
+            /* shift back the entries that follow in the probe sequence so that no lookup stops early at the freed slot */
+            size_t mask = paired_handles->pointer_handle_capacity - 1;
+            size_t next_slot = slot;
+
+            while (1)
+            {
+                size_t home_slot;
+
+                next_slot = (next_slot + 1) & mask;
+                if (paired_handles->pointer_handles[next_slot].count == 0)
+                {
+                    break;
+                }
+
+                home_slot = get_pointer_handle_hash(paired_handles->pointer_handles[next_slot].handle_value) & mask;
+                if (((next_slot - home_slot) & mask) >= ((next_slot - slot) & mask))
+                {
+                    paired_handles->pointer_handles[slot] = paired_handles->pointer_handles[next_slot];
+                    slot = next_slot;
+                }
+            }
+
+            paired_handles->pointer_handles[slot].count = 0;
+            paired_handles->pointer_handle_used_slot_count--;
+
+            if (paired_handles->pointer_handle_used_slot_count == 0)
+            {
+                /* Codes_SRS_UMOCKCALLPAIRS_01_023: [ If the hash set is empty after removing the handle value, it shall be freed and the pointer_handles field shall be set to NULL. ]*/
+                umockalloc_free(paired_handles->pointer_handles);
+                paired_handles->pointer_handles = NULL;
+                paired_handles->pointer_handle_capacity = 0;
+            }
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
 
 int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, const void* handle, const char* handle_type, size_t handle_type_size)
 {
-    PAIRED_HANDLE* new_paired_handles;
     int result;
 
     if ((paired_handles == NULL) ||
@@ -24,11 +216,38 @@ int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, cons
         result = __LINE__;
         UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: NULL paired_handles");
     }
+    else if (is_pointer_handle_type(handle_type, handle_type_size))
+    {
+        /* Codes_SRS_UMOCKCALLPAIRS_01_017: [ If umocktypes_get_handlers returns the void* handlers for handle_type and handle_type_size is the size of a pointer, umockcallpairs_track_create_paired_call shall store the handle value inline in a hash set keyed by the pointer value, without allocating memory for the handle and without calling umocktypes_copy. ]*/
+        result = track_create_pointer_handle(paired_handles, handle);
+    }
     else
     {
         /* Codes_SRS_UMOCKCALLPAIRS_01_001: [ umockcallpairs_track_create_paired_call shall add a new entry to the PAIRED_HANDLES array and on success it shall return 0. ]*/
-        new_paired_handles = (PAIRED_HANDLE*)umockalloc_realloc(paired_handles->paired_handles, sizeof(PAIRED_HANDLE) * (paired_handles->paired_handle_count + 1));
-        if (new_paired_handles == NULL)
+        /* Codes_SRS_UMOCKCALLPAIRS_01_016: [ The PAIRED_HANDLES array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+        if (paired_handles->paired_handle_count == paired_handles->paired_handle_capacity)
+        {
+            size_t new_capacity = (paired_handles->paired_handle_capacity == 0) ? INITIAL_PAIRED_HANDLES_CAPACITY : paired_handles->paired_handle_capacity * 2;
+            PAIRED_HANDLE* new_paired_handles;
+
+            if ((new_capacity <= paired_handles->paired_handle_capacity) ||
+                (new_capacity > ((size_t)-1) / sizeof(PAIRED_HANDLE)))
+            {
+                new_paired_handles = NULL;
+            }
+            else
+            {
+                new_paired_handles = (PAIRED_HANDLE*)umockalloc_realloc(paired_handles->paired_handles, sizeof(PAIRED_HANDLE) * new_capacity);
+            }
+
+            if (new_paired_handles != NULL)
+            {
+                paired_handles->paired_handles = new_paired_handles;
+                paired_handles->paired_handle_capacity = new_capacity;
+            }
+        }
+
+        if (paired_handles->paired_handle_count == paired_handles->paired_handle_capacity)
         {
             result = __LINE__;
             UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: Allocation failed");
@@ -36,7 +255,6 @@ int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, cons
         else
         {
             paired_handles->paired_handle_count++;
-            paired_handles->paired_handles = new_paired_handles;
 
             /* Codes_SRS_UMOCKCALLPAIRS_01_003: [ umockcallpairs_track_create_paired_call shall allocate a memory block and store a pointer to it in the memory field of the new entry. ]*/
             paired_handles->paired_handles[paired_handles->paired_handle_count - 1].handle_value = umockalloc_malloc(handle_type_size);
@@ -44,11 +262,7 @@ int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, cons
             {
                 /* Codes_SRS_UMOCKCALLPAIRS_01_005: [ If allocating memory fails, umockcallpairs_track_create_paired_call shall fail and return a non-zero value. ]*/
                 paired_handles->paired_handle_count--;
-                if (paired_handles->paired_handle_count == 0)
-                {
-                    umockalloc_free(paired_handles->paired_handles);
-                    paired_handles->paired_handles = NULL;
-                }
+                free_paired_handles_if_empty(paired_handles);
 
                 result = __LINE__;
                 UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: Failed allocating memory for handle value for create");
@@ -63,11 +277,7 @@ int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, cons
                     /* Codes_SRS_UMOCKCALLPAIRS_01_005: [ If allocating memory fails, umockcallpairs_track_create_paired_call shall fail and return a non-zero value. ]*/
                     umockalloc_free(paired_handles->paired_handles[paired_handles->paired_handle_count - 1].handle_value);
                     paired_handles->paired_handle_count--;
-                    if (paired_handles->paired_handle_count == 0)
-                    {
-                        umockalloc_free(paired_handles->paired_handles);
-                        paired_handles->paired_handles = NULL;
-                    }
+                    free_paired_handles_if_empty(paired_handles);
 
                     result = __LINE__;
                     UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: Failed allocating memory for handle type for create");
@@ -84,11 +294,7 @@ int umockcallpairs_track_create_paired_call(PAIRED_HANDLES* paired_handles, cons
                         umockalloc_free(paired_handles->paired_handles[paired_handles->paired_handle_count - 1].handle_type);
                         umockalloc_free(paired_handles->paired_handles[paired_handles->paired_handle_count - 1].handle_value);
                         paired_handles->paired_handle_count--;
-                        if (paired_handles->paired_handle_count == 0)
-                        {
-                            umockalloc_free(paired_handles->paired_handles);
-                            paired_handles->paired_handles = NULL;
-                        }
+                        free_paired_handles_if_empty(paired_handles);
 
                         result = __LINE__;
                         UMOCK_LOG("umock_track_create_destroy_paired_calls_malloc: Failed copying handle");
@@ -117,10 +323,18 @@ int umockcallpairs_track_destroy_paired_call(PAIRED_HANDLES* paired_handles, con
         result = __LINE__;
         UMOCK_LOG("umock_track_create_destroy_paired_calls_free: are_equal failed");
     }
+    /* Codes_SRS_UMOCKCALLPAIRS_01_021: [ If the hash set of pointer handles is not empty, umockcallpairs_track_destroy_paired_call shall first look up the handle value in it, comparing the pointer values bitwise. ]*/
+    else if ((paired_handles->pointer_handle_used_slot_count > 0) &&
+        (track_destroy_pointer_handle(paired_handles, handle) == 0))
+    {
+        result = 0;
+    }
     else
     {
         unsigned char is_error = 0;
 
+        /* Codes_SRS_UMOCKCALLPAIRS_01_024: [ If the handle value is not found in the hash set, umockcallpairs_track_destroy_paired_call shall look it up in the PAIRED_HANDLES array. ]*/
+
         /* Codes_SRS_UMOCKCALLPAIRS_01_008: [ umockcallpairs_track_destroy_paired_call shall remove from the paired handles array pointed by the paired_handles field the entry that is associated with the handle passed in the handle argument. ]*/
         for (i = 0; i < paired_handles->paired_handle_count; i++)
         {
@@ -166,12 +380,9 @@ int umockcallpairs_track_destroy_paired_call(PAIRED_HANDLES* paired_handles, con
                     (void)memmove(&paired_handles->paired_handles[i], &paired_handles->paired_handles[i + 1], sizeof(PAIRED_HANDLE) * (paired_handles->paired_handle_count - i - 1));
                 }
                 paired_handles->paired_handle_count--;
-                if (paired_handles->paired_handle_count == 0)
-                {
-                    /* Codes_SRS_UMOCKCALLPAIRS_01_012: [ If the paired handles array is empty after removing the entry, the paired_handles field shall be freed and set to NULL. ]*/
-                    umockalloc_free(paired_handles->paired_handles);
-                    paired_handles->paired_handles = NULL;
-                }
+
+                /* Codes_SRS_UMOCKCALLPAIRS_01_012: [ If the paired handles array is empty after removing the entry, the paired_handles field shall be freed and set to NULL. ]*/
+                free_paired_handles_if_empty(paired_handles);
 
                 /* Codes_SRS_UMOCKCALLPAIRS_01_009: [ On success umockcallpairs_track_destroy_paired_call shall return 0. ]*/
                 result = 0;
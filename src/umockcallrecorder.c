@@ -2,6 +2,8 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "macro_utils/macro_utils.h"
@@ -10,28 +12,178 @@
 #include "umock_c/umock_lock_if.h"
 #include "umock_c/umock_log.h"
 #include "umock_c/umockalloc.h"
+#include "umock_c/umockatomic.h"
 #include "umock_c/umockcallrecorder.h"
 #include "umock_c/umockcall.h"
+#include "umock_c/umockstringbuilder.h"
+
+/* marks the end of a bucket chain (and empty buckets) in the index of the expected calls that have ignore_all_calls set */
+#define NO_IGNORE_ALL_CALL ((size_t)-1)
+
+/* marks expected calls that are not in an unordered group and the absence of an open unordered group */
+#define NO_UNORDERED_GROUP ((size_t)-1)
+
+/* marks the end of a bucket chain (and empty buckets) in the index of an unordered group */
+#define NO_UNORDERED_GROUP_CALL ((size_t)-1)
+
+/* number of entries allocated the first time the expected/actual call arrays are grown */
+#define INITIAL_CALL_ARRAY_CAPACITY 8
+
+/* number of slots in the first segment of the unexpected actual calls log is 1 << UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS, each
+   following segment has twice the slots of the previous one */
+#define UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS 6
+#define UNEXPECTED_CALL_SEGMENT_COUNT (64 - UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS)
 
 typedef struct UMOCK_EXPECTED_CALL_TAG
 {
     UMOCKCALL_HANDLE umockcall;
+    /* index of the next expected call with ignore_all_calls set in the same bucket, only valid for calls in the ignore all calls index */
+    size_t next_ignore_all_call;
+    /* hash of the function name, only valid for calls in the ignore all calls index */
+    size_t function_name_hash;
+    /* offset in the expected calls string where the stringified form of this call ends, only valid for calls that are cached */
+    size_t stringified_end;
+    /* number of actual calls matched with the expected call */
+    size_t match_count;
+    /* index of the unordered group the call belongs to or NO_UNORDERED_GROUP */
+    size_t unordered_group;
     unsigned int is_matched : 1;
 } UMOCK_EXPECTED_CALL;
 
+typedef struct UMOCK_UNORDERED_GROUP_CALL_TAG
+{
+    size_t function_name_hash;
+    /* offset in the group of the next call in the same bucket */
+    size_t next_in_bucket;
+} UMOCK_UNORDERED_GROUP_CALL;
+
+typedef struct UMOCK_CALL_BUCKET_TAG
+{
+    /* first and last call in the bucket (offsets in the group for unordered groups, expected call indices for the ignore all calls index) */
+    size_t first_call;
+    size_t last_call;
+} UMOCK_CALL_BUCKET;
+
+/* a run of consecutive expected calls that can be matched in any order */
+typedef struct UMOCK_UNORDERED_GROUP_TAG
+{
+    size_t first_expected_call;
+    size_t call_count;
+    /* capacity of calls, which is also the number of buckets (a power of 2) */
+    size_t call_capacity;
+    UMOCK_UNORDERED_GROUP_CALL* calls;
+    UMOCK_CALL_BUCKET* buckets;
+    /* offset in the group of the first call that may still need actual calls, the calls before it were matched at least
+       min_repeat_count times or have ignore_all_calls set */
+    size_t first_unsatisfied_call;
+    unsigned int is_done : 1;
+} UMOCK_UNORDERED_GROUP;
+
+typedef struct UMOCK_PER_THREAD_CALL_TAG
+{
+    uint64_t sequence_number;
+    UMOCKCALL_HANDLE umockcall;
+} UMOCK_PER_THREAD_CALL;
+
+/* actual calls recorded by one thread and not yet merged into the call recorder */
+typedef struct UMOCK_PER_THREAD_CALLS_TAG
+{
+    /* address of a thread local variable, identifies the thread that owns the buffer */
+    const void* thread_key;
+    UMOCK_C_LOCK_HANDLE lock;
+    size_t call_count;
+    size_t call_capacity;
+    size_t merged_call_count;
+    UMOCK_PER_THREAD_CALL* calls;
+} UMOCK_PER_THREAD_CALLS;
+
+/* Matching an actual call only needs to look at the expected calls that have ignore_all_calls set and are before the first
+   unmatched expected call, and at the first unmatched expected call itself. The recorder keeps the index of the first expected
+   call that was not yet matched (all calls before it are either matched or have ignore_all_calls set) and indexes the expected calls
+   before it that have ignore_all_calls set, so that the already matched calls are not walked again for every actual call. The index
+   is a chained hash table keyed on the hash of the function name (the same way unordered groups index their calls), so an actual call
+   is only compared with the ignore_all_calls expected calls of the same function. Each chain keeps the calls in the order they were
+   indexed, so that the first equal call wins. */
+/* The stringified forms of the calls are cached in expected_calls_string and actual_calls_string so that repeated queries only
+   stringify the calls added since the previous query. Actual calls never change once recorded. Expected calls can only be changed
+   while they are the last expected call (by the call modifiers), so all but the last expected call are cached. The expected calls
+   are only matched in order, thus the calls that drop out of the expected calls string (by being matched) are always at its start
+   and are skipped by moving expected_calls_string_start. */
+/* An expected call can have a repeat count (see umockcall_set_repeat_count), in which case it stays the first unmatched expected
+   call until it was matched max_repeat_count times. Once it was matched min_repeat_count times it is also done as soon as an actual
+   call does not match it, the actual call being then compared with the next expected calls. The remaining count of such a call is
+   part of its stringified form, so when it changes the cached expected calls string is dropped from that call on. */
+/* A cloned call recorder shares the calls of the original one (see umockcall_share), only the is_matched flags and the call arrays
+   are copied. A shared expected call is replaced with its own copy right before it is changed (by umockcallrecorder_fail_call or by
+   the caller of umockcallrecorder_get_last_expected_call). Actual calls are never changed, so they stay shared. */
+/* When recording per thread is enabled, an actual call is only appended to a buffer owned by the calling thread, tagged with a
+   sequence number taken from a counter shared by the threads. No call recorder lock is taken for that, except once per thread to
+   register its buffer. The buffers are merged in sequence number order (and the calls matched against the expected calls) whenever
+   the recorded calls are looked at or changed, so the result is the same as if the calls were recorded in the sequence number order. */
+/* When the call recorder has a lock and no expected call can match (there is no expected call at or after the first unmatched
+   expected call and no expected call with ignore_all_calls set before it), an actual call can only end up in the actual calls
+   array. Such calls are appended to a log without taking the lock: a slot is reserved by a compare-exchange on the log call count
+   and the call is stored in it. The log is made of segments that are never moved, segment k holding (1 << k) times the slots of
+   the first one, so a slot index maps directly to a segment and an offset in it. A segment is allocated by the first thread that
+   needs it and published with a compare-exchange. The log is merged (in slot order) into the actual calls array under the
+   exclusive lock before any other call is added and whenever the recorded calls are looked at, after which it is rewound. */
+/* The expected calls added between umockcallrecorder_begin_unordered_expected_calls and umockcallrecorder_end_unordered_expected_calls
+   form an unordered group, which takes the place of a single expected call in the order of the expected calls. Each group indexes
+   its calls in a chained hash table keyed on the hash of the function name, so an actual call is only compared with the calls of
+   the group that have the same function name. Each chain keeps the calls in the order they were added, so that the first
+   equal call wins, and calls that cannot be matched anymore are unlinked when a lookup walks over them. The group is done once
+   an actual call does not match any of its calls while all of them had enough matches; until then the first unmatched expected
+   call stays the first call of the group. Calls in a group are matched out of order, so the cached expected calls string is
+   dropped from a matched call on. */
 typedef struct UMOCKCALLRECORDER_TAG
 {
     size_t expected_call_count;
+    size_t expected_call_capacity;
     UMOCK_EXPECTED_CALL* expected_calls;
+    size_t first_unmatched_expected_call;
+    /* number of buckets in ignore_all_buckets (0 or a power of 2) */
+    size_t ignore_all_bucket_count;
+    UMOCK_CALL_BUCKET* ignore_all_buckets;
     size_t actual_call_count;
+    size_t actual_call_capacity;
     UMOCKCALL_HANDLE* actual_calls;
-    char* expected_calls_string;
-    char* actual_calls_string;
+    UMOCKSTRINGBUILDER expected_calls_string;
+    size_t expected_calls_string_call_count;
+    size_t expected_calls_string_cached_length;
+    size_t expected_calls_string_start;
+    size_t first_reported_expected_call;
+    UMOCKSTRINGBUILDER actual_calls_string;
+    size_t actual_calls_string_call_count;
+    /* why the first actual call did not match the first unmatched expected call, NULL when there is nothing to add */
+    char* first_actual_call_mismatch;
     UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock;
     void* lock_factory_create_lock_params;
     UMOCK_C_LOCK_HANDLE lock;
+    /* 0 when recording per thread is not enabled, otherwise an id that is unique across all call recorders */
+    uint64_t per_thread_calls_id;
+    volatile uint64_t next_sequence_number;
+    size_t per_thread_calls_count;
+    UMOCK_PER_THREAD_CALLS** per_thread_calls;
+    /* number of expected calls before the first unmatched expected call that have ignore_all_calls set */
+    size_t ignore_all_call_count;
+    /* number of expected calls that an actual call could match, only changed with the lock held */
+    volatile uint64_t matchable_expected_call_count;
+    /* number of slots reserved in the unexpected actual calls log */
+    volatile uint64_t unexpected_call_count;
+    uint64_t merged_unexpected_call_count;
+    UMOCKCALL_HANDLE* volatile unexpected_call_segments[UNEXPECTED_CALL_SEGMENT_COUNT];
+    size_t unordered_group_count;
+    UMOCK_UNORDERED_GROUP* unordered_groups;
+    /* index of the unordered group that expected calls are added to or NO_UNORDERED_GROUP */
+    size_t open_unordered_group;
 } UMOCKCALLRECORDER;
 
+static volatile uint64_t last_per_thread_calls_id = 0;
+
+/* caches the buffer of the current thread for the call recorder that last recorded a call on this thread */
+static UMOCK_THREAD_LOCAL uint64_t current_thread_recorder_id;
+static UMOCK_THREAD_LOCAL UMOCK_PER_THREAD_CALLS* current_thread_calls;
+
 static void internal_lock_acquire_exclusive_if_needed(UMOCKCALLRECORDER_HANDLE call_recorder)
 {
     if (call_recorder->lock != NULL)
@@ -64,296 +216,1785 @@ static void internal_lock_release_shared_if_needed(UMOCKCALLRECORDER_HANDLE call
     }
 }
 
-static void internal_umockcallrecorder_reset_all_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+/* the lock has to be held in exclusive mode (or the call recorder not yet shared) */
+static void update_matchable_expected_call_count(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
 {
-    /* Codes_SRS_UMOCKCALLRECORDER_01_005: [ umockcallrecorder_reset_all_calls shall free all the expected and actual calls for the call recorder identified by umock_call_recorder. ]*/
-    if (umock_call_recorder->expected_calls != NULL)
-    {
-        size_t i;
-        for (i = 0; i < umock_call_recorder->expected_call_count; i++)
-        {
-            umockcall_destroy(umock_call_recorder->expected_calls[i].umockcall);
-        }
+    /* Codes_SRS_UMOCKCALLRECORDER_01_137: [ The number of expected calls that an actual call could match (the expected calls starting with the first unmatched expected call plus the expected calls before it that have ignore_all_calls set) shall be kept in a counter that is updated atomically whenever expected calls are added, matched, reset or cloned. ]*/
+    umockatomic_store_uint64(&umock_call_recorder->matchable_expected_call_count,
+        (uint64_t)(umock_call_recorder->expected_call_count - umock_call_recorder->first_unmatched_expected_call) + umock_call_recorder->ignore_all_call_count);
+}
 
-        umockalloc_free(umock_call_recorder->expected_calls);
-        umock_call_recorder->expected_calls = NULL;
+static void get_unexpected_call_slot_position(uint64_t slot, size_t* segment_index, uint64_t* offset)
+{
+    uint64_t first_segment_count = (slot >> UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS) + 1;
+    size_t index = 0;
+
+    /* segment k starts at slot ((1 << k) - 1) << UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS */
+    while ((first_segment_count >> (index + 1)) != 0)
+    {
+        index++;
     }
-    umock_call_recorder->expected_call_count = 0;
 
-    if (umock_call_recorder->actual_calls != NULL)
+    *segment_index = index;
+    *offset = slot - ((((uint64_t)1 << index) - 1) << UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS);
+}
+
+static int compute_grown_capacity(size_t current_capacity, size_t required_capacity, size_t item_size, size_t* new_capacity)
+{
+    int result;
+    size_t capacity = (current_capacity == 0) ? INITIAL_CALL_ARRAY_CAPACITY : current_capacity;
+
+    while ((capacity < required_capacity) && (capacity <= ((size_t)-1) / 2))
     {
-        size_t i;
-        for (i = 0; i < umock_call_recorder->actual_call_count; i++)
-        {
-            umockcall_destroy(umock_call_recorder->actual_calls[i]);
-        }
+        capacity *= 2;
+    }
+    if (capacity < required_capacity)
+    {
+        capacity = required_capacity;
+    }
 
-        umockalloc_free(umock_call_recorder->actual_calls);
-        umock_call_recorder->actual_calls = NULL;
+    if (capacity > ((size_t)-1) / item_size)
+    {
+        UMOCK_LOG("umockcallrecorder: Capacity %zu is too large for items of size %zu.", capacity, item_size);
+        result = MU_FAILURE;
     }
-    umock_call_recorder->actual_call_count = 0;
+    else
+    {
+        *new_capacity = capacity;
+        result = 0;
+    }
+
+    return result;
 }
 
-UMOCKCALLRECORDER_HANDLE umockcallrecorder_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
+static int ensure_expected_call_capacity(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t required_capacity)
 {
-    UMOCKCALLRECORDER_HANDLE result;
+    int result;
+    size_t new_capacity;
 
-    /* Codes_SRS_UMOCKCALLRECORDER_01_095: [ lock_factory_create_lock may be NULL. ]*/
-    /* Codes_SRS_UMOCKCALLRECORDER_01_001: [ umockcallrecorder_create shall create a new instance of a call recorder and return a non-NULL handle to it on success. ]*/
-    result = umockalloc_malloc(sizeof(UMOCKCALLRECORDER));
-    if (result == NULL)
+    if (required_capacity <= umock_call_recorder->expected_call_capacity)
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_002: [ If any error occurs, umockcallrecorder_create shall return NULL. ]*/
-        UMOCK_LOG("umockalloc_malloc(%zu) failed", sizeof(UMOCKCALLRECORDER));
+        result = 0;
+    }
+    else if (compute_grown_capacity(umock_call_recorder->expected_call_capacity, required_capacity, sizeof(UMOCK_EXPECTED_CALL), &new_capacity) != 0)
+    {
+        result = MU_FAILURE;
     }
     else
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_097: [ If lock_factory_create_lock is not NULL, umockcallrecorder_create shall call lock_factory_create_lock to create the lock used when working with the stored calls. ]*/
-        if (
-            (lock_factory_create_lock != NULL) && 
-            ((result->lock = lock_factory_create_lock(lock_factory_create_lock_params)) == NULL)
-            )
+        UMOCK_EXPECTED_CALL* new_expected_calls = umockalloc_realloc(umock_call_recorder->expected_calls, sizeof(UMOCK_EXPECTED_CALL) * new_capacity);
+        if (new_expected_calls == NULL)
         {
-            /* Codes_SRS_UMOCKCALLRECORDER_01_002: [ If any error occurs, umockcallrecorder_create shall return NULL. ]*/
-            UMOCK_LOG("lock_factory_create_lock failed");
+            UMOCK_LOG("umockcallrecorder: Cannot grow expected calls array to %zu items.", new_capacity);
+            result = MU_FAILURE;
         }
         else
         {
-            if (lock_factory_create_lock == NULL)
-            {
-                result->lock = NULL;
-            }
+            umock_call_recorder->expected_calls = new_expected_calls;
+            umock_call_recorder->expected_call_capacity = new_capacity;
+            result = 0;
+        }
+    }
 
-            result->expected_call_count = 0;
-            result->expected_calls = NULL;
-            result->expected_calls_string = NULL;
-            result->actual_call_count = 0;
-            result->actual_calls = NULL;
-            result->actual_calls_string = NULL;
+    return result;
+}
 
-            /* Codes_SRS_UMOCKCALLRECORDER_01_096: [ lock_factory_create_lock shall be saved for later use. ]*/
-            result->lock_factory_create_lock = lock_factory_create_lock;
-            result->lock_factory_create_lock_params = lock_factory_create_lock_params;
+static int ensure_actual_call_capacity(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t required_capacity)
+{
+    int result;
+    size_t new_capacity;
 
-            goto all_ok;
+    if (required_capacity <= umock_call_recorder->actual_call_capacity)
+    {
+        result = 0;
+    }
+    else if (compute_grown_capacity(umock_call_recorder->actual_call_capacity, required_capacity, sizeof(UMOCKCALL_HANDLE), &new_capacity) != 0)
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        UMOCKCALL_HANDLE* new_actual_calls = umockalloc_realloc(umock_call_recorder->actual_calls, sizeof(UMOCKCALL_HANDLE) * new_capacity);
+        if (new_actual_calls == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot grow actual calls array to %zu items.", new_capacity);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            umock_call_recorder->actual_calls = new_actual_calls;
+            umock_call_recorder->actual_call_capacity = new_capacity;
+            result = 0;
         }
-
-        umockalloc_free(result);
-        result = NULL;
     }
 
-all_ok:
     return result;
 }
 
-void umockcallrecorder_destroy(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+static int ensure_thread_call_capacity(UMOCK_PER_THREAD_CALLS* thread_calls, size_t required_capacity)
 {
-    /* Codes_SRS_UMOCKCALLRECORDER_01_004: [ If umock_call_recorder is NULL, umockcallrecorder_destroy shall do nothing. ]*/
-    if (umock_call_recorder != NULL)
+    int result;
+    size_t new_capacity;
+
+    if (required_capacity <= thread_calls->call_capacity)
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_003: [ umockcallrecorder_destroy shall free the resources associated with a the call recorder identified by the umock_call_recorder argument. ]*/
-        internal_umockcallrecorder_reset_all_calls(umock_call_recorder);
-        if (umock_call_recorder->actual_calls_string != NULL)
-        {
-            umockalloc_free(umock_call_recorder->actual_calls_string);
-        }
-        if (umock_call_recorder->expected_calls_string != NULL)
+        result = 0;
+    }
+    else if (compute_grown_capacity(thread_calls->call_capacity, required_capacity, sizeof(UMOCK_PER_THREAD_CALL), &new_capacity) != 0)
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        UMOCK_PER_THREAD_CALL* new_calls = umockalloc_realloc(thread_calls->calls, sizeof(UMOCK_PER_THREAD_CALL) * new_capacity);
+        if (new_calls == NULL)
         {
-            umockalloc_free(umock_call_recorder->expected_calls_string);
+            UMOCK_LOG("umockcallrecorder: Cannot grow per thread calls array to %zu items.", new_capacity);
+            result = MU_FAILURE;
         }
-        if (umock_call_recorder->lock != NULL)
+        else
         {
-            umock_call_recorder->lock->destroy(umock_call_recorder->lock);
+            thread_calls->calls = new_calls;
+            thread_calls->call_capacity = new_capacity;
+            result = 0;
         }
-        umockalloc_free(umock_call_recorder);
     }
+
+    return result;
 }
 
-int umockcallrecorder_reset_all_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+/* takes the call stored in a reserved slot of the unexpected actual calls log and clears the slot so that it can be reused */
+static UMOCKCALL_HANDLE take_unexpected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, uint64_t slot)
+{
+    UMOCKCALL_HANDLE result;
+    size_t segment_index;
+    uint64_t offset;
+    UMOCKCALL_HANDLE* segment;
+
+    get_unexpected_call_slot_position(slot, &segment_index, &offset);
+    segment = umock_call_recorder->unexpected_call_segments[segment_index];
+
+    /* the slot is reserved before the call is stored in it, wait for a thread that is still storing its call */
+    do
+    {
+        result = umockatomic_load_pointer((void* volatile*)&segment[offset]);
+    } while (result == NULL);
+
+    segment[offset] = NULL;
+
+    return result;
+}
+
+static int get_expected_call_repeat_count(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index, size_t* min_repeat_count, size_t* max_repeat_count)
 {
     int result;
 
-    if (umock_call_recorder == NULL)
+    if (umockcall_get_repeat_count(umock_call_recorder->expected_calls[index].umockcall, min_repeat_count, max_repeat_count) != 0)
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_007: [ If umock_call_recorder is NULL, umockcallrecorder_reset_all_calls shall fail and return a non-zero value. ]*/
-        UMOCK_LOG("umockcallrecorder: Reset all calls failed: NULL umock_call_recorder.");
+        UMOCK_LOG("umockcallrecorder: Cannot get the repeat count of expected call %zu.", index);
         result = MU_FAILURE;
     }
     else
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_065: [ If a lock was created for the call recorder, umockcallrecorder_reset_all_calls shall acquire the lock in exclusive mode. ]*/
-        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
-        {
-            internal_umockcallrecorder_reset_all_calls(umock_call_recorder);
+        result = 0;
+    }
 
-            /* Codes_SRS_UMOCKCALLRECORDER_01_066: [ If a lock was created for the call recorder, umockcallrecorder_reset_all_calls shall release the exclusive lock. ]*/
-            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+    return result;
+}
 
-            /* Codes_SRS_UMOCKCALLRECORDER_01_006: [ On success umockcallrecorder_reset_all_calls shall return 0. ]*/
-            result = 0;
-        }
+static void drop_cached_expected_calls_string_from(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    /* calls before the first reported one were stringified as empty strings (matched or ignored), which does not change anymore */
+    if ((index >= umock_call_recorder->first_reported_expected_call) &&
+        (index < umock_call_recorder->expected_calls_string_call_count))
+    {
+        umock_call_recorder->expected_calls_string_cached_length = (index == umock_call_recorder->first_reported_expected_call) ?
+            umock_call_recorder->expected_calls_string_start :
+            umock_call_recorder->expected_calls[index - 1].stringified_end;
+        umock_call_recorder->expected_calls_string_call_count = index;
     }
+}
 
-    return result;
+static void append_call_to_unordered_group_bucket(UMOCK_UNORDERED_GROUP* group, size_t offset)
+{
+    UMOCK_CALL_BUCKET* bucket = &group->buckets[group->calls[offset].function_name_hash & (group->call_capacity - 1)];
+
+    group->calls[offset].next_in_bucket = NO_UNORDERED_GROUP_CALL;
+    if (bucket->last_call == NO_UNORDERED_GROUP_CALL)
+    {
+        bucket->first_call = offset;
+    }
+    else
+    {
+        group->calls[bucket->last_call].next_in_bucket = offset;
+    }
+    bucket->last_call = offset;
 }
 
-int umockcallrecorder_add_expected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
+static int grow_unordered_group(UMOCK_UNORDERED_GROUP* group)
 {
     int result;
+    size_t new_capacity;
 
-    if ((umock_call_recorder == NULL) ||
-        (mock_call == NULL))
+    if (compute_grown_capacity(group->call_capacity, group->call_count + 1, sizeof(UMOCK_UNORDERED_GROUP_CALL), &new_capacity) != 0)
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_012: [ If any of the arguments is NULL, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
-        UMOCK_LOG("umockcallrecorder: Bad arguments in add expected call: umock_call_recorder = %p, mock_call = %p.",
-            umock_call_recorder, mock_call);
         result = MU_FAILURE;
     }
     else
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_068: [ If a lock was created for the call recorder, umockcallrecorder_add_expected_call shall acquire the lock in exclusive mode. ]*/
-        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        UMOCK_CALL_BUCKET* new_buckets = umockalloc_malloc(sizeof(UMOCK_CALL_BUCKET) * new_capacity);
+        if (new_buckets == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot allocate %zu buckets for an unordered group.", new_capacity);
+            result = MU_FAILURE;
+        }
+        else
         {
-            UMOCK_EXPECTED_CALL* new_expected_calls = umockalloc_realloc(umock_call_recorder->expected_calls, sizeof(UMOCK_EXPECTED_CALL) * (umock_call_recorder->expected_call_count + 1));
-            if (new_expected_calls == NULL)
+            UMOCK_UNORDERED_GROUP_CALL* new_calls = umockalloc_realloc(group->calls, sizeof(UMOCK_UNORDERED_GROUP_CALL) * new_capacity);
+            if (new_calls == NULL)
             {
-                /* Codes_SRS_UMOCKCALLRECORDER_01_013: [ If any error occurs, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
-                UMOCK_LOG("umockcallrecorder: Cannot allocate memory in add expected call.");
+                UMOCK_LOG("umockcallrecorder: Cannot grow the calls of an unordered group to %zu items.", new_capacity);
+                umockalloc_free(new_buckets);
                 result = MU_FAILURE;
             }
             else
             {
-                /* Codes_SRS_UMOCKCALLRECORDER_01_008: [ umockcallrecorder_add_expected_call shall add the mock_call call to the expected call list maintained by the call recorder identified by umock_call_recorder. ]*/
-                umock_call_recorder->expected_calls = new_expected_calls;
-                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].umockcall = mock_call;
-                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count++].is_matched = 0;
+                size_t i;
+
+                if (group->buckets != NULL)
+                {
+                    umockalloc_free(group->buckets);
+                }
+
+                group->calls = new_calls;
+                group->buckets = new_buckets;
+                group->call_capacity = new_capacity;
+
+                for (i = 0; i < new_capacity; i++)
+                {
+                    group->buckets[i].first_call = NO_UNORDERED_GROUP_CALL;
+                    group->buckets[i].last_call = NO_UNORDERED_GROUP_CALL;
+                }
+
+                /* rehash in the order the calls were added, so that each chain stays in that order */
+                for (i = 0; i < group->call_count; i++)
+                {
+                    append_call_to_unordered_group_bucket(group, i);
+                }
 
-                /* Codes_SRS_UMOCKCALLRECORDER_01_009: [ On success umockcallrecorder_add_expected_call shall return 0. ]*/
                 result = 0;
             }
-
-            /* Codes_SRS_UMOCKCALLRECORDER_01_069: [ If a lock was created for the call recorder, umockcallrecorder_add_expected_call shall release the exclusive lock. ]*/
-            internal_lock_release_exclusive_if_needed(umock_call_recorder);
         }
     }
 
     return result;
 }
 
-int umockcallrecorder_add_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call, UMOCKCALL_HANDLE* matched_call)
+static int add_call_to_open_unordered_group(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
 {
     int result;
+    UMOCK_UNORDERED_GROUP* group = &umock_call_recorder->unordered_groups[umock_call_recorder->open_unordered_group];
+    size_t function_name_hash;
 
-    if ((umock_call_recorder == NULL) ||
-        (mock_call == NULL) ||
-        (matched_call == NULL))
+    /* Codes_SRS_UMOCKCALLRECORDER_01_165: [ If an unordered group is open, umockcallrecorder_add_expected_call shall add mock_call to the group, indexing it by the hash of its function name obtained by calling umockcall_get_function_name_hash. ]*/
+    if (umockcall_get_function_name_hash(mock_call, &function_name_hash) != 0)
+    {
+        UMOCK_LOG("umockcallrecorder: Cannot get the function name hash of an expected call.");
+        result = MU_FAILURE;
+    }
+    else if ((group->call_count == group->call_capacity) &&
+        (grow_unordered_group(group) != 0))
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_019: [ If any of the arguments is NULL, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
-        UMOCK_LOG("umockcallrecorder: Bad arguments in add actual call: umock_call_recorder = %p, mock_call = %p, matched_call = %p.",
-            umock_call_recorder, mock_call, matched_call);
         result = MU_FAILURE;
     }
     else
     {
-        size_t i;
-        unsigned int is_error = 0;
+        group->calls[group->call_count].function_name_hash = function_name_hash;
+        append_call_to_unordered_group_bucket(group, group->call_count);
+        group->call_count++;
+        result = 0;
+    }
 
-        *matched_call = NULL;
+    return result;
+}
 
-        /* Codes_SRS_UMOCKCALLRECORDER_01_071: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall acquire the lock in exclusive mode. ]*/
-        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+/* returns a negative value on error, 1 if the actual call matched a call of the group or the group is done and the expected calls
+   after it have to be compared, 0 if the actual call is an unexpected call */
+static int match_unordered_group(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index, UMOCKCALL_HANDLE mock_call, size_t function_name_hash, UMOCKCALL_HANDLE* matched_call, size_t* matched_index)
+{
+    int result = 0;
+    UMOCK_UNORDERED_GROUP* group = &umock_call_recorder->unordered_groups[umock_call_recorder->expected_calls[index].unordered_group];
+    UMOCK_CALL_BUCKET* bucket = &group->buckets[function_name_hash & (group->call_capacity - 1)];
+    size_t previous_offset = NO_UNORDERED_GROUP_CALL;
+    size_t offset = bucket->first_call;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_167: [ When the first unmatched expected call is in an unordered group, the actual call shall only be compared with the calls of the group that have the same function name hash and can still be matched, in the order they were added, the first equal call being the matched call. ]*/
+    while (offset != NO_UNORDERED_GROUP_CALL)
+    {
+        size_t next_offset = group->calls[offset].next_in_bucket;
+
+        if (group->calls[offset].function_name_hash == function_name_hash)
         {
-            /* Codes_SRS_UMOCKCALLRECORDER_01_014: [ umockcallrecorder_add_actual_call shall check whether the call mock_call matches any of the expected calls maintained by umock_call_recorder. ]*/
-            /* Codes_SRS_UMOCK_C_LIB_01_115: [ umock_c shall compare calls in order. ]*/
-            for (i = 0; i < umock_call_recorder->expected_call_count; i++)
+            size_t call_index = group->first_expected_call + offset;
+            int ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[call_index].umockcall);
+            if (ignore_all_calls < 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_058: [ If getting ignore_all_calls by calling umockcall_get_ignore_all_calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
+                *matched_index = call_index;
+                result = -1;
+                break;
+            }
+            else if ((ignore_all_calls == 0) && (umock_call_recorder->expected_calls[call_index].is_matched != 0))
             {
-                int ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[i].umockcall);
-                if (ignore_all_calls < 0)
+                /* the call cannot be matched anymore, unlink it so that later lookups do not walk over it */
+                if (previous_offset == NO_UNORDERED_GROUP_CALL)
                 {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_058: [ If getting ignore_all_calls by calling umockcall_get_ignore_all_calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
-                    UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
-                    is_error = 1;
-                    break;
+                    bucket->first_call = next_offset;
                 }
                 else
                 {
-                    if ((umock_call_recorder->expected_calls[i].is_matched == 0) ||
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_057: [ If any expected call has ignore_all_calls set and the actual call is equal to it when comparing the 2 calls, then the call shall be considered matched and not added to the actual calls list. ]*/
-                        (ignore_all_calls > 0))
-                    {
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_017: [ Comparing the calls shall be done by calling umockcall_are_equal. ]*/
-                        int are_equal_result = umockcall_are_equal(umock_call_recorder->expected_calls[i].umockcall, mock_call);
-                        if (are_equal_result == 1)
-                        {
-                            /* Codes_SRS_UMOCKCALLRECORDER_01_016: [ If the call matches one of the expected calls, a handle to the matched call shall be filled into the matched_call argument. ]*/
-                            *matched_call = umock_call_recorder->expected_calls[i].umockcall;
-                            break;
-                        }
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
-                        else if (are_equal_result != 0)
-                        {
-                            is_error = 1;
-                            break;
-                        }
-                        else
-                        {
-                            if (ignore_all_calls == 0)
-                            {
-                                i = umock_call_recorder->expected_call_count;
-                                break;
-                            }
-                        }
-                    }
+                    group->calls[previous_offset].next_in_bucket = next_offset;
                 }
-            }
-
-            if ((umock_call_recorder->actual_call_count == 0) && (i < umock_call_recorder->expected_call_count))
-            {
-                umock_call_recorder->expected_calls[i].is_matched = 1;
+                if (bucket->last_call == offset)
+                {
+                    bucket->last_call = previous_offset;
+                }
+                offset = next_offset;
+                continue;
             }
             else
             {
-                i = umock_call_recorder->expected_call_count;
+                /* Codes_SRS_UMOCKCALLRECORDER_01_017: [ Comparing the calls shall be done by calling umockcall_are_equal. ]*/
+                int are_equal_result = umockcall_are_equal(umock_call_recorder->expected_calls[call_index].umockcall, mock_call);
+                if (are_equal_result == 1)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_016: [ If the call matches one of the expected calls, a handle to the matched call shall be filled into the matched_call argument. ]*/
+                    *matched_call = umock_call_recorder->expected_calls[call_index].umockcall;
+                    *matched_index = call_index;
+                    result = 1;
+                    break;
+                }
+                else if (are_equal_result != 0)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                    *matched_index = call_index;
+                    result = -1;
+                    break;
+                }
             }
+        }
+
+        previous_offset = offset;
+        offset = next_offset;
+    }
 
-            if (is_error)
+    if ((result == 0) && (umock_call_recorder->actual_call_count == 0))
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_168: [ If the actual call does not match any call of the unordered group and every call of the group was matched at least min_repeat_count times or has ignore_all_calls set, the group shall be done, all its calls shall be considered matched and the actual call shall be compared with the expected calls after the group. ]*/
+        while (group->first_unsatisfied_call < group->call_count)
+        {
+            size_t call_index = group->first_expected_call + group->first_unsatisfied_call;
+            int ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[call_index].umockcall);
+            if (ignore_all_calls < 0)
             {
-                UMOCK_LOG("umockcallrecorder: Error in finding a matched call.");
-                result = MU_FAILURE;
+                /* Codes_SRS_UMOCKCALLRECORDER_01_058: [ If getting ignore_all_calls by calling umockcall_get_ignore_all_calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
+                *matched_index = call_index;
+                result = -1;
+                break;
             }
-            else
+            else if (ignore_all_calls == 0)
+            {
+                size_t min_repeat_count;
+                size_t max_repeat_count;
+
+                if (get_expected_call_repeat_count(umock_call_recorder, call_index, &min_repeat_count, &max_repeat_count) != 0)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_148: [ If umockcall_get_repeat_count fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                    *matched_index = call_index;
+                    result = -1;
+                    break;
+                }
+                else if (umock_call_recorder->expected_calls[call_index].match_count < min_repeat_count)
+                {
+                    break;
+                }
+            }
+
+            group->first_unsatisfied_call++;
+        }
+
+        if ((result == 0) && (group->first_unsatisfied_call == group->call_count))
+        {
+            size_t i;
+
+            for (i = 0; i < group->call_count; i++)
+            {
+                umock_call_recorder->expected_calls[group->first_expected_call + i].is_matched = 1;
+            }
+
+            group->is_done = 1;
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+static void free_unordered_groups(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    if (umock_call_recorder->unordered_groups != NULL)
+    {
+        size_t i;
+
+        for (i = 0; i < umock_call_recorder->unordered_group_count; i++)
+        {
+            umockalloc_free(umock_call_recorder->unordered_groups[i].calls);
+            umockalloc_free(umock_call_recorder->unordered_groups[i].buckets);
+        }
+
+        umockalloc_free(umock_call_recorder->unordered_groups);
+        umock_call_recorder->unordered_groups = NULL;
+        umock_call_recorder->unordered_group_count = 0;
+    }
+
+    umock_call_recorder->open_unordered_group = NO_UNORDERED_GROUP;
+}
+
+static int clone_unordered_groups(UMOCKCALLRECORDER_HANDLE destination, UMOCKCALLRECORDER_HANDLE source)
+{
+    int result;
+
+    if (source->unordered_group_count == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        destination->unordered_groups = umockalloc_malloc(sizeof(UMOCK_UNORDERED_GROUP) * source->unordered_group_count);
+        if (destination->unordered_groups == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot allocate the unordered groups.");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            size_t i;
+
+            for (i = 0; i < source->unordered_group_count; i++)
             {
-                if (i == umock_call_recorder->expected_call_count)
+                UMOCK_UNORDERED_GROUP* group = &destination->unordered_groups[i];
+
+                *group = source->unordered_groups[i];
+                group->calls = NULL;
+                group->buckets = NULL;
+
+                if (group->call_capacity > 0)
                 {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_015: [ If the call does not match any of the expected calls, then umockcallrecorder_add_actual_call shall add the mock_call call to the actual call list maintained by umock_call_recorder. ]*/
-                    /* an unexpected call */
-                    UMOCKCALL_HANDLE* new_actual_calls = umockalloc_realloc(umock_call_recorder->actual_calls, sizeof(UMOCKCALL_HANDLE) * (umock_call_recorder->actual_call_count + 1));
-                    if (new_actual_calls == NULL)
+                    group->calls = umockalloc_malloc(sizeof(UMOCK_UNORDERED_GROUP_CALL) * group->call_capacity);
+                    group->buckets = umockalloc_malloc(sizeof(UMOCK_CALL_BUCKET) * group->call_capacity);
+                    if ((group->calls == NULL) ||
+                        (group->buckets == NULL))
                     {
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_020: [ If allocating memory for the actual calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
-                        UMOCK_LOG("umockcallrecorder: Cannot allocate memory for actual calls.");
-                        result = MU_FAILURE;
+                        UMOCK_LOG("umockcallrecorder: Cannot allocate the index of an unordered group.");
+                        umockalloc_free(group->calls);
+                        umockalloc_free(group->buckets);
+                        break;
                     }
-                    else
-                    {
-                        umock_call_recorder->actual_calls = new_actual_calls;
-                        umock_call_recorder->actual_calls[umock_call_recorder->actual_call_count++] = mock_call;
 
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_018: [ When no error is encountered, umockcallrecorder_add_actual_call shall return 0. ]*/
-                        result = 0;
-                    }
+                    (void)memcpy(group->calls, source->unordered_groups[i].calls, sizeof(UMOCK_UNORDERED_GROUP_CALL) * group->call_count);
+                    (void)memcpy(group->buckets, source->unordered_groups[i].buckets, sizeof(UMOCK_CALL_BUCKET) * group->call_capacity);
                 }
-                else
-                {
-                    umockcall_destroy(mock_call);
+            }
 
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_018: [ When no error is encountered, umockcallrecorder_add_actual_call shall return 0. ]*/
-                    result = 0;
+            /* the groups that were copied are freed with the destination call recorder */
+            destination->unordered_group_count = i;
+
+            if (i < source->unordered_group_count)
+            {
+                result = MU_FAILURE;
+            }
+            else
+            {
+                destination->open_unordered_group = source->open_unordered_group;
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+static void append_call_to_ignore_all_bucket(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    UMOCK_CALL_BUCKET* bucket = &umock_call_recorder->ignore_all_buckets[umock_call_recorder->expected_calls[index].function_name_hash & (umock_call_recorder->ignore_all_bucket_count - 1)];
+
+    umock_call_recorder->expected_calls[index].next_ignore_all_call = NO_IGNORE_ALL_CALL;
+    if (bucket->last_call == NO_IGNORE_ALL_CALL)
+    {
+        bucket->first_call = index;
+    }
+    else
+    {
+        umock_call_recorder->expected_calls[bucket->last_call].next_ignore_all_call = index;
+    }
+    bucket->last_call = index;
+}
+
+static int grow_ignore_all_index(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+    size_t new_bucket_count;
+
+    if (compute_grown_capacity(umock_call_recorder->ignore_all_bucket_count, umock_call_recorder->ignore_all_call_count + 1, sizeof(UMOCK_CALL_BUCKET), &new_bucket_count) != 0)
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        UMOCK_CALL_BUCKET* new_buckets = umockalloc_malloc(sizeof(UMOCK_CALL_BUCKET) * new_bucket_count);
+        if (new_buckets == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot allocate %zu buckets for the ignore all calls index.", new_bucket_count);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            UMOCK_CALL_BUCKET* old_buckets = umock_call_recorder->ignore_all_buckets;
+            size_t old_bucket_count = umock_call_recorder->ignore_all_bucket_count;
+            size_t i;
+
+            umock_call_recorder->ignore_all_buckets = new_buckets;
+            umock_call_recorder->ignore_all_bucket_count = new_bucket_count;
+
+            for (i = 0; i < new_bucket_count; i++)
+            {
+                new_buckets[i].first_call = NO_IGNORE_ALL_CALL;
+                new_buckets[i].last_call = NO_IGNORE_ALL_CALL;
+            }
+
+            /* the calls are indexed in ascending order, rehashing each old chain in order keeps the new chains in that order,
+               as the old chains that feed a new bucket hold disjoint sets of hashes */
+            for (i = 0; i < old_bucket_count; i++)
+            {
+                size_t index = old_buckets[i].first_call;
+                while (index != NO_IGNORE_ALL_CALL)
+                {
+                    size_t next_index = umock_call_recorder->expected_calls[index].next_ignore_all_call;
+                    append_call_to_ignore_all_bucket(umock_call_recorder, index);
+                    index = next_index;
                 }
             }
-
-            /* Codes_SRS_UMOCKCALLRECORDER_01_070: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall release the exclusive lock. ]*/
-            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+
+            if (old_buckets != NULL)
+            {
+                umockalloc_free(old_buckets);
+            }
+
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static int add_call_to_ignore_all_index(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    int result;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_173: [ When an expected call that has ignore_all_calls set ends up before the first unmatched expected call, umockcallrecorder_add_actual_call shall obtain the hash of its function name by calling umockcall_get_function_name_hash and add it to the index of the ignore_all_calls expected calls. ]*/
+    if (umockcall_get_function_name_hash(umock_call_recorder->expected_calls[index].umockcall, &umock_call_recorder->expected_calls[index].function_name_hash) != 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_174: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Cannot get the function name hash of an ignore_all_calls expected call.");
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_UMOCKCALLRECORDER_01_175: [ The index shall have at least as many buckets as indexed calls, its buckets being reallocated geometrically when it is full. ]*/
+    else if ((umock_call_recorder->ignore_all_call_count + 1 > umock_call_recorder->ignore_all_bucket_count) &&
+        (grow_ignore_all_index(umock_call_recorder) != 0))
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_176: [ If growing the index fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+        result = MU_FAILURE;
+    }
+    else
+    {
+        append_call_to_ignore_all_bucket(umock_call_recorder, index);
+        umock_call_recorder->ignore_all_call_count++;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int clone_ignore_all_index(UMOCKCALLRECORDER_HANDLE destination, UMOCKCALLRECORDER_HANDLE source)
+{
+    int result;
+
+    if (source->ignore_all_bucket_count == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        destination->ignore_all_buckets = umockalloc_malloc(sizeof(UMOCK_CALL_BUCKET) * source->ignore_all_bucket_count);
+        if (destination->ignore_all_buckets == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot allocate the ignore all calls index.");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            (void)memcpy(destination->ignore_all_buckets, source->ignore_all_buckets, sizeof(UMOCK_CALL_BUCKET) * source->ignore_all_bucket_count);
+            destination->ignore_all_bucket_count = source->ignore_all_bucket_count;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static void internal_umockcallrecorder_reset_all_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    /* Codes_SRS_UMOCKCALLRECORDER_01_005: [ umockcallrecorder_reset_all_calls shall free all the expected and actual calls for the call recorder identified by umock_call_recorder. ]*/
+    if (umock_call_recorder->expected_calls != NULL)
+    {
+        size_t i;
+        for (i = 0; i < umock_call_recorder->expected_call_count; i++)
+        {
+            umockcall_destroy(umock_call_recorder->expected_calls[i].umockcall);
+        }
+
+        umockalloc_free(umock_call_recorder->expected_calls);
+        umock_call_recorder->expected_calls = NULL;
+    }
+    umock_call_recorder->expected_call_count = 0;
+    umock_call_recorder->expected_call_capacity = 0;
+    umock_call_recorder->first_unmatched_expected_call = 0;
+    /* Codes_SRS_UMOCKCALLRECORDER_01_180: [ umockcallrecorder_reset_all_calls shall free the index of the ignore_all_calls expected calls. ]*/
+    if (umock_call_recorder->ignore_all_buckets != NULL)
+    {
+        umockalloc_free(umock_call_recorder->ignore_all_buckets);
+        umock_call_recorder->ignore_all_buckets = NULL;
+    }
+    umock_call_recorder->ignore_all_bucket_count = 0;
+
+    if (umock_call_recorder->actual_calls != NULL)
+    {
+        size_t i;
+        for (i = 0; i < umock_call_recorder->actual_call_count; i++)
+        {
+            umockcall_destroy(umock_call_recorder->actual_calls[i]);
+        }
+
+        umockalloc_free(umock_call_recorder->actual_calls);
+        umock_call_recorder->actual_calls = NULL;
+    }
+    umock_call_recorder->actual_call_count = 0;
+    umock_call_recorder->actual_call_capacity = 0;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_185: [ umockcallrecorder_reset_all_calls shall free the mismatch description of the first actual call. ]*/
+    if (umock_call_recorder->first_actual_call_mismatch != NULL)
+    {
+        umockalloc_free(umock_call_recorder->first_actual_call_mismatch);
+        umock_call_recorder->first_actual_call_mismatch = NULL;
+    }
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_132: [ umockcallrecorder_reset_all_calls shall free the actual calls buffered by the threads and not yet merged. ]*/
+    {
+        size_t i;
+        for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+        {
+            UMOCK_PER_THREAD_CALLS* thread_calls = umock_call_recorder->per_thread_calls[i];
+            size_t j;
+
+            if (thread_calls->lock != NULL)
+            {
+                thread_calls->lock->acquire_exclusive(thread_calls->lock);
+            }
+
+            for (j = 0; j < thread_calls->call_count; j++)
+            {
+                umockcall_destroy(thread_calls->calls[j].umockcall);
+            }
+            thread_calls->call_count = 0;
+
+            if (thread_calls->lock != NULL)
+            {
+                thread_calls->lock->release_exclusive(thread_calls->lock);
+            }
+        }
+    }
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_143: [ umockcallrecorder_reset_all_calls shall free the actual calls in the unexpected actual calls log that were not yet merged. ]*/
+    {
+        uint64_t unexpected_call_count = umockatomic_load_uint64(&umock_call_recorder->unexpected_call_count);
+        uint64_t i;
+
+        for (i = umock_call_recorder->merged_unexpected_call_count; i < unexpected_call_count; i++)
+        {
+            UMOCKCALL_HANDLE mock_call = take_unexpected_call(umock_call_recorder, i);
+            umockcall_destroy(mock_call);
+        }
+
+        umock_call_recorder->merged_unexpected_call_count = 0;
+        umockatomic_store_uint64(&umock_call_recorder->unexpected_call_count, 0);
+    }
+
+    umock_call_recorder->ignore_all_call_count = 0;
+    update_matchable_expected_call_count(umock_call_recorder);
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_172: [ umockcallrecorder_reset_all_calls shall free the unordered groups and close the open unordered group, if any. ]*/
+    free_unordered_groups(umock_call_recorder);
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_113: [ umockcallrecorder_reset_all_calls shall discard the cached stringified calls. ]*/
+    umockstringbuilder_clear(&umock_call_recorder->expected_calls_string);
+    umock_call_recorder->expected_calls_string_call_count = 0;
+    umock_call_recorder->expected_calls_string_cached_length = 0;
+    umock_call_recorder->expected_calls_string_start = 0;
+    umock_call_recorder->first_reported_expected_call = 0;
+    umockstringbuilder_clear(&umock_call_recorder->actual_calls_string);
+    umock_call_recorder->actual_calls_string_call_count = 0;
+}
+
+UMOCKCALLRECORDER_HANDLE umockcallrecorder_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
+{
+    UMOCKCALLRECORDER_HANDLE result;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_095: [ lock_factory_create_lock may be NULL. ]*/
+    /* Codes_SRS_UMOCKCALLRECORDER_01_001: [ umockcallrecorder_create shall create a new instance of a call recorder and return a non-NULL handle to it on success. ]*/
+    result = umockalloc_malloc(sizeof(UMOCKCALLRECORDER));
+    if (result == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_002: [ If any error occurs, umockcallrecorder_create shall return NULL. ]*/
+        UMOCK_LOG("umockalloc_malloc(%zu) failed", sizeof(UMOCKCALLRECORDER));
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_097: [ If lock_factory_create_lock is not NULL, umockcallrecorder_create shall call lock_factory_create_lock to create the lock used when working with the stored calls. ]*/
+        if (
+            (lock_factory_create_lock != NULL) && 
+            ((result->lock = lock_factory_create_lock(lock_factory_create_lock_params)) == NULL)
+            )
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_002: [ If any error occurs, umockcallrecorder_create shall return NULL. ]*/
+            UMOCK_LOG("lock_factory_create_lock failed");
+        }
+        else
+        {
+            size_t i;
+
+            if (lock_factory_create_lock == NULL)
+            {
+                result->lock = NULL;
+            }
+
+            result->expected_call_count = 0;
+            result->expected_call_capacity = 0;
+            result->expected_calls = NULL;
+            result->first_unmatched_expected_call = 0;
+            result->ignore_all_bucket_count = 0;
+            result->ignore_all_buckets = NULL;
+            umockstringbuilder_init(&result->expected_calls_string);
+            result->expected_calls_string_call_count = 0;
+            result->expected_calls_string_cached_length = 0;
+            result->expected_calls_string_start = 0;
+            result->first_reported_expected_call = 0;
+            result->actual_call_count = 0;
+            result->actual_call_capacity = 0;
+            result->actual_calls = NULL;
+            umockstringbuilder_init(&result->actual_calls_string);
+            result->actual_calls_string_call_count = 0;
+            result->first_actual_call_mismatch = NULL;
+            result->per_thread_calls_id = 0;
+            result->next_sequence_number = 0;
+            result->per_thread_calls_count = 0;
+            result->per_thread_calls = NULL;
+            result->ignore_all_call_count = 0;
+            result->matchable_expected_call_count = 0;
+            result->unexpected_call_count = 0;
+            result->merged_unexpected_call_count = 0;
+            result->unordered_group_count = 0;
+            result->unordered_groups = NULL;
+            result->open_unordered_group = NO_UNORDERED_GROUP;
+            for (i = 0; i < UNEXPECTED_CALL_SEGMENT_COUNT; i++)
+            {
+                result->unexpected_call_segments[i] = NULL;
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_096: [ lock_factory_create_lock shall be saved for later use. ]*/
+            result->lock_factory_create_lock = lock_factory_create_lock;
+            result->lock_factory_create_lock_params = lock_factory_create_lock_params;
+
+            goto all_ok;
+        }
+
+        umockalloc_free(result);
+        result = NULL;
+    }
+
+all_ok:
+    return result;
+}
+
+void umockcallrecorder_destroy(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    /* Codes_SRS_UMOCKCALLRECORDER_01_004: [ If umock_call_recorder is NULL, umockcallrecorder_destroy shall do nothing. ]*/
+    if (umock_call_recorder != NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_003: [ umockcallrecorder_destroy shall free the resources associated with a the call recorder identified by the umock_call_recorder argument. ]*/
+        internal_umockcallrecorder_reset_all_calls(umock_call_recorder);
+        if (umock_call_recorder->per_thread_calls != NULL)
+        {
+            size_t i;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_133: [ umockcallrecorder_destroy shall free the buffers of the threads and destroy their locks. ]*/
+            for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+            {
+                if (umock_call_recorder->per_thread_calls[i]->lock != NULL)
+                {
+                    umock_call_recorder->per_thread_calls[i]->lock->destroy(umock_call_recorder->per_thread_calls[i]->lock);
+                }
+                umockalloc_free(umock_call_recorder->per_thread_calls[i]->calls);
+                umockalloc_free(umock_call_recorder->per_thread_calls[i]);
+            }
+            umockalloc_free(umock_call_recorder->per_thread_calls);
+        }
+        {
+            size_t i;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_144: [ umockcallrecorder_destroy shall free the segments of the unexpected actual calls log. ]*/
+            for (i = 0; i < UNEXPECTED_CALL_SEGMENT_COUNT; i++)
+            {
+                if (umock_call_recorder->unexpected_call_segments[i] != NULL)
+                {
+                    umockalloc_free(umock_call_recorder->unexpected_call_segments[i]);
+                }
+            }
+        }
+        umockstringbuilder_deinit(&umock_call_recorder->actual_calls_string);
+        umockstringbuilder_deinit(&umock_call_recorder->expected_calls_string);
+        if (umock_call_recorder->lock != NULL)
+        {
+            umock_call_recorder->lock->destroy(umock_call_recorder->lock);
+        }
+        umockalloc_free(umock_call_recorder);
+    }
+}
+
+int umockcallrecorder_reset_all_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    if (umock_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_007: [ If umock_call_recorder is NULL, umockcallrecorder_reset_all_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Reset all calls failed: NULL umock_call_recorder.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_065: [ If a lock was created for the call recorder, umockcallrecorder_reset_all_calls shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            internal_umockcallrecorder_reset_all_calls(umock_call_recorder);
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_066: [ If a lock was created for the call recorder, umockcallrecorder_reset_all_calls shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_006: [ On success umockcallrecorder_reset_all_calls shall return 0. ]*/
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+int umockcallrecorder_reserve(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t expected_call_count, size_t actual_call_count)
+{
+    int result;
+
+    if (umock_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_104: [ If umock_call_recorder is NULL, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Reserve failed: NULL umock_call_recorder.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_105: [ If a lock was created for the call recorder, umockcallrecorder_reserve shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_103: [ umockcallrecorder_reserve shall make sure that the call recorder can hold at least expected_call_count expected calls and actual_call_count actual calls without reallocating its call arrays. ]*/
+            if (ensure_expected_call_capacity(umock_call_recorder, expected_call_count) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_107: [ If growing any of the call arrays fails, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot reserve %zu expected calls.", expected_call_count);
+                result = MU_FAILURE;
+            }
+            else if (ensure_actual_call_capacity(umock_call_recorder, actual_call_count) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_107: [ If growing any of the call arrays fails, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot reserve %zu actual calls.", actual_call_count);
+                result = MU_FAILURE;
+            }
+            else
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_108: [ On success umockcallrecorder_reserve shall return 0. ]*/
+                result = 0;
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_106: [ If a lock was created for the call recorder, umockcallrecorder_reserve shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
+
+/* the call recorder lock has to be held in exclusive mode */
+static int append_unexpected_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
+{
+    int result;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_102: [ The actual calls array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+    if (ensure_actual_call_capacity(umock_call_recorder, umock_call_recorder->actual_call_count + 1) != 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_020: [ If allocating memory for the actual calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Cannot allocate memory for actual calls.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        umock_call_recorder->actual_calls[umock_call_recorder->actual_call_count++] = mock_call;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int internal_add_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call, UMOCKCALL_HANDLE* matched_call)
+{
+    int result;
+    size_t i;
+    unsigned int is_error = 0;
+    /* index of the expected call where the matching stopped (matched or failed comparing) */
+    size_t matched_index = umock_call_recorder->expected_call_count;
+    /* the function name hash of the actual call, only obtained when an index has to be looked up */
+    size_t function_name_hash = 0;
+    unsigned int has_function_name_hash = 0;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_014: [ umockcallrecorder_add_actual_call shall check whether the call mock_call matches any of the expected calls maintained by umock_call_recorder. ]*/
+    /* Codes_SRS_UMOCK_C_LIB_01_115: [ umock_c shall compare calls in order. ]*/
+    /* Codes_SRS_UMOCKCALLRECORDER_01_099: [ The expected calls before the first unmatched expected call that have ignore_all_calls set shall be compared first, in the order they were added. ]*/
+    if (umock_call_recorder->ignore_all_call_count > 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_177: [ The hash of the function name of the actual call shall be obtained by calling umockcall_get_function_name_hash at most once per actual call, and only when it is needed to look up the ignore_all_calls expected calls or an unordered group. ]*/
+        if (umockcall_get_function_name_hash(mock_call, &function_name_hash) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_169: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot get the function name hash of an actual call.");
+            is_error = 1;
+        }
+        else
+        {
+            has_function_name_hash = 1;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_178: [ The actual call shall only be compared with the ignore_all_calls expected calls that have the same function name hash. ]*/
+            for (i = umock_call_recorder->ignore_all_buckets[function_name_hash & (umock_call_recorder->ignore_all_bucket_count - 1)].first_call;
+                i != NO_IGNORE_ALL_CALL;
+                i = umock_call_recorder->expected_calls[i].next_ignore_all_call)
+            {
+                if (umock_call_recorder->expected_calls[i].function_name_hash == function_name_hash)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_057: [ If any expected call has ignore_all_calls set and the actual call is equal to it when comparing the 2 calls, then the call shall be considered matched and not added to the actual calls list. ]*/
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_017: [ Comparing the calls shall be done by calling umockcall_are_equal. ]*/
+                    int are_equal_result = umockcall_are_equal(umock_call_recorder->expected_calls[i].umockcall, mock_call);
+                    if (are_equal_result == 1)
+                    {
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_016: [ If the call matches one of the expected calls, a handle to the matched call shall be filled into the matched_call argument. ]*/
+                        *matched_call = umock_call_recorder->expected_calls[i].umockcall;
+                        matched_index = i;
+                        break;
+                    }
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                    else if (are_equal_result != 0)
+                    {
+                        is_error = 1;
+                        matched_index = i;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_100: [ Afterwards the expected calls starting with the first unmatched expected call shall be compared in order, skipping matched calls, up to and including the first unmatched call that does not have ignore_all_calls set. ]*/
+    while ((is_error == 0) &&
+        (matched_index == umock_call_recorder->expected_call_count) &&
+        (umock_call_recorder->first_unmatched_expected_call < umock_call_recorder->expected_call_count))
+    {
+        size_t index = umock_call_recorder->first_unmatched_expected_call;
+        int ignore_all_calls;
+
+        if ((umock_call_recorder->expected_calls[index].unordered_group != NO_UNORDERED_GROUP) &&
+            (umock_call_recorder->unordered_groups[umock_call_recorder->expected_calls[index].unordered_group].is_done == 0))
+        {
+            int group_result;
+
+            if (has_function_name_hash == 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_177: [ The hash of the function name of the actual call shall be obtained by calling umockcall_get_function_name_hash at most once per actual call, and only when it is needed to look up the ignore_all_calls expected calls or an unordered group. ]*/
+                if (umockcall_get_function_name_hash(mock_call, &function_name_hash) != 0)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_169: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                    UMOCK_LOG("umockcallrecorder: Cannot get the function name hash of an actual call.");
+                    is_error = 1;
+                    matched_index = index;
+                    continue;
+                }
+
+                has_function_name_hash = 1;
+            }
+
+            group_result = match_unordered_group(umock_call_recorder, index, mock_call, function_name_hash, matched_call, &matched_index);
+            if (group_result < 0)
+            {
+                is_error = 1;
+            }
+            else if (group_result == 0)
+            {
+                break;
+            }
+            else
+            {
+                /* either matched (which ends the loop) or the group is done and the calls after it are compared */
+            }
+
+            continue;
+        }
+
+        ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[index].umockcall);
+        if (ignore_all_calls < 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_058: [ If getting ignore_all_calls by calling umockcall_get_ignore_all_calls fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
+            is_error = 1;
+            matched_index = index;
+        }
+        else if ((ignore_all_calls == 0) && (umock_call_recorder->expected_calls[index].is_matched != 0))
+        {
+            umock_call_recorder->first_unmatched_expected_call++;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_017: [ Comparing the calls shall be done by calling umockcall_are_equal. ]*/
+            int are_equal_result = umockcall_are_equal(umock_call_recorder->expected_calls[index].umockcall, mock_call);
+            if ((are_equal_result != 0) && (are_equal_result != 1))
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                is_error = 1;
+                matched_index = index;
+            }
+            else
+            {
+                if (are_equal_result == 1)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_016: [ If the call matches one of the expected calls, a handle to the matched call shall be filled into the matched_call argument. ]*/
+                    *matched_call = umock_call_recorder->expected_calls[index].umockcall;
+                    matched_index = index;
+                }
+
+                if (ignore_all_calls > 0)
+                {
+                    /* the call is now behind the first unmatched expected call, index it so that it is still compared against later actual calls */
+                    if (add_call_to_ignore_all_index(umock_call_recorder, index) != 0)
+                    {
+                        is_error = 1;
+                        matched_index = index;
+                    }
+                    else
+                    {
+                        umock_call_recorder->first_unmatched_expected_call++;
+                    }
+                }
+                else if ((are_equal_result == 0) && (umock_call_recorder->actual_call_count == 0))
+                {
+                    size_t min_repeat_count;
+                    size_t max_repeat_count;
+
+                    if (get_expected_call_repeat_count(umock_call_recorder, index, &min_repeat_count, &max_repeat_count) != 0)
+                    {
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_148: [ If umockcall_get_repeat_count fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                        is_error = 1;
+                        matched_index = index;
+                    }
+                    else if (umock_call_recorder->expected_calls[index].match_count >= min_repeat_count)
+                    {
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_147: [ If the actual call does not match the first unmatched expected call and that expected call was already matched at least min_repeat_count times, the expected call shall be considered matched and the actual call shall be compared with the expected calls after it. ]*/
+                        umock_call_recorder->expected_calls[index].is_matched = 1;
+                        umock_call_recorder->first_unmatched_expected_call++;
+                    }
+                    else
+                    {
+                        /* only the first unmatched call without ignore_all_calls can be matched */
+                        break;
+                    }
+                }
+                else
+                {
+                    /* only the first unmatched call without ignore_all_calls can be matched */
+                    break;
+                }
+            }
+        }
+    }
+
+    i = matched_index;
+    if ((umock_call_recorder->actual_call_count == 0) && (i < umock_call_recorder->expected_call_count))
+    {
+        size_t min_repeat_count;
+        size_t max_repeat_count;
+
+        if (is_error != 0)
+        {
+            /* the expected call that could not be compared is not compared again */
+            umock_call_recorder->expected_calls[i].is_matched = 1;
+        }
+        else if (get_expected_call_repeat_count(umock_call_recorder, i, &min_repeat_count, &max_repeat_count) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_148: [ If umockcall_get_repeat_count fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+            umock_call_recorder->expected_calls[i].is_matched = 1;
+            is_error = 1;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_146: [ umockcallrecorder_add_actual_call shall count the actual calls matched with each expected call and shall consider the expected call matched once it was matched max_repeat_count times, max_repeat_count being obtained by calling umockcall_get_repeat_count. ]*/
+            umock_call_recorder->expected_calls[i].match_count++;
+            if (umock_call_recorder->expected_calls[i].match_count >= max_repeat_count)
+            {
+                umock_call_recorder->expected_calls[i].is_matched = 1;
+            }
+
+            if (umock_call_recorder->expected_calls[i].unordered_group != NO_UNORDERED_GROUP)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_170: [ When an expected call of an unordered group that was already stringified is matched, umockcallrecorder_get_expected_calls shall stringify that call and the calls after it again. ]*/
+                drop_cached_expected_calls_string_from(umock_call_recorder, i);
+            }
+            else if ((min_repeat_count != 1) || (max_repeat_count != 1))
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_152: [ When the number of remaining calls of an expected call that was already stringified changes, umockcallrecorder_get_expected_calls shall stringify that call and the calls after it again. ]*/
+                drop_cached_expected_calls_string_from(umock_call_recorder, i);
+            }
+        }
+    }
+    else
+    {
+        i = umock_call_recorder->expected_call_count;
+    }
+
+    update_matchable_expected_call_count(umock_call_recorder);
+
+    if (is_error)
+    {
+        UMOCK_LOG("umockcallrecorder: Error in finding a matched call.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        if (i == umock_call_recorder->expected_call_count)
+        {
+            char* mismatch = NULL;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+            /* only the first actual call can be the final mismatch, so at most one description is built per test */
+            if ((umock_call_recorder->actual_call_count == 0) &&
+                (umock_call_recorder->first_unmatched_expected_call < umock_call_recorder->expected_call_count) &&
+                (umock_call_recorder->expected_calls[umock_call_recorder->first_unmatched_expected_call].unordered_group == NO_UNORDERED_GROUP))
+            {
+                mismatch = umockcall_stringify_mismatch(umock_call_recorder->expected_calls[umock_call_recorder->first_unmatched_expected_call].umockcall, mock_call);
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_015: [ If the call does not match any of the expected calls, then umockcallrecorder_add_actual_call shall add the mock_call call to the actual call list maintained by umock_call_recorder. ]*/
+            /* an unexpected call */
+            if (append_unexpected_actual_call(umock_call_recorder, mock_call) != 0)
+            {
+                if (mismatch != NULL)
+                {
+                    umockalloc_free(mismatch);
+                }
+
+                result = MU_FAILURE;
+            }
+            else
+            {
+                if (mismatch != NULL)
+                {
+                    umock_call_recorder->first_actual_call_mismatch = mismatch;
+                }
+
+                /* Codes_SRS_UMOCKCALLRECORDER_01_018: [ When no error is encountered, umockcallrecorder_add_actual_call shall return 0. ]*/
+                result = 0;
+            }
+        }
+        else
+        {
+            umockcall_destroy(mock_call);
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_018: [ When no error is encountered, umockcallrecorder_add_actual_call shall return 0. ]*/
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static UMOCK_PER_THREAD_CALLS* create_current_thread_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    UMOCK_PER_THREAD_CALLS* result;
+    UMOCK_PER_THREAD_CALLS** new_per_thread_calls = umockalloc_realloc(umock_call_recorder->per_thread_calls, sizeof(UMOCK_PER_THREAD_CALLS*) * (umock_call_recorder->per_thread_calls_count + 1));
+    if (new_per_thread_calls == NULL)
+    {
+        UMOCK_LOG("umockcallrecorder: Cannot grow the per thread calls array.");
+        result = NULL;
+    }
+    else
+    {
+        umock_call_recorder->per_thread_calls = new_per_thread_calls;
+
+        result = umockalloc_malloc(sizeof(UMOCK_PER_THREAD_CALLS));
+        if (result == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot allocate the per thread calls.");
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_126: [ If lock_factory_create_lock was given to umockcallrecorder_create, each thread buffer shall have its own lock created by calling lock_factory_create_lock. ]*/
+            if (
+                (umock_call_recorder->lock_factory_create_lock != NULL) &&
+                ((result->lock = umock_call_recorder->lock_factory_create_lock(umock_call_recorder->lock_factory_create_lock_params)) == NULL)
+                )
+            {
+                UMOCK_LOG("umockcallrecorder: Cannot create the lock for the per thread calls.");
+                umockalloc_free(result);
+                result = NULL;
+            }
+            else
+            {
+                if (umock_call_recorder->lock_factory_create_lock == NULL)
+                {
+                    result->lock = NULL;
+                }
+
+                result->thread_key = (const void*)&current_thread_recorder_id;
+                result->call_count = 0;
+                result->call_capacity = 0;
+                result->merged_call_count = 0;
+                result->calls = NULL;
+                umock_call_recorder->per_thread_calls[umock_call_recorder->per_thread_calls_count++] = result;
+            }
+        }
+    }
+
+    return result;
+}
+
+static UMOCK_PER_THREAD_CALLS* get_current_thread_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    UMOCK_PER_THREAD_CALLS* result;
+
+    if (current_thread_recorder_id == umock_call_recorder->per_thread_calls_id)
+    {
+        result = current_thread_calls;
+    }
+    else
+    {
+        size_t i;
+
+        /* Codes_SRS_UMOCKCALLRECORDER_01_125: [ The first time a thread adds an actual call, umockcallrecorder_add_actual_call shall look up or create the buffer of the thread while holding the call recorder lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            result = NULL;
+            for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+            {
+                if (umock_call_recorder->per_thread_calls[i]->thread_key == (const void*)&current_thread_recorder_id)
+                {
+                    result = umock_call_recorder->per_thread_calls[i];
+                    break;
+                }
+            }
+
+            if (result == NULL)
+            {
+                result = create_current_thread_calls(umock_call_recorder);
+            }
+
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+
+        if (result != NULL)
+        {
+            current_thread_recorder_id = umock_call_recorder->per_thread_calls_id;
+            current_thread_calls = result;
+        }
+    }
+
+    return result;
+}
+
+static int add_per_thread_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
+{
+    int result;
+    UMOCK_PER_THREAD_CALLS* thread_calls = get_current_thread_calls(umock_call_recorder);
+
+    if (thread_calls == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_128: [ If creating or growing the buffer of the thread fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Cannot get the per thread calls.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        if (thread_calls->lock != NULL)
+        {
+            thread_calls->lock->acquire_exclusive(thread_calls->lock);
+        }
+
+        if (ensure_thread_call_capacity(thread_calls, thread_calls->call_count + 1) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_128: [ If creating or growing the buffer of the thread fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot grow the per thread calls.");
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_124: [ umockcallrecorder_add_actual_call shall append mock_call to the buffer of the calling thread, together with a sequence number obtained by atomically incrementing a counter shared by all the threads of the call recorder. ]*/
+            /* the sequence number is taken with the thread lock held, so a merge sees either both the number and the call or none of them */
+            thread_calls->calls[thread_calls->call_count].sequence_number = umockatomic_increment_uint64(&umock_call_recorder->next_sequence_number);
+            thread_calls->calls[thread_calls->call_count].umockcall = mock_call;
+            thread_calls->call_count++;
+            result = 0;
+        }
+
+        if (thread_calls->lock != NULL)
+        {
+            thread_calls->lock->release_exclusive(thread_calls->lock);
+        }
+    }
+
+    return result;
+}
+
+/* the call recorder lock has to be held in exclusive mode */
+static int merge_per_thread_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result = 0;
+    size_t i;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_130: [ While merging, the lock of each thread buffer shall be held, so that no call is appended during the merge. ]*/
+    for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+    {
+        if (umock_call_recorder->per_thread_calls[i]->lock != NULL)
+        {
+            umock_call_recorder->per_thread_calls[i]->lock->acquire_exclusive(umock_call_recorder->per_thread_calls[i]->lock);
+        }
+    }
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_129: [ The calls buffered by all the threads shall be merged in the order of their sequence numbers, each call being matched against the expected calls exactly like umockcallrecorder_add_actual_call does when recording per thread is not enabled. ]*/
+    for (;;)
+    {
+        UMOCK_PER_THREAD_CALLS* next_thread_calls = NULL;
+        UMOCKCALL_HANDLE mock_call;
+        UMOCKCALL_HANDLE matched_call;
+
+        for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+        {
+            UMOCK_PER_THREAD_CALLS* thread_calls = umock_call_recorder->per_thread_calls[i];
+            if (
+                (thread_calls->merged_call_count < thread_calls->call_count) &&
+                ((next_thread_calls == NULL) ||
+                 (thread_calls->calls[thread_calls->merged_call_count].sequence_number < next_thread_calls->calls[next_thread_calls->merged_call_count].sequence_number))
+                )
+            {
+                next_thread_calls = thread_calls;
+            }
+        }
+
+        if (next_thread_calls == NULL)
+        {
+            break;
+        }
+
+        mock_call = next_thread_calls->calls[next_thread_calls->merged_call_count++].umockcall;
+        matched_call = NULL;
+        if (internal_add_actual_call(umock_call_recorder, mock_call, &matched_call) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot merge a per thread actual call.");
+            umockcall_destroy(mock_call);
+            result = MU_FAILURE;
+        }
+        else if (
+            (matched_call != NULL) &&
+            ((umockcall_get_fail_call(matched_call) != 0) || (umockcall_get_has_call_results(matched_call) != 0))
+            )
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_182: [ If a buffered call matches an expected call that has fail_call set or that hands values back to the actual call (umockcall_get_has_call_results returns a non-zero value), the remaining calls shall still be merged and the function that triggered the merge shall fail, since the call was made without seeing the expected call it matched. ]*/
+            UMOCK_LOG("umockcallrecorder: A per thread actual call matched an expected call whose return value, out arguments, captures or failure could not be applied to it.");
+            result = MU_FAILURE;
+        }
+    }
+
+    for (i = 0; i < umock_call_recorder->per_thread_calls_count; i++)
+    {
+        umock_call_recorder->per_thread_calls[i]->call_count = 0;
+        umock_call_recorder->per_thread_calls[i]->merged_call_count = 0;
+
+        if (umock_call_recorder->per_thread_calls[i]->lock != NULL)
+        {
+            umock_call_recorder->per_thread_calls[i]->lock->release_exclusive(umock_call_recorder->per_thread_calls[i]->lock);
+        }
+    }
+
+    return result;
+}
+
+static int add_unexpected_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
+{
+    int result;
+
+    for (;;)
+    {
+        uint64_t slot = umockatomic_load_uint64(&umock_call_recorder->unexpected_call_count);
+        size_t segment_index;
+        uint64_t offset;
+        UMOCKCALL_HANDLE* segment;
+
+        get_unexpected_call_slot_position(slot, &segment_index, &offset);
+        if (segment_index >= UNEXPECTED_CALL_SEGMENT_COUNT)
+        {
+            UMOCK_LOG("umockcallrecorder: The unexpected actual calls log is full.");
+            result = MU_FAILURE;
+            break;
+        }
+
+        segment = umockatomic_load_pointer((void* volatile*)&umock_call_recorder->unexpected_call_segments[segment_index]);
+        if (segment == NULL)
+        {
+            size_t segment_size = (size_t)1 << UNEXPECTED_CALL_FIRST_SEGMENT_SIZE_BITS;
+            size_t j;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_139: [ A segment shall be allocated by the first thread that needs it and published by an atomic compare-exchange, a thread that loses the race shall free its segment and use the published one. ]*/
+            for (j = 0; j < segment_index; j++)
+            {
+                if (segment_size > ((size_t)-1) / (2 * sizeof(UMOCKCALL_HANDLE)))
+                {
+                    break;
+                }
+                segment_size *= 2;
+            }
+
+            if ((j < segment_index) ||
+                ((segment = umockalloc_malloc(sizeof(UMOCKCALL_HANDLE) * segment_size)) == NULL))
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_140: [ If allocating a segment of the unexpected actual calls log fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot allocate segment %zu of the unexpected actual calls log.", segment_index);
+                result = MU_FAILURE;
+                break;
+            }
+
+            for (j = 0; j < segment_size; j++)
+            {
+                segment[j] = NULL;
+            }
+
+            if (!umockatomic_compare_exchange_pointer((void* volatile*)&umock_call_recorder->unexpected_call_segments[segment_index], NULL, segment))
+            {
+                umockalloc_free(segment);
+            }
+        }
+        /* Codes_SRS_UMOCKCALLRECORDER_01_138: [ The call shall be stored in the next slot of the log, the slot being reserved by an atomic compare-exchange of the log call count, so that many threads can record calls concurrently. ]*/
+        else if (umockatomic_compare_exchange_uint64(&umock_call_recorder->unexpected_call_count, slot, slot + 1))
+        {
+            umockatomic_store_pointer((void* volatile*)&segment[offset], mock_call);
+            result = 0;
+            break;
+        }
+    }
+
+    return result;
+}
+
+/* the call recorder lock has to be held in exclusive mode */
+static int merge_unexpected_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result = 0;
+    uint64_t unexpected_call_count = umockatomic_load_uint64(&umock_call_recorder->unexpected_call_count);
+
+    while (umock_call_recorder->merged_unexpected_call_count < unexpected_call_count)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+        /* Codes_SRS_UMOCKCALLRECORDER_01_181: [ A call in the unexpected actual calls log shall never match an expected call, since it was logged when no expected call could match and any expected call added meanwhile was added after it. ]*/
+        UMOCKCALL_HANDLE mock_call = take_unexpected_call(umock_call_recorder, umock_call_recorder->merged_unexpected_call_count);
+
+        umock_call_recorder->merged_unexpected_call_count++;
+        if (append_unexpected_actual_call(umock_call_recorder, mock_call) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot merge an unexpected actual call.");
+            umockcall_destroy(mock_call);
+            result = MU_FAILURE;
+        }
+
+        if (umock_call_recorder->merged_unexpected_call_count == unexpected_call_count)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_142: [ Once all the calls in the log are merged, the log shall be rewound by an atomic compare-exchange of the log call count with 0, so that its segments are reused. ]*/
+            if (umockatomic_compare_exchange_uint64(&umock_call_recorder->unexpected_call_count, unexpected_call_count, 0))
+            {
+                umock_call_recorder->merged_unexpected_call_count = 0;
+                unexpected_call_count = 0;
+            }
+            else
+            {
+                /* more calls were logged meanwhile, merge them too */
+                unexpected_call_count = umockatomic_load_uint64(&umock_call_recorder->unexpected_call_count);
+            }
+        }
+    }
+
+    return result;
+}
+
+/* the call recorder lock has to be held in exclusive mode */
+static int merge_pending_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    /* the unexpected actual calls log is only written while recording per thread is not enabled, so its calls come first */
+    if (merge_unexpected_actual_calls(umock_call_recorder) != 0)
+    {
+        (void)merge_per_thread_actual_calls(umock_call_recorder);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = merge_per_thread_actual_calls(umock_call_recorder);
+    }
+
+    return result;
+}
+
+int umockcallrecorder_add_expected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call)
+{
+    int result;
+
+    if ((umock_call_recorder == NULL) ||
+        (mock_call == NULL))
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_012: [ If any of the arguments is NULL, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Bad arguments in add expected call: umock_call_recorder = %p, mock_call = %p.",
+            umock_call_recorder, mock_call);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_068: [ If a lock was created for the call recorder, umockcallrecorder_add_expected_call shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_129: [ The calls buffered by all the threads shall be merged in the order of their sequence numbers, each call being matched against the expected calls exactly like umockcallrecorder_add_actual_call does when recording per thread is not enabled. ]*/
+            /* Codes_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+            /* merging before adding the expected call keeps the calls made before it from being matched against it */
+            if (merge_pending_actual_calls(umock_call_recorder) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_013: [ If any error occurs, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot merge the pending actual calls in add expected call.");
+                result = MU_FAILURE;
+            }
+            /* Codes_SRS_UMOCKCALLRECORDER_01_101: [ The expected calls array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+            else if (ensure_expected_call_capacity(umock_call_recorder, umock_call_recorder->expected_call_count + 1) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_013: [ If any error occurs, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot allocate memory in add expected call.");
+                result = MU_FAILURE;
+            }
+            else if ((umock_call_recorder->open_unordered_group != NO_UNORDERED_GROUP) &&
+                (add_call_to_open_unordered_group(umock_call_recorder, mock_call) != 0))
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_166: [ If adding mock_call to the open unordered group fails, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot add the expected call to the open unordered group.");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_008: [ umockcallrecorder_add_expected_call shall add the mock_call call to the expected call list maintained by the call recorder identified by umock_call_recorder. ]*/
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].umockcall = mock_call;
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].next_ignore_all_call = NO_IGNORE_ALL_CALL;
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].function_name_hash = 0;
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].match_count = 0;
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count].unordered_group = umock_call_recorder->open_unordered_group;
+                umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count++].is_matched = 0;
+                update_matchable_expected_call_count(umock_call_recorder);
+
+                /* Codes_SRS_UMOCKCALLRECORDER_01_009: [ On success umockcallrecorder_add_expected_call shall return 0. ]*/
+                result = 0;
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_069: [ If a lock was created for the call recorder, umockcallrecorder_add_expected_call shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
+
+int umockcallrecorder_add_actual_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, UMOCKCALL_HANDLE mock_call, UMOCKCALL_HANDLE* matched_call)
+{
+    int result;
+
+    if ((umock_call_recorder == NULL) ||
+        (mock_call == NULL) ||
+        (matched_call == NULL))
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_019: [ If any of the arguments is NULL, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: Bad arguments in add actual call: umock_call_recorder = %p, mock_call = %p, matched_call = %p.",
+            umock_call_recorder, mock_call, matched_call);
+        result = MU_FAILURE;
+    }
+    else if (umock_call_recorder->per_thread_calls_id != 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_127: [ When recording per thread is enabled, umockcallrecorder_add_actual_call shall set matched_call to NULL, as the call is only matched against the expected calls when merged. ]*/
+        *matched_call = NULL;
+
+        result = add_per_thread_actual_call(umock_call_recorder, mock_call);
+    }
+    else if (
+        (umock_call_recorder->lock != NULL) &&
+        (umockatomic_load_uint64(&umock_call_recorder->matchable_expected_call_count) == 0)
+        )
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_136: [ If a lock was created for the call recorder, recording per thread is not enabled and no expected call can match, umockcallrecorder_add_actual_call shall set matched_call to NULL and append mock_call to the unexpected actual calls log without acquiring the lock. ]*/
+        *matched_call = NULL;
+
+        result = add_unexpected_actual_call(umock_call_recorder, mock_call);
+    }
+    else
+    {
+        *matched_call = NULL;
+
+        /* Codes_SRS_UMOCKCALLRECORDER_01_071: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+            if (merge_unexpected_actual_calls(umock_call_recorder) != 0)
+            {
+                UMOCK_LOG("umockcallrecorder: Cannot merge the unexpected actual calls in add actual call.");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                result = internal_add_actual_call(umock_call_recorder, mock_call, matched_call);
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_070: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
+
+static void drop_matched_expected_calls_from_string(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    size_t i;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_112: [ Cached expected calls that were matched since the previous call shall be removed from the start of the string without stringifying any call. ]*/
+    while ((umock_call_recorder->first_reported_expected_call < umock_call_recorder->expected_calls_string_call_count) &&
+        ((umock_call_recorder->expected_calls[umock_call_recorder->first_reported_expected_call].is_matched != 0) ||
+        (umock_call_recorder->expected_calls[umock_call_recorder->first_reported_expected_call].stringified_end == umock_call_recorder->expected_calls_string_start)))
+    {
+        umock_call_recorder->expected_calls_string_start = umock_call_recorder->expected_calls[umock_call_recorder->first_reported_expected_call].stringified_end;
+        umock_call_recorder->first_reported_expected_call++;
+    }
+
+    /* move the string to the start of the buffer once more than half of it is made of dropped calls, so that the memory does not keep growing */
+    if ((umock_call_recorder->expected_calls_string_start > 0) &&
+        (umock_call_recorder->expected_calls_string_start >= umock_call_recorder->expected_calls_string_cached_length - umock_call_recorder->expected_calls_string_start))
+    {
+        size_t dropped_length = umock_call_recorder->expected_calls_string_start;
+
+        umock_call_recorder->expected_calls_string_cached_length -= dropped_length;
+        (void)memmove(umock_call_recorder->expected_calls_string.buffer, umock_call_recorder->expected_calls_string.buffer + dropped_length, umock_call_recorder->expected_calls_string_cached_length);
+        umock_call_recorder->expected_calls_string.length = umock_call_recorder->expected_calls_string_cached_length;
+        umock_call_recorder->expected_calls_string.buffer[umock_call_recorder->expected_calls_string_cached_length] = '\0';
+
+        for (i = umock_call_recorder->first_reported_expected_call; i < umock_call_recorder->expected_calls_string_call_count; i++)
+        {
+            umock_call_recorder->expected_calls[i].stringified_end -= dropped_length;
+        }
+
+        umock_call_recorder->expected_calls_string_start = 0;
+    }
+}
+
+static int append_expected_call_to_string(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    int result;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_055: [ Getting the ignore_all_calls property shall be done by calling umockcall_get_ignore_all_calls. ]*/
+    int ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[index].umockcall);
+    if (ignore_all_calls < 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_056: [ If umockcall_get_ignore_all_calls returns a negative value then umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+        UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
+        result = MU_FAILURE;
+    }
+    else if ((umock_call_recorder->expected_calls[index].is_matched != 0) ||
+        /* Codes_SRS_UMOCKCALLRECORDER_01_054: [ Calls that have the ignore_all_calls property set shall not be reported in the expected call list. ]*/
+        (ignore_all_calls != 0))
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t min_repeat_count;
+        size_t max_repeat_count;
+
+        if (get_expected_call_repeat_count(umock_call_recorder, index, &min_repeat_count, &max_repeat_count) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_151: [ If umockcall_get_repeat_count fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+            result = MU_FAILURE;
+        }
+        else if (umock_call_recorder->expected_calls[index].match_count >= min_repeat_count)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_149: [ Expected calls that were matched at least min_repeat_count times shall not be reported in the expected call list. ]*/
+            result = 0;
+        }
+        /* Codes_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
+        else if (umockcall_stringify_append(umock_call_recorder->expected_calls[index].umockcall, &umock_call_recorder->expected_calls_string) != 0)
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_030: [ If umockcall_stringify_append fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot stringify expected call.");
+            result = MU_FAILURE;
+        }
+        else if ((min_repeat_count != 1) || (max_repeat_count != 1))
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_150: [ For an expected call whose repeat count is not exactly 1, the stringified call shall be followed by " N remaining", where N is the number of calls still needed to reach min_repeat_count. ]*/
+            char remaining_string[64];
+            (void)sprintf(remaining_string, " %zu remaining", min_repeat_count - umock_call_recorder->expected_calls[index].match_count);
+            if (umockstringbuilder_append_string(&umock_call_recorder->expected_calls_string, remaining_string) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot append the remaining count of expected call.");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                result = 0;
+            }
+        }
+        else
+        {
+            result = 0;
         }
     }
 
@@ -373,88 +2014,62 @@ const char* umockcallrecorder_get_expected_calls(UMOCKCALLRECORDER_HANDLE umock_
     else
     {
         size_t i;
-        char* new_expected_calls_string;
-        size_t current_length = 0;
 
         /* Codes_SRS_UMOCKCALLRECORDER_01_076: [ If a lock was created for the call recorder, umockcallrecorder_get_expected_calls shall acquire the lock in exclusive mode. ]*/
         internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
         {
-            for (i = 0; i < umock_call_recorder->expected_call_count; i++)
+            if (merge_pending_actual_calls(umock_call_recorder) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot merge the pending actual calls in get expected calls.");
+                result = NULL;
+            }
+            else
             {
-                /* Codes_SRS_UMOCKCALLRECORDER_01_055: [ Getting the ignore_all_calls property shall be done by calling umockcall_get_ignore_all_calls. ]*/
-                int ignore_all_calls = umockcall_get_ignore_all_calls(umock_call_recorder->expected_calls[i].umockcall);
-                if (ignore_all_calls < 0)
+                /* Codes_SRS_UMOCKCALLRECORDER_01_109: [ umockcallrecorder_get_expected_calls shall build the string in a string builder owned by the call recorder, reusing the memory allocated by previous calls. ]*/
+                /* the last expected call is not cached, drop it */
+                umock_call_recorder->expected_calls_string.length = umock_call_recorder->expected_calls_string_cached_length;
+                if (umock_call_recorder->expected_calls_string.buffer != NULL)
                 {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_056: [ If umockcall_get_ignore_all_calls returns a negative value then umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-                    UMOCK_LOG("umockcallrecorder: Cannot get the ignore_all_calls flag.");
-                    break;
+                    umock_call_recorder->expected_calls_string.buffer[umock_call_recorder->expected_calls_string_cached_length] = '\0';
                 }
-                else
+
+                drop_matched_expected_calls_from_string(umock_call_recorder);
+
+                /* Codes_SRS_UMOCKCALLRECORDER_01_111: [ umockcallrecorder_get_expected_calls shall stringify only the expected calls that were not stringified by a previous call, except for the last expected call, which shall be stringified every time. ]*/
+                for (i = umock_call_recorder->expected_calls_string_call_count; i < umock_call_recorder->expected_call_count; i++)
                 {
-                    if ((umock_call_recorder->expected_calls[i].is_matched == 0) &&
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_054: [ Calls that have the ignore_all_calls property set shall not be reported in the expected call list. ]*/
-                        (ignore_all_calls == 0))
+                    if (append_expected_call_to_string(umock_call_recorder, i) != 0)
                     {
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
-                        char* stringified_call = umockcall_stringify(umock_call_recorder->expected_calls[i].umockcall);
-                        if (stringified_call == NULL)
-                        {
-                            /* Codes_SRS_UMOCKCALLRECORDER_01_030: [ If umockcall_stringify fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-                            break;
-                        }
-                        else
-                        {
-                            size_t stringified_call_length = strlen(stringified_call);
-                            new_expected_calls_string = umockalloc_realloc(umock_call_recorder->expected_calls_string, current_length + stringified_call_length + 1);
-                            if (new_expected_calls_string == NULL)
-                            {
-                                umockalloc_free(stringified_call);
-
-                                /* Codes_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-                                break;
-                            }
-                            else
-                            {
-                                umock_call_recorder->expected_calls_string = new_expected_calls_string;
-                                (void)memcpy(umock_call_recorder->expected_calls_string + current_length, stringified_call, stringified_call_length + 1);
-                                current_length += stringified_call_length;
-                            }
+                        break;
+                    }
 
-                            umockalloc_free(stringified_call);
-                        }
+                    if (i + 1 < umock_call_recorder->expected_call_count)
+                    {
+                        umock_call_recorder->expected_calls[i].stringified_end = umock_call_recorder->expected_calls_string.length;
+                        umock_call_recorder->expected_calls_string_cached_length = umock_call_recorder->expected_calls_string.length;
+                        umock_call_recorder->expected_calls_string_call_count = i + 1;
                     }
                 }
-            }
 
-            if (i < umock_call_recorder->expected_call_count)
-            {
-                result = NULL;
-            }
-            else
-            {
-                if (current_length == 0)
+                if (i < umock_call_recorder->expected_call_count)
+                {
+                    result = NULL;
+                }
+                else
                 {
-                    new_expected_calls_string = umockalloc_realloc(umock_call_recorder->expected_calls_string, 1);
-                    if (new_expected_calls_string == NULL)
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
+                    result = umockstringbuilder_get_string(&umock_call_recorder->expected_calls_string);
+                    if (result == NULL)
                     {
                         /* Codes_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
                         UMOCK_LOG("umockcallrecorder: Cannot allocate memory for expected calls.");
-                        result = NULL;
                     }
                     else
                     {
-                        umock_call_recorder->expected_calls_string = new_expected_calls_string;
-                        umock_call_recorder->expected_calls_string[0] = '\0';
-
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
-                        result = umock_call_recorder->expected_calls_string;
+                        result += umock_call_recorder->expected_calls_string_start;
                     }
                 }
-                else
-                {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
-                    result = umock_call_recorder->expected_calls_string;
-                }
             }
 
             /* Codes_SRS_UMOCKCALLRECORDER_01_077: [ If a lock was created for the call recorder, umockcallrecorder_get_expected_calls shall release the exclusive lock. ]*/
@@ -465,6 +2080,47 @@ const char* umockcallrecorder_get_expected_calls(UMOCKCALLRECORDER_HANDLE umock_
     return result;
 }
 
+/* the call recorder lock has to be held in exclusive mode */
+static int append_actual_call_to_string(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    int result;
+    size_t original_length = umock_call_recorder->actual_calls_string.length;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
+    if (umockcall_stringify_append(umock_call_recorder->actual_calls[index], &umock_call_recorder->actual_calls_string) != 0)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_025: [ If umockcall_stringify_append fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
+        UMOCK_LOG("umockcallrecorder: Cannot stringify actual call.");
+        result = MU_FAILURE;
+    }
+    else if ((index == 0) && (umock_call_recorder->first_actual_call_mismatch != NULL))
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_184: [ If a mismatch description was kept for the first actual call, the stringified first actual call shall be followed by a space and the description. ]*/
+        if ((umockstringbuilder_append_char(&umock_call_recorder->actual_calls_string, ' ') != 0) ||
+            (umockstringbuilder_append_string(&umock_call_recorder->actual_calls_string, umock_call_recorder->first_actual_call_mismatch) != 0))
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_026: [ If allocating memory for the resulting string fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
+            UMOCK_LOG("umockcallrecorder: Cannot append the mismatch description of the first actual call.");
+            umock_call_recorder->actual_calls_string.length = original_length;
+            if (umock_call_recorder->actual_calls_string.buffer != NULL)
+            {
+                umock_call_recorder->actual_calls_string.buffer[original_length] = '\0';
+            }
+            result = MU_FAILURE;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
 const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
 {
     const char* result;
@@ -478,62 +2134,28 @@ const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_ca
     else
     {
         size_t i;
-        char* new_actual_calls_string;
 
         /* Codes_SRS_UMOCKCALLRECORDER_01_073: [ If a lock was created for the call recorder, umockcallrecorder_get_actual_calls shall acquire the lock in exclusive mode. ]*/
         internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
         {
-            if (umock_call_recorder->actual_call_count == 0)
+            if (merge_pending_actual_calls(umock_call_recorder) != 0)
             {
-                new_actual_calls_string = umockalloc_realloc(umock_call_recorder->actual_calls_string, 1);
-                if (new_actual_calls_string == NULL)
-                {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_026: [ If allocating memory for the resulting string fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
-                    UMOCK_LOG("umockcallrecorder: Cannot allocate memory for actual calls.");
-                    result = NULL;
-                }
-                else
-                {
-                    umock_call_recorder->actual_calls_string = new_actual_calls_string;
-                    umock_call_recorder->actual_calls_string[0] = '\0';
-
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_022: [ umockcallrecorder_get_actual_calls shall return a pointer to the string representation of all the actual calls. ]*/
-                    result = umock_call_recorder->actual_calls_string;
-                }
+                /* Codes_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot merge the pending actual calls in get actual calls.");
+                result = NULL;
             }
             else
             {
-                size_t current_length = 0;
-
-                for (i = 0; i < umock_call_recorder->actual_call_count; i++)
+                /* Codes_SRS_UMOCKCALLRECORDER_01_110: [ umockcallrecorder_get_actual_calls shall build the string in a string builder owned by the call recorder, reusing the memory allocated by previous calls. ]*/
+                /* Codes_SRS_UMOCKCALLRECORDER_01_114: [ umockcallrecorder_get_actual_calls shall stringify only the actual calls that were not stringified by a previous call and append them to the previously built string. ]*/
+                for (i = umock_call_recorder->actual_calls_string_call_count; i < umock_call_recorder->actual_call_count; i++)
                 {
-                    /* Codes_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
-                    char* stringified_call = umockcall_stringify(umock_call_recorder->actual_calls[i]);
-                    if (stringified_call == NULL)
+                    if (append_actual_call_to_string(umock_call_recorder, i) != 0)
                     {
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_025: [ If umockcall_stringify fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
                         break;
                     }
-                    else
-                    {
-                        size_t stringified_call_length = strlen(stringified_call);
-                        new_actual_calls_string = umockalloc_realloc(umock_call_recorder->actual_calls_string, current_length + stringified_call_length + 1);
-                        if (new_actual_calls_string == NULL)
-                        {
-                            umockalloc_free(stringified_call);
 
-                            /* Codes_SRS_UMOCKCALLRECORDER_01_026: [ If allocating memory for the resulting string fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
-                            break;
-                        }
-                        else
-                        {
-                            umock_call_recorder->actual_calls_string = new_actual_calls_string;
-                            (void)memcpy(umock_call_recorder->actual_calls_string + current_length, stringified_call, stringified_call_length + 1);
-                            current_length += stringified_call_length;
-                        }
-
-                        umockalloc_free(stringified_call);
-                    }
+                    umock_call_recorder->actual_calls_string_call_count = i + 1;
                 }
 
                 if (i < umock_call_recorder->actual_call_count)
@@ -543,7 +2165,12 @@ const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_ca
                 else
                 {
                     /* Codes_SRS_UMOCKCALLRECORDER_01_022: [ umockcallrecorder_get_actual_calls shall return a pointer to the string representation of all the actual calls. ]*/
-                    result = umock_call_recorder->actual_calls_string;
+                    result = umockstringbuilder_get_string(&umock_call_recorder->actual_calls_string);
+                    if (result == NULL)
+                    {
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_026: [ If allocating memory for the resulting string fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
+                        UMOCK_LOG("umockcallrecorder: Cannot allocate memory for actual calls.");
+                    }
                 }
             }
 
@@ -555,6 +2182,40 @@ const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_ca
     return result;
 }
 
+static int unshare_expected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, size_t index)
+{
+    int result;
+    int is_shared = umockcall_is_shared(umock_call_recorder->expected_calls[index].umockcall);
+
+    if (is_shared < 0)
+    {
+        UMOCK_LOG("umockcallrecorder: Cannot find out whether expected call %zu is shared.", index);
+        result = MU_FAILURE;
+    }
+    else if (is_shared == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        UMOCKCALL_HANDLE own_call = umockcall_clone(umock_call_recorder->expected_calls[index].umockcall);
+        if (own_call == NULL)
+        {
+            UMOCK_LOG("umockcallrecorder: Cannot copy shared expected call %zu.", index);
+            result = MU_FAILURE;
+        }
+        else
+        {
+            /* this only releases the reference held by this call recorder */
+            umockcall_destroy(umock_call_recorder->expected_calls[index].umockcall);
+            umock_call_recorder->expected_calls[index].umockcall = own_call;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
 UMOCKCALL_HANDLE umockcallrecorder_get_last_expected_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
 {
     UMOCKCALL_HANDLE result;
@@ -567,8 +2228,8 @@ UMOCKCALL_HANDLE umockcallrecorder_get_last_expected_call(UMOCKCALLRECORDER_HAND
     }
     else
     {
-        /* Codes_SRS_UMOCKCALLRECORDER_01_079: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall acquire the lock in shared mode. ]*/
-        internal_lock_acquire_shared_if_needed(umock_call_recorder);
+        /* Codes_SRS_UMOCKCALLRECORDER_01_079: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
         {
             if (umock_call_recorder->expected_call_count == 0)
             {
@@ -576,21 +2237,64 @@ UMOCKCALL_HANDLE umockcallrecorder_get_last_expected_call(UMOCKCALLRECORDER_HAND
                 UMOCK_LOG("umockcallrecorder: No expected calls recorded.");
                 result = NULL;
             }
+            /* Codes_SRS_UMOCKCALLRECORDER_01_115: [ Since the caller can change the returned call, if the last expected call is shared with another call recorder (as indicated by umockcall_is_shared), umockcallrecorder_get_last_expected_call shall replace it with a copy obtained by calling umockcall_clone and release the shared call by calling umockcall_destroy. ]*/
+            else if (unshare_expected_call(umock_call_recorder, umock_call_recorder->expected_call_count - 1) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_116: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_get_last_expected_call shall fail and return NULL. ]*/
+                UMOCK_LOG("umockcallrecorder: Cannot get an unshared last expected call.");
+                result = NULL;
+            }
             else
             {
                 /* Codes_SRS_UMOCKCALLRECORDER_01_032: [ umockcallrecorder_get_last_expected_call shall return the last expected call for the umock_call_recorder call recorder. ]*/
                 result = umock_call_recorder->expected_calls[umock_call_recorder->expected_call_count - 1].umockcall;
             }
 
-            /* Codes_SRS_UMOCKCALLRECORDER_01_080: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall release the shared lock. ]*/
-            internal_lock_release_shared_if_needed(umock_call_recorder);
+            /* Codes_SRS_UMOCKCALLRECORDER_01_080: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
         }
     }
 
     return result;
 }
 
+static int merge_pending_actual_calls_exclusive(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    /* Codes_SRS_UMOCKCALLRECORDER_01_134: [ If recording per thread is enabled, umockcallrecorder_clone shall first merge the calls buffered by the threads while holding the lock of umock_call_recorder in exclusive mode. ]*/
+    /* Codes_SRS_UMOCKCALLRECORDER_01_145: [ If the unexpected actual calls log has calls that were not merged, umockcallrecorder_clone shall first merge them while holding the lock of umock_call_recorder in exclusive mode. ]*/
+    internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+    {
+        result = merge_pending_actual_calls(umock_call_recorder);
+
+        internal_lock_release_exclusive_if_needed(umock_call_recorder);
+    }
+
+    return result;
+}
+
 /* Codes_SRS_UMOCKCALLRECORDER_01_035: [ umockcallrecorder_clone shall clone a call recorder and return a handle to the newly cloned call recorder. ]*/
+static int clone_first_actual_call_mismatch(UMOCKCALLRECORDER_HANDLE destination, UMOCKCALLRECORDER_HANDLE source)
+{
+    int result;
+    size_t length = strlen(source->first_actual_call_mismatch);
+
+    destination->first_actual_call_mismatch = umockalloc_malloc(length + 1);
+    if (destination->first_actual_call_mismatch == NULL)
+    {
+        UMOCK_LOG("umockcallrecorder: Cannot allocate the mismatch description of the first actual call.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        (void)memcpy(destination->first_actual_call_mismatch, source->first_actual_call_mismatch, length + 1);
+        result = 0;
+    }
+
+    return result;
+}
+
 UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
 {
     UMOCKCALLRECORDER_HANDLE result;
@@ -601,6 +2305,15 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
         UMOCK_LOG("umockcallrecorder_clone: NULL umock_call_recorder.");
         result = NULL;
     }
+    else if (
+        ((umock_call_recorder->per_thread_calls_id != 0) || (umockatomic_load_uint64(&umock_call_recorder->unexpected_call_count) != 0)) &&
+        (merge_pending_actual_calls_exclusive(umock_call_recorder) != 0)
+        )
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+        UMOCK_LOG("umockcallrecorder_clone: Cannot merge the pending actual calls.");
+        result = NULL;
+    }
     else
     {
         /* Codes_SRS_UMOCKCALLRECORDER_01_082: [ If a lock was created for the call recorder umock_call_recorder, umockcallrecorder_clone shall acquire_the lock in shared mode for umock_call_recorder. ]*/
@@ -632,9 +2345,14 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
                     for (i = 0; i < umock_call_recorder->expected_call_count; i++)
                     {
                         result->expected_calls[i].is_matched = umock_call_recorder->expected_calls[i].is_matched;
-
-                        /* Codes_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be cloned by calling umockcall_clone. ]*/
-                        result->expected_calls[i].umockcall = umockcall_clone(umock_call_recorder->expected_calls[i].umockcall);
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_153: [ umockcallrecorder_clone shall also copy the number of actual calls matched with each expected call. ]*/
+                        result->expected_calls[i].match_count = umock_call_recorder->expected_calls[i].match_count;
+                        result->expected_calls[i].next_ignore_all_call = umock_call_recorder->expected_calls[i].next_ignore_all_call;
+                        result->expected_calls[i].function_name_hash = umock_call_recorder->expected_calls[i].function_name_hash;
+                        result->expected_calls[i].unordered_group = umock_call_recorder->expected_calls[i].unordered_group;
+
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be shared with the new call recorder by calling umockcall_share. ]*/
+                        result->expected_calls[i].umockcall = umockcall_share(umock_call_recorder->expected_calls[i].umockcall);
                         if (result->expected_calls[i].umockcall == NULL)
                         {
                             break;
@@ -659,9 +2377,28 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
                     else
                     {
                         result->expected_call_count = umock_call_recorder->expected_call_count;
+                        result->expected_call_capacity = umock_call_recorder->expected_call_count;
+                        result->first_unmatched_expected_call = umock_call_recorder->first_unmatched_expected_call;
+                        result->ignore_all_call_count = umock_call_recorder->ignore_all_call_count;
+                        update_matchable_expected_call_count(result);
 
-                        result->actual_calls = umockalloc_malloc(sizeof(UMOCKCALL_HANDLE) * umock_call_recorder->actual_call_count);
-                        if (result->actual_calls == NULL)
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_179: [ umockcallrecorder_clone shall copy the index of the ignore_all_calls expected calls. ]*/
+                        if (clone_ignore_all_index(result, umock_call_recorder) != 0)
+                        {
+                            /* Codes_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+                            umockcallrecorder_destroy(result);
+                            result = NULL;
+                            UMOCK_LOG("umockcallrecorder: clone call recorder failed - cannot copy the ignore all calls index.");
+                        }
+                        /* Codes_SRS_UMOCKCALLRECORDER_01_171: [ umockcallrecorder_clone shall copy the unordered groups and which unordered group is open, if any. ]*/
+                        else if (clone_unordered_groups(result, umock_call_recorder) != 0)
+                        {
+                            /* Codes_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+                            umockcallrecorder_destroy(result);
+                            result = NULL;
+                            UMOCK_LOG("umockcallrecorder: clone call recorder failed - cannot copy the unordered groups.");
+                        }
+                        else if ((result->actual_calls = umockalloc_malloc(sizeof(UMOCKCALL_HANDLE) * umock_call_recorder->actual_call_count)) == NULL)
                         {
                             /* Codes_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
                             umockcallrecorder_destroy(result);
@@ -678,8 +2415,8 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
                             /* Codes_SRS_UMOCKCALLRECORDER_01_041: [ umockcallrecorder_clone shall clone all the actual calls. ]*/
                             for (i = 0; i < umock_call_recorder->actual_call_count; i++)
                             {
-                                /* Codes_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be cloned by calling umockcall_clone. ]*/
-                                result->actual_calls[i] = umockcall_clone(umock_call_recorder->actual_calls[i]);
+                                /* Codes_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be shared with the new call recorder by calling umockcall_share. ]*/
+                                result->actual_calls[i] = umockcall_share(umock_call_recorder->actual_calls[i]);
                                 if (result->actual_calls[i] == NULL)
                                 {
                                     break;
@@ -704,6 +2441,26 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
                             else
                             {
                                 result->actual_call_count = umock_call_recorder->actual_call_count;
+                                result->actual_call_capacity = umock_call_recorder->actual_call_count;
+
+                                /* Codes_SRS_UMOCKCALLRECORDER_01_186: [ umockcallrecorder_clone shall copy the mismatch description of the first actual call. ]*/
+                                if ((umock_call_recorder->first_actual_call_mismatch != NULL) &&
+                                    (clone_first_actual_call_mismatch(result, umock_call_recorder) != 0))
+                                {
+                                    /* Codes_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+                                    umockcallrecorder_destroy(result);
+                                    result = NULL;
+                                    UMOCK_LOG("umockcallrecorder: clone call recorder failed - cannot copy the mismatch description of the first actual call.");
+                                }
+                                else if (umock_call_recorder->per_thread_calls_id != 0)
+                                {
+                                    /* Codes_SRS_UMOCKCALLRECORDER_01_135: [ If recording per thread is enabled for umock_call_recorder, it shall also be enabled for the cloned call recorder. ]*/
+                                    result->per_thread_calls_id = umockatomic_increment_uint64(&last_per_thread_calls_id);
+                                }
+                                else
+                                {
+                                    /* nothing else to copy */
+                                }
                             }
                         }
                     }
@@ -766,8 +2523,15 @@ int umockcallrecorder_fail_call(UMOCKCALLRECORDER_HANDLE umock_call_recorder, si
         /* Codes_SRS_UMOCKCALLRECORDER_01_089: [ If a lock was created for the call recorder, umockcallrecorder_fail_call shall acquire the lock in exclusive mode. ]*/
         internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
         {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_117: [ If the expected call is shared with another call recorder (as indicated by umockcall_is_shared), umockcallrecorder_fail_call shall first replace it with a copy obtained by calling umockcall_clone and release the shared call by calling umockcall_destroy. ]*/
+            if (unshare_expected_call(umock_call_recorder, index) != 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_118: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_fail_call shall return a non-zero value. ]*/
+                result = MU_FAILURE;
+                UMOCK_LOG("umockcallrecorder_fail_call: Cannot get an unshared expected call.");
+            }
             /* Codes_SRS_UMOCKCALLRECORDER_01_047: [ umockcallrecorder_fail_call shall mark an expected call as to be failed by calling umockcall_set_fail_call with a 1 value for fail_call. ]*/
-            if (umockcall_set_fail_call(umock_call_recorder->expected_calls[index].umockcall, 1) != 0)
+            else if (umockcall_set_fail_call(umock_call_recorder->expected_calls[index].umockcall, 1) != 0)
             {
                 /* Codes_SRS_UMOCKCALLRECORDER_01_051: [ If umockcall_set_fail_call fails, umockcallrecorder_fail_call shall return a non-zero value. ]*/
                 result = MU_FAILURE;
@@ -829,3 +2593,130 @@ int umockcallrecorder_can_call_fail(UMOCKCALLRECORDER_HANDLE umock_call_recorder
 
     return result;
 }
+
+int umockcallrecorder_enable_per_thread_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    if (umock_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_119: [ If umock_call_recorder is NULL, umockcallrecorder_enable_per_thread_actual_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: NULL umock_call_recorder in enable per thread actual calls.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_120: [ If a lock was created for the call recorder, umockcallrecorder_enable_per_thread_actual_calls shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            /* Codes_SRS_UMOCKCALLRECORDER_01_122: [ If recording per thread is already enabled, umockcallrecorder_enable_per_thread_actual_calls shall leave it enabled and return 0. ]*/
+            if (umock_call_recorder->per_thread_calls_id == 0)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_121: [ umockcallrecorder_enable_per_thread_actual_calls shall make all subsequent umockcallrecorder_add_actual_call calls record the actual calls per thread and return 0. ]*/
+                umock_call_recorder->per_thread_calls_id = umockatomic_increment_uint64(&last_per_thread_calls_id);
+            }
+
+            result = 0;
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_123: [ If a lock was created for the call recorder, umockcallrecorder_enable_per_thread_actual_calls shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
+
+int umockcallrecorder_begin_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    if (umock_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_154: [ If umock_call_recorder is NULL, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: NULL umock_call_recorder in begin unordered expected calls.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_155: [ If a lock was created for the call recorder, umockcallrecorder_begin_unordered_expected_calls shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            if (umock_call_recorder->open_unordered_group != NO_UNORDERED_GROUP)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_157: [ If an unordered group is already open, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: Unordered groups cannot be nested.");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                UMOCK_UNORDERED_GROUP* new_groups = umockalloc_realloc(umock_call_recorder->unordered_groups, sizeof(UMOCK_UNORDERED_GROUP) * (umock_call_recorder->unordered_group_count + 1));
+                if (new_groups == NULL)
+                {
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_158: [ If allocating memory for the unordered group fails, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+                    UMOCK_LOG("umockcallrecorder: Cannot allocate memory for the unordered group.");
+                    result = MU_FAILURE;
+                }
+                else
+                {
+                    UMOCK_UNORDERED_GROUP* group = &new_groups[umock_call_recorder->unordered_group_count];
+
+                    /* Codes_SRS_UMOCKCALLRECORDER_01_156: [ umockcallrecorder_begin_unordered_expected_calls shall open a new unordered group, to which all the expected calls added until umockcallrecorder_end_unordered_expected_calls is called are added, and return 0. ]*/
+                    group->first_expected_call = umock_call_recorder->expected_call_count;
+                    group->call_count = 0;
+                    group->call_capacity = 0;
+                    group->calls = NULL;
+                    group->buckets = NULL;
+                    group->first_unsatisfied_call = 0;
+                    group->is_done = 0;
+
+                    umock_call_recorder->unordered_groups = new_groups;
+                    umock_call_recorder->open_unordered_group = umock_call_recorder->unordered_group_count;
+                    umock_call_recorder->unordered_group_count++;
+
+                    result = 0;
+                }
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_159: [ If a lock was created for the call recorder, umockcallrecorder_begin_unordered_expected_calls shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
+
+int umockcallrecorder_end_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    int result;
+
+    if (umock_call_recorder == NULL)
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_160: [ If umock_call_recorder is NULL, umockcallrecorder_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockcallrecorder: NULL umock_call_recorder in end unordered expected calls.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKCALLRECORDER_01_161: [ If a lock was created for the call recorder, umockcallrecorder_end_unordered_expected_calls shall acquire the lock in exclusive mode. ]*/
+        internal_lock_acquire_exclusive_if_needed(umock_call_recorder);
+        {
+            if (umock_call_recorder->open_unordered_group == NO_UNORDERED_GROUP)
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_163: [ If no unordered group is open, umockcallrecorder_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("umockcallrecorder: No unordered group is open.");
+                result = MU_FAILURE;
+            }
+            else
+            {
+                /* Codes_SRS_UMOCKCALLRECORDER_01_162: [ umockcallrecorder_end_unordered_expected_calls shall close the open unordered group, so that the expected calls added afterwards are matched in order again, and return 0. ]*/
+                umock_call_recorder->open_unordered_group = NO_UNORDERED_GROUP;
+                result = 0;
+            }
+
+            /* Codes_SRS_UMOCKCALLRECORDER_01_164: [ If a lock was created for the call recorder, umockcallrecorder_end_unordered_expected_calls shall release the exclusive lock. ]*/
+            internal_lock_release_exclusive_if_needed(umock_call_recorder);
+        }
+    }
+
+    return result;
+}
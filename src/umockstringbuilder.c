@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umockalloc.h"
+#include "umock_c/umockstringbuilder.h"
+#include "umock_c/umock_log.h"
+
+void umockstringbuilder_init(UMOCKSTRINGBUILDER* string_builder)
+{
+    if (string_builder == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_002: [ If string_builder is NULL, umockstringbuilder_init shall return. ]*/
+        UMOCK_LOG("umockstringbuilder_init: NULL string_builder.");
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_001: [ umockstringbuilder_init shall initialize string_builder to an empty string without allocating any memory. ]*/
+        string_builder->buffer = NULL;
+        string_builder->length = 0;
+        string_builder->capacity = 0;
+    }
+}
+
+void umockstringbuilder_deinit(UMOCKSTRINGBUILDER* string_builder)
+{
+    if (string_builder == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_004: [ If string_builder is NULL, umockstringbuilder_deinit shall return. ]*/
+        UMOCK_LOG("umockstringbuilder_deinit: NULL string_builder.");
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_003: [ umockstringbuilder_deinit shall free the memory held by string_builder and leave it as an empty string. ]*/
+        if (string_builder->buffer != NULL)
+        {
+            umockalloc_free(string_builder->buffer);
+            string_builder->buffer = NULL;
+        }
+
+        string_builder->length = 0;
+        string_builder->capacity = 0;
+    }
+}
+
+void umockstringbuilder_clear(UMOCKSTRINGBUILDER* string_builder)
+{
+    if (string_builder == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_006: [ If string_builder is NULL, umockstringbuilder_clear shall return. ]*/
+        UMOCK_LOG("umockstringbuilder_clear: NULL string_builder.");
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_005: [ umockstringbuilder_clear shall set the length of the string held by string_builder to 0, keeping the allocated memory so that it can be reused. ]*/
+        string_builder->length = 0;
+        if (string_builder->buffer != NULL)
+        {
+            string_builder->buffer[0] = '\0';
+        }
+    }
+}
+
+int umockstringbuilder_reserve(UMOCKSTRINGBUILDER* string_builder, size_t additional_length)
+{
+    int result;
+
+    if (string_builder == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_008: [ If string_builder is NULL, umockstringbuilder_reserve shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockstringbuilder_reserve: NULL string_builder.");
+        result = MU_FAILURE;
+    }
+    else if (additional_length > SIZE_MAX - 1 - string_builder->length)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_012: [ If the needed size does not fit in a size_t, umockstringbuilder_reserve shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockstringbuilder_reserve: size overflow, length=%zu, additional_length=%zu.", string_builder->length, additional_length);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        size_t needed_capacity = string_builder->length + additional_length + 1;
+
+        if (needed_capacity <= string_builder->capacity)
+        {
+            /* Codes_SRS_UMOCKSTRINGBUILDER_01_009: [ If string_builder already has room for additional_length more characters (plus the NULL terminator), umockstringbuilder_reserve shall succeed without allocating memory. ]*/
+            result = 0;
+        }
+        else
+        {
+            char* new_buffer;
+
+            /* Codes_SRS_UMOCKSTRINGBUILDER_01_010: [ Otherwise umockstringbuilder_reserve shall grow the buffer by calling umockalloc_realloc to the larger of the needed size and twice the current capacity. ]*/
+            size_t new_capacity = (string_builder->capacity > (SIZE_MAX / 2)) ? SIZE_MAX : string_builder->capacity * 2;
+            if (new_capacity < needed_capacity)
+            {
+                new_capacity = needed_capacity;
+            }
+
+            new_buffer = (char*)umockalloc_realloc(string_builder->buffer, new_capacity);
+            if (new_buffer == NULL)
+            {
+                /* Codes_SRS_UMOCKSTRINGBUILDER_01_011: [ If umockalloc_realloc fails, umockstringbuilder_reserve shall fail, leave string_builder unchanged and return a non-zero value. ]*/
+                UMOCK_LOG("umockstringbuilder_reserve: Cannot grow buffer to %zu bytes.", new_capacity);
+                result = MU_FAILURE;
+            }
+            else
+            {
+                new_buffer[string_builder->length] = '\0';
+                string_builder->buffer = new_buffer;
+                string_builder->capacity = new_capacity;
+
+                /* Codes_SRS_UMOCKSTRINGBUILDER_01_007: [ umockstringbuilder_reserve shall make sure that additional_length characters can be appended to string_builder without any further allocation and on success return 0. ]*/
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+int umockstringbuilder_append(UMOCKSTRINGBUILDER* string_builder, const char* source, size_t source_length)
+{
+    int result;
+
+    if ((string_builder == NULL) ||
+        ((source == NULL) && (source_length > 0)))
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_014: [ If string_builder is NULL or source is NULL while source_length is non-zero, umockstringbuilder_append shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockstringbuilder_append: Invalid arguments string_builder=%p, source=%p, source_length=%zu.", (void*)string_builder, (const void*)source, source_length);
+        result = MU_FAILURE;
+    }
+    /* Codes_SRS_UMOCKSTRINGBUILDER_01_015: [ umockstringbuilder_append shall make room for the new characters by calling umockstringbuilder_reserve. ]*/
+    else if (umockstringbuilder_reserve(string_builder, source_length) != 0)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_016: [ If umockstringbuilder_reserve fails, umockstringbuilder_append shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockstringbuilder_append: Cannot reserve %zu characters.", source_length);
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_013: [ umockstringbuilder_append shall append source_length characters from source at the end of the string held by string_builder, keep the string NULL terminated and on success return 0. ]*/
+        if (source_length > 0)
+        {
+            (void)memcpy(string_builder->buffer + string_builder->length, source, source_length);
+            string_builder->length += source_length;
+        }
+
+        string_builder->buffer[string_builder->length] = '\0';
+        result = 0;
+    }
+
+    return result;
+}
+
+int umockstringbuilder_append_string(UMOCKSTRINGBUILDER* string_builder, const char* source)
+{
+    int result;
+
+    if (source == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_018: [ If source is NULL, umockstringbuilder_append_string shall fail and return a non-zero value. ]*/
+        UMOCK_LOG("umockstringbuilder_append_string: NULL source.");
+        result = MU_FAILURE;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_017: [ umockstringbuilder_append_string shall append the NULL terminated string source by calling umockstringbuilder_append and return its result. ]*/
+        result = umockstringbuilder_append(string_builder, source, strlen(source));
+    }
+
+    return result;
+}
+
+int umockstringbuilder_append_char(UMOCKSTRINGBUILDER* string_builder, char c)
+{
+    /* Codes_SRS_UMOCKSTRINGBUILDER_01_019: [ umockstringbuilder_append_char shall append the character c by calling umockstringbuilder_append and return its result. ]*/
+    return umockstringbuilder_append(string_builder, &c, 1);
+}
+
+const char* umockstringbuilder_get_string(UMOCKSTRINGBUILDER* string_builder)
+{
+    const char* result;
+
+    if (string_builder == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_021: [ If string_builder is NULL, umockstringbuilder_get_string shall fail and return NULL. ]*/
+        UMOCK_LOG("umockstringbuilder_get_string: NULL string_builder.");
+        result = NULL;
+    }
+    /* Codes_SRS_UMOCKSTRINGBUILDER_01_022: [ If no memory was allocated yet for string_builder, umockstringbuilder_get_string shall allocate memory for an empty string by calling umockstringbuilder_reserve. ]*/
+    else if (umockstringbuilder_reserve(string_builder, 0) != 0)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_023: [ If umockstringbuilder_reserve fails, umockstringbuilder_get_string shall fail and return NULL. ]*/
+        UMOCK_LOG("umockstringbuilder_get_string: Cannot allocate memory for the string.");
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_020: [ umockstringbuilder_get_string shall return the NULL terminated string held by string_builder. The string remains owned by string_builder. ]*/
+        result = string_builder->buffer;
+    }
+
+    return result;
+}
+
+char* umockstringbuilder_detach(UMOCKSTRINGBUILDER* string_builder)
+{
+    char* result;
+
+    /* Codes_SRS_UMOCKSTRINGBUILDER_01_025: [ umockstringbuilder_detach shall obtain the string by calling umockstringbuilder_get_string. ]*/
+    if (umockstringbuilder_get_string(string_builder) == NULL)
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_026: [ If umockstringbuilder_get_string fails, umockstringbuilder_detach shall fail and return NULL. ]*/
+        UMOCK_LOG("umockstringbuilder_detach: Cannot get the string.");
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_UMOCKSTRINGBUILDER_01_024: [ umockstringbuilder_detach shall return the NULL terminated string held by string_builder, transfer its ownership to the caller and leave string_builder as an empty string that holds no memory. ]*/
+        result = string_builder->buffer;
+        string_builder->buffer = NULL;
+        string_builder->length = 0;
+        string_builder->capacity = 0;
+    }
+
+    return result;
+}
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "macro_utils/macro_utils.h" 
@@ -9,15 +10,18 @@
 #include "umock_c/umocktypes.h"
 #include "umock_c/umocktypename.h"
 #include "umock_c/umockalloc.h"
+#include "umock_c/umockatomic.h"
 #include "umock_c/umock_log.h"
 
+/* the registered types are kept in an open addressing hash table (linear probing) keyed on the normalized type name.
+   Each entry is allocated individually so that pointers to handlers stay valid while the table grows. */
+#define TYPE_HANDLER_TABLE_INITIAL_SIZE 64
+
 typedef struct UMOCK_VALUE_TYPE_HANDLERS_TAG
 {
     char* type;
-    UMOCKTYPE_STRINGIFY_FUNC stringify_func;
-    UMOCKTYPE_COPY_FUNC copy_func;
-    UMOCKTYPE_FREE_FUNC free_func;
-    UMOCKTYPE_ARE_EQUAL_FUNC are_equal_func;
+    size_t hash;
+    UMOCKTYPE_HANDLERS handlers;
 } UMOCK_VALUE_TYPE_HANDLERS;
 
 typedef enum UMOCKTYPES_STATE_TAG
@@ -26,30 +30,421 @@ typedef enum UMOCKTYPES_STATE_TAG
     UMOCKTYPES_STATE_INITIALIZED
 } UMOCKTYPES_STATE;
 
-static UMOCK_VALUE_TYPE_HANDLERS* type_handlers = NULL;
+/* the type names passed to stringify/are_equal/copy/free are mostly MU_TOSTRING literals, so the set of different spellings is small.
+   The type name cache maps such a spelling (as passed by the caller) to the handlers it resolved to, which avoids normalizing
+   (and allocating) on every call.
+   The generated mocks resolve types from any thread, so the cache is an open addressing table whose slots are claimed with
+   a compare-exchange and never move. When the table is half full it is replaced by a table twice as big holding the same entries.
+   Other threads can still be probing a replaced table, so replaced tables and the entries (which are shared between tables) are
+   only freed when the cache is cleared: when types are registered, which (like the registration itself) is not expected to happen
+   while mocks are being called, or when the module is deinitialized. */
+#define TYPE_NAME_CACHE_INITIAL_SIZE 256
+
+typedef struct UMOCK_TYPE_NAME_CACHE_ENTRY_TAG
+{
+    size_t hash;
+    UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
+    /* links all published entries, so that each of them is freed exactly once */
+    struct UMOCK_TYPE_NAME_CACHE_ENTRY_TAG* next_entry;
+    /* points to the memory right after the entry */
+    char* raw_type;
+} UMOCK_TYPE_NAME_CACHE_ENTRY;
+
+typedef struct UMOCK_TYPE_NAME_CACHE_TAG
+{
+    size_t size;
+    volatile uint64_t count;
+    /* the table this one replaced */
+    struct UMOCK_TYPE_NAME_CACHE_TAG* replaced_cache;
+    /* points to the memory right after the table */
+    UMOCK_TYPE_NAME_CACHE_ENTRY* volatile* slots;
+} UMOCK_TYPE_NAME_CACHE;
+
+static UMOCK_VALUE_TYPE_HANDLERS** type_handler_table = NULL;
+static size_t type_handler_table_size = 0;
 static size_t type_handler_count = 0;
+static UMOCK_TYPE_NAME_CACHE* volatile type_name_cache = NULL;
+static UMOCK_TYPE_NAME_CACHE_ENTRY* volatile type_name_cache_entries = NULL;
 static UMOCKTYPES_STATE umocktypes_state = UMOCKTYPES_STATE_NOT_INITIALIZED;
+/* bumped whenever previously resolved handlers might not be valid anymore, starts at 1 so that a zero initialized binding is always stale */
+static size_t type_handlers_generation = 1;
+
+static size_t get_type_name_hash(const char* type_name)
+{
+    /* FNV-1a */
+    size_t result = (size_t)2166136261U;
+    while (*type_name != '\0')
+    {
+        result ^= (unsigned char)*type_name;
+        result *= (size_t)16777619U;
+        type_name++;
+    }
+
+    return result;
+}
 
 static UMOCK_VALUE_TYPE_HANDLERS* get_value_type_handlers(const char* type_name)
 {
-    UMOCK_VALUE_TYPE_HANDLERS* result;
-    size_t i;
+    UMOCK_VALUE_TYPE_HANDLERS* result = NULL;
 
-    for (i = 0; i < type_handler_count; i++)
+    if (type_handler_table_size > 0)
     {
-        if (strcmp(type_handlers[i].type, type_name) == 0)
+        size_t hash = get_type_name_hash(type_name);
+        size_t mask = type_handler_table_size - 1;
+        size_t slot = hash & mask;
+
+        /* the table is never full, so an empty slot always ends the probe sequence */
+        while (type_handler_table[slot] != NULL)
         {
+            if ((type_handler_table[slot]->hash == hash) &&
+                (strcmp(type_handler_table[slot]->type, type_name) == 0))
+            {
+                result = type_handler_table[slot];
+                break;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return result;
+}
+
+static void insert_value_type_handlers(UMOCK_VALUE_TYPE_HANDLERS** table, size_t table_size, UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers)
+{
+    size_t mask = table_size - 1;
+    size_t slot = value_type_handlers->hash & mask;
+
+    while (table[slot] != NULL)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    table[slot] = value_type_handlers;
+}
+
+static int ensure_type_handler_table_capacity(void)
+{
+    int result;
+
+    /* keep the load factor at or below 1/2 */
+    if ((type_handler_count + 1) * 2 <= type_handler_table_size)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t new_table_size = (type_handler_table_size == 0) ? TYPE_HANDLER_TABLE_INITIAL_SIZE : type_handler_table_size * 2;
+        UMOCK_VALUE_TYPE_HANDLERS** new_table = (UMOCK_VALUE_TYPE_HANDLERS**)umockalloc_malloc(sizeof(UMOCK_VALUE_TYPE_HANDLERS*) * new_table_size);
+        if (new_table == NULL)
+        {
+            UMOCK_LOG("Could not allocate type handler table of %zu entries.\r\n", new_table_size);
+            result = __LINE__;
+        }
+        else
+        {
+            size_t i;
+
+            (void)memset(new_table, 0, sizeof(UMOCK_VALUE_TYPE_HANDLERS*) * new_table_size);
+            for (i = 0; i < type_handler_table_size; i++)
+            {
+                if (type_handler_table[i] != NULL)
+                {
+                    insert_value_type_handlers(new_table, new_table_size, type_handler_table[i]);
+                }
+            }
+
+            umockalloc_free(type_handler_table);
+            type_handler_table = new_table;
+            type_handler_table_size = new_table_size;
+
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static void clear_type_name_cache(void)
+{
+    UMOCK_TYPE_NAME_CACHE* cache = type_name_cache;
+    UMOCK_TYPE_NAME_CACHE_ENTRY* entry = type_name_cache_entries;
+
+    while (cache != NULL)
+    {
+        UMOCK_TYPE_NAME_CACHE* replaced_cache = cache->replaced_cache;
+        umockalloc_free(cache);
+        cache = replaced_cache;
+    }
+
+    while (entry != NULL)
+    {
+        UMOCK_TYPE_NAME_CACHE_ENTRY* next_entry = entry->next_entry;
+        umockalloc_free(entry);
+        entry = next_entry;
+    }
+
+    type_name_cache = NULL;
+    type_name_cache_entries = NULL;
+}
+
+static UMOCK_TYPE_NAME_CACHE* create_type_name_cache(size_t size)
+{
+    UMOCK_TYPE_NAME_CACHE* result = (UMOCK_TYPE_NAME_CACHE*)umockalloc_malloc(sizeof(UMOCK_TYPE_NAME_CACHE) + (sizeof(UMOCK_TYPE_NAME_CACHE_ENTRY*) * size));
+    if (result == NULL)
+    {
+        UMOCK_LOG("Could not allocate type name cache of %zu entries.\r\n", size);
+    }
+    else
+    {
+        result->size = size;
+        result->count = 0;
+        result->replaced_cache = NULL;
+        result->slots = (UMOCK_TYPE_NAME_CACHE_ENTRY* volatile*)(result + 1);
+        (void)memset((void*)result->slots, 0, sizeof(UMOCK_TYPE_NAME_CACHE_ENTRY*) * size);
+    }
+
+    return result;
+}
+
+static UMOCK_VALUE_TYPE_HANDLERS* get_cached_value_type_handlers(const char* raw_type, size_t hash)
+{
+    UMOCK_VALUE_TYPE_HANDLERS* result = NULL;
+    UMOCK_TYPE_NAME_CACHE* cache = umockatomic_load_pointer((void* volatile*)&type_name_cache);
+
+    if (cache != NULL)
+    {
+        size_t mask = cache->size - 1;
+        size_t slot = hash & mask;
+        size_t probe_count;
+
+        /* Codes_SRS_UMOCKTYPES_01_080: [ Looking up a type string in the cache shall not take any lock, the cache slots shall be read with atomic loads. ]*/
+        for (probe_count = 0; probe_count < cache->size; probe_count++)
+        {
+            UMOCK_TYPE_NAME_CACHE_ENTRY* entry = umockatomic_load_pointer((void* volatile*)&cache->slots[slot]);
+            if (entry == NULL)
+            {
+                break;
+            }
+
+            if ((entry->hash == hash) &&
+                (strcmp(entry->raw_type, raw_type) == 0))
+            {
+                result = entry->value_type_handlers;
+                break;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return result;
+}
+
+/* returns non-zero if new_entry was not published (the same type string is already in the cache or there is no free slot) */
+static int publish_cache_entry(UMOCK_TYPE_NAME_CACHE* cache, UMOCK_TYPE_NAME_CACHE_ENTRY* new_entry)
+{
+    int result = MU_FAILURE;
+    size_t mask = cache->size - 1;
+    size_t slot = new_entry->hash & mask;
+    size_t probe_count;
+
+    for (probe_count = 0; probe_count < cache->size; probe_count++)
+    {
+        /* Codes_SRS_UMOCKTYPES_01_081: [ A new cache entry shall be fully initialized before being published in a free slot with an atomic compare-exchange, so that several threads can add entries concurrently. ]*/
+        UMOCK_TYPE_NAME_CACHE_ENTRY* entry;
+        if (umockatomic_compare_exchange_pointer((void* volatile*)&cache->slots[slot], NULL, new_entry))
+        {
+            (void)umockatomic_increment_uint64(&cache->count);
+            result = 0;
+            break;
+        }
+
+        entry = umockatomic_load_pointer((void* volatile*)&cache->slots[slot]);
+        if ((entry->hash == new_entry->hash) &&
+            (strcmp(entry->raw_type, new_entry->raw_type) == 0))
+        {
+            /* Codes_SRS_UMOCKTYPES_01_082: [ If another thread cached the same type string in the meantime, the new entry shall be discarded. ]*/
             break;
         }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return result;
+}
+
+/* returns the cache new entries should be added to, NULL if there is none */
+static UMOCK_TYPE_NAME_CACHE* get_type_name_cache_with_free_slots(void)
+{
+    UMOCK_TYPE_NAME_CACHE* cache = umockatomic_load_pointer((void* volatile*)&type_name_cache);
+
+    if (cache == NULL)
+    {
+        UMOCK_TYPE_NAME_CACHE* new_cache = create_type_name_cache(TYPE_NAME_CACHE_INITIAL_SIZE);
+        if (new_cache != NULL)
+        {
+            if (!umockatomic_compare_exchange_pointer((void* volatile*)&type_name_cache, NULL, new_cache))
+            {
+                /* another thread created the cache in the meantime */
+                umockalloc_free(new_cache);
+            }
+
+            cache = umockatomic_load_pointer((void* volatile*)&type_name_cache);
+        }
+    }
+    else if (umockatomic_load_uint64(&cache->count) * 2 >= cache->size)
+    {
+        /* Codes_SRS_UMOCKTYPES_01_084: [ If half of the cache slots are used, the cache shall be replaced by a cache with twice as many slots holding the same entries. ]*/
+        UMOCK_TYPE_NAME_CACHE* new_cache = create_type_name_cache(cache->size * 2);
+        if (new_cache != NULL)
+        {
+            size_t i;
+
+            /* entries published in the old table while copying simply do not make it into the new one, they get cached again on their next lookup */
+            for (i = 0; i < cache->size; i++)
+            {
+                UMOCK_TYPE_NAME_CACHE_ENTRY* entry = umockatomic_load_pointer((void* volatile*)&cache->slots[i]);
+                if (entry != NULL)
+                {
+                    (void)publish_cache_entry(new_cache, entry);
+                }
+            }
+
+            /* Codes_SRS_UMOCKTYPES_01_085: [ A replaced cache shall only be freed when all cached type strings are discarded, since other threads can still be reading it. ]*/
+            new_cache->replaced_cache = cache;
+            if (!umockatomic_compare_exchange_pointer((void* volatile*)&type_name_cache, cache, new_cache))
+            {
+                /* another thread replaced the cache in the meantime */
+                umockalloc_free(new_cache);
+            }
+        }
+
+        cache = umockatomic_load_pointer((void* volatile*)&type_name_cache);
+        if (umockatomic_load_uint64(&cache->count) * 2 >= cache->size)
+        {
+            cache = NULL;
+        }
+    }
+    else
+    {
+        /* there are free slots */
+    }
+
+    return cache;
+}
+
+/* caching is only an optimization, if anything fails here the type simply stays uncached */
+static void add_cached_value_type_handlers(const char* raw_type, size_t hash, UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers)
+{
+    UMOCK_TYPE_NAME_CACHE* cache = get_type_name_cache_with_free_slots();
+    if (cache != NULL)
+    {
+        size_t raw_type_length = strlen(raw_type);
+        UMOCK_TYPE_NAME_CACHE_ENTRY* new_entry = (UMOCK_TYPE_NAME_CACHE_ENTRY*)umockalloc_malloc(sizeof(UMOCK_TYPE_NAME_CACHE_ENTRY) + raw_type_length + 1);
+        if (new_entry != NULL)
+        {
+            new_entry->raw_type = (char*)(new_entry + 1);
+            new_entry->hash = hash;
+            new_entry->value_type_handlers = value_type_handlers;
+            (void)memcpy(new_entry->raw_type, raw_type, raw_type_length + 1);
+
+            if (publish_cache_entry(cache, new_entry) != 0)
+            {
+                umockalloc_free(new_entry);
+            }
+            else
+            {
+                /* keep track of the entry so that it is freed when the cache is cleared */
+                do
+                {
+                    new_entry->next_entry = umockatomic_load_pointer((void* volatile*)&type_name_cache_entries);
+                } while (!umockatomic_compare_exchange_pointer((void* volatile*)&type_name_cache_entries, new_entry->next_entry, new_entry));
+            }
+        }
     }
+}
 
-    if (i < type_handler_count)
+/* Resolves the handlers for type. Returns non-zero if normalizing the type fails. *value_type_handlers is set to NULL if the type is not registered. */
+static int resolve_value_type_handlers(const char* type, UMOCK_VALUE_TYPE_HANDLERS** value_type_handlers)
+{
+    int result;
+    size_t hash = get_type_name_hash(type);
+
+    /* Codes_SRS_UMOCKTYPES_01_069: [ If the same type string was resolved before, the handlers it was resolved to shall be used without normalizing the type string again. ]*/
+    *value_type_handlers = get_cached_value_type_handlers(type, hash);
+    if (*value_type_handlers != NULL)
     {
-        result = &type_handlers[i];
+        result = 0;
     }
     else
     {
-        result = NULL;
+        char* normalized_type = umocktypename_normalize(type);
+        if (normalized_type == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            size_t normalized_type_length = strlen(normalized_type);
+            *value_type_handlers = get_value_type_handlers(normalized_type);
+
+            /* Codes_SRS_UMOCK_C_LIB_01_153: [ If no custom handler has beed registered for a pointer type, it shall be trated as void*. ] */
+            if ((*value_type_handlers == NULL) && (normalized_type[normalized_type_length - 1] == '*'))
+            {
+                *value_type_handlers = get_value_type_handlers("void*");
+            }
+
+            if (*value_type_handlers != NULL)
+            {
+                /* Codes_SRS_UMOCKTYPES_01_070: [ Once a type string was resolved to registered handlers, the type string and the handlers shall be cached. ]*/
+                add_cached_value_type_handlers(type, hash, *value_type_handlers);
+            }
+
+            umockalloc_free(normalized_type);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/* takes ownership of normalized_type on success */
+static int add_value_type_handlers(char* normalized_type, UMOCKTYPE_STRINGIFY_FUNC stringify_func, UMOCKTYPE_ARE_EQUAL_FUNC are_equal_func, UMOCKTYPE_COPY_FUNC copy_func, UMOCKTYPE_FREE_FUNC free_func)
+{
+    int result;
+
+    if (ensure_type_handler_table_capacity() != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        UMOCK_VALUE_TYPE_HANDLERS* new_value_type_handlers = (UMOCK_VALUE_TYPE_HANDLERS*)umockalloc_malloc(sizeof(UMOCK_VALUE_TYPE_HANDLERS));
+        if (new_value_type_handlers == NULL)
+        {
+            UMOCK_LOG("Could not allocate type handler entry for type %s.\r\n", normalized_type);
+            result = __LINE__;
+        }
+        else
+        {
+            new_value_type_handlers->type = normalized_type;
+            new_value_type_handlers->hash = get_type_name_hash(normalized_type);
+            new_value_type_handlers->handlers.stringify_func = stringify_func;
+            new_value_type_handlers->handlers.copy_func = copy_func;
+            new_value_type_handlers->handlers.free_func = free_func;
+            new_value_type_handlers->handlers.are_equal_func = are_equal_func;
+
+            insert_value_type_handlers(type_handler_table, type_handler_table_size, new_value_type_handlers);
+            type_handler_count++;
+
+            /* a newly registered type can change what a pointer type resolves to (it could have been resolved as void* before) */
+            /* Codes_SRS_UMOCKTYPES_01_071: [ Registering a new type or alias type shall discard all cached type strings. ]*/
+            clear_type_name_cache();
+            type_handlers_generation++;
+
+            result = 0;
+        }
     }
 
     return result;
@@ -69,8 +464,10 @@ int umocktypes_init(void)
     else
     {
         /* Codes_SRS_UMOCKTYPES_01_002: [ After initialization the list of registered type shall be empty. ] */
-        type_handlers = NULL;
+        type_handler_table = NULL;
+        type_handler_table_size = 0;
         type_handler_count = 0;
+        type_handlers_generation++;
 
         umocktypes_state = UMOCKTYPES_STATE_INITIALIZED;
 
@@ -89,15 +486,25 @@ void umocktypes_deinit(void)
         size_t i;
 
         /* Codes_SRS_UMOCKTYPES_01_005: [ umocktypes_deinit shall free all resources associated with the registered types and shall leave the module in a state where another init is possible. ]*/
-        for (i = 0; i < type_handler_count; i++)
+        for (i = 0; i < type_handler_table_size; i++)
         {
-            umockalloc_free(type_handlers[i].type);
+            if (type_handler_table[i] != NULL)
+            {
+                umockalloc_free(type_handler_table[i]->type);
+                umockalloc_free(type_handler_table[i]);
+            }
         }
 
-        umockalloc_free(type_handlers);
-        type_handlers = NULL;
+        umockalloc_free(type_handler_table);
+        type_handler_table = NULL;
+        type_handler_table_size = 0;
         type_handler_count = 0;
 
+        clear_type_name_cache();
+
+        /* Codes_SRS_UMOCKTYPES_01_073: [ umocktypes_deinit shall change the value returned by umocktypes_get_generation. ]*/
+        type_handlers_generation++;
+
         /* Codes_SRS_UMOCKTYPES_01_040: [ An umocktypes_init call after deinit shall succeed provided all underlying calls succeed. ]*/
         umocktypes_state = UMOCKTYPES_STATE_NOT_INITIALIZED;
     }
@@ -141,10 +548,10 @@ int umocktypes_register_type(const char* type, UMOCKTYPE_STRINGIFY_FUNC stringif
             {
                 umockalloc_free(normalized_type);
 
-                if ((stringify_func != type_handler->stringify_func) ||
-                    (are_equal_func != type_handler->are_equal_func) ||
-                    (copy_func != type_handler->copy_func) ||
-                    (free_func != type_handler->free_func))
+                if ((stringify_func != type_handler->handlers.stringify_func) ||
+                    (are_equal_func != type_handler->handlers.are_equal_func) ||
+                    (copy_func != type_handler->handlers.copy_func) ||
+                    (free_func != type_handler->handlers.free_func))
                 {
                     /* Codes_SRS_UMOCKTYPES_01_011: [ If the type has already been registered but at least one of the function pointers is different, umocktypes_register_type shall fail and return a non-zero value. ]*/
                     UMOCK_LOG("Could not register type, type %s already registered with different handlers.\r\n", type);
@@ -156,30 +563,19 @@ int umocktypes_register_type(const char* type, UMOCKTYPE_STRINGIFY_FUNC stringif
                     result = 0;
                 }
             }
+            /* Codes_SRS_UMOCKTYPES_01_007: [ umocktypes_register_type shall register an interface made out of the stringify, are equal, copy and free functions for the type identified by the argument type. ] */
+            /* Codes_SRS_UMOCKTYPES_01_067: [ The registered types shall be stored in a hash table keyed on the normalized type name. ]*/
+            else if (add_value_type_handlers(normalized_type, stringify_func, are_equal_func, copy_func, free_func) != 0)
+            {
+                /* Codes_SRS_UMOCKTYPES_01_012: [ If an error occurs allocating memory for the newly registered type, umocktypes_register_type shall fail and return a non-zero value. ]*/
+                umockalloc_free(normalized_type);
+                UMOCK_LOG("Could not register type, failed allocating memory for types.\r\n");
+                result = __LINE__;
+            }
             else
             {
-                UMOCK_VALUE_TYPE_HANDLERS* new_type_handlers = (UMOCK_VALUE_TYPE_HANDLERS*)umockalloc_realloc(type_handlers, sizeof(UMOCK_VALUE_TYPE_HANDLERS) * (type_handler_count + 1));
-                if (new_type_handlers == NULL)
-                {
-                    /* Codes_SRS_UMOCKTYPES_01_012: [ If an error occurs allocating memory for the newly registered type, umocktypes_register_type shall fail and return a non-zero value. ]*/
-                    umockalloc_free(normalized_type);
-                    UMOCK_LOG("Could not register type, failed allocating memory for types.\r\n");
-                    result = __LINE__;
-                }
-                else
-                {
-                    /* Codes_SRS_UMOCKTYPES_01_007: [ umocktypes_register_type shall register an interface made out of the stringify, are equal, copy and free functions for the type identified by the argument type. ] */
-                    type_handlers = new_type_handlers;
-                    type_handlers[type_handler_count].type = normalized_type;
-                    type_handlers[type_handler_count].stringify_func = stringify_func;
-                    type_handlers[type_handler_count].copy_func = copy_func;
-                    type_handlers[type_handler_count].free_func = free_func;
-                    type_handlers[type_handler_count].are_equal_func = are_equal_func;
-                    type_handler_count++;
-
-                    /* Codes_SRS_UMOCKTYPES_01_008: [ On success umocktypes_register_type shall return 0. ]*/
-                    result = 0;
-                }
+                /* Codes_SRS_UMOCKTYPES_01_008: [ On success umocktypes_register_type shall return 0. ]*/
+                result = 0;
             }
         }
     }
@@ -216,54 +612,43 @@ int umocktypes_register_alias_type(const char* type, const char* is_type)
         }
         else
         {
-            UMOCK_VALUE_TYPE_HANDLERS* new_type_handlers = (UMOCK_VALUE_TYPE_HANDLERS*)umockalloc_realloc(type_handlers, sizeof(UMOCK_VALUE_TYPE_HANDLERS) * (type_handler_count + 1));
-            if (new_type_handlers == NULL)
+            UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers = get_value_type_handlers(normalized_is_type);
+            if (value_type_handlers == NULL)
             {
-                UMOCK_LOG("Could not register alias type, failed allocating memory.\r\n");
+                /* Codes_SRS_UMOCKTYPES_01_057: [ If is_type was not already registered, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
+                UMOCK_LOG("Could not register alias type, type %s was not previously registered.\r\n", normalized_is_type);
                 result = __LINE__;
             }
             else
             {
-                UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
-                type_handlers = new_type_handlers;
-                value_type_handlers = get_value_type_handlers(normalized_is_type);
-                if (value_type_handlers == NULL)
+                /* Codes_SRS_UMOCKTYPES_01_059: [ Before adding it as alias, type shall be normalized by using umocktypename_normalize. ]*/
+                char* normalized_type = umocktypename_normalize(type);
+                if (normalized_type == NULL)
                 {
-                    /* Codes_SRS_UMOCKTYPES_01_057: [ If is_type was not already registered, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
-                    UMOCK_LOG("Could not register alias type, type %s was not previously registered.\r\n", normalized_is_type);
+                    /* Codes_SRS_UMOCKTYPES_01_060: [ If umocktypename_normalize fails, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
+                    UMOCK_LOG("Could not register alias type, normalizing type %s failed.\r\n", type);
                     result = __LINE__;
                 }
                 else
                 {
-                    /* Codes_SRS_UMOCKTYPES_01_059: [ Before adding it as alias, type shall be normalized by using umocktypename_normalize. ]*/
-                    char* normalized_type = umocktypename_normalize(type);
-                    if (normalized_type == NULL)
+                    if (strcmp(normalized_type, normalized_is_type) == 0)
+                    {
+                        umockalloc_free(normalized_type);
+
+                        /* Codes_SRS_UMOCKTYPES_01_062: [ If type and is_type are the same, umocktypes_register_alias_type shall succeed and return 0. ]*/
+                        result = 0;
+                    }
+                    else if (add_value_type_handlers(normalized_type, value_type_handlers->handlers.stringify_func, value_type_handlers->handlers.are_equal_func, value_type_handlers->handlers.copy_func, value_type_handlers->handlers.free_func) != 0)
                     {
-                        /* Codes_SRS_UMOCKTYPES_01_060: [ If umocktypename_normalize fails, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
-                        UMOCK_LOG("Could not register alias type, normalizing type %s failed.\r\n", type);
+                        /* Codes_SRS_UMOCKTYPES_01_068: [ If allocating memory for the alias type fails, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
+                        umockalloc_free(normalized_type);
+                        UMOCK_LOG("Could not register alias type, failed allocating memory.\r\n");
                         result = __LINE__;
                     }
                     else
                     {
-                        if (strcmp(normalized_type, normalized_is_type) == 0)
-                        {
-                            umockalloc_free(normalized_type);
-
-                            /* Codes_SRS_UMOCKTYPES_01_062: [ If type and is_type are the same, umocktypes_register_alias_type shall succeed and return 0. ]*/
-                            result = 0;
-                        }
-                        else
-                        {
-                            type_handlers[type_handler_count].type = normalized_type;
-                            type_handlers[type_handler_count].stringify_func = value_type_handlers->stringify_func;
-                            type_handlers[type_handler_count].copy_func = value_type_handlers->copy_func;
-                            type_handlers[type_handler_count].free_func = value_type_handlers->free_func;
-                            type_handlers[type_handler_count].are_equal_func = value_type_handlers->are_equal_func;
-                            type_handler_count++;
-
-                            /* Codes_SRS_UMOCKTYPES_01_054: [ On success, umocktypes_register_alias_type shall return 0. ]*/
-                            result = 0;
-                        }
+                        /* Codes_SRS_UMOCKTYPES_01_054: [ On success, umocktypes_register_alias_type shall return 0. ]*/
+                        result = 0;
                     }
                 }
             }
@@ -295,40 +680,27 @@ char* umocktypes_stringify(const char* type, const void* value)
     }
     else
     {
-        /* Codes_SRS_UMOCKTYPES_01_035: [ Before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
-        char* normalized_type = umocktypename_normalize(type);
-        if (normalized_type == NULL)
+        UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
+
+        /* Codes_SRS_UMOCKTYPES_01_035: [ Unless type is found in the type name cache, before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
+        /* Codes_SRS_UMOCKTYPES_01_063: [ If type is a pointer type and type was not registered then umocktypes_stringify shall execute as if type is void*. ]*/
+        if (resolve_value_type_handlers(type, &value_type_handlers) != 0)
         {
             /* Codes_SRS_UMOCKTYPES_01_044: [ If normalizing the typename fails, umocktypes_stringify shall fail and return NULL. ]*/
             UMOCK_LOG("Could not stringify type, normalizing type %s failed.\r\n", type);
             result = NULL;
         }
+        else if (value_type_handlers == NULL)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_017: [ If type can not be found in the registered types list maintained by the module, umocktypes_stringify shall fail and return NULL. ]*/
+            UMOCK_LOG("Could not stringify type, type %s not registered.\r\n", type);
+            result = NULL;
+        }
         else
         {
-            size_t normalized_type_length = strlen(normalized_type);
-            UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers = get_value_type_handlers(normalized_type);
-
-            /* Codes_SRS_UMOCK_C_LIB_01_153: [ If no custom handler has beed registered for a pointer type, it shall be trated as void*. ] */
-            if ((value_type_handlers == NULL) && (normalized_type[normalized_type_length - 1] == '*'))
-            {
-                /* Codes_SRS_UMOCKTYPES_01_063: [ If type is a pointer type and type was not registered then umocktypes_stringify shall execute as if type is void*. ]*/
-                value_type_handlers = get_value_type_handlers("void*");
-            }
-
-            if (value_type_handlers == NULL)
-            {
-                /* Codes_SRS_UMOCKTYPES_01_017: [ If type can not be found in the registered types list maintained by the module, umocktypes_stringify shall fail and return NULL. ]*/
-                UMOCK_LOG("Could not stringify type, type %s not registered.\r\n", normalized_type);
-                result = NULL;
-            }
-            else
-            {
-                /* Codes_SRS_UMOCKTYPES_01_014: [ The string representation shall be obtained by calling the stringify function registered for the type identified by the argument type. ]*/
-                /* Codes_SRS_UMOCKTYPES_01_015: [ On success umocktypes_stringify shall return the char* produced by the underlying stringify function for type (passed in umocktypes_register_type). ]*/
-                result = value_type_handlers->stringify_func(value);
-            }
-
-            umockalloc_free(normalized_type);
+            /* Codes_SRS_UMOCKTYPES_01_014: [ The string representation shall be obtained by calling the stringify function registered for the type identified by the argument type. ]*/
+            /* Codes_SRS_UMOCKTYPES_01_015: [ On success umocktypes_stringify shall return the char* produced by the underlying stringify function for type (passed in umocktypes_register_type). ]*/
+            result = value_type_handlers->handlers.stringify_func(value);
         }
     }
 
@@ -356,64 +728,48 @@ int umocktypes_are_equal(const char* type, const void* left, const void* right)
     }
     else
     {
-        /* Codes_SRS_UMOCKTYPES_01_036: [ Before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
-        char* normalized_type = umocktypename_normalize(type);
-        if (normalized_type == NULL)
+        UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
+
+        /* Codes_SRS_UMOCKTYPES_01_036: [ Unless type is found in the type name cache, before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
+        /* Codes_SRS_UMOCKTYPES_01_064: [ If type is a pointer type and type was not registered then umocktypes_are_equal shall execute as if type is void*. ]*/
+        if (resolve_value_type_handlers(type, &value_type_handlers) != 0)
         {
             /* Codes_SRS_UMOCKTYPES_01_043: [ If normalizing the typename fails, umocktypes_are_equal shall fail and return -1. ]*/
             UMOCK_LOG("Could not compare values for type, normalizing type %s failed.\r\n", type);
             result = -1;
         }
+        else if (value_type_handlers == NULL)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_024: [ If type can not be found in the registered types list maintained by the module, umocktypes_are_equal shall fail and return -1. ]*/
+            UMOCK_LOG("Could not compare values for type, type %s not registered.\r\n", type);
+            result = -1;
+        }
+        /* Codes_SRS_UMOCKTYPES_01_051: [ If the pointer values for left and right are equal, umocktypes_are_equal shall return 1 without calling the underlying are_equal function. ]*/
+        else if (left == right)
+        {
+            result = 1;
+        }
         else
         {
-            size_t normalized_type_length = strlen(normalized_type);
-            UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers = get_value_type_handlers(normalized_type);
-
-            /* Codes_SRS_UMOCK_C_LIB_01_153: [ If no custom handler has beed registered for a pointer type, it shall be trated as void*. ] */
-            if ((value_type_handlers == NULL) && (normalized_type[normalized_type_length - 1] == '*'))
+            /* Codes_SRS_UMOCKTYPES_01_019: [ umocktypes_are_equal shall call the underlying are_equal function for the type identified by the argument type (passed in umocktypes_register_type). ] */
+            switch (value_type_handlers->handlers.are_equal_func(left, right))
             {
-                /* Codes_SRS_UMOCKTYPES_01_064: [ If type is a pointer type and type was not registered then umocktypes_are_equal shall execute as if type is void*. ]*/
-                value_type_handlers = get_value_type_handlers("void*");
-            }
-
-            if (value_type_handlers == NULL)
-            {
-                /* Codes_SRS_UMOCKTYPES_01_024: [ If type can not be found in the registered types list maintained by the module, umocktypes_are_equal shall fail and return -1. ]*/
-                UMOCK_LOG("Could not compare values for type, type %s not registered.\r\n", normalized_type);
+            default:
+                /* Codes_SRS_UMOCKTYPES_01_020: [ If the underlying are_equal function fails,, umocktypes_are_equal shall fail and return -1. ] */
+                UMOCK_LOG("Underlying compare failed for type %s.\r\n", type);
                 result = -1;
-            }
-            else
-            {
-                /* Codes_SRS_UMOCKTYPES_01_051: [ If the pointer values for left and right are equal, umocktypes_are_equal shall return 1 without calling the underlying are_equal function. ]*/
-                if (left == right)
-                {
-                    result = 1;
-                }
-                else
-                {
-                    /* Codes_SRS_UMOCKTYPES_01_019: [ umocktypes_are_equal shall call the underlying are_equal function for the type identified by the argument type (passed in umocktypes_register_type). ] */
-                    switch (value_type_handlers->are_equal_func(left, right))
-                    {
-                    default:
-                        /* Codes_SRS_UMOCKTYPES_01_020: [ If the underlying are_equal function fails,, umocktypes_are_equal shall fail and return -1. ] */
-                        UMOCK_LOG("Underlying compare failed for type %s.\r\n", normalized_type);
-                        result = -1;
-                        break;
-
-                    case 1:
-                        /* Codes_SRS_UMOCKTYPES_01_021: [ If the underlying are_equal function indicates the types are equal, umocktypes_are_equal shall return 1. ]*/
-                        result = 1;
-                        break;
-
-                    case 0:
-                        /* Codes_SRS_UMOCKTYPES_01_022: [ If the underlying are_equal function indicates the types are not equal, umocktypes_are_equal shall return 0. ]*/
-                        result = 0;
-                        break;
-                    }
-                }
-            }
+                break;
 
-            umockalloc_free(normalized_type);
+            case 1:
+                /* Codes_SRS_UMOCKTYPES_01_021: [ If the underlying are_equal function indicates the types are equal, umocktypes_are_equal shall return 1. ]*/
+                result = 1;
+                break;
+
+            case 0:
+                /* Codes_SRS_UMOCKTYPES_01_022: [ If the underlying are_equal function indicates the types are not equal, umocktypes_are_equal shall return 0. ]*/
+                result = 0;
+                break;
+            }
         }
     }
 
@@ -441,41 +797,28 @@ int umocktypes_copy(const char* type, void* destination, const void* source)
     }
     else
     {
-        /* Codes_SRS_UMOCKTYPES_01_037: [ Before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
-        char* normalized_type = umocktypename_normalize(type);
-        if (normalized_type == NULL)
+        UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
+
+        /* Codes_SRS_UMOCKTYPES_01_037: [ Unless type is found in the type name cache, before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
+        /* Codes_SRS_UMOCKTYPES_01_065: [ If type is a pointer type and type was not registered then umocktypes_copy shall execute as if type is void*. ]*/
+        if (resolve_value_type_handlers(type, &value_type_handlers) != 0)
         {
             /* Codes_SRS_UMOCKTYPES_01_042: [ If normalizing the typename fails, umocktypes_copy shall fail and return a non-zero value. ]*/
             UMOCK_LOG("Could not copy type, normalizing type %s failed.\r\n", type);
             result = -1;
         }
+        else if (value_type_handlers == NULL)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_029: [ If type can not be found in the registered types list maintained by the module, umocktypes_copy shall fail and return -1. ]*/
+            UMOCK_LOG("Could not copy type, type %s not registered.\r\n", type);
+            result = __LINE__;
+        }
         else
         {
-            size_t normalized_type_length = strlen(normalized_type);
-            UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers = get_value_type_handlers(normalized_type);
-
-            /* Codes_SRS_UMOCK_C_LIB_01_153: [ If no custom handler has beed registered for a pointer type, it shall be trated as void*. ] */
-            if ((value_type_handlers == NULL) && (normalized_type[normalized_type_length - 1] == '*'))
-            {
-                /* Codes_SRS_UMOCKTYPES_01_065: [ If type is a pointer type and type was not registered then umocktypes_copy shall execute as if type is void*. ]*/
-                value_type_handlers = get_value_type_handlers("void*");
-            }
-
-            if (value_type_handlers == NULL)
-            {
-                /* Codes_SRS_UMOCKTYPES_01_029: [ If type can not be found in the registered types list maintained by the module, umocktypes_copy shall fail and return -1. ]*/
-                UMOCK_LOG("Could not copy type, type %s not registered.\r\n", normalized_type);
-                result = __LINE__;
-            }
-            else
-            {
-                /* Codes_SRS_UMOCKTYPES_01_026: [ The copy shall be done by calling the underlying copy function (passed in umocktypes_register_type) for the type identified by the type argument. ]*/
-                /* Codes_SRS_UMOCKTYPES_01_052: [ On success, umocktypes_copy shall return 0. ]*/
-                /* Codes_SRS_UMOCKTYPES_01_028: [ If the underlying copy fails, umocktypes_copy shall return -1. ]*/
-                result = value_type_handlers->copy_func(destination, source);
-            }
-
-            umockalloc_free(normalized_type);
+            /* Codes_SRS_UMOCKTYPES_01_026: [ The copy shall be done by calling the underlying copy function (passed in umocktypes_register_type) for the type identified by the type argument. ]*/
+            /* Codes_SRS_UMOCKTYPES_01_052: [ On success, umocktypes_copy shall return 0. ]*/
+            /* Codes_SRS_UMOCKTYPES_01_028: [ If the underlying copy fails, umocktypes_copy shall return -1. ]*/
+            result = value_type_handlers->handlers.copy_func(destination, source);
         }
     }
 
@@ -491,35 +834,69 @@ void umocktypes_free(const char* type, void* value)
         /* Codes_SRS_UMOCKTYPES_01_048: [ If umocktypes_free is called when the module is not initialized, umocktypes_free shall do nothing. ]*/
         (umocktypes_state == UMOCKTYPES_STATE_INITIALIZED))
     {
-        /* Codes_SRS_UMOCKTYPES_01_038: [ Before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
-        char* normalized_type = umocktypename_normalize(type);
-        if (normalized_type == NULL)
+        UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
+
+        /* Codes_SRS_UMOCKTYPES_01_038: [ Unless type is found in the type name cache, before looking it up, the type string shall be normalized by calling umocktypename_normalize. ]*/
+        /* Codes_SRS_UMOCKTYPES_01_066: [ If type is a pointer type and type was not registered then umocktypes_free shall execute as if type is void*. ]*/
+        if (resolve_value_type_handlers(type, &value_type_handlers) != 0)
         {
             /* Codes_SRS_UMOCKTYPES_01_041: [ If normalizing the typename fails, umocktypes_free shall do nothing. ]*/
         }
+        else if (value_type_handlers == NULL)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_032: [ If type can not be found in the registered types list maintained by the module, umocktypes_free shall do nothing. ]*/
+        }
         else
         {
-            size_t normalized_type_length = strlen(normalized_type);
-            UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers = get_value_type_handlers(normalized_type);
+            /* Codes_SRS_UMOCKTYPES_01_033: [ The free shall be done by calling the underlying free function (passed in umocktypes_register_type) for the type identified by the type argument. ]*/
+            value_type_handlers->handlers.free_func(value);
+        }
+    }
+}
 
-            /* Codes_SRS_UMOCK_C_LIB_01_153: [ If no custom handler has beed registered for a pointer type, it shall be trated as void*. ] */
-            if ((value_type_handlers == NULL) && (normalized_type[normalized_type_length - 1] == '*'))
-            {
-                /* Codes_SRS_UMOCKTYPES_01_066: [ If type is a pointer type and type was not registered then umocktypes_free shall execute as if type is void*. ]*/
-                value_type_handlers = get_value_type_handlers("void*");
-            }
+const UMOCKTYPE_HANDLERS* umocktypes_get_handlers(const char* type)
+{
+    const UMOCKTYPE_HANDLERS* result;
 
-            if (value_type_handlers == NULL)
-            {
-                /* Codes_SRS_UMOCKTYPES_01_032: [ If type can not be found in the registered types list maintained by the module, umocktypes_free shall do nothing. ]*/
-            }
-            else
-            {
-                /* Codes_SRS_UMOCKTYPES_01_033: [ The free shall be done by calling the underlying free function (passed in umocktypes_register_type) for the type identified by the type argument. ]*/
-                value_type_handlers->free_func(value);
-            }
+    if (type == NULL)
+    {
+        /* Codes_SRS_UMOCKTYPES_01_074: [ If type is NULL, umocktypes_get_handlers shall fail and return NULL. ]*/
+        UMOCK_LOG("Could not get handlers for type, NULL type.\r\n");
+        result = NULL;
+    }
+    else if (umocktypes_state != UMOCKTYPES_STATE_INITIALIZED)
+    {
+        /* Codes_SRS_UMOCKTYPES_01_075: [ If umocktypes_get_handlers is called when the module is not initialized, umocktypes_get_handlers shall fail and return NULL. ]*/
+        result = NULL;
+    }
+    else
+    {
+        UMOCK_VALUE_TYPE_HANDLERS* value_type_handlers;
 
-            umockalloc_free(normalized_type);
+        /* Codes_SRS_UMOCKTYPES_01_076: [ umocktypes_get_handlers shall resolve type the same way umocktypes_stringify, umocktypes_are_equal, umocktypes_copy and umocktypes_free do (normalization and the void* fallback for pointer types). ]*/
+        if (resolve_value_type_handlers(type, &value_type_handlers) != 0)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_077: [ If normalizing the typename fails, umocktypes_get_handlers shall fail and return NULL. ]*/
+            UMOCK_LOG("Could not get handlers for type, normalizing type %s failed.\r\n", type);
+            result = NULL;
+        }
+        else if (value_type_handlers == NULL)
+        {
+            /* Codes_SRS_UMOCKTYPES_01_078: [ If type can not be found in the registered types list maintained by the module, umocktypes_get_handlers shall return NULL. ]*/
+            result = NULL;
+        }
+        else
+        {
+            /* Codes_SRS_UMOCKTYPES_01_079: [ On success umocktypes_get_handlers shall return the handlers registered for type. The handlers stay valid until the value returned by umocktypes_get_generation changes. ]*/
+            result = &value_type_handlers->handlers;
         }
     }
+
+    return result;
+}
+
+size_t umocktypes_get_generation(void)
+{
+    /* Codes_SRS_UMOCKTYPES_01_072: [ umocktypes_get_generation shall return a value that changes every time the module is initialized, deinitialized or a new type or alias type is registered. ]*/
+    return type_handlers_generation;
 }
@@ -32,6 +32,7 @@ Tests_SRS_UMOCK_C_LIB_01_194: [ If the first argument passed to destroy_call is
 
 #include "umock_c/umock_c.h"
 #include "umock_c/umocktypes.h"          // for REGISTER_TYPE, IMPLEMENT_UMO...
+#include "umock_c/umockalloc.h"          // for umockc_set_stringify_buffer_truncation
 
 #include "umock_c/umock_c_ENABLE_MOCKS.h" // ============================== ENABLE_MOCKS
 #include "test_dependency.h"
@@ -1481,7 +1482,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_checks_the_argument_buffer_and_mismatch_is_
     // arrange
     unsigned char expected_buffer[] = { 0x42 };
     unsigned char actual_buffer[] = { 0x43 };
-    char actual_string[64];
+    char actual_string[256];
     STRICT_EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
         .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
 
@@ -1489,7 +1490,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_checks_the_argument_buffer_and_mismatch_is_
     test_dependency_buffer_arg(actual_buffer);
 
     // assert
-    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)]", actual_buffer);
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 0 of 1, bytes 0 to 0: expected [0x42] actual [0x43]", actual_buffer);
     ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42])]", umock_c_get_expected_calls());
     ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
 }
@@ -1502,7 +1503,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_checks_the_argument_buffer_and_mismatch_is_
     // arrange
     unsigned char expected_buffer[] = { 0x42 };
     unsigned char actual_buffer[] = { 0x43 };
-    char actual_string[64];
+    char actual_string[256];
     EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
         .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
 
@@ -1510,7 +1511,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_checks_the_argument_buffer_and_mismatch_is_
     test_dependency_buffer_arg(actual_buffer);
 
     // assert
-    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)]", actual_buffer);
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 0 of 1, bytes 0 to 0: expected [0x42] actual [0x43]", actual_buffer);
     ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42])]", umock_c_get_expected_calls());
     ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
 }
@@ -1586,7 +1587,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_with_2_bytes_and_first_byte_different_check
     // arrange
     unsigned char expected_buffer[] = { 0x42, 0x41 };
     unsigned char actual_buffer[] = { 0x43, 0x41 };
-    char actual_string[64];
+    char actual_string[256];
     EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
         .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
 
@@ -1594,7 +1595,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_with_2_bytes_and_first_byte_different_check
     test_dependency_buffer_arg(actual_buffer);
 
     // assert
-    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)]", actual_buffer);
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 0 of 2, bytes 0 to 1: expected [0x42 0x41] actual [0x43 0x41]", actual_buffer);
     ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42 0x41])]", umock_c_get_expected_calls());
     ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
 }
@@ -1607,7 +1608,7 @@ TEST_FUNCTION(ValidateArgumentBuffer_with_2_bytes_and_second_byte_different_chec
     // arrange
     unsigned char expected_buffer[] = { 0x42, 0x41 };
     unsigned char actual_buffer[] = { 0x42, 0x42 };
-    char actual_string[64];
+    char actual_string[256];
     EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
         .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
 
@@ -1615,11 +1616,106 @@ TEST_FUNCTION(ValidateArgumentBuffer_with_2_bytes_and_second_byte_different_chec
     test_dependency_buffer_arg(actual_buffer);
 
     // assert
-    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)]", actual_buffer);
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 1 of 2, bytes 0 to 1: expected [0x42 0x41] actual [0x42 0x42]", actual_buffer);
     ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42 0x41])]", umock_c_get_expected_calls());
     ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
 }
 
+TEST_FUNCTION(ValidateArgumentBuffer_with_a_large_buffer_and_truncation_shows_the_first_and_last_bytes)
+{
+    // arrange
+    unsigned char expected_buffer[4096];
+    unsigned char actual_buffer[4096];
+    size_t i;
+    for (i = 0; i < sizeof(expected_buffer); i++)
+    {
+        expected_buffer[i] = (unsigned char)i;
+    }
+    (void)memcpy(actual_buffer, expected_buffer, sizeof(actual_buffer));
+    actual_buffer[2048] = 0x42;
+    umockc_set_stringify_buffer_truncation(2);
+    STRICT_EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
+        .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
+
+    // act
+    test_dependency_buffer_arg(actual_buffer);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x00 0x01 ...(4096 bytes)... 0xFE 0xFF])]", umock_c_get_expected_calls());
+
+    // cleanup
+    umockc_set_stringify_buffer_truncation(0);
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_096: [If the content of the code under test buffer and the buffer supplied to ValidateArgumentBuffer does not match then this should be treated as a mismatch in argument comparison for that argument.]*/
+/* Tests_SRS_UMOCK_C_LIB_01_243: [ When the buffers do not match, the first unexpected actual call shall be followed in the actual calls string by the offset of the first differing byte and the bytes of both buffers around it, rather than the full buffers. ]*/
+TEST_FUNCTION(ValidateArgumentBuffer_with_a_large_buffer_detects_a_difference_at_the_end)
+{
+    // arrange
+    unsigned char expected_buffer[4096];
+    unsigned char actual_buffer[4096];
+    char actual_string[512];
+    size_t i;
+    for (i = 0; i < sizeof(expected_buffer); i++)
+    {
+        expected_buffer[i] = (unsigned char)i;
+    }
+    (void)memcpy(actual_buffer, expected_buffer, sizeof(actual_buffer));
+    actual_buffer[sizeof(actual_buffer) - 1] = 0x42;
+    umockc_set_stringify_buffer_truncation(1);
+    STRICT_EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
+        .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
+
+    // act
+    test_dependency_buffer_arg(actual_buffer);
+
+    // assert
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 4095 of 4096, bytes 4087 to 4095: expected [0xF7 0xF8 0xF9 0xFA 0xFB 0xFC 0xFD 0xFE 0xFF] actual [0xF7 0xF8 0xF9 0xFA 0xFB 0xFC 0xFD 0xFE 0x42]", actual_buffer);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x00 ...(4096 bytes)... 0xFF])]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
+
+    // cleanup
+    umockc_set_stringify_buffer_truncation(0);
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_096: [If the content of the code under test buffer and the buffer supplied to ValidateArgumentBuffer does not match then this should be treated as a mismatch in argument comparison for that argument.]*/
+TEST_FUNCTION(ValidateArgumentBuffer_with_a_NULL_argument_is_a_mismatch)
+{
+    // arrange
+    unsigned char expected_buffer[] = { 0x42 };
+    char actual_string[256];
+    STRICT_EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
+        .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
+
+    // act
+    test_dependency_buffer_arg(NULL);
+
+    // assert
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the argument is NULL", (void*)NULL);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42])]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_243: [ When the buffers do not match, the first unexpected actual call shall be followed in the actual calls string by the offset of the first differing byte and the bytes of both buffers around it, rather than the full buffers. ]*/
+TEST_FUNCTION(ValidateArgumentBuffer_mismatch_is_only_described_for_the_first_unexpected_call)
+{
+    // arrange
+    unsigned char expected_buffer[] = { 0x42 };
+    unsigned char actual_buffer[] = { 0x43 };
+    char actual_string[256];
+    STRICT_EXPECTED_CALL(test_dependency_buffer_arg(IGNORED_ARG))
+        .ValidateArgumentBuffer(1, expected_buffer, sizeof(expected_buffer));
+
+    // act
+    test_dependency_buffer_arg(actual_buffer);
+    test_dependency_buffer_arg(actual_buffer);
+
+    // assert
+    (void)sprintf(actual_string, "[test_dependency_buffer_arg(%p)] ValidateArgumentBuffer mismatch for argument a: the buffer differs at offset 0 of 1, bytes 0 to 0: expected [0x42] actual [0x43][test_dependency_buffer_arg(%p)]", actual_buffer, actual_buffer);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_buffer_arg([0x42])]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, actual_string, umock_c_get_actual_calls());
+}
+
 /* Tests_SRS_UMOCK_C_LIB_01_131: [ The memory pointed by bytes shall be copied. ]*/
 TEST_FUNCTION(ValidateArgumentBuffer_copies_the_bytes_to_compare)
 {
@@ -2719,6 +2815,92 @@ TEST_FUNCTION(auto_ignore_when_first_arg_is_a_nested_macro_succeeds_for_2nd_arg)
 }
 
 
+/* Tests_SRS_UMOCK_C_LIB_01_230: [ The ignored arguments mask of a STRICT_EXPECTED_CALL site shall be computed by parsing the call string only the first time the call site is executed on a thread and shall then be cached, keyed by the address of the call string literal. ]*/
+TEST_FUNCTION(auto_ignore_for_a_call_site_executed_in_a_loop_ignores_the_argument_every_time)
+{
+    // arrange
+    int i;
+    for (i = 0; i < 3; i++)
+    {
+        STRICT_EXPECTED_CALL(test_dependency_2_args(i, IGNORED_ARG));
+    }
+
+    // act
+    (void)test_dependency_2_args(0, 42);
+    (void)test_dependency_2_args(1, 43);
+    (void)test_dependency_2_args(2, 44);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_230: [ The ignored arguments mask of a STRICT_EXPECTED_CALL site shall be computed by parsing the call string only the first time the call site is executed on a thread and shall then be cached, keyed by the address of the call string literal. ]*/
+TEST_FUNCTION(auto_ignore_keeps_a_separate_mask_for_each_call_site_of_the_same_mock)
+{
+    // arrange
+    int i;
+    for (i = 0; i < 2; i++)
+    {
+        STRICT_EXPECTED_CALL(test_dependency_2_args(1, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 2));
+    }
+
+    // act
+    (void)test_dependency_2_args(1, 42);
+    (void)test_dependency_2_args(42, 2);
+    (void)test_dependency_2_args(1, 43);
+    (void)test_dependency_2_args(43, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_2_args(0,2)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_2_args(43,1)]", umock_c_get_actual_calls());
+}
+
+static void expect_more_call_sites_than_the_auto_ignore_cache_holds(void)
+{
+    STRICT_EXPECTED_CALL(test_dependency_2_args(1, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 2));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(3, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 4));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(5, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 6));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(7, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 8));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(9, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(test_dependency_2_args(IGNORED_ARG, 10));
+}
+
+static void call_the_call_sites_that_do_not_fit_in_the_auto_ignore_cache(void)
+{
+    (void)test_dependency_2_args(1, 42);
+    (void)test_dependency_2_args(42, 2);
+    (void)test_dependency_2_args(3, 42);
+    (void)test_dependency_2_args(42, 4);
+    (void)test_dependency_2_args(5, 42);
+    (void)test_dependency_2_args(42, 6);
+    (void)test_dependency_2_args(7, 42);
+    (void)test_dependency_2_args(42, 8);
+    (void)test_dependency_2_args(9, 42);
+    (void)test_dependency_2_args(42, 10);
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_231: [ When more call sites than the cache can hold are used for the same mock, the oldest cached call site shall be replaced. ]*/
+TEST_FUNCTION(auto_ignore_with_more_call_sites_than_the_cache_holds_ignores_the_right_arguments)
+{
+    // arrange
+    expect_more_call_sites_than_the_auto_ignore_cache_holds();
+    expect_more_call_sites_than_the_auto_ignore_cache_holds();
+
+    // act
+    call_the_call_sites_that_do_not_fit_in_the_auto_ignore_cache();
+    call_the_call_sites_that_do_not_fit_in_the_auto_ignore_cache();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
 #if !defined(_MSC_VER) || _MSC_VER >= 1600
 /* Tests_SRS_UMOCK_C_LIB_01_205: [ If IGNORED_ARG is used as an argument value with STRICT_EXPECTED_CALL, the argument shall be automatically ignored. ]*/
 /* Tests_SRS_UMOCK_C_LIB_01_207: [ IGNORED_ARG shall be defined to 0 so that it can be used for numeric and pointer type arguments. ]*/
@@ -2848,6 +3030,392 @@ TEST_FUNCTION(IgnoreAllCalls_ignores_only_calls_with_matching_args_2)
     ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(43)]", umock_c_get_actual_calls());
 }
 
+/* Tests_SRS_UMOCK_C_LIB_01_102: [If multiple matching actual calls occur no unexpected calls shall be reported.]*/
+/* Tests_SRS_UMOCK_C_LIB_01_103: [The call matching shall be done taking into account arguments and call modifiers referring to arguments.]*/
+TEST_FUNCTION(IgnoreAllCalls_for_several_functions_ignores_the_calls_of_each_function)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_no_args())
+        .IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_dependency_2_args(1, 2))
+        .IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(43))
+        .IgnoreAllCalls();
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(44));
+
+    // act
+    test_dependency_1_arg(44);
+    test_dependency_2_args(1, 2);
+    test_dependency_1_arg(43);
+    (void)test_dependency_no_args();
+    test_dependency_1_arg(42);
+    test_dependency_2_args(1, 3);
+    test_dependency_1_arg(45);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_2_args(1,3)][test_dependency_1_arg(45)]", umock_c_get_actual_calls());
+}
+
+/* Times(size_t call_count) */
+
+/* Tests_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+TEST_FUNCTION(Times_matches_the_expected_call_with_call_count_actual_calls)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .Times(3);
+
+    // act
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+/* Tests_SRS_UMOCK_C_LIB_01_237: [ An expected call that was not matched by enough actual calls shall be reported in the expected calls followed by the number of remaining calls. ]*/
+TEST_FUNCTION(Times_reports_the_remaining_calls)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .Times(3);
+
+    // act
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(42)] 2 remaining", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+TEST_FUNCTION(Times_reports_an_extra_call_as_unexpected)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .Times(2);
+
+    // act
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(42)]", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+TEST_FUNCTION(Times_keeps_the_order_with_the_next_expected_call)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .Times(2);
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(43));
+
+    // act
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(43);
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(42)] 1 remaining[test_dependency_1_arg(43)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(43)][test_dependency_1_arg(42)]", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_234: [ The Times call modifier shall record that the expected call shall be matched by exactly call_count actual calls. ]*/
+TEST_FUNCTION(Times_sets_the_return_value_for_all_the_matched_calls)
+{
+    // arrange
+    int result_1;
+    int result_2;
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .SetReturn(7)
+        .Times(2);
+
+    // act
+    result_1 = test_dependency_1_arg(42);
+    result_2 = test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 7, result_1);
+    ASSERT_ARE_EQUAL(int, 7, result_2);
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_238: [ If setting the repeat count of the last expected call fails, umock_c shall raise an error with the code UMOCK_C_INVALID_REPEAT_COUNT. ]*/
+TEST_FUNCTION(Times_with_0_indicates_an_error)
+{
+    // arrange
+
+    // act
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .Times(0);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_on_umock_c_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_INVALID_REPEAT_COUNT, test_on_umock_c_error_calls[0].error_code);
+}
+
+/* AtLeast(size_t call_count) */
+
+/* Tests_SRS_UMOCK_C_LIB_01_235: [ The AtLeast call modifier shall record that the expected call shall be matched by at least call_count actual calls. ]*/
+TEST_FUNCTION(AtLeast_matches_any_number_of_calls_above_call_count)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .AtLeast(1);
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(43));
+
+    // act
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_235: [ The AtLeast call modifier shall record that the expected call shall be matched by at least call_count actual calls. ]*/
+/* Tests_SRS_UMOCK_C_LIB_01_237: [ An expected call that was not matched by enough actual calls shall be reported in the expected calls followed by the number of remaining calls. ]*/
+TEST_FUNCTION(AtLeast_reports_the_remaining_calls)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .AtLeast(2);
+
+    // act
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(42)] 1 remaining", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* AtMost(size_t call_count) */
+
+/* Tests_SRS_UMOCK_C_LIB_01_236: [ The AtMost call modifier shall record that the expected call shall be matched by at most call_count actual calls. ]*/
+TEST_FUNCTION(AtMost_does_not_report_a_missing_call)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .AtMost(2);
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(43));
+
+    // act
+    (void)test_dependency_1_arg(43);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_236: [ The AtMost call modifier shall record that the expected call shall be matched by at most call_count actual calls. ]*/
+TEST_FUNCTION(AtMost_reports_calls_above_call_count_as_unexpected)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .AtMost(2);
+
+    // act
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+    (void)test_dependency_1_arg(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(42)]", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_238: [ If setting the repeat count of the last expected call fails, umock_c shall raise an error with the code UMOCK_C_INVALID_REPEAT_COUNT. ]*/
+TEST_FUNCTION(AtMost_with_0_indicates_an_error)
+{
+    // arrange
+
+    // act
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+        .AtMost(0);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_on_umock_c_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_INVALID_REPEAT_COUNT, test_on_umock_c_error_calls[0].error_code);
+}
+
+/* UNORDERED_EXPECTED_CALLS(...) */
+
+/* Tests_SRS_UMOCK_C_LIB_01_239: [ UNORDERED_EXPECTED_CALLS shall record that the expected calls recorded by the statements passed to it can happen in any order with respect to each other. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_matches_the_calls_in_any_order)
+{
+    // arrange
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+        STRICT_EXPECTED_CALL(test_dependency_2_args(2, 3));
+        STRICT_EXPECTED_CALL(test_dependency_no_args());
+    );
+
+    // act
+    (void)test_dependency_no_args();
+    (void)test_dependency_2_args(2, 3);
+    (void)test_dependency_1_arg(1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, test_on_umock_c_error_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_240: [ An actual call shall be matched with the first call of the group, in the order they were recorded, that is equal to it and was not matched yet. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_matches_equal_calls_in_the_order_they_were_recorded)
+{
+    // arrange
+    int result_1;
+    int result_2;
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+            .SetReturn(1);
+        STRICT_EXPECTED_CALL(test_dependency_no_args());
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(42))
+            .SetReturn(2);
+    );
+
+    // act
+    result_1 = test_dependency_1_arg(42);
+    result_2 = test_dependency_1_arg(42);
+    (void)test_dependency_no_args();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result_1);
+    ASSERT_ARE_EQUAL(int, 2, result_2);
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_239: [ UNORDERED_EXPECTED_CALLS shall record that the expected calls recorded by the statements passed to it can happen in any order with respect to each other. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_reports_the_calls_of_the_group_that_were_not_matched)
+{
+    // arrange
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(2));
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(3));
+    );
+
+    // act
+    (void)test_dependency_1_arg(2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(1)][test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_241: [ The expected calls recorded after the group shall only be matched once all the calls of the group were matched. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_keeps_the_order_with_the_next_expected_call)
+{
+    // arrange
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(2));
+    );
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(3));
+
+    // act
+    (void)test_dependency_1_arg(1);
+    (void)test_dependency_1_arg(3);
+    (void)test_dependency_1_arg(2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(2)][test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(3)][test_dependency_1_arg(2)]", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_241: [ The expected calls recorded after the group shall only be matched once all the calls of the group were matched. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_matches_the_next_expected_call_after_the_group_was_matched)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_no_args());
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(2));
+    );
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(3));
+
+    // act
+    (void)test_dependency_no_args();
+    (void)test_dependency_1_arg(2);
+    (void)test_dependency_1_arg(1);
+    (void)test_dependency_1_arg(3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_241: [ The expected calls recorded after the group shall only be matched once all the calls of the group were matched. ]*/
+TEST_FUNCTION(UNORDERED_EXPECTED_CALLS_honours_the_repeat_count_of_the_calls_in_the_group)
+{
+    // arrange
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1))
+            .Times(2);
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(2))
+            .AtLeast(1);
+    );
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(3));
+
+    // act
+    (void)test_dependency_1_arg(1);
+    (void)test_dependency_1_arg(2);
+    (void)test_dependency_1_arg(2);
+    (void)test_dependency_1_arg(1);
+    (void)test_dependency_1_arg(3);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_242: [ If opening or closing the group of unordered calls fails, the on_error callback shall be called with UMOCK_C_ERROR. ]*/
+TEST_FUNCTION(nested_UNORDERED_EXPECTED_CALLS_indicates_an_error)
+{
+    // arrange
+
+    // act
+    UNORDERED_EXPECTED_CALLS(
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+        UNORDERED_EXPECTED_CALLS(
+            STRICT_EXPECTED_CALL(test_dependency_1_arg(2));
+        );
+    );
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_on_umock_c_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, test_on_umock_c_error_calls[0].error_code);
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_239: [ UNORDERED_EXPECTED_CALLS shall record that the expected calls recorded by the statements passed to it can happen in any order with respect to each other. ]*/
+TEST_FUNCTION(umock_c_reset_all_calls_closes_an_open_unordered_group)
+{
+    // arrange
+    ASSERT_ARE_EQUAL(int, 0, umock_c_begin_unordered_expected_calls());
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+
+    // act
+    umock_c_reset_all_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, umock_c_end_unordered_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+}
+
 /* Tests_SRS_UMOCK_C_LIB_31_209: [call_cannot_fail_func__{name} call modifier shall record that when performing failure case run, this call should be skipped. ] */
 TEST_FUNCTION(CallCannotFail_sets_cannot_fail_for_strict_expected_call)
 {
@@ -3117,4 +3685,63 @@ TEST_FUNCTION(IGNORED_STRUCT_ARG_works_with_nested_struct)
     ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
 }
 
+/* Tests_SRS_UMOCKCALLRECORDER_01_111: [ umockcallrecorder_get_expected_calls shall stringify only the expected calls that were not stringified by a previous call, except for the last expected call, which shall be stringified every time. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_112: [ Cached expected calls that were matched since the previous call shall be removed from the start of the string without stringifying any call. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_114: [ umockcallrecorder_get_actual_calls shall stringify only the actual calls that were not stringified by a previous call and append them to the previously built string. ]*/
+TEST_FUNCTION(querying_the_expected_and_actual_calls_repeatedly_reports_the_calls_as_they_are_matched)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(1));
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(2));
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(1)][test_dependency_1_arg(2)]", umock_c_get_expected_calls());
+    STRICT_EXPECTED_CALL(test_dependency_1_arg(3));
+
+    // act
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(1)][test_dependency_1_arg(2)][test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    (void)test_dependency_1_arg(1);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(2)][test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+    (void)test_dependency_1_arg(2);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    (void)test_dependency_1_arg(4);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(3)]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(4)]", umock_c_get_actual_calls());
+    (void)test_dependency_1_arg(5);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_1_arg(4)][test_dependency_1_arg(5)]", umock_c_get_actual_calls());
+}
+
+/* umock_c_enable_call_arena */
+
+/* these tests leave the call arena enabled, so they are kept last in the suite */
+
+/* Tests_SRS_UMOCK_C_LIB_01_227: [ After umock_c_enable_call_arena succeeds, the call objects created for expected and actual calls shall be allocated from an arena (bump allocator). ]*/
+/* Tests_SRS_UMOCK_C_LIB_01_228: [ The memory in the arena shall be released at once when umock_c_reset_all_calls is called. ]*/
+TEST_FUNCTION(calls_recorded_with_the_call_arena_enabled_are_matched_and_reset)
+{
+    // arrange
+    size_t i;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_call_arena());
+
+    for (i = 0; i < 3; i++)
+    {
+        STRICT_EXPECTED_CALL(test_dependency_1_arg(42));
+        STRICT_EXPECTED_CALL(test_dependency_char_star_arg("arena"));
+        STRICT_EXPECTED_CALL(test_dependency_2_args(1, 2));
+
+        // act
+        (void)test_dependency_1_arg(42);
+        (void)test_dependency_char_star_arg("arena");
+        (void)test_dependency_2_args(1, 3);
+
+        // assert
+        ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_2_args(1,2)]", umock_c_get_expected_calls());
+        ASSERT_ARE_EQUAL(char_ptr, "[test_dependency_2_args(1,3)]", umock_c_get_actual_calls());
+
+        umock_c_reset_all_calls();
+        ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+        ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+    }
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
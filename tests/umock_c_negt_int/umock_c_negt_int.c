@@ -2,6 +2,11 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stdio.h>                           // for sprintf
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>                          // for _exit
+#endif
 
 #include "testrunnerswitcher.h"
 
@@ -55,6 +60,25 @@ int function_under_test_2_calls(void)
     return result;
 }
 
+int function_under_test_2_calls_of_the_same_function(int* first_result, int* second_result)
+{
+    int result;
+
+    *first_result = function_1();
+    *second_result = function_1();
+    if ((*first_result != 0) ||
+        (*second_result != 0))
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
 int function_under_test_1_call_dep_void_return(void)
 {
     function_3_void_return();
@@ -161,6 +185,64 @@ int function_under_test_4_call_dep_void_ptr_return_non_NULL(void)
     return result;
 }
 
+#ifndef _WIN32
+
+#define MAX_PARALLEL_RESULTS 16
+
+typedef struct PARALLEL_RESULT_TAG
+{
+    size_t index;
+    UMOCK_C_NEGATIVE_TESTS_RESULT result;
+    char expected_calls[64];
+    char actual_calls[64];
+} PARALLEL_RESULT;
+
+static PARALLEL_RESULT parallel_results[MAX_PARALLEL_RESULTS];
+static size_t parallel_result_count;
+
+static void on_parallel_result(void* context, size_t index, UMOCK_C_NEGATIVE_TESTS_RESULT result, const char* expected_calls, const char* actual_calls)
+{
+    (void)context;
+    if (parallel_result_count < MAX_PARALLEL_RESULTS)
+    {
+        parallel_results[parallel_result_count].index = index;
+        parallel_results[parallel_result_count].result = result;
+        (void)snprintf(parallel_results[parallel_result_count].expected_calls, sizeof(parallel_results[parallel_result_count].expected_calls), "%s", expected_calls);
+        (void)snprintf(parallel_results[parallel_result_count].actual_calls, sizeof(parallel_results[parallel_result_count].actual_calls), "%s", actual_calls);
+    }
+    parallel_result_count++;
+}
+
+static int test_body_2_calls(void* context, size_t index)
+{
+    (void)context;
+    (void)index;
+    return (function_under_test_2_calls() != 0) ? 0 : __LINE__;
+}
+
+static int test_body_9_calls(void* context, size_t index)
+{
+    (void)context;
+    (void)index;
+    return (function_under_test_4_call_dep_void_ptr_return_non_NULL() != 0) ? 0 : __LINE__;
+}
+
+static int test_body_failing_on_index_1(void* context, size_t index)
+{
+    (void)context;
+    (void)function_under_test_2_calls();
+    return (index == 1) ? __LINE__ : 0;
+}
+
+static int test_body_exiting_the_worker(void* context, size_t index)
+{
+    (void)context;
+    (void)index;
+    _exit(1);
+}
+
+#endif
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -248,6 +330,31 @@ TEST_FUNCTION(negative_tests_with_2_calls)
     }
 }
 
+/* Tests_SRS_UMOCK_C_LIB_01_247: [ For the negative tests, an expected call with a repeat count is a single call: it shall be counted once by umock_c_negative_tests_call_count, and failing it with umock_c_negative_tests_fail_call shall fail all the actual calls that match it. ]*/
+TEST_FUNCTION(negative_tests_with_a_repeated_call_fail_all_its_repetitions_at_once)
+{
+    // arrange
+    int first_result;
+    int second_result;
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1).Times(2);
+    umock_c_negative_tests_snapshot();
+    umock_c_negative_tests_reset();
+    umock_c_negative_tests_fail_call(0);
+
+    // act
+    result = function_under_test_2_calls_of_the_same_function(&first_result, &second_result);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, umock_c_negative_tests_call_count());
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, first_result);
+    ASSERT_ARE_EQUAL(int, 1, second_result);
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
 /* Tests_SRS_UMOCK_C_LIB_01_167: [ umock_c_negative_tests_snapshot shall take a snapshot of the current setup of expected calls (a.k.a happy path). ]*/
 /* Tests_SRS_UMOCK_C_LIB_01_170: [ umock_c_negative_tests_reset shall bring umock_c expected and actual calls to the state recorded when umock_c_negative_tests_snapshot was called. ]*/
 /* Tests_SRS_UMOCK_C_LIB_01_173: [ umock_c_negative_tests_fail_call shall instruct the negative tests module to fail a specific call. ]*/
@@ -426,6 +533,35 @@ TEST_FUNCTION(umock_c_negative_tests_can_call_fail_test)
     ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_can_call_fail(5), "function_mark_cannot_fail_with_args indicated it can fail");
 }
 
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_050: [ umock_c_negative_tests_next_failable_index shall return the smallest index greater than or equal to index of an expected call in the snapshot that can fail. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_051: [ If there is no such index, umock_c_negative_tests_next_failable_index shall return the number of expected calls in the snapshot. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_visits_only_the_calls_that_can_fail)
+{
+    // arrange
+    size_t visited[6];
+    size_t visited_count = 0;
+    size_t i;
+    STRICT_EXPECTED_CALL(void_function_no_args());
+    STRICT_EXPECTED_CALL(function_mark_cannot_fail_no_args()).CallCannotFail();
+    STRICT_EXPECTED_CALL(void_function_with_args(12));
+    STRICT_EXPECTED_CALL(function_default_no_args());
+    STRICT_EXPECTED_CALL(function_default_with_args(34));
+    STRICT_EXPECTED_CALL(function_mark_cannot_fail_with_args(78)).CallCannotFail();
+    umock_c_negative_tests_snapshot();
+
+    // act
+    for (i = umock_c_negative_tests_next_failable_index(0); i < umock_c_negative_tests_call_count(); i = umock_c_negative_tests_next_failable_index(i + 1))
+    {
+        ASSERT_IS_TRUE(visited_count < 6);
+        visited[visited_count++] = i;
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, visited_count);
+    ASSERT_ARE_EQUAL(size_t, 3, visited[0]);
+    ASSERT_ARE_EQUAL(size_t, 4, visited[1]);
+}
+
 /* Tests_SRS_UMOCK_C_LIB_01_214: [ Specifying the return values for success and failure shall be equivalent to calling REGISTER_GLOBAL_MOCK_RETURNS. ]*/
 TEST_FUNCTION(fail_return_value_specified_in_MOCKABLE_FUNCTION_WITH_RETURNS_is_returned)
 {
@@ -461,4 +597,226 @@ TEST_FUNCTION(SetFailReturns_overrides_MOCKABLE_FUNCTION_WITH_RETURNS)
     ASSERT_ARE_EQUAL(int, 44, result);
 }
 
+#ifndef _WIN32
+
+/* umock_c_negative_tests_run_parallel */
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_036: [ Each worker shall handle the failure indices worker_index, worker_index + worker_count, ... up to the call count. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_041: [ The worker shall write the index, its result and the strings returned by umock_c_get_expected_calls and umock_c_get_actual_calls to its pipe. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_045: [ If on_result is not NULL, after all workers closed their pipes umock_c_negative_tests_run_parallel shall call on_result for each index in increasing index order, passing on_result_context, the index, its result and the reported expected and actual calls. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_with_2_calls_reports_each_index)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+    parallel_result_count = 0;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body_2_calls, NULL, on_parallel_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, parallel_result_count);
+    ASSERT_ARE_EQUAL(size_t, 0, parallel_results[0].index);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, parallel_results[0].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[function_2()]", parallel_results[0].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "", parallel_results[0].actual_calls);
+    ASSERT_ARE_EQUAL(size_t, 1, parallel_results[1].index);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, parallel_results[1].result);
+    ASSERT_ARE_EQUAL(char_ptr, "", parallel_results[1].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "", parallel_results[1].actual_calls);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_036: [ Each worker shall handle the failure indices worker_index, worker_index + worker_count, ... up to the call count. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_045: [ If on_result is not NULL, after all workers closed their pipes umock_c_negative_tests_run_parallel shall call on_result for each index in increasing index order, passing on_result_context, the index, its result and the reported expected and actual calls. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_with_more_calls_than_workers_reports_all_indices_in_order)
+{
+    // arrange
+    size_t i;
+    int result;
+    for (i = 0; i < 9; i++)
+    {
+        STRICT_EXPECTED_CALL(function_4_void_ptr_return_non_NULL((void*)0x42))
+            .SetFailReturn(NULL);
+    }
+    umock_c_negative_tests_snapshot();
+    parallel_result_count = 0;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(3, test_body_9_calls, NULL, on_parallel_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 9, parallel_result_count);
+    for (i = 0; i < 9; i++)
+    {
+        ASSERT_ARE_EQUAL(size_t, i, parallel_results[i].index);
+        ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, parallel_results[i].result);
+    }
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_033: [ If worker_count is 0, umock_c_negative_tests_run_parallel shall use the number of online processors as the worker count. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_034: [ The worker count shall be capped to the number of failure indices. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_with_0_workers_uses_the_default_worker_count)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+
+    // act
+    result = umock_c_negative_tests_run_parallel(0, test_body_2_calls, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_040: [ The index shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED if test_body returns 0 and as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED otherwise. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_reports_the_failed_index)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+    parallel_result_count = 0;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body_failing_on_index_1, NULL, on_parallel_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, parallel_result_count);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, parallel_results[0].result);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED, parallel_results[1].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_038: [ If umock_c_negative_tests_can_call_fail returns 0 for the index, the worker shall report the index as UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED without calling test_body. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_skips_calls_that_cannot_fail)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .CallCannotFail();
+    umock_c_negative_tests_snapshot();
+    parallel_result_count = 0;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body_failing_on_index_1, NULL, on_parallel_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, parallel_result_count);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, parallel_results[0].result);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED, parallel_results[1].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_044: [ Indices for which no complete report was received shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_reports_the_indices_of_a_worker_that_exited_as_lost)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+    parallel_result_count = 0;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(1, test_body_exiting_the_worker, NULL, on_parallel_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, parallel_result_count);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, parallel_results[0].result);
+    ASSERT_ARE_EQUAL(int, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, parallel_results[1].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_035: [ umock_c_negative_tests_run_parallel shall start worker_count worker processes by calling fork, each having a pipe to report its results to the parent. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_leaves_the_calls_of_the_test_process_untouched)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body_2_calls, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "[function_1()][function_2()]", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_030: [ If test_body is NULL, umock_c_negative_tests_run_parallel shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(negative_tests_run_parallel_with_NULL_test_body_fails)
+{
+    // arrange
+    int result;
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+#endif
+
+/* umock_c_enable_call_arena */
+
+/* this test leaves the call arena enabled, so it is kept last in the suite */
+
+/* Tests_SRS_UMOCK_C_LIB_01_229: [ Copies of calls (for example the ones made by the negative tests snapshot) shall not be allocated from the arena. ]*/
+TEST_FUNCTION(negative_tests_with_the_call_arena_enabled_replay_the_snapshot)
+{
+    size_t i;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_call_arena());
+    STRICT_EXPECTED_CALL(function_1())
+        .SetReturn(0).SetFailReturn(1);
+    STRICT_EXPECTED_CALL(function_2())
+        .SetReturn(0).SetFailReturn(1);
+    umock_c_negative_tests_snapshot();
+    umock_c_reset_all_calls();
+
+    for (i = 0; i < umock_c_negative_tests_call_count(); i++)
+    {
+        // arrange
+        char temp_str[128];
+        int result;
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(i);
+
+        // act
+        result = function_under_test_2_calls();
+
+        // assert
+        sprintf(temp_str, "On failed call %zu", i + 1);
+        ASSERT_ARE_NOT_EQUAL(int, 0, result, temp_str);
+
+        umock_c_reset_all_calls();
+    }
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/* the system headers are included first, so that only the calls made by the code under test are redirected */
+int mock_pipe(int pipe_fds[2]);
+pid_t mock_fork(void);
+ssize_t mock_read(int fd, void* buffer, size_t count);
+ssize_t mock_write(int fd, const void* buffer, size_t count);
+int mock_close(int fd);
+int mock_poll(struct pollfd* fds, nfds_t nfds, int timeout);
+int mock_kill(pid_t pid, int sig);
+pid_t mock_waitpid(pid_t pid, int* status, int options);
+void mock__exit(int status);
+long mock_sysconf(int name);
+void* mock_calloc(size_t nmemb, size_t size);
+
+#define pipe(pipe_fds) mock_pipe(pipe_fds)
+#define fork() mock_fork()
+#define read(fd, buffer, count) mock_read(fd, buffer, count)
+#define write(fd, buffer, count) mock_write(fd, buffer, count)
+#define close(fd) mock_close(fd)
+#define poll(fds, nfds, timeout) mock_poll(fds, nfds, timeout)
+#define kill(pid, sig) mock_kill(pid, sig)
+#define waitpid(pid, status, options) mock_waitpid(pid, status, options)
+#define _exit(status) mock__exit(status)
+#define sysconf(name) mock_sysconf(name)
+#define umockalloc_calloc(nmemb, size) mock_calloc(nmemb, size)
+
+/* include code under test */
+#include "../../src/umock_c_negative_tests_parallel.c"
@@ -0,0 +1,810 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/types.h>
+
+// TEST_DEFINE_ENUM_TYPE will use wchar.h, which we technically get from testrunnerswitcher.h
+// IWYU pragma: no_include <wchar.h>
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+
+TEST_DEFINE_ENUM_TYPE(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_VALUES)
+
+#define MAX_WORKERS 4
+#define MAX_CALLS 16
+#define MAX_STREAM_SIZE 4096
+#define TEST_FD_BASE 100
+#define TEST_PID_BASE 1000
+
+/* same layout as the report header written by the workers */
+typedef struct TEST_INDEX_REPORT_HEADER_TAG
+{
+    size_t index;
+    int result;
+    size_t expected_calls_size;
+    size_t actual_calls_size;
+} TEST_INDEX_REPORT_HEADER;
+
+typedef struct TEST_WORKER_STREAM_TAG
+{
+    char data[MAX_STREAM_SIZE];
+    size_t size;
+    size_t position;
+    /* at most this many bytes are returned by one read, 0 meaning no limit */
+    size_t read_size_limit;
+    /* the number of reads that fail with EINTR before the data is returned */
+    size_t interrupted_read_count;
+} TEST_WORKER_STREAM;
+
+typedef struct ON_RESULT_CALL_TAG
+{
+    size_t index;
+    UMOCK_C_NEGATIVE_TESTS_RESULT result;
+    char expected_calls[64];
+    char actual_calls[64];
+} ON_RESULT_CALL;
+
+static TEST_WORKER_STREAM worker_streams[MAX_WORKERS];
+
+static size_t pipe_call_count;
+static size_t when_shall_pipe_fail;
+static size_t fork_call_count;
+static size_t when_shall_fork_fail;
+static size_t when_shall_fork_return_0;
+static size_t close_call_count;
+static int closed_fds[4 * MAX_WORKERS];
+static size_t poll_call_count;
+static size_t poll_interrupted_count;
+static int poll_shall_fail;
+static size_t kill_call_count;
+static pid_t killed_pids[MAX_WORKERS];
+static size_t waitpid_call_count;
+static long sysconf_call_result;
+static size_t sysconf_call_count;
+static void* last_calloc_result;
+
+static char written_data[MAX_STREAM_SIZE];
+static size_t written_size;
+static int write_shall_fail;
+static jmp_buf exit_jump;
+static int exit_status;
+
+static size_t negative_tests_call_count;
+static const int* failable_indices;
+static size_t reset_call_count;
+static size_t fail_call_indices[MAX_CALLS];
+static size_t fail_call_call_count;
+static const char* expected_calls_result;
+static const char* actual_calls_result;
+
+static size_t test_body_call_count;
+static size_t test_body_indices[MAX_CALLS];
+static int test_body_result;
+
+static ON_RESULT_CALL on_result_calls[MAX_CALLS];
+static size_t on_result_call_count;
+
+int mock_pipe(int pipe_fds[2])
+{
+    int result;
+
+    pipe_call_count++;
+    if (pipe_call_count == when_shall_pipe_fail)
+    {
+        errno = EMFILE;
+        result = -1;
+    }
+    else
+    {
+        pipe_fds[0] = TEST_FD_BASE + (int)(2 * (pipe_call_count - 1));
+        pipe_fds[1] = pipe_fds[0] + 1;
+        result = 0;
+    }
+
+    return result;
+}
+
+pid_t mock_fork(void)
+{
+    pid_t result;
+
+    fork_call_count++;
+    if (fork_call_count == when_shall_fork_fail)
+    {
+        errno = EAGAIN;
+        result = -1;
+    }
+    else if (fork_call_count == when_shall_fork_return_0)
+    {
+        result = 0;
+    }
+    else
+    {
+        result = TEST_PID_BASE + (pid_t)fork_call_count - 1;
+    }
+
+    return result;
+}
+
+ssize_t mock_read(int fd, void* buffer, size_t count)
+{
+    ssize_t result;
+    TEST_WORKER_STREAM* stream = &worker_streams[(fd - TEST_FD_BASE) / 2];
+
+    if (stream->interrupted_read_count > 0)
+    {
+        stream->interrupted_read_count--;
+        errno = EINTR;
+        result = -1;
+    }
+    else
+    {
+        size_t remaining = stream->size - stream->position;
+        if ((stream->read_size_limit != 0) && (remaining > stream->read_size_limit))
+        {
+            remaining = stream->read_size_limit;
+        }
+        if (remaining > count)
+        {
+            remaining = count;
+        }
+
+        (void)memcpy(buffer, stream->data + stream->position, remaining);
+        stream->position += remaining;
+        result = (ssize_t)remaining;
+    }
+
+    return result;
+}
+
+ssize_t mock_write(int fd, const void* buffer, size_t count)
+{
+    ssize_t result;
+
+    (void)fd;
+    if (write_shall_fail)
+    {
+        errno = EPIPE;
+        result = -1;
+    }
+    else
+    {
+        ASSERT_IS_TRUE(written_size + count <= sizeof(written_data));
+        (void)memcpy(written_data + written_size, buffer, count);
+        written_size += count;
+        result = (ssize_t)count;
+    }
+
+    return result;
+}
+
+int mock_close(int fd)
+{
+    if (close_call_count < sizeof(closed_fds) / sizeof(closed_fds[0]))
+    {
+        closed_fds[close_call_count] = fd;
+    }
+    close_call_count++;
+    return 0;
+}
+
+int mock_poll(struct pollfd* fds, nfds_t nfds, int timeout)
+{
+    int result;
+
+    (void)timeout;
+    poll_call_count++;
+    if (poll_interrupted_count > 0)
+    {
+        poll_interrupted_count--;
+        errno = EINTR;
+        result = -1;
+    }
+    else if (poll_shall_fail)
+    {
+        errno = ENOMEM;
+        result = -1;
+    }
+    else
+    {
+        nfds_t i;
+
+        /* all the pipes are always readable, reading returns 0 once a worker has no more data */
+        result = 0;
+        for (i = 0; i < nfds; i++)
+        {
+            fds[i].revents = (fds[i].fd >= 0) ? POLLIN : 0;
+            if (fds[i].fd >= 0)
+            {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+int mock_kill(pid_t pid, int sig)
+{
+    (void)sig;
+    if (kill_call_count < MAX_WORKERS)
+    {
+        killed_pids[kill_call_count] = pid;
+    }
+    kill_call_count++;
+    return 0;
+}
+
+pid_t mock_waitpid(pid_t pid, int* status, int options)
+{
+    (void)status;
+    (void)options;
+    waitpid_call_count++;
+    return pid;
+}
+
+void mock__exit(int status)
+{
+    exit_status = status;
+    longjmp(exit_jump, 1);
+}
+
+long mock_sysconf(int name)
+{
+    (void)name;
+    sysconf_call_count++;
+    return sysconf_call_result;
+}
+
+void* mock_calloc(size_t nmemb, size_t size)
+{
+    last_calloc_result = calloc(nmemb, size);
+    return last_calloc_result;
+}
+
+size_t umock_c_negative_tests_call_count(void)
+{
+    return negative_tests_call_count;
+}
+
+size_t umock_c_negative_tests_next_failable_index(size_t index)
+{
+    while ((index < negative_tests_call_count) && !failable_indices[index])
+    {
+        index++;
+    }
+
+    return index;
+}
+
+void umock_c_negative_tests_reset(void)
+{
+    reset_call_count++;
+}
+
+void umock_c_negative_tests_fail_call(size_t index)
+{
+    fail_call_indices[fail_call_call_count++] = index;
+}
+
+const char* umock_c_get_expected_calls(void)
+{
+    return expected_calls_result;
+}
+
+const char* umock_c_get_actual_calls(void)
+{
+    return actual_calls_result;
+}
+
+static int test_body(void* context, size_t index)
+{
+    (void)context;
+    test_body_indices[test_body_call_count++] = index;
+    return test_body_result;
+}
+
+static void on_result(void* context, size_t index, UMOCK_C_NEGATIVE_TESTS_RESULT result, const char* expected_calls, const char* actual_calls)
+{
+    (void)context;
+    ASSERT_IS_TRUE(on_result_call_count < MAX_CALLS);
+    on_result_calls[on_result_call_count].index = index;
+    on_result_calls[on_result_call_count].result = result;
+    (void)strncpy(on_result_calls[on_result_call_count].expected_calls, expected_calls, sizeof(on_result_calls[0].expected_calls) - 1);
+    (void)strncpy(on_result_calls[on_result_call_count].actual_calls, actual_calls, sizeof(on_result_calls[0].actual_calls) - 1);
+    on_result_call_count++;
+}
+
+static void append_report(size_t worker_index, size_t index, UMOCK_C_NEGATIVE_TESTS_RESULT result, const char* expected_calls, const char* actual_calls)
+{
+    TEST_WORKER_STREAM* stream = &worker_streams[worker_index];
+    TEST_INDEX_REPORT_HEADER header;
+
+    header.index = index;
+    header.result = (int)result;
+    header.expected_calls_size = strlen(expected_calls) + 1;
+    header.actual_calls_size = strlen(actual_calls) + 1;
+
+    ASSERT_IS_TRUE(stream->size + sizeof(header) + header.expected_calls_size + header.actual_calls_size <= sizeof(stream->data));
+    (void)memcpy(stream->data + stream->size, &header, sizeof(header));
+    stream->size += sizeof(header);
+    (void)memcpy(stream->data + stream->size, expected_calls, header.expected_calls_size);
+    stream->size += header.expected_calls_size;
+    (void)memcpy(stream->data + stream->size, actual_calls, header.actual_calls_size);
+    stream->size += header.actual_calls_size;
+}
+
+static const int all_failable[MAX_CALLS] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 };
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+    (void)memset(worker_streams, 0, sizeof(worker_streams));
+    pipe_call_count = 0;
+    when_shall_pipe_fail = 0;
+    fork_call_count = 0;
+    when_shall_fork_fail = 0;
+    when_shall_fork_return_0 = 0;
+    close_call_count = 0;
+    poll_call_count = 0;
+    poll_interrupted_count = 0;
+    poll_shall_fail = 0;
+    kill_call_count = 0;
+    waitpid_call_count = 0;
+    sysconf_call_result = 1;
+    sysconf_call_count = 0;
+    last_calloc_result = NULL;
+    written_size = 0;
+    write_shall_fail = 0;
+    exit_status = -1;
+    negative_tests_call_count = 0;
+    failable_indices = all_failable;
+    reset_call_count = 0;
+    fail_call_call_count = 0;
+    expected_calls_result = "";
+    actual_calls_result = "";
+    test_body_call_count = 0;
+    test_body_result = 0;
+    on_result_call_count = 0;
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+}
+
+/* umock_c_negative_tests_run_parallel */
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_030: [ If test_body is NULL, umock_c_negative_tests_run_parallel shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_with_NULL_test_body_fails)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 2;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, NULL, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, fork_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_031: [ umock_c_negative_tests_run_parallel shall obtain the number of failure indices by calling umock_c_negative_tests_call_count. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_032: [ If there are no failure indices (which is also the case when the module is not initialized or no snapshot was taken), umock_c_negative_tests_run_parallel shall return 0 without starting any worker. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_without_failure_indices_does_not_start_workers)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, pipe_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, fork_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_033: [ If worker_count is 0, umock_c_negative_tests_run_parallel shall use the number of online processors as the worker count. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_with_0_workers_uses_the_number_of_online_processors)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 8;
+    sysconf_call_result = 3;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(0, test_body, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, sysconf_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, fork_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, waitpid_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_034: [ The worker count shall be capped to the number of failure indices. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_caps_the_worker_count_to_the_number_of_failure_indices)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 2;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    append_report(1, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+
+    // act
+    result = umock_c_negative_tests_run_parallel(4, test_body, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, pipe_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, fork_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_035: [ umock_c_negative_tests_run_parallel shall start worker_count worker processes by calling fork, each having a pipe to report its results to the parent. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_043: [ umock_c_negative_tests_run_parallel shall read the reports of all workers concurrently until each worker closes its pipe. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_045: [ If on_result is not NULL, after all workers closed their pipes umock_c_negative_tests_run_parallel shall call on_result for each index in increasing index order, passing on_result_context, the index, its result and the reported expected and actual calls. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_reports_the_results_of_all_workers_in_index_order)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 4;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[a()]", "[b()]");
+    append_report(0, 2, UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED, "", "");
+    append_report(1, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[c()]", "");
+    append_report(1, 3, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "[d()]");
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, fork_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, on_result_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_calls[0].index);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[0].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", on_result_calls[0].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[b()]", on_result_calls[0].actual_calls);
+    ASSERT_ARE_EQUAL(size_t, 1, on_result_calls[1].index);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[1].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[c()]", on_result_calls[1].expected_calls);
+    ASSERT_ARE_EQUAL(size_t, 2, on_result_calls[2].index);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED, on_result_calls[2].result);
+    ASSERT_ARE_EQUAL(size_t, 3, on_result_calls[3].index);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[3].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[d()]", on_result_calls[3].actual_calls);
+    ASSERT_ARE_EQUAL(size_t, 2, waitpid_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, kill_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_043: [ umock_c_negative_tests_run_parallel shall read the reports of all workers concurrently until each worker closes its pipe. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_reassembles_reports_split_over_short_reads)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 4;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[a()]", "[b()]");
+    append_report(0, 2, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[e()]", "[f()]");
+    append_report(1, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[c()]", "[d()]");
+    append_report(1, 3, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[g()]", "[h()]");
+    /* the header itself is split over several reads */
+    worker_streams[0].read_size_limit = 1;
+    worker_streams[1].read_size_limit = 7;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, on_result_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", on_result_calls[0].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[b()]", on_result_calls[0].actual_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[c()]", on_result_calls[1].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[d()]", on_result_calls[1].actual_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[e()]", on_result_calls[2].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[f()]", on_result_calls[2].actual_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[g()]", on_result_calls[3].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "[h()]", on_result_calls[3].actual_calls);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_043: [ umock_c_negative_tests_run_parallel shall read the reports of all workers concurrently until each worker closes its pipe. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_retries_interrupted_polls_and_reads)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 1;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    worker_streams[0].interrupted_read_count = 2;
+    poll_interrupted_count = 1;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, on_result_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[0].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_044: [ Indices for which no complete report was received shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_reports_the_indices_of_a_worker_that_died_as_lost)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 4;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    append_report(0, 2, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    /* the second worker closes its pipe without reporting anything */
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, on_result_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[0].result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, on_result_calls[1].result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[2].result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, on_result_calls[3].result);
+    ASSERT_ARE_EQUAL(char_ptr, "", on_result_calls[1].expected_calls);
+    ASSERT_ARE_EQUAL(char_ptr, "", on_result_calls[1].actual_calls);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_044: [ Indices for which no complete report was received shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_reports_a_truncated_report_as_lost)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 3;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[a()]", "[b()]");
+    append_report(0, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[c()]", "[d()]");
+    append_report(0, 2, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "[e()]", "[f()]");
+    /* the worker died in the middle of the strings of its last report */
+    worker_streams[0].size -= 3;
+    worker_streams[0].read_size_limit = 5;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, on_result_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[0].result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[1].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[d()]", on_result_calls[1].actual_calls);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, on_result_calls[2].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_044: [ Indices for which no complete report was received shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_reports_a_truncated_header_as_lost)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 2;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    append_report(0, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    worker_streams[0].size -= sizeof(TEST_INDEX_REPORT_HEADER);
+
+    // act
+    result = umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, on_result_calls[0].result);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST, on_result_calls[1].result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_046: [ On success, umock_c_negative_tests_run_parallel shall return 0 if no index was reported as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED or UMOCK_C_NEGATIVE_TESTS_RESULT_WORKER_LOST and a non-zero value otherwise. ]*/
+TEST_FUNCTION(umock_c_negative_tests_run_parallel_with_a_failed_index_fails)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 2;
+    append_report(0, 0, UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, "", "");
+    append_report(0, 1, UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED, "[a()]", "");
+
+    // act
+    result = umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, on_result_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_NEGATIVE_TESTS_RESULT, UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED, on_result_calls[1].result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", on_result_calls[1].expected_calls);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_047: [ If any error occurs, umock_c_negative_tests_run_parallel shall stop all the workers and return a non-zero value. ]*/
+TEST_FUNCTION(when_fork_fails_umock_c_negative_tests_run_parallel_stops_the_started_workers)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 4;
+    when_shall_fork_fail = 3;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(3, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, kill_call_count);
+    ASSERT_ARE_EQUAL(int, TEST_PID_BASE, killed_pids[0]);
+    ASSERT_ARE_EQUAL(int, TEST_PID_BASE + 1, killed_pids[1]);
+    ASSERT_ARE_EQUAL(size_t, 2, waitpid_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_call_count);
+    /* write ends of the 2 started workers, both ends of the failed pipe and the read ends of the 2 started workers */
+    ASSERT_ARE_EQUAL(size_t, 6, close_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_047: [ If any error occurs, umock_c_negative_tests_run_parallel shall stop all the workers and return a non-zero value. ]*/
+TEST_FUNCTION(when_pipe_fails_umock_c_negative_tests_run_parallel_stops_the_started_workers)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 4;
+    when_shall_pipe_fail = 2;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(3, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, fork_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, kill_call_count);
+    ASSERT_ARE_EQUAL(int, TEST_PID_BASE, killed_pids[0]);
+    ASSERT_ARE_EQUAL(size_t, 1, waitpid_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_047: [ If any error occurs, umock_c_negative_tests_run_parallel shall stop all the workers and return a non-zero value. ]*/
+TEST_FUNCTION(when_poll_fails_umock_c_negative_tests_run_parallel_stops_all_workers)
+{
+    // arrange
+    int result;
+    negative_tests_call_count = 2;
+    poll_shall_fail = 1;
+
+    // act
+    result = umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, kill_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, waitpid_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_036: [ Each worker shall handle the failure indices worker_index, worker_index + worker_count, ... up to the call count. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_037: [ For each index the worker shall determine whether the call can fail by calling umock_c_negative_tests_next_failable_index. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_038: [ If the call cannot fail, the worker shall report the index as UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED without resetting the calls and without calling test_body. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_039: [ Otherwise the worker shall call umock_c_negative_tests_reset, then umock_c_negative_tests_fail_call for the index and then call test_body, passing test_body_context and the index as arguments. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_041: [ The worker shall write the index, its result and the strings returned by umock_c_get_expected_calls and umock_c_get_actual_calls to its pipe. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_042: [ When done, the worker shall terminate by calling _exit, without returning to the caller of umock_c_negative_tests_run_parallel. ]*/
+TEST_FUNCTION(a_worker_runs_its_failable_indices_and_reports_them)
+{
+    // arrange
+    static const int failable[5] = { 1, 1, 0, 1, 1 };
+    TEST_INDEX_REPORT_HEADER header;
+    size_t position = 0;
+    size_t report_index;
+    negative_tests_call_count = 5;
+    failable_indices = failable;
+    expected_calls_result = "[a()]";
+    actual_calls_result = "[b()]";
+    /* the first fork returns in the worker, which handles indices 0, 2 and 4 */
+    when_shall_fork_return_0 = 1;
+
+    // act
+    if (setjmp(exit_jump) == 0)
+    {
+        (void)umock_c_negative_tests_run_parallel(2, test_body, NULL, on_result, NULL);
+        ASSERT_FAIL("The worker returned to the caller");
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, exit_status);
+    ASSERT_ARE_EQUAL(size_t, 2, reset_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, fail_call_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, fail_call_indices[0]);
+    ASSERT_ARE_EQUAL(size_t, 4, fail_call_indices[1]);
+    ASSERT_ARE_EQUAL(size_t, 2, test_body_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_body_indices[0]);
+    ASSERT_ARE_EQUAL(size_t, 4, test_body_indices[1]);
+    ASSERT_ARE_EQUAL(size_t, 0, on_result_call_count);
+
+    for (report_index = 0; report_index < 3; report_index++)
+    {
+        static const size_t expected_indices[3] = { 0, 2, 4 };
+        ASSERT_IS_TRUE(written_size - position >= sizeof(header));
+        (void)memcpy(&header, written_data + position, sizeof(header));
+        position += sizeof(header);
+        ASSERT_ARE_EQUAL(size_t, expected_indices[report_index], header.index);
+        if (report_index == 1)
+        {
+            ASSERT_ARE_EQUAL(int, (int)UMOCK_C_NEGATIVE_TESTS_RESULT_SKIPPED, header.result);
+            ASSERT_ARE_EQUAL(char_ptr, "", written_data + position);
+            ASSERT_ARE_EQUAL(char_ptr, "", written_data + position + header.expected_calls_size);
+        }
+        else
+        {
+            ASSERT_ARE_EQUAL(int, (int)UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED, header.result);
+            ASSERT_ARE_EQUAL(char_ptr, "[a()]", written_data + position);
+            ASSERT_ARE_EQUAL(char_ptr, "[b()]", written_data + position + header.expected_calls_size);
+        }
+        position += header.expected_calls_size + header.actual_calls_size;
+    }
+    ASSERT_ARE_EQUAL(size_t, written_size, position);
+
+    // cleanup
+    free(last_calloc_result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_040: [ The index shall be reported as UMOCK_C_NEGATIVE_TESTS_RESULT_PASSED if test_body returns 0 and as UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED otherwise. ]*/
+TEST_FUNCTION(a_worker_reports_an_index_for_which_the_test_body_fails_as_failed)
+{
+    // arrange
+    TEST_INDEX_REPORT_HEADER header;
+    negative_tests_call_count = 1;
+    test_body_result = 1;
+    when_shall_fork_return_0 = 1;
+
+    // act
+    if (setjmp(exit_jump) == 0)
+    {
+        (void)umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+        ASSERT_FAIL("The worker returned to the caller");
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, exit_status);
+    ASSERT_IS_TRUE(written_size >= sizeof(header));
+    (void)memcpy(&header, written_data, sizeof(header));
+    ASSERT_ARE_EQUAL(size_t, 0, header.index);
+    ASSERT_ARE_EQUAL(int, (int)UMOCK_C_NEGATIVE_TESTS_RESULT_FAILED, header.result);
+
+    // cleanup
+    free(last_calloc_result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_042: [ When done, the worker shall terminate by calling _exit, without returning to the caller of umock_c_negative_tests_run_parallel. ]*/
+TEST_FUNCTION(when_writing_a_report_fails_the_worker_stops_and_exits_with_a_non_zero_code)
+{
+    // arrange
+    negative_tests_call_count = 3;
+    write_shall_fail = 1;
+    when_shall_fork_return_0 = 1;
+
+    // act
+    if (setjmp(exit_jump) == 0)
+    {
+        (void)umock_c_negative_tests_run_parallel(1, test_body, NULL, on_result, NULL);
+        ASSERT_FAIL("The worker returned to the caller");
+    }
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, exit_status);
+    ASSERT_ARE_EQUAL(size_t, 1, test_body_call_count);
+
+    // cleanup
+    free(last_calloc_result);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
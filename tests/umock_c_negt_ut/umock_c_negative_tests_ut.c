@@ -38,7 +38,10 @@ typedef struct umockcallrecorder_get_expected_call_count_CALL_TAG
 static umockcallrecorder_get_expected_call_count_CALL* umockcallrecorder_get_expected_call_count_calls;
 static size_t umockcallrecorder_get_expected_call_count_call_count;
 static int umockcallrecorder_get_expected_call_count_call_result;
+static size_t umockcallrecorder_get_expected_call_count_value;
 static int umockcallrecorder_can_call_fail_result;
+static size_t umockcallrecorder_can_call_fail_call_count;
+static const int* umockcallrecorder_can_call_fail_per_index_results;
 
 
 typedef struct umockcallrecorder_fail_call_CALL_TAG
@@ -113,7 +116,7 @@ int umockcallrecorder_get_expected_call_count(UMOCKCALLRECORDER_HANDLE umock_cal
         umockcallrecorder_get_expected_call_count_calls[umockcallrecorder_get_expected_call_count_call_count].umock_call_recorder = umock_call_recorder;
         umockcallrecorder_get_expected_call_count_calls[umockcallrecorder_get_expected_call_count_call_count].expected_call_count = expected_call_count;
         umockcallrecorder_get_expected_call_count_call_count++;
-        *expected_call_count = 42;
+        *expected_call_count = umockcallrecorder_get_expected_call_count_value;
     }
 
     return umockcallrecorder_get_expected_call_count_call_result;
@@ -161,7 +164,8 @@ int umockcallrecorder_can_call_fail(UMOCKCALLRECORDER_HANDLE umock_call_recorder
 {
     umockecallercorder_can_call_fail_call.umock_call_recorder = umock_call_recorder;
     umockecallercorder_can_call_fail_call.index = index;
-    *can_call_fail = umockcallrecorder_can_call_fail_paramater_result;
+    umockcallrecorder_can_call_fail_call_count++;
+    *can_call_fail = (umockcallrecorder_can_call_fail_per_index_results != NULL) ? umockcallrecorder_can_call_fail_per_index_results[index] : umockcallrecorder_can_call_fail_paramater_result;
     return umockcallrecorder_can_call_fail_result;
 }
 
@@ -196,6 +200,7 @@ void reset_all_calls(void)
     umockcallrecorder_get_expected_call_count_calls = NULL;
     umockcallrecorder_get_expected_call_count_call_count = 0;
     umockcallrecorder_get_expected_call_count_call_result = 0;
+    umockcallrecorder_get_expected_call_count_value = 42;
 
     if (umockcallrecorder_fail_call_calls != NULL)
     {
@@ -208,6 +213,8 @@ void reset_all_calls(void)
     umockecallercorder_can_call_fail_call.index = 0;
     umockecallercorder_can_call_fail_call.umock_call_recorder = 0;
     umockcallrecorder_can_call_fail_result = 0;
+    umockcallrecorder_can_call_fail_call_count = 0;
+    umockcallrecorder_can_call_fail_per_index_results = NULL;
 
     if (umock_c_set_call_recorder_calls != NULL)
     {
@@ -409,6 +416,73 @@ TEST_FUNCTION(umock_c_negative_tests_snapshot_when_not_initialized_does_nothing)
     ASSERT_ARE_EQUAL(size_t, 0, umock_c_indicate_error_call_count);
 }
 
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_048: [ umock_c_negative_tests_snapshot shall compute the sorted list of failable indices of the copy by calling umockcallrecorder_get_expected_call_count and then umockcallrecorder_can_call_fail for each expected call. ]*/
+TEST_FUNCTION(umock_c_negative_tests_snapshot_computes_the_failable_indices_of_the_copy)
+{
+    // arrange
+    static const int can_call_fail_results[] = { 1, 0, 0, 1, 1 };
+    (void)umock_c_negative_tests_init();
+    reset_all_calls();
+    umockcallrecorder_clone_call_result = test_cloned_call_recorder;
+    umockcallrecorder_get_expected_call_count_value = 5;
+    umockcallrecorder_can_call_fail_per_index_results = can_call_fail_results;
+
+    // act
+    umock_c_negative_tests_snapshot();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, umockcallrecorder_get_expected_call_count_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_cloned_call_recorder, umockcallrecorder_get_expected_call_count_calls[0].umock_call_recorder);
+    ASSERT_ARE_EQUAL(size_t, 5, umockcallrecorder_can_call_fail_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_cloned_call_recorder, umockecallercorder_can_call_fail_call.umock_call_recorder);
+    ASSERT_ARE_EQUAL(size_t, 0, umock_c_indicate_error_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_049: [ If computing the failable indices fails, umock_c_negative_tests_snapshot shall destroy the copy, keep the previous snapshot and indicate the error via the umock error callback with error code UMOCK_C_ERROR. ]*/
+TEST_FUNCTION(when_getting_the_expected_call_count_fails_umock_c_negative_tests_snapshot_indicates_an_error)
+{
+    // arrange
+    (void)umock_c_negative_tests_init();
+    reset_all_calls();
+    umockcallrecorder_clone_call_result = test_cloned_call_recorder;
+    umockcallrecorder_get_expected_call_count_call_result = __LINE__;
+
+    // act
+    umock_c_negative_tests_snapshot();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, umockcallrecorder_destroy_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_cloned_call_recorder, umockcallrecorder_destroy_calls[0].umock_call_recorder);
+    ASSERT_ARE_EQUAL(size_t, 1, umock_c_indicate_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, umock_c_indicate_error_calls[0].error_code);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_049: [ If computing the failable indices fails, umock_c_negative_tests_snapshot shall destroy the copy, keep the previous snapshot and indicate the error via the umock error callback with error code UMOCK_C_ERROR. ]*/
+TEST_FUNCTION(when_getting_whether_a_call_can_fail_fails_umock_c_negative_tests_snapshot_keeps_the_previous_snapshot)
+{
+    // arrange
+    (void)umock_c_negative_tests_init();
+    umock_c_negative_tests_snapshot();
+    reset_all_calls();
+    umockcallrecorder_clone_call_result = test_cloned_call_recorder;
+    umockcallrecorder_can_call_fail_result = __LINE__;
+
+    // act
+    umock_c_negative_tests_snapshot();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, umockcallrecorder_destroy_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_cloned_call_recorder, umockcallrecorder_destroy_calls[0].umock_call_recorder);
+    ASSERT_ARE_EQUAL(size_t, 1, umock_c_indicate_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, umock_c_indicate_error_calls[0].error_code);
+
+    // the first snapshot is still used
+    reset_all_calls();
+    umock_c_negative_tests_reset();
+    ASSERT_ARE_EQUAL(size_t, 1, umock_c_set_call_recorder_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, umock_c_set_call_recorder_calls[0].umock_call_recorder);
+}
+
 /* umock_c_negative_tests_reset */
 
 /* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_011: [ umock_c_negative_tests_reset shall reset the call recorder used by umock_c to the call recorder stored in umock_c_negative_tests_reset. ]*/
@@ -756,4 +830,99 @@ TEST_FUNCTION(umock_c_negative_tests_can_call_fail_when_the_module_is_not_initia
     ASSERT_ARE_EQUAL(size_t, 0, umockecallercorder_can_call_fail_call.index);
 }
 
+/* umock_c_negative_tests_next_failable_index */
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_050: [ umock_c_negative_tests_next_failable_index shall return the smallest index greater than or equal to index of an expected call in the snapshot that can fail. ]*/
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_051: [ If there is no such index, umock_c_negative_tests_next_failable_index shall return the number of expected calls in the snapshot. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_returns_the_next_index_of_a_call_that_can_fail)
+{
+    // arrange
+    static const int can_call_fail_results[] = { 1, 0, 0, 1, 1 };
+    (void)umock_c_negative_tests_init();
+    umockcallrecorder_get_expected_call_count_value = 5;
+    umockcallrecorder_can_call_fail_per_index_results = can_call_fail_results;
+    umock_c_negative_tests_snapshot();
+    reset_all_calls();
+
+    // act
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, umock_c_negative_tests_next_failable_index(0));
+    ASSERT_ARE_EQUAL(size_t, 3, umock_c_negative_tests_next_failable_index(1));
+    ASSERT_ARE_EQUAL(size_t, 3, umock_c_negative_tests_next_failable_index(2));
+    ASSERT_ARE_EQUAL(size_t, 3, umock_c_negative_tests_next_failable_index(3));
+    ASSERT_ARE_EQUAL(size_t, 4, umock_c_negative_tests_next_failable_index(4));
+    ASSERT_ARE_EQUAL(size_t, 5, umock_c_negative_tests_next_failable_index(5));
+    ASSERT_ARE_EQUAL(size_t, 5, umock_c_negative_tests_next_failable_index(100));
+    ASSERT_ARE_EQUAL(size_t, 0, umock_c_indicate_error_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_051: [ If there is no such index, umock_c_negative_tests_next_failable_index shall return the number of expected calls in the snapshot. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_when_no_call_can_fail_returns_the_call_count)
+{
+    // arrange
+    size_t result;
+    (void)umock_c_negative_tests_init();
+    umockcallrecorder_get_expected_call_count_value = 3;
+    umockcallrecorder_can_call_fail_paramater_result = 0;
+    umock_c_negative_tests_snapshot();
+    reset_all_calls();
+
+    // act
+    result = umock_c_negative_tests_next_failable_index(0);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 3, result);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_052: [ umock_c_negative_tests_next_failable_index shall only use the failable indices computed by umock_c_negative_tests_snapshot, without calling into the call recorder. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_does_not_call_into_the_call_recorder)
+{
+    // arrange
+    size_t result;
+    (void)umock_c_negative_tests_init();
+    umockcallrecorder_get_expected_call_count_value = 3;
+    umockcallrecorder_can_call_fail_paramater_result = 1;
+    umock_c_negative_tests_snapshot();
+    reset_all_calls();
+
+    // act
+    result = umock_c_negative_tests_next_failable_index(1);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umock_c_get_call_recorder_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_get_expected_call_count_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_can_call_fail_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_054: [ If no call has been made to umock_c_negative_tests_snapshot, umock_c_negative_tests_next_failable_index shall return 0 and indicate the error via the umock error callback with error code UMOCK_C_ERROR. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_when_no_snapshot_was_done_indicates_an_error)
+{
+    // arrange
+    size_t result;
+    (void)umock_c_negative_tests_init();
+    reset_all_calls();
+
+    // act
+    result = umock_c_negative_tests_next_failable_index(0);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, umock_c_indicate_error_call_count);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, umock_c_indicate_error_calls[0].error_code);
+}
+
+/* Tests_SRS_UMOCK_C_NEGATIVE_TESTS_01_053: [ If the module was not previously initialized, umock_c_negative_tests_next_failable_index shall return 0. ]*/
+TEST_FUNCTION(umock_c_negative_tests_next_failable_index_when_the_module_is_not_initialized_returns_0)
+{
+    // arrange
+
+    // act
+    size_t result = umock_c_negative_tests_next_failable_index(2);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umock_c_indicate_error_call_count);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,446 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>                      // for sprintf
+#include <stdlib.h>
+#include <time.h>                       // for timespec_get
+
+#include "macro_utils/macro_utils.h" // IWYU pragma: keep
+#include "c_logging/logger.h"
+
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes.h"
+#include "umock_c/umockalloc.h"
+
+#include "umockalloc_counting.h"
+
+/* Measures the cost of the umock_c hot paths (recording and matching calls, negative tests snapshots, building the call reports, tracking paired handles).
+Each scenario logs one line of the form:
+umock_c_perf scenario=<name> calls=<count> ns_per_call=<value> allocs_per_call=<value>
+so that the results can be collected by a script and compared between runs. allocs_per_call counts the umockalloc malloc/calloc/realloc calls. */
+
+#define CALL_COUNT 10000
+#define NEGATIVE_TESTS_CALL_COUNT 100
+#define REGISTERED_TYPE_COUNT 1000
+#define TYPE_NAME_LENGTH 32
+#define IGNORE_ALL_CALLS_OTHER_FUNCTION_COUNT 32
+#define STRINGIFY_BUFFER_COUNT 1000
+#define STRINGIFY_BUFFER_LENGTH 4096
+
+typedef int PERF_TYPE;
+typedef void* PERF_HANDLE;
+
+#include "umock_c/umock_c_ENABLE_MOCKS.h" // ============================== ENABLE_MOCKS
+
+MOCK_FUNCTION_WITH_CODE(, int, perf_function, int, a)
+MOCK_FUNCTION_END(0)
+MOCK_FUNCTION_WITH_CODE(, int, perf_function_with_registered_type, PERF_TYPE, a)
+MOCK_FUNCTION_END(0)
+MOCK_FUNCTION_WITH_CODE(, PERF_HANDLE, perf_create, int, a)
+    PERF_HANDLE my_result = (PERF_HANDLE)(uintptr_t)(a + 1);
+MOCK_FUNCTION_END(my_result)
+MOCK_FUNCTION_WITH_CODE(, void, perf_destroy, PERF_HANDLE, h)
+MOCK_FUNCTION_END()
+MOCK_FUNCTION_WITH_CODE(, int, perf_send, const void*, buffer)
+MOCK_FUNCTION_END(0)
+
+#include "umock_c/umock_c_DISABLE_MOCKS.h" // ============================== DISABLE_MOCKS
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void test_on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)sprintf(temp_str, "umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+static char* perf_stringify(const void* value)
+{
+    (void)value;
+    return NULL;
+}
+
+static int perf_are_equal(const void* left, const void* right)
+{
+    return (*(const int*)left == *(const int*)right) ? 1 : 0;
+}
+
+static int perf_copy(void* destination, const void* source)
+{
+    *(int*)destination = *(const int*)source;
+    return 0;
+}
+
+static void perf_free(void* value)
+{
+    (void)value;
+}
+
+static double get_time_ns(void)
+{
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000000000.0 + (double)ts.tv_nsec;
+}
+
+static double start_time;
+
+static void start_measurement(void)
+{
+    umockalloc_counting_reset();
+    start_time = get_time_ns();
+}
+
+static void end_measurement(const char* scenario, size_t call_count)
+{
+    double elapsed_ns = get_time_ns() - start_time;
+    size_t allocation_count = umockalloc_counting_get_allocation_count();
+
+    LogInfo("umock_c_perf scenario=%s calls=%u ns_per_call=%.1f allocs_per_call=%.2f",
+        scenario, (unsigned int)call_count, elapsed_ns / (double)call_count, (double)allocation_count / (double)call_count);
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(test_on_umock_c_error));
+    REGISTER_UMOCK_ALIAS_TYPE(PERF_HANDLE, void*);
+    REGISTER_UMOCKC_PAIRED_CREATE_DESTROY_CALLS(perf_create, perf_destroy);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION(umock_c_perf_calls_with_no_expectations)
+{
+    size_t i;
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("no_expectations", CALL_COUNT);
+}
+
+TEST_FUNCTION(umock_c_perf_strict_expected_calls)
+{
+    size_t i;
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function((int)i));
+    }
+    end_measurement("strict_expected_calls", CALL_COUNT);
+}
+
+TEST_FUNCTION(umock_c_perf_strict_in_order_matching)
+{
+    size_t i;
+
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function((int)i));
+    }
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("strict_in_order_matching", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_ignore_all_calls)
+{
+    size_t i;
+
+    STRICT_EXPECTED_CALL(perf_function(IGNORED_ARG))
+        .IgnoreAllCalls();
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("ignore_all_calls", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_ignore_all_calls_with_other_functions)
+{
+    size_t i;
+
+    /* many ignore_all_calls expectations for other functions (like logging or allocator mocks) should not slow down the matching */
+    for (i = 0; i < IGNORE_ALL_CALLS_OTHER_FUNCTION_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_create(IGNORED_ARG))
+            .IgnoreAllCalls();
+        STRICT_EXPECTED_CALL(perf_destroy(IGNORED_ARG))
+            .IgnoreAllCalls();
+    }
+    STRICT_EXPECTED_CALL(perf_function(IGNORED_ARG))
+        .IgnoreAllCalls();
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("ignore_all_calls_with_other_functions", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_repeated_expected_call)
+{
+    size_t i;
+
+    STRICT_EXPECTED_CALL(perf_function(IGNORED_ARG))
+        .Times(CALL_COUNT);
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("repeated_expected_call", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_unordered_expected_calls)
+{
+    size_t i;
+
+    /* the calls of the 2 functions are interleaved in the group and each function is called in one go */
+    UNORDERED_EXPECTED_CALLS(
+        for (i = 0; i < CALL_COUNT / 2; i++)
+        {
+            STRICT_EXPECTED_CALL(perf_function((int)i));
+            STRICT_EXPECTED_CALL(perf_create((int)i));
+        }
+    );
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT / 2; i++)
+    {
+        (void)perf_create((int)i);
+    }
+    for (i = 0; i < CALL_COUNT / 2; i++)
+    {
+        (void)perf_function((int)i);
+    }
+    end_measurement("unordered_expected_calls", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_matching_with_many_registered_types)
+{
+    char (*type_names)[TYPE_NAME_LENGTH] = malloc(REGISTERED_TYPE_COUNT * TYPE_NAME_LENGTH);
+    size_t i;
+
+    ASSERT_IS_NOT_NULL(type_names);
+
+    /* the type used by the mock is registered last, which is the worst case for looking it up */
+    for (i = 0; i < REGISTERED_TYPE_COUNT; i++)
+    {
+        (void)sprintf(type_names[i], "PERF_TYPE_%u", (unsigned int)i);
+        ASSERT_ARE_EQUAL(int, 0, umocktypes_register_type(type_names[i], perf_stringify, perf_are_equal, perf_copy, perf_free));
+    }
+    REGISTER_UMOCK_ALIAS_TYPE(PERF_TYPE, int);
+
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function_with_registered_type((PERF_TYPE)i));
+    }
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function_with_registered_type((PERF_TYPE)i);
+    }
+    end_measurement("many_registered_types", CALL_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+
+    /* bring back the types registered by umock_c_init only */
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(test_on_umock_c_error));
+    REGISTER_UMOCK_ALIAS_TYPE(PERF_HANDLE, void*);
+    free(type_names);
+}
+
+TEST_FUNCTION(umock_c_perf_negative_tests_snapshot)
+{
+    size_t i;
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+
+    for (i = 0; i < NEGATIVE_TESTS_CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function((int)i))
+            .SetFailReturn(1);
+    }
+
+    start_measurement();
+    umock_c_negative_tests_snapshot();
+    end_measurement("negative_tests_snapshot", NEGATIVE_TESTS_CALL_COUNT);
+
+    umock_c_negative_tests_deinit();
+}
+
+TEST_FUNCTION(umock_c_perf_negative_tests_reset)
+{
+    size_t i;
+
+    ASSERT_ARE_EQUAL(int, 0, umock_c_negative_tests_init());
+
+    for (i = 0; i < NEGATIVE_TESTS_CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function((int)i))
+            .SetFailReturn(1);
+    }
+    umock_c_negative_tests_snapshot();
+
+    /* one reset per failure point, as a negative test loop does */
+    start_measurement();
+    for (i = 0; i < NEGATIVE_TESTS_CALL_COUNT; i++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(i);
+    }
+    end_measurement("negative_tests_reset", NEGATIVE_TESTS_CALL_COUNT);
+
+    umock_c_negative_tests_deinit();
+}
+
+TEST_FUNCTION(umock_c_perf_stringify_expected_calls)
+{
+    size_t i;
+    const char* expected_calls;
+
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_function((int)i));
+    }
+
+    start_measurement();
+    expected_calls = umock_c_get_expected_calls();
+    end_measurement("stringify_expected_calls", CALL_COUNT);
+
+    ASSERT_IS_NOT_NULL(expected_calls);
+}
+
+TEST_FUNCTION(umock_c_perf_stringify_actual_calls)
+{
+    size_t i;
+    const char* actual_calls;
+
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        (void)perf_function((int)i);
+    }
+
+    start_measurement();
+    actual_calls = umock_c_get_actual_calls();
+    end_measurement("stringify_actual_calls", CALL_COUNT);
+
+    ASSERT_IS_NOT_NULL(actual_calls);
+}
+
+TEST_FUNCTION(umock_c_perf_stringify_buffer)
+{
+    size_t i;
+    static unsigned char buffer[STRINGIFY_BUFFER_LENGTH];
+
+    for (i = 0; i < STRINGIFY_BUFFER_LENGTH; i++)
+    {
+        buffer[i] = (unsigned char)i;
+    }
+
+    start_measurement();
+    for (i = 0; i < STRINGIFY_BUFFER_COUNT; i++)
+    {
+        char* stringified_buffer = umockc_stringify_buffer(buffer, sizeof(buffer));
+        ASSERT_IS_NOT_NULL(stringified_buffer);
+        umockalloc_free(stringified_buffer);
+    }
+    end_measurement("stringify_buffer_4096_bytes", STRINGIFY_BUFFER_COUNT);
+}
+
+TEST_FUNCTION(umock_c_perf_validate_argument_buffer)
+{
+    size_t i;
+    static unsigned char buffer[STRINGIFY_BUFFER_LENGTH];
+
+    for (i = 0; i < STRINGIFY_BUFFER_LENGTH; i++)
+    {
+        buffer[i] = (unsigned char)i;
+    }
+
+    for (i = 0; i < STRINGIFY_BUFFER_COUNT; i++)
+    {
+        STRICT_EXPECTED_CALL(perf_send(IGNORED_ARG))
+            .ValidateArgumentBuffer(1, buffer, sizeof(buffer));
+    }
+
+    start_measurement();
+    for (i = 0; i < STRINGIFY_BUFFER_COUNT; i++)
+    {
+        (void)perf_send(buffer);
+    }
+    end_measurement("validate_argument_buffer_4096_bytes", STRINGIFY_BUFFER_COUNT);
+
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+TEST_FUNCTION(umock_c_perf_paired_handles)
+{
+    size_t i;
+    PERF_HANDLE* handles = malloc(CALL_COUNT * sizeof(PERF_HANDLE));
+    ASSERT_IS_NOT_NULL(handles);
+
+    start_measurement();
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        handles[i] = perf_create((int)i);
+    }
+    for (i = 0; i < CALL_COUNT; i++)
+    {
+        perf_destroy(handles[i]);
+    }
+    end_measurement("paired_handles", 2 * CALL_COUNT);
+
+    free(handles);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
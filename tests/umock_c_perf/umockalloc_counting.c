@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "umockalloc_counting.h"
+
+/* This builds umockalloc.c with its malloc/calloc/realloc calls counted. Since it defines every umockalloc symbol,
+the linker uses it instead of the umockalloc object in the umock_c library. */
+
+static size_t allocation_count;
+
+static void* counting_malloc(size_t size)
+{
+    allocation_count++;
+    return malloc(size);
+}
+
+static void* counting_calloc(size_t nmemb, size_t size)
+{
+    allocation_count++;
+    return calloc(nmemb, size);
+}
+
+static void* counting_realloc(void* ptr, size_t size)
+{
+    allocation_count++;
+    return realloc(ptr, size);
+}
+
+size_t umockalloc_counting_get_allocation_count(void)
+{
+    return allocation_count;
+}
+
+void umockalloc_counting_reset(void)
+{
+    allocation_count = 0;
+}
+
+#define malloc counting_malloc
+#define calloc counting_calloc
+#define realloc counting_realloc
+
+#include "../../src/umockalloc.c"
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef UMOCKALLOC_COUNTING_H
+#define UMOCKALLOC_COUNTING_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /* number of malloc/calloc/realloc calls made by umockalloc since the last umockalloc_counting_reset */
+    size_t umockalloc_counting_get_allocation_count(void);
+    void umockalloc_counting_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMOCKALLOC_COUNTING_H */
@@ -21,6 +21,7 @@
 static UMOCKCALL_HANDLE test_expected_call = (UMOCKCALL_HANDLE)0x4242;
 static UMOCKCALL_HANDLE test_actual_call = (UMOCKCALL_HANDLE)0x4243;
 static UMOCKCALLRECORDER_HANDLE test_call_recorder = (UMOCKCALLRECORDER_HANDLE)0x4244;
+static UMOCKALLOC_ARENA_HANDLE test_arena = (UMOCKALLOC_ARENA_HANDLE)0x4246;
 static UMOCKCALLRECORDER_HANDLE test_cloned_call_recorder = (UMOCKCALLRECORDER_HANDLE)0x4245;
 
 static int umocktypes_init_result;
@@ -91,6 +92,27 @@ typedef struct umockcallrecorder_clone_CALL_TAG
 
 static UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone_result;
 
+typedef struct umockcallrecorder_enable_per_thread_actual_calls_CALL_TAG
+{
+    UMOCKCALLRECORDER_HANDLE umock_call_recorder;
+} umockcallrecorder_enable_per_thread_actual_calls_CALL;
+
+static int umockcallrecorder_enable_per_thread_actual_calls_result;
+
+typedef struct umockcallrecorder_begin_unordered_expected_calls_CALL_TAG
+{
+    UMOCKCALLRECORDER_HANDLE umock_call_recorder;
+} umockcallrecorder_begin_unordered_expected_calls_CALL;
+
+static int umockcallrecorder_begin_unordered_expected_calls_result;
+
+typedef struct umockcallrecorder_end_unordered_expected_calls_CALL_TAG
+{
+    UMOCKCALLRECORDER_HANDLE umock_call_recorder;
+} umockcallrecorder_end_unordered_expected_calls_CALL;
+
+static int umockcallrecorder_end_unordered_expected_calls_result;
+
 typedef struct umocktypes_init_CALL_TAG
 {
     int dummy;
@@ -106,6 +128,29 @@ typedef struct umocktypes_c_register_types_CALL_TAG
     int dummy;
 } umocktypes_c_register_types_CALL;
 
+typedef struct umockalloc_arena_create_CALL_TAG
+{
+    UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock;
+    void* lock_factory_create_lock_params;
+} umockalloc_arena_create_CALL;
+
+static UMOCKALLOC_ARENA_HANDLE umockalloc_arena_create_result;
+
+typedef struct umockalloc_arena_destroy_CALL_TAG
+{
+    UMOCKALLOC_ARENA_HANDLE arena;
+} umockalloc_arena_destroy_CALL;
+
+typedef struct umockalloc_arena_reset_CALL_TAG
+{
+    UMOCKALLOC_ARENA_HANDLE arena;
+} umockalloc_arena_reset_CALL;
+
+typedef struct umockalloc_set_call_arena_CALL_TAG
+{
+    UMOCKALLOC_ARENA_HANDLE arena;
+} umockalloc_set_call_arena_CALL;
+
 typedef struct test_on_umock_c_error_CALL_TAG
 {
     UMOCK_C_ERROR_CODE error_code;
@@ -123,9 +168,16 @@ typedef union TEST_MOCK_CALL_UNION_TAG
     umockcallrecorder_add_expected_call_CALL umockcallrecorder_add_expected_call;
     umockcallrecorder_add_actual_call_CALL umockcallrecorder_add_actual_call;
     umockcallrecorder_clone_CALL umockcallrecorder_clone;
+    umockcallrecorder_enable_per_thread_actual_calls_CALL umockcallrecorder_enable_per_thread_actual_calls;
+    umockcallrecorder_begin_unordered_expected_calls_CALL umockcallrecorder_begin_unordered_expected_calls;
+    umockcallrecorder_end_unordered_expected_calls_CALL umockcallrecorder_end_unordered_expected_calls;
     umocktypes_init_CALL umocktypes_init;
     umocktypes_deinit_CALL umocktypes_deinit;
     umocktypes_c_register_types_CALL umocktypes_c_register_types;
+    umockalloc_arena_create_CALL umockalloc_arena_create;
+    umockalloc_arena_destroy_CALL umockalloc_arena_destroy;
+    umockalloc_arena_reset_CALL umockalloc_arena_reset;
+    umockalloc_set_call_arena_CALL umockalloc_set_call_arena;
 } TEST_MOCK_CALL_UNION;
 
 #define TEST_MOCK_CALL_TYPE_VALUES \
@@ -139,9 +191,16 @@ typedef union TEST_MOCK_CALL_UNION_TAG
     TEST_MOCK_CALL_TYPE_umockcallrecorder_add_expected_call, \
     TEST_MOCK_CALL_TYPE_umockcallrecorder_add_actual_call, \
     TEST_MOCK_CALL_TYPE_umockcallrecorder_clone, \
+    TEST_MOCK_CALL_TYPE_umockcallrecorder_enable_per_thread_actual_calls, \
+    TEST_MOCK_CALL_TYPE_umockcallrecorder_begin_unordered_expected_calls, \
+    TEST_MOCK_CALL_TYPE_umockcallrecorder_end_unordered_expected_calls, \
     TEST_MOCK_CALL_TYPE_umocktypes_init, \
     TEST_MOCK_CALL_TYPE_umocktypes_deinit, \
-    TEST_MOCK_CALL_TYPE_umocktypes_c_register_types \
+    TEST_MOCK_CALL_TYPE_umocktypes_c_register_types, \
+    TEST_MOCK_CALL_TYPE_umockalloc_arena_create, \
+    TEST_MOCK_CALL_TYPE_umockalloc_arena_destroy, \
+    TEST_MOCK_CALL_TYPE_umockalloc_arena_reset, \
+    TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena \
 
 MU_DEFINE_ENUM(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
 MU_DEFINE_ENUM_STRINGS(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
@@ -244,6 +303,48 @@ UMOCKCALLRECORDER_HANDLE umockcallrecorder_clone(UMOCKCALLRECORDER_HANDLE umock_
     return umockcallrecorder_clone_result;
 }
 
+int umockcallrecorder_enable_per_thread_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcallrecorder_enable_per_thread_actual_calls;
+        mocked_calls[mocked_call_count].u.umockcallrecorder_enable_per_thread_actual_calls.umock_call_recorder = umock_call_recorder;
+        mocked_call_count++;
+    }
+
+    return umockcallrecorder_enable_per_thread_actual_calls_result;
+}
+
+int umockcallrecorder_begin_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcallrecorder_begin_unordered_expected_calls;
+        mocked_calls[mocked_call_count].u.umockcallrecorder_begin_unordered_expected_calls.umock_call_recorder = umock_call_recorder;
+        mocked_call_count++;
+    }
+
+    return umockcallrecorder_begin_unordered_expected_calls_result;
+}
+
+int umockcallrecorder_end_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcallrecorder_end_unordered_expected_calls;
+        mocked_calls[mocked_call_count].u.umockcallrecorder_end_unordered_expected_calls.umock_call_recorder = umock_call_recorder;
+        mocked_call_count++;
+    }
+
+    return umockcallrecorder_end_unordered_expected_calls_result;
+}
+
 const char* umockcallrecorder_get_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
 {
     TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
@@ -354,6 +455,10 @@ void reset_all_calls(void)
     umockcallrecorder_add_expected_call_result = 0;
     umockcallrecorder_add_actual_call_result = 0;
     umockcallrecorder_clone_result = test_cloned_call_recorder;
+    umockcallrecorder_enable_per_thread_actual_calls_result = 0;
+    umockcallrecorder_begin_unordered_expected_calls_result = 0;
+    umockcallrecorder_end_unordered_expected_calls_result = 0;
+    umockalloc_arena_create_result = test_arena;
 }
 
 void* umockalloc_malloc(size_t size)
@@ -366,6 +471,57 @@ void umockalloc_free(void* ptr)
     free(ptr);
 }
 
+UMOCKALLOC_ARENA_HANDLE umockalloc_arena_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockalloc_arena_create;
+        mocked_calls[mocked_call_count].u.umockalloc_arena_create.lock_factory_create_lock = lock_factory_create_lock;
+        mocked_calls[mocked_call_count].u.umockalloc_arena_create.lock_factory_create_lock_params = lock_factory_create_lock_params;
+        mocked_call_count++;
+    }
+
+    return umockalloc_arena_create_result;
+}
+
+void umockalloc_arena_destroy(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockalloc_arena_destroy;
+        mocked_calls[mocked_call_count].u.umockalloc_arena_destroy.arena = arena;
+        mocked_call_count++;
+    }
+}
+
+void umockalloc_arena_reset(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockalloc_arena_reset;
+        mocked_calls[mocked_call_count].u.umockalloc_arena_reset.arena = arena;
+        mocked_call_count++;
+    }
+}
+
+void umockalloc_set_call_arena(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena;
+        mocked_calls[mocked_call_count].u.umockalloc_set_call_arena.arena = arena;
+        mocked_call_count++;
+    }
+}
+
 static UMOCK_C_LOCK_HANDLE test_lock_factory_create_lock(void* params)
 {
     (void)params;
@@ -641,6 +797,27 @@ TEST_FUNCTION(umock_c_deinit_when_not_initialized_does_nothing)
     ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
 }
 
+/* Tests_SRS_UMOCK_C_01_051: [ If the call arena was enabled, umock_c_deinit shall stop using it by calling umockalloc_set_call_arena with NULL and destroy it by calling umockalloc_arena_destroy. ]*/
+TEST_FUNCTION(umock_c_deinit_with_the_call_arena_enabled_destroys_the_arena)
+{
+    // arrange
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_call_arena());
+    reset_all_calls();
+
+    // act
+    umock_c_deinit();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena, mocked_calls[1].call_type);
+    ASSERT_IS_NULL(mocked_calls[1].u.umockalloc_set_call_arena.arena);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_arena, mocked_calls[2].u.umockalloc_arena_destroy.arena);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umocktypes_deinit, mocked_calls[3].call_type);
+}
+
 /* umock_c_reset_all_calls */
 
 /* Tests_SRS_UMOCK_C_01_012: [ If the module is not initialized, umock_c_reset_all_calls shall do nothing. ]*/
@@ -690,6 +867,298 @@ TEST_FUNCTION(when_the_underlying_call_recorder_reset_all_calls_fails_then_umock
     ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_RESET_CALLS_ERROR, mocked_calls[1].u.test_on_umock_c_error.error_code);
 }
 
+/* Tests_SRS_UMOCK_C_01_050: [ If the call arena was enabled, umock_c_reset_all_calls shall release all the memory allocated from it by calling umockalloc_arena_reset after resetting the call recorder. ]*/
+TEST_FUNCTION(umock_c_reset_all_calls_with_the_call_arena_enabled_resets_the_arena)
+{
+    // arrange
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_call_arena());
+    reset_all_calls();
+
+    // act
+    umock_c_reset_all_calls();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_reset_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_reset_all_calls.umock_call_recorder);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_reset, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_arena, mocked_calls[1].u.umockalloc_arena_reset.arena);
+}
+
+/* umock_c_enable_call_arena */
+
+/* Tests_SRS_UMOCK_C_01_046: [ If the module is not initialized, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_enable_call_arena_when_the_module_is_not_initialized_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_01_045: [ umock_c_enable_call_arena shall create an arena by calling umockalloc_arena_create, passing the lock factory given to umock_c_init_with_lock_factory (if any). ]*/
+/* Tests_SRS_UMOCK_C_01_048: [ umock_c_enable_call_arena shall set the arena as the call arena by calling umockalloc_set_call_arena and return 0. ]*/
+TEST_FUNCTION(umock_c_enable_call_arena_creates_the_arena_and_sets_it_as_the_call_arena)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_create, mocked_calls[0].call_type);
+    ASSERT_IS_NULL(mocked_calls[0].u.umockalloc_arena_create.lock_factory_create_lock);
+    ASSERT_IS_NULL(mocked_calls[0].u.umockalloc_arena_create.lock_factory_create_lock_params);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_arena, mocked_calls[1].u.umockalloc_set_call_arena.arena);
+}
+
+/* Tests_SRS_UMOCK_C_01_045: [ umock_c_enable_call_arena shall create an arena by calling umockalloc_arena_create, passing the lock factory given to umock_c_init_with_lock_factory (if any). ]*/
+TEST_FUNCTION(umock_c_enable_call_arena_passes_the_lock_factory_to_the_arena)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(NULL, test_lock_factory_create_lock, (void*)0x4242));
+    reset_all_calls();
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_create, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_lock_factory_create_lock, mocked_calls[0].u.umockalloc_arena_create.lock_factory_create_lock);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, mocked_calls[0].u.umockalloc_arena_create.lock_factory_create_lock_params);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_arena, mocked_calls[1].u.umockalloc_set_call_arena.arena);
+}
+
+/* Tests_SRS_UMOCK_C_01_047: [ If the call arena is already enabled, umock_c_enable_call_arena shall return 0. ]*/
+TEST_FUNCTION(umock_c_enable_call_arena_when_already_enabled_succeeds_without_creating_another_arena)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_call_arena());
+    reset_all_calls();
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_01_049: [ If umockalloc_arena_create fails, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_umockalloc_arena_create_fails_umock_c_enable_call_arena_fails)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+    umockalloc_arena_create_result = NULL;
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_create, mocked_calls[0].call_type);
+}
+
+/* Tests_SRS_UMOCK_C_01_049: [ If umockalloc_arena_create fails, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_enable_call_arena_after_a_failed_create_retries_creating_the_arena)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    umockalloc_arena_create_result = NULL;
+    (void)umock_c_enable_call_arena();
+    reset_all_calls();
+
+    // act
+    result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_arena_create, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockalloc_set_call_arena, mocked_calls[1].call_type);
+}
+
+/* umock_c_enable_per_thread_call_recording */
+
+/* Tests_SRS_UMOCK_C_01_053: [ If the module is not initialized, umock_c_enable_per_thread_call_recording shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_enable_per_thread_call_recording_when_the_module_is_not_initialized_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umock_c_enable_per_thread_call_recording();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_01_052: [ umock_c_enable_per_thread_call_recording shall enable recording the actual calls per thread by calling umockcallrecorder_enable_per_thread_actual_calls on the call recorder created in umock_c_init. ]*/
+/* Tests_SRS_UMOCK_C_01_054: [ On success, umock_c_enable_per_thread_call_recording shall return 0. ]*/
+TEST_FUNCTION(umock_c_enable_per_thread_call_recording_enables_per_thread_actual_calls_on_the_call_recorder)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+
+    // act
+    result = umock_c_enable_per_thread_call_recording();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_enable_per_thread_actual_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_enable_per_thread_actual_calls.umock_call_recorder);
+}
+
+/* Tests_SRS_UMOCK_C_01_055: [ If umockcallrecorder_enable_per_thread_actual_calls fails, umock_c_enable_per_thread_call_recording shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_umockcallrecorder_enable_per_thread_actual_calls_fails_umock_c_enable_per_thread_call_recording_fails)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+    umockcallrecorder_enable_per_thread_actual_calls_result = 42;
+
+    // act
+    result = umock_c_enable_per_thread_call_recording();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_enable_per_thread_actual_calls, mocked_calls[0].call_type);
+}
+
+/* umock_c_begin_unordered_expected_calls */
+
+/* Tests_SRS_UMOCK_C_01_056: [ If the module is not initialized, umock_c_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_begin_unordered_expected_calls_when_the_module_is_not_initialized_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umock_c_begin_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_01_057: [ umock_c_begin_unordered_expected_calls shall open an unordered group by calling umockcallrecorder_begin_unordered_expected_calls on the call recorder created in umock_c_init. ]*/
+/* Tests_SRS_UMOCK_C_01_059: [ On success, umock_c_begin_unordered_expected_calls shall return 0. ]*/
+TEST_FUNCTION(umock_c_begin_unordered_expected_calls_calls_the_call_recorder)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+
+    // act
+    result = umock_c_begin_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_begin_unordered_expected_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_begin_unordered_expected_calls.umock_call_recorder);
+}
+
+/* Tests_SRS_UMOCK_C_01_058: [ If umockcallrecorder_begin_unordered_expected_calls fails, umock_c_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_umockcallrecorder_begin_unordered_expected_calls_fails_umock_c_begin_unordered_expected_calls_fails)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+    umockcallrecorder_begin_unordered_expected_calls_result = 42;
+
+    // act
+    result = umock_c_begin_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_begin_unordered_expected_calls, mocked_calls[0].call_type);
+}
+
+/* umock_c_end_unordered_expected_calls */
+
+/* Tests_SRS_UMOCK_C_01_060: [ If the module is not initialized, umock_c_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_c_end_unordered_expected_calls_when_the_module_is_not_initialized_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umock_c_end_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_C_01_061: [ umock_c_end_unordered_expected_calls shall close the open unordered group by calling umockcallrecorder_end_unordered_expected_calls on the call recorder created in umock_c_init. ]*/
+/* Tests_SRS_UMOCK_C_01_063: [ On success, umock_c_end_unordered_expected_calls shall return 0. ]*/
+TEST_FUNCTION(umock_c_end_unordered_expected_calls_calls_the_call_recorder)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+
+    // act
+    result = umock_c_end_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_end_unordered_expected_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_end_unordered_expected_calls.umock_call_recorder);
+}
+
+/* Tests_SRS_UMOCK_C_01_062: [ If umockcallrecorder_end_unordered_expected_calls fails, umock_c_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_umockcallrecorder_end_unordered_expected_calls_fails_umock_c_end_unordered_expected_calls_fails)
+{
+    // arrange
+    int result;
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init(NULL));
+    reset_all_calls();
+    umockcallrecorder_end_unordered_expected_calls_result = 42;
+
+    // act
+    result = umock_c_end_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_end_unordered_expected_calls, mocked_calls[0].call_type);
+}
+
 /* umock_c_get_actual_calls */
 
 /* Tests_SRS_UMOCK_C_01_013: [ umock_c_get_actual_calls shall return the string for the recorded actual calls by calling umockcallrecorder_get_actual_calls on the call recorder created in umock_c_init. ]*/
@@ -711,8 +1180,8 @@ TEST_FUNCTION(umock_c_get_actual_calls_calls_the_underlying_call_recorder_get_ac
     ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_get_actual_calls.umock_call_recorder);
 }
 
-/* Tests_SRS_UMOCK_C_01_013: [ umock_c_get_actual_calls shall return the string for the recorded actual calls by calling umockcallrecorder_get_actual_calls on the call recorder created in umock_c_init. ]*/
-TEST_FUNCTION(when_the_underlying_call_recorder_get_actual_calls_fails_then_umock_c_get_actual_calls_returns_NULL)
+/* Tests_SRS_UMOCK_C_01_066: [ If umockcallrecorder_get_actual_calls fails, umock_c_get_actual_calls shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return NULL. ]*/
+TEST_FUNCTION(when_the_underlying_call_recorder_get_actual_calls_fails_then_umock_c_get_actual_calls_triggers_the_on_error_callback_and_returns_NULL)
 {
     // arrange
     const char* result;
@@ -725,9 +1194,11 @@ TEST_FUNCTION(when_the_underlying_call_recorder_get_actual_calls_fails_then_umoc
 
     // assert
     ASSERT_IS_NULL(result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_get_actual_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_get_actual_calls.umock_call_recorder);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_on_umock_c_error, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, mocked_calls[1].u.test_on_umock_c_error.error_code);
 }
 
 /* Tests_SRS_UMOCK_C_01_014: [ If the module is not initialized, umock_c_get_actual_calls shall return NULL. ]*/
@@ -764,8 +1235,8 @@ TEST_FUNCTION(umock_c_get_expected_calls_calls_the_underlying_call_recorder_get_
     ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_get_expected_calls.umock_call_recorder);
 }
 
-/* Tests_SRS_UMOCK_C_01_015: [ umock_c_get_expected_calls shall return the string for the recorded expected calls by calling umockcallrecorder_get_expected_calls on the call recorder created in umock_c_init. ]*/
-TEST_FUNCTION(when_the_underlying_call_recorder_get_expected_calls_fails_then_umock_c_get_expected_calls_returns_NULL)
+/* Tests_SRS_UMOCK_C_01_065: [ If umockcallrecorder_get_expected_calls fails, umock_c_get_expected_calls shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return NULL. ]*/
+TEST_FUNCTION(when_the_underlying_call_recorder_get_expected_calls_fails_then_umock_c_get_expected_calls_triggers_the_on_error_callback_and_returns_NULL)
 {
     // arrange
     const char* result;
@@ -778,9 +1249,11 @@ TEST_FUNCTION(when_the_underlying_call_recorder_get_expected_calls_fails_then_um
 
     // assert
     ASSERT_IS_NULL(result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_get_expected_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_get_expected_calls.umock_call_recorder);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_on_umock_c_error, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, mocked_calls[1].u.test_on_umock_c_error.error_code);
 }
 
 /* Tests_SRS_UMOCK_C_01_016: [ If the module is not initialized, umock_c_get_expected_calls shall return NULL. ]*/
@@ -871,8 +1344,8 @@ TEST_FUNCTION(umock_c_add_expected_call_calls_the_underlying_call_recorder_add_e
     ASSERT_ARE_EQUAL(void_ptr, test_expected_call, mocked_calls[0].u.umockcallrecorder_add_expected_call.mock_call);
 }
 
-/* Tests_SRS_UMOCK_C_01_019: [ umock_c_add_expected_call shall add an expected call by calling umockcallrecorder_add_expected_call on the call recorder created in umock_c_init. ]*/
-TEST_FUNCTION(when_the_underlying_call_recorder_add_expected_call_fails_then_umock_c_add_expected_call_returns_NULL)
+/* Tests_SRS_UMOCK_C_01_064: [ If umockcallrecorder_add_expected_call fails, umock_c_add_expected_call shall trigger the on_umock_c_error callback with UMOCK_C_ERROR and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_underlying_call_recorder_add_expected_call_fails_then_umock_c_add_expected_call_triggers_the_on_error_callback_and_fails)
 {
     // arrange
     int result;
@@ -885,10 +1358,12 @@ TEST_FUNCTION(when_the_underlying_call_recorder_add_expected_call_fails_then_umo
 
     // assert
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcallrecorder_add_expected_call, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(void_ptr, test_call_recorder, mocked_calls[0].u.umockcallrecorder_add_expected_call.umock_call_recorder);
     ASSERT_ARE_EQUAL(void_ptr, test_expected_call, mocked_calls[0].u.umockcallrecorder_add_expected_call.mock_call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_on_umock_c_error, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR, mocked_calls[1].u.test_on_umock_c_error.error_code);
 }
 
 /* Tests_SRS_UMOCK_C_01_020: [ If the module is not initialized, umock_c_add_expected_call shall return a non-zero value. ]*/
@@ -2,6 +2,9 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "macro_utils/macro_utils.h" // IWYU pragma: keep
 
@@ -9,7 +12,14 @@
 // IWYU pragma: no_include <wchar.h>
 #include "testrunnerswitcher.h"
 
+#include "umock_c/umockalloc.h"
+#include "umock_c/umockatomic.h"
+#include "umock_c/umocktypes.h"
 #include "umock_c/umock_lock_factory_default.h"
+#include "umock_c/umock_lock_instrumentation.h"
+#ifdef __linux__
+#include "umock_c/umock_lock_factory_futex.h"
+#endif
 #include "minipal/umock_threadapi.h"
 
 #include "umock_c/umock_c_ENABLE_MOCKS.h" // ============================== ENABLE_MOCKS
@@ -17,6 +27,9 @@
 #include "umock_c/umock_c.h"
 
 MOCKABLE_FUNCTION(, void, test_mock_function, int, arg);
+MOCKABLE_FUNCTION(, int, test_mock_function_first_called_from_threads, int, arg1, int, arg2);
+MOCKABLE_FUNCTION(, int, test_mock_function_with_return, int, arg);
+MOCKABLE_FUNCTION(, void, test_mock_function_auto_ignore, int, arg1, int, arg2);
 
 #include "umock_c/umock_c_DISABLE_MOCKS.h" // ============================== DISABLE_MOCKS
 
@@ -28,6 +41,15 @@ static void test_on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
     ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
 }
 
+static size_t reported_error_count;
+static UMOCK_C_ERROR_CODE last_reported_error_code;
+
+static void test_on_umock_c_error_counting(UMOCK_C_ERROR_CODE error_code)
+{
+    reported_error_count++;
+    last_reported_error_code = error_code;
+}
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -71,9 +93,8 @@ static int actual_calls_thread(void* arg)
     return 0;
 }
 
-TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_do_not_crash)
+static void run_expected_calls_and_actual_calls_from_multiple_threads(void)
 {
-    // arrange
     UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
     size_t i;
 
@@ -87,14 +108,512 @@ TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_do_not_crash
         ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], actual_calls_thread, NULL));
     }
 
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        int dont_care;
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &dont_care));
+    }
+}
+
+TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_do_not_crash)
+{
+    // arrange
+
+    // act
+    run_expected_calls_and_actual_calls_from_multiple_threads();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+}
+
+#ifdef __linux__
+TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_with_the_futex_lock_factory_do_not_crash)
+{
+    // arrange
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_futex_create_lock, NULL));
+
+    // act
+    run_expected_calls_and_actual_calls_from_multiple_threads();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+
+    // cleanup
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+#endif
+
+#define TYPE_SPELLING_COUNT 100
+
+static volatile int resolve_types_failed;
+
+static int resolve_types_thread(void* arg)
+{
+    size_t i;
+    int value = 42;
+    void* pointer_value = &value;
+
+    (void)arg;
+
+    for (i = 0; i < TYPE_SPELLING_COUNT; i++)
+    {
+        char type_name[32];
+        char* stringified;
+
+        /* every spelling is new to the type name cache, unregistered pointer types resolve to void* */
+        (void)sprintf(type_name, "struct test_struct_%zu*", i);
+        stringified = umocktypes_stringify(type_name, &pointer_value);
+        if (stringified == NULL)
+        {
+            resolve_types_failed = 1;
+        }
+        umockalloc_free(stringified);
+
+        (void)sprintf(type_name, "int%*s", (int)(i % 8), "");
+        if (umocktypes_are_equal(type_name, &value, &value) != 1)
+        {
+            resolve_types_failed = 1;
+        }
+    }
+
+    return 0;
+}
+
+TEST_FUNCTION(types_resolved_for_the_first_time_from_multiple_threads_are_resolved_correctly)
+{
+    // arrange
+    UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
+    size_t i;
+    resolve_types_failed = 0;
+
+    // act
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], resolve_types_thread, NULL));
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        int dont_care;
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &dont_care));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, resolve_types_failed);
+}
+
+static int first_calls_thread(void* arg)
+{
+    (void)arg;
+
+    if (test_mock_function_first_called_from_threads(42, 43) != 0)
+    {
+        resolve_types_failed = 1;
+    }
+
+    return 0;
+}
+
+TEST_FUNCTION(first_calls_to_a_mock_from_multiple_threads_use_the_resolved_type_handlers)
+{
+    // arrange
+    UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
+    size_t i;
+    resolve_types_failed = 0;
+
+    // act
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], first_calls_thread, NULL));
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        int dont_care;
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &dont_care));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, resolve_types_failed);
+    ASSERT_ARE_EQUAL(char_ptr,
+        "[test_mock_function_first_called_from_threads(42,43)][test_mock_function_first_called_from_threads(42,43)]"
+        "[test_mock_function_first_called_from_threads(42,43)][test_mock_function_first_called_from_threads(42,43)]"
+        "[test_mock_function_first_called_from_threads(42,43)][test_mock_function_first_called_from_threads(42,43)]"
+        "[test_mock_function_first_called_from_threads(42,43)][test_mock_function_first_called_from_threads(42,43)]",
+        umock_c_get_actual_calls());
+}
+
+static uint64_t get_histogram_total(const uint64_t* histogram)
+{
+    uint64_t result = 0;
+    size_t i;
+
+    for (i = 0; i < UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        result += histogram[i];
+    }
+
+    return result;
+}
+
+TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_with_an_instrumented_lock_factory_gather_lock_statistics)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(umock_lock_factory_create_lock, NULL);
+    ASSERT_IS_NOT_NULL(instrumentation);
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_instrumentation_create_lock, instrumentation));
+
     // act
+    run_expected_calls_and_actual_calls_from_multiple_threads();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(instrumentation, &stats));
+    /* every expected call and every actual call is recorded under the lock */
+    ASSERT_IS_TRUE(stats.exclusive.acquire_count + stats.shared.acquire_count >= 2 * CALLS_PER_THREAD * THREAD_COUNT);
+    ASSERT_ARE_EQUAL(uint64_t, stats.exclusive.acquire_count, stats.exclusive.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, stats.shared.acquire_count, stats.shared.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, stats.exclusive.acquire_count, get_histogram_total(stats.exclusive.wait_histogram));
+    ASSERT_ARE_EQUAL(uint64_t, stats.exclusive.release_count, get_histogram_total(stats.exclusive.hold_histogram));
+    ASSERT_ARE_EQUAL(uint64_t, stats.shared.acquire_count, get_histogram_total(stats.shared.wait_histogram));
+    ASSERT_ARE_EQUAL(uint64_t, stats.shared.release_count, get_histogram_total(stats.shared.hold_histogram));
+
+    // cleanup
+    umock_c_deinit();
+    umock_lock_instrumentation_destroy(instrumentation);
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+
+static int numbered_actual_calls_thread(void* arg)
+{
+    size_t thread_index = (size_t)arg;
+    size_t i;
+
+    for (i = 0; i < CALLS_PER_THREAD; i++)
+    {
+        test_mock_function((int)(thread_index * CALLS_PER_THREAD + i));
+    }
+
+    return 0;
+}
+
+static void run_numbered_actual_calls_from_multiple_threads(void)
+{
+    UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
+    size_t i;
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], numbered_actual_calls_thread, (void*)i));
+    }
+
     for (i = 0; i < THREAD_COUNT; i++)
     {
         int dont_care;
         ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &dont_care));
     }
+}
+
+static void assert_actual_calls_keep_the_order_of_each_thread(void)
+{
+    size_t next_call_index[THREAD_COUNT] = { 0 };
+    size_t call_count = 0;
+    const char* actual_calls;
+    const char* current;
+    int arg;
+
+    actual_calls = umock_c_get_actual_calls();
+    ASSERT_IS_NOT_NULL(actual_calls);
+    current = actual_calls;
+    while ((current = strstr(current, "[test_mock_function(")) != NULL)
+    {
+        size_t thread_index;
+        ASSERT_ARE_EQUAL(int, 1, sscanf(current, "[test_mock_function(%d)]", &arg));
+        thread_index = (size_t)arg / CALLS_PER_THREAD;
+        ASSERT_IS_TRUE(thread_index < THREAD_COUNT);
+        /* the calls made by one thread are merged in the order the thread made them */
+        ASSERT_ARE_EQUAL(size_t, thread_index * CALLS_PER_THREAD + next_call_index[thread_index], (size_t)arg);
+        next_call_index[thread_index]++;
+        call_count++;
+        current++;
+    }
+    ASSERT_ARE_EQUAL(size_t, THREAD_COUNT * CALLS_PER_THREAD, call_count);
+}
+
+TEST_FUNCTION(actual_calls_from_multiple_threads_without_expected_calls_keep_the_order_of_each_thread)
+{
+    // arrange
+
+    // act
+    run_numbered_actual_calls_from_multiple_threads();
+
+    // assert
+    assert_actual_calls_keep_the_order_of_each_thread();
+}
+
+TEST_FUNCTION(actual_calls_from_multiple_threads_recorded_per_thread_keep_the_order_of_each_thread)
+{
+    // arrange
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_per_thread_call_recording());
+
+    // act
+    run_numbered_actual_calls_from_multiple_threads();
+
+    // assert
+    assert_actual_calls_keep_the_order_of_each_thread();
+
+    // cleanup
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+
+TEST_FUNCTION(expected_calls_and_actual_calls_from_multiple_threads_recorded_per_thread_are_matched_when_merged)
+{
+    // arrange
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_per_thread_call_recording());
+
+    // act
+    run_expected_calls_and_actual_calls_from_multiple_threads();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+
+    // cleanup
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_245: [ When recording per thread, if an actual call matches an expected call that was set up with SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn, CaptureArgumentValue_{arg_name} or that is failed by the negative tests, the on_error callback shall be called with UMOCK_C_ERROR when the calls are merged, and umock_c_get_expected_calls or umock_c_get_actual_calls shall return NULL if they triggered the merge. ]*/
+TEST_FUNCTION(a_call_recorded_per_thread_that_matches_an_expected_call_with_a_return_value_is_reported_as_an_error)
+{
+    // arrange
+    const char* result;
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error_counting, umock_lock_factory_create_lock, NULL));
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_per_thread_call_recording());
+    reported_error_count = 0;
+    STRICT_EXPECTED_CALL(test_mock_function_with_return(42))
+        .SetReturn(42);
+    (void)test_mock_function_with_return(42);
+
+    // act
+    result = umock_c_get_actual_calls();
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, reported_error_count);
+    ASSERT_ARE_EQUAL(int, (int)UMOCK_C_ERROR, (int)last_reported_error_code);
+
+    // cleanup
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_245: [ When recording per thread, if an actual call matches an expected call that was set up with SetReturn, CopyOutArgumentBuffer, CopyOutArgumentBuffer_{arg_name}, CaptureReturn, CaptureArgumentValue_{arg_name} or that is failed by the negative tests, the on_error callback shall be called with UMOCK_C_ERROR when the calls are merged, and umock_c_get_expected_calls or umock_c_get_actual_calls shall return NULL if they triggered the merge. ]*/
+TEST_FUNCTION(a_call_recorded_per_thread_that_matches_an_expected_call_without_call_results_is_not_reported_as_an_error)
+{
+    // arrange
+    const char* result;
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error_counting, umock_lock_factory_create_lock, NULL));
+    ASSERT_ARE_EQUAL(int, 0, umock_c_enable_per_thread_call_recording());
+    reported_error_count = 0;
+    STRICT_EXPECTED_CALL(test_mock_function_with_return(42));
+    (void)test_mock_function_with_return(42);
+
+    // act
+    result = umock_c_get_actual_calls();
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+    ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
+    ASSERT_ARE_EQUAL(size_t, 0, reported_error_count);
+
+    // cleanup
+    umock_c_deinit();
+    ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, umock_lock_factory_create_lock, NULL));
+}
+
+#if USE_VALGRIND
+#define EXPECTED_CALL_RACE_ROUNDS 100
+#else
+#define EXPECTED_CALL_RACE_ROUNDS 2000
+#endif
+#define CALLS_PER_RACE_ROUND 20
+
+static volatile uint64_t race_round_started;
+
+static int race_actual_calls_thread(void* arg)
+{
+    size_t i;
+
+    (void)arg;
+
+    /* start calling together with the main thread adding the expected call */
+    while (umockatomic_load_uint64(&race_round_started) == 0)
+    {
+    }
+
+    for (i = 0; i < CALLS_PER_RACE_ROUND; i++)
+    {
+        test_mock_function(0);
+    }
+
+    return 0;
+}
+
+static size_t count_calls_in_string(const char* calls_string)
+{
+    size_t result = 0;
+    const char* current = calls_string;
+
+    while ((current = strstr(current, "[test_mock_function(")) != NULL)
+    {
+        result++;
+        current++;
+    }
+
+    return result;
+}
+
+TEST_FUNCTION(an_expected_call_added_while_actual_calls_are_logged_from_multiple_threads_is_matched_at_most_once)
+{
+    size_t round;
+
+    for (round = 0; round < EXPECTED_CALL_RACE_ROUNDS; round++)
+    {
+        // arrange
+        UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
+        size_t i;
+        size_t unmatched_expected_call_count;
+        umock_c_reset_all_calls();
+        umockatomic_store_uint64(&race_round_started, 0);
+
+        for (i = 0; i < THREAD_COUNT; i++)
+        {
+            ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], race_actual_calls_thread, NULL));
+        }
+
+        // act
+        // the expected call is added while the threads log calls that no expected call could match
+        umockatomic_store_uint64(&race_round_started, 1);
+        STRICT_EXPECTED_CALL(test_mock_function(0));
+
+        for (i = 0; i < THREAD_COUNT; i++)
+        {
+            int dont_care;
+            ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &dont_care));
+        }
+
+        // assert
+        // every actual call is either recorded or consumed the expected call
+        unmatched_expected_call_count = count_calls_in_string(umock_c_get_expected_calls());
+        ASSERT_IS_TRUE(unmatched_expected_call_count <= 1, "round %zu", round);
+        ASSERT_ARE_EQUAL(size_t, THREAD_COUNT * CALLS_PER_RACE_ROUND - (1 - unmatched_expected_call_count), count_calls_in_string(umock_c_get_actual_calls()), "round %zu", round);
+    }
+}
+
+#if USE_VALGRIND
+#define AUTO_IGNORE_ROUNDS_PER_THREAD 100
+#else
+#define AUTO_IGNORE_ROUNDS_PER_THREAD 10000
+#endif
+
+/* more call sites than the auto ignore cache of the mock holds, so that the threads keep replacing cached masks; even sites ignore arg1, odd sites ignore arg2 */
+static const char* const auto_ignore_call_strings[] =
+{
+    "test_mock_function_auto_ignore(IGNORED_ARG, 1)",
+    "test_mock_function_auto_ignore(2, IGNORED_ARG)",
+    "test_mock_function_auto_ignore(IGNORED_ARG, 3)",
+    "test_mock_function_auto_ignore(4, IGNORED_ARG)",
+    "test_mock_function_auto_ignore(IGNORED_ARG, 5)",
+    "test_mock_function_auto_ignore(6, IGNORED_ARG)",
+    "test_mock_function_auto_ignore(IGNORED_ARG, 7)",
+    "test_mock_function_auto_ignore(8, IGNORED_ARG)",
+    "test_mock_function_auto_ignore(IGNORED_ARG, 9)",
+    "test_mock_function_auto_ignore(10, IGNORED_ARG)"
+};
+
+static UMOCK_THREAD_LOCAL size_t ignore_arg1_count;
+static UMOCK_THREAD_LOCAL size_t ignore_arg2_count;
+
+static mock_call_modifier_test_mock_function_auto_ignore counting_ignore_argument_arg1(void)
+{
+    mock_call_modifier_test_mock_function_auto_ignore result;
+    (void)memset(&result, 0, sizeof(result));
+    ignore_arg1_count++;
+    return result;
+}
+
+static mock_call_modifier_test_mock_function_auto_ignore counting_ignore_argument_arg2(void)
+{
+    mock_call_modifier_test_mock_function_auto_ignore result;
+    (void)memset(&result, 0, sizeof(result));
+    ignore_arg2_count++;
+    return result;
+}
+
+/* applies the auto ignore masks of all call sites through a modifier that only counts the ignored arguments,
+so that the cache is exercised by all threads at once without the threads changing each other's expected calls */
+static int auto_ignore_args_thread(void* arg)
+{
+    int result = 0;
+    size_t i;
+    size_t j;
+    mock_call_modifier_test_mock_function_auto_ignore counting_modifier;
+
+    (void)arg;
+    (void)memset(&counting_modifier, 0, sizeof(counting_modifier));
+    counting_modifier.IgnoreArgument_arg1 = counting_ignore_argument_arg1;
+    counting_modifier.IgnoreArgument_arg2 = counting_ignore_argument_arg2;
+
+    for (i = 0; i < AUTO_IGNORE_ROUNDS_PER_THREAD; i++)
+    {
+        for (j = 0; j < sizeof(auto_ignore_call_strings) / sizeof(auto_ignore_call_strings[0]); j++)
+        {
+            ignore_arg1_count = 0;
+            ignore_arg2_count = 0;
+            (void)get_auto_ignore_args_function_test_mock_function_auto_ignore(0, 0)(counting_modifier, auto_ignore_call_strings[j]);
+            if ((ignore_arg1_count != (((j % 2) == 0) ? 1U : 0U)) ||
+                (ignore_arg2_count != (((j % 2) == 0) ? 0U : 1U)))
+            {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+/* Tests_SRS_UMOCK_C_LIB_01_248: [ The cache shall be kept per thread, so that threads setting expectations on the same mock at the same time never read or replace each other's cached masks. ]*/
+TEST_FUNCTION(auto_ignore_args_from_multiple_threads_ignore_the_arguments_of_their_own_call_site)
+{
+    // arrange
+    UMOCK_THREAD_HANDLE threads[THREAD_COUNT];
+    size_t i;
+
+    // act
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_create(&threads[i], auto_ignore_args_thread, NULL));
+    }
 
     // assert
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        int mismatch_count;
+        ASSERT_ARE_EQUAL(UMOCK_THREADAPI_RESULT, UMOCK_THREADAPI_OK, umock_threadapi_join(threads[i], &mismatch_count));
+        ASSERT_ARE_EQUAL(int, 0, mismatch_count);
+    }
+
     ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_expected_calls());
     ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
 }
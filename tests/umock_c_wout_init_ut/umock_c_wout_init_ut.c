@@ -25,6 +25,10 @@ static size_t umockcallrecorder_clone_call_count;
 static size_t umock_c_get_last_expected_call_call_count;
 static size_t umock_c_add_expected_call_call_count;
 static size_t umock_c_add_actual_call_call_count;
+static size_t umockalloc_arena_create_call_count;
+static size_t umockcallrecorder_enable_per_thread_actual_calls_call_count;
+static size_t umockcallrecorder_begin_unordered_expected_calls_call_count;
+static size_t umockcallrecorder_end_unordered_expected_calls_call_count;
 
 UMOCKCALLRECORDER_HANDLE umockcallrecorder_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
 {
@@ -91,6 +95,27 @@ UMOCKCALL_HANDLE umockcallrecorder_get_last_expected_call(UMOCKCALLRECORDER_HAND
     return NULL;
 }
 
+int umockcallrecorder_enable_per_thread_actual_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    (void)umock_call_recorder;
+    umockcallrecorder_enable_per_thread_actual_calls_call_count++;
+    return 0;
+}
+
+int umockcallrecorder_begin_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    (void)umock_call_recorder;
+    umockcallrecorder_begin_unordered_expected_calls_call_count++;
+    return 0;
+}
+
+int umockcallrecorder_end_unordered_expected_calls(UMOCKCALLRECORDER_HANDLE umock_call_recorder)
+{
+    (void)umock_call_recorder;
+    umockcallrecorder_end_unordered_expected_calls_call_count++;
+    return 0;
+}
+
 int umocktypes_init(void)
 {
     return 0;
@@ -116,6 +141,29 @@ void umockalloc_free(void* ptr)
     free(ptr);
 }
 
+UMOCKALLOC_ARENA_HANDLE umockalloc_arena_create(UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC lock_factory_create_lock, void* lock_factory_create_lock_params)
+{
+    (void)lock_factory_create_lock;
+    (void)lock_factory_create_lock_params;
+    umockalloc_arena_create_call_count++;
+    return NULL;
+}
+
+void umockalloc_arena_destroy(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    (void)arena;
+}
+
+void umockalloc_arena_reset(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    (void)arena;
+}
+
+void umockalloc_set_call_arena(UMOCKALLOC_ARENA_HANDLE arena)
+{
+    (void)arena;
+}
+
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
 TEST_SUITE_INITIALIZE(suite_init)
@@ -136,6 +184,9 @@ TEST_FUNCTION_INITIALIZE(test_function_init)
     umock_c_get_last_expected_call_call_count = 0;
     umock_c_add_expected_call_call_count = 0;
     umock_c_add_actual_call_call_count = 0;
+    umockalloc_arena_create_call_count = 0;
+    umockcallrecorder_begin_unordered_expected_calls_call_count = 0;
+    umockcallrecorder_end_unordered_expected_calls_call_count = 0;
 }
 
 TEST_FUNCTION_CLEANUP(test_function_cleanup)
@@ -277,4 +328,64 @@ TEST_FUNCTION(when_the_module_is_not_initialize_umock_c_set_call_recorder_fails)
     ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_destroy_call_count);
 }
 
+/* umock_c_enable_call_arena */
+
+/* Tests_SRS_UMOCK_C_01_046: [ If the module is not initialized, umock_c_enable_call_arena shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_module_is_not_initialized_umock_c_enable_call_arena_fails)
+{
+    // arrange
+
+    // act
+    int result = umock_c_enable_call_arena();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umockalloc_arena_create_call_count);
+}
+
+/* umock_c_enable_per_thread_call_recording */
+
+/* Tests_SRS_UMOCK_C_01_053: [ If the module is not initialized, umock_c_enable_per_thread_call_recording shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_module_is_not_initialized_umock_c_enable_per_thread_call_recording_fails)
+{
+    // arrange
+
+    // act
+    int result = umock_c_enable_per_thread_call_recording();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_enable_per_thread_actual_calls_call_count);
+}
+
+/* umock_c_begin_unordered_expected_calls */
+
+/* Tests_SRS_UMOCK_C_01_056: [ If the module is not initialized, umock_c_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_module_is_not_initialized_umock_c_begin_unordered_expected_calls_fails)
+{
+    // arrange
+
+    // act
+    int result = umock_c_begin_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_begin_unordered_expected_calls_call_count);
+}
+
+/* umock_c_end_unordered_expected_calls */
+
+/* Tests_SRS_UMOCK_C_01_060: [ If the module is not initialized, umock_c_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_module_is_not_initialized_umock_c_end_unordered_expected_calls_fails)
+{
+    // arrange
+
+    // act
+    int result = umock_c_end_unordered_expected_calls();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umockcallrecorder_end_unordered_expected_calls_call_count);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+void* mock_malloc(size_t size);
+void mock_free(void* ptr);
+
+#define umockalloc_malloc(size) mock_malloc(size)
+#define umockalloc_free(ptr) mock_free(ptr)
+
+/* unistd.h is included above, so that only the calls made by the code under test are redirected */
+#define syscall(...) mock_syscall(__VA_ARGS__)
+
+long mock_syscall(long number, uint32_t* uaddr, int futex_op, uint32_t val, const void* timeout, uint32_t* uaddr2, uint32_t val3);
+
+/* called each time the code under test reads the lock state, so that a test can play another thread releasing the lock while the code under test spins */
+void mock_lock_state_loaded(void);
+
+static uint32_t test_load_lock_state(_Atomic uint32_t* state, memory_order order)
+{
+    mock_lock_state_loaded();
+    return atomic_load_explicit(state, order);
+}
+
+static int test_load_spin_estimate(atomic_int* spin_estimate, memory_order order)
+{
+    return atomic_load_explicit(spin_estimate, order);
+}
+
+#undef atomic_load_explicit
+#define atomic_load_explicit(object, order) _Generic((object), _Atomic uint32_t*: test_load_lock_state, default: test_load_spin_estimate)((object), (order))
+
+/* include code under test */
+#include "../../src/umock_lock_factory_futex.c"
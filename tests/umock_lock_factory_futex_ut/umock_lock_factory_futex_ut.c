@@ -0,0 +1,652 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// TEST_DEFINE_ENUM_TYPE will use wchar.h, which we technically get from testrunnerswitcher.h
+// IWYU pragma: no_include <wchar.h>
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_lock_factory_futex.h"
+#include "umock_c/umock_lock_if.h"               // for UMOCK_C_LOCK_IF_TAG
+
+static size_t malloc_call_count;
+static size_t when_shall_malloc_fail;
+
+typedef struct mock_malloc_CALL_TAG
+{
+    size_t size;
+} mock_malloc_CALL;
+
+typedef struct mock_free_CALL_TAG
+{
+    void* ptr;
+} mock_free_CALL;
+
+typedef struct mock_syscall_CALL_TAG
+{
+    long number;
+    uint32_t* uaddr;
+    int futex_op;
+    uint32_t val;
+} mock_syscall_CALL;
+
+typedef union TEST_MOCK_CALL_UNION_TAG
+{
+    mock_malloc_CALL mock_malloc;
+    mock_free_CALL mock_free;
+    mock_syscall_CALL mock_syscall;
+} TEST_MOCK_CALL_UNION;
+
+#define TEST_MOCK_CALL_TYPE_VALUES \
+    TEST_MOCK_CALL_TYPE_mock_malloc, \
+    TEST_MOCK_CALL_TYPE_mock_free, \
+    TEST_MOCK_CALL_TYPE_mock_syscall \
+
+MU_DEFINE_ENUM(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+MU_DEFINE_ENUM_STRINGS(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+TEST_DEFINE_ENUM_TYPE(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+
+typedef struct TEST_MOCK_CALL_TAG
+{
+    TEST_MOCK_CALL_TYPE call_type;
+    TEST_MOCK_CALL_UNION u;
+} TEST_MOCK_CALL;
+
+static size_t mocked_call_count;
+static TEST_MOCK_CALL* mocked_calls;
+
+/* plays the other thread: called when the code under test goes to sleep on the futex */
+static void(*on_futex_wait)(void);
+
+    void* mock_malloc(size_t size)
+    {
+        void* result;
+
+        TEST_MOCK_CALL* new_calls = (TEST_MOCK_CALL*)realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+        if (new_calls != NULL)
+        {
+            mocked_calls = new_calls;
+            mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_mock_malloc;
+            mocked_calls[mocked_call_count].u.mock_malloc.size = size;
+            mocked_call_count++;
+        }
+
+        malloc_call_count++;
+        if (malloc_call_count == when_shall_malloc_fail)
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = malloc(size);
+        }
+        return result;
+    }
+
+    void mock_free(void* ptr)
+    {
+        TEST_MOCK_CALL* new_calls = (TEST_MOCK_CALL*)realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+        if (new_calls != NULL)
+        {
+            mocked_calls = new_calls;
+            mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_mock_free;
+            mocked_calls[mocked_call_count].u.mock_free.ptr = ptr;
+            mocked_call_count++;
+        }
+
+        free(ptr);
+    }
+
+long mock_syscall(long number, uint32_t* uaddr, int futex_op, uint32_t val, const void* timeout, uint32_t* uaddr2, uint32_t val3)
+{
+    TEST_MOCK_CALL* new_calls = (TEST_MOCK_CALL*)realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+
+    (void)timeout;
+    (void)uaddr2;
+    (void)val3;
+
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_mock_syscall;
+        mocked_calls[mocked_call_count].u.mock_syscall.number = number;
+        mocked_calls[mocked_call_count].u.mock_syscall.uaddr = uaddr;
+        mocked_calls[mocked_call_count].u.mock_syscall.futex_op = futex_op;
+        mocked_calls[mocked_call_count].u.mock_syscall.val = val;
+        mocked_call_count++;
+    }
+
+    if ((futex_op == FUTEX_WAIT_PRIVATE) &&
+        (on_futex_wait != NULL))
+    {
+        on_futex_wait();
+    }
+
+    return 0;
+}
+
+static size_t lock_state_load_count;
+/* when not 0, the lock state load at which the test releases the exclusive lock, as if another thread did it while the code under test spins */
+static size_t release_at_lock_state_load;
+static size_t lock_state_loads_before_wait;
+
+static void release_exclusive_from_another_thread(void);
+
+void mock_lock_state_loaded(void)
+{
+    lock_state_load_count++;
+    if ((release_at_lock_state_load != 0) &&
+        (lock_state_load_count == release_at_lock_state_load))
+    {
+        release_at_lock_state_load = 0;
+        release_exclusive_from_another_thread();
+    }
+}
+
+static void reset_all_calls(void)
+{
+    malloc_call_count = 0;
+    when_shall_malloc_fail = 0;
+    on_futex_wait = NULL;
+    lock_state_load_count = 0;
+    release_at_lock_state_load = 0;
+
+    if (mocked_calls != NULL)
+    {
+        free(mocked_calls);
+        mocked_calls = NULL;
+    }
+
+    mocked_call_count = 0;
+}
+
+static UMOCK_C_LOCK_HANDLE test_lock;
+static size_t readers_to_release;
+
+static void release_shared_from_another_thread(void)
+{
+    readers_to_release--;
+    if (readers_to_release == 0)
+    {
+        on_futex_wait = NULL;
+    }
+    test_lock->release_shared(test_lock);
+}
+
+static void release_exclusive_from_another_thread(void)
+{
+    on_futex_wait = NULL;
+    test_lock->release_exclusive(test_lock);
+}
+
+static void record_spins_and_release_exclusive_from_another_thread(void)
+{
+    lock_state_loads_before_wait = lock_state_load_count;
+    release_exclusive_from_another_thread();
+}
+
+/* acquires the lock while another thread holds it, returns how many times the acquire spun before waiting on the lock state */
+static size_t acquire_after_waiting(void)
+{
+    test_lock->acquire_exclusive(test_lock);
+    reset_all_calls();
+    on_futex_wait = record_spins_and_release_exclusive_from_another_thread;
+
+    test_lock->acquire_shared(test_lock);
+    test_lock->release_shared(test_lock);
+
+    /* the first load of the lock state is made before spinning */
+    return lock_state_loads_before_wait - 1;
+}
+
+/* acquires the lock while another thread holds it and releases it after the acquire spun spin_count times */
+static void acquire_after_spinning(size_t spin_count)
+{
+    test_lock->acquire_exclusive(test_lock);
+    reset_all_calls();
+    release_at_lock_state_load = spin_count + 1;
+
+    test_lock->acquire_shared(test_lock);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+    test_lock->release_shared(test_lock);
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+    reset_all_calls();
+}
+
+/* umock_lock_factory_futex_create_lock */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_001: [ umock_lock_factory_futex_create_lock shall allocate memory for the lock. ]*/
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_002: [ umock_lock_factory_futex_create_lock shall initialize the lock state to not held and the spin estimate to 0. ]*/
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_003: [ umock_lock_factory_futex_create_lock shall return a lock handle that has the function pointers set to umock_lock_futex_acquire_shared, umock_lock_futex_release_shared, umock_lock_futex_acquire_exclusive, umock_lock_futex_release_exclusive and umock_lock_futex_destroy. ]*/
+TEST_FUNCTION(umock_lock_factory_futex_create_lock_succeeds)
+{
+    // arrange
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+
+    // assert
+    ASSERT_IS_NOT_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+    ASSERT_IS_NOT_NULL(lock->acquire_exclusive);
+    ASSERT_IS_NOT_NULL(lock->release_exclusive);
+    ASSERT_IS_NOT_NULL(lock->acquire_shared);
+    ASSERT_IS_NOT_NULL(lock->release_shared);
+    ASSERT_IS_NOT_NULL(lock->destroy);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_004: [ If any error occurs, umock_lock_factory_futex_create_lock shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umock_lock_factory_futex_create_lock_also_fails)
+{
+    // arrange
+    when_shall_malloc_fail = 1;
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+
+    // assert
+    ASSERT_IS_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+}
+
+/* umock_lock_futex_acquire_shared */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_005: [ If lock is NULL, umock_lock_futex_acquire_shared shall return. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_shared_with_NULL_lock_returns)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->acquire_shared(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_006: [ umock_lock_futex_acquire_shared shall increment the readers count in the lock state if no writer holds the lock. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_shared_twice_acquires_the_lock_without_waiting)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->acquire_shared(lock);
+    lock->acquire_shared(lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->release_shared(lock);
+    lock->release_shared(lock);
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_007: [ While a writer holds the lock, umock_lock_futex_acquire_shared shall spin for a number of iterations derived from the spins needed by previous acquires and then set the waiters bit and wait on the lock state by calling syscall with SYS_futex and FUTEX_WAIT_PRIVATE. ]*/
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_010: [ If the last holder releases the lock and the waiters bit is set, the waiters bit shall be cleared and all the waiters shall be woken by calling syscall with SYS_futex and FUTEX_WAKE_PRIVATE. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_shared_while_a_writer_holds_the_lock_waits_until_it_is_released)
+{
+    // arrange
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    test_lock->acquire_exclusive(test_lock);
+    reset_all_calls();
+    on_futex_wait = release_exclusive_from_another_thread;
+
+    // act
+    test_lock->acquire_shared(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_syscall, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(long, SYS_futex, mocked_calls[0].u.mock_syscall.number);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAIT_PRIVATE, mocked_calls[0].u.mock_syscall.futex_op);
+    ASSERT_ARE_EQUAL(uint32_t, 0xC0000000, mocked_calls[0].u.mock_syscall.val);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_syscall, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(long, SYS_futex, mocked_calls[1].u.mock_syscall.number);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAKE_PRIVATE, mocked_calls[1].u.mock_syscall.futex_op);
+    ASSERT_ARE_EQUAL(void_ptr, mocked_calls[0].u.mock_syscall.uaddr, mocked_calls[1].u.mock_syscall.uaddr);
+
+    // cleanup
+    test_lock->release_shared(test_lock);
+    test_lock->destroy(test_lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_007: [ While a writer holds the lock, umock_lock_futex_acquire_shared shall spin for a number of iterations derived from the spins needed by previous acquires and then set the waiters bit and wait on the lock state by calling syscall with SYS_futex and FUTEX_WAIT_PRIVATE. ]*/
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_018: [ An acquire that waited on the lock state shall halve the spin estimate of the lock, any other acquire shall move the spin estimate an eighth of the way towards the number of spins it needed. ]*/
+TEST_FUNCTION(acquires_that_get_the_lock_while_spinning_make_the_next_acquires_spin_longer)
+{
+    // arrange
+    size_t i;
+    size_t initial_spin_count;
+    size_t spin_count;
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    initial_spin_count = acquire_after_waiting();
+
+    // act
+    for (i = 0; i < 32; i++)
+    {
+        acquire_after_spinning(initial_spin_count);
+    }
+    spin_count = acquire_after_waiting();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 10, initial_spin_count);
+    ASSERT_IS_TRUE(spin_count > initial_spin_count, "the acquire spun %zu times", spin_count);
+
+    // cleanup
+    test_lock->destroy(test_lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_018: [ An acquire that waited on the lock state shall halve the spin estimate of the lock, any other acquire shall move the spin estimate an eighth of the way towards the number of spins it needed. ]*/
+TEST_FUNCTION(acquires_that_wait_on_the_lock_make_the_next_acquires_spin_less)
+{
+    // arrange
+    size_t i;
+    size_t spin_count;
+    size_t previous_spin_count;
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    for (i = 0; i < 64; i++)
+    {
+        acquire_after_spinning(10);
+    }
+    previous_spin_count = acquire_after_waiting();
+    ASSERT_IS_TRUE(previous_spin_count > 10, "the acquire spun %zu times", previous_spin_count);
+
+    // act
+    for (i = 0; i < 16; i++)
+    {
+        spin_count = acquire_after_waiting();
+
+        // assert
+        ASSERT_IS_TRUE(spin_count <= previous_spin_count, "the acquire spun %zu times after %zu", spin_count, previous_spin_count);
+        previous_spin_count = spin_count;
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 10, spin_count);
+
+    // cleanup
+    test_lock->destroy(test_lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_018: [ An acquire that waited on the lock state shall halve the spin estimate of the lock, any other acquire shall move the spin estimate an eighth of the way towards the number of spins it needed. ]*/
+TEST_FUNCTION(acquires_that_do_not_spin_bring_the_spin_estimate_back_to_0)
+{
+    // arrange
+    size_t i;
+    size_t spin_count;
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    for (i = 0; i < 64; i++)
+    {
+        acquire_after_spinning(8);
+    }
+
+    // act
+    for (i = 0; i < 64; i++)
+    {
+        test_lock->acquire_exclusive(test_lock);
+        test_lock->release_exclusive(test_lock);
+    }
+    spin_count = acquire_after_waiting();
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 10, spin_count);
+
+    // cleanup
+    test_lock->destroy(test_lock);
+}
+
+/* umock_lock_futex_release_shared */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_008: [ If lock is NULL, umock_lock_futex_release_shared shall return. ]*/
+TEST_FUNCTION(umock_lock_futex_release_shared_with_NULL_lock_returns)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->release_shared(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_009: [ umock_lock_futex_release_shared shall decrement the readers count in the lock state. ]*/
+TEST_FUNCTION(umock_lock_futex_release_shared_releases_the_lock_so_that_it_can_be_acquired_exclusively)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    lock->acquire_shared(lock);
+    reset_all_calls();
+
+    // act
+    lock->release_shared(lock);
+    lock->acquire_exclusive(lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->release_exclusive(lock);
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_010: [ If the last holder releases the lock and the waiters bit is set, the waiters bit shall be cleared and all the waiters shall be woken by calling syscall with SYS_futex and FUTEX_WAKE_PRIVATE. ]*/
+TEST_FUNCTION(umock_lock_futex_release_shared_by_a_reader_that_is_not_the_last_one_does_not_wake_the_waiters)
+{
+    // arrange
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    test_lock->acquire_shared(test_lock);
+    test_lock->acquire_shared(test_lock);
+    reset_all_calls();
+    readers_to_release = 2;
+    on_futex_wait = release_shared_from_another_thread;
+
+    // act
+    test_lock->acquire_exclusive(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAIT_PRIVATE, mocked_calls[0].u.mock_syscall.futex_op);
+    ASSERT_ARE_EQUAL(uint32_t, 0x40000002, mocked_calls[0].u.mock_syscall.val);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAIT_PRIVATE, mocked_calls[1].u.mock_syscall.futex_op);
+    ASSERT_ARE_EQUAL(uint32_t, 0x40000001, mocked_calls[1].u.mock_syscall.val);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAKE_PRIVATE, mocked_calls[2].u.mock_syscall.futex_op);
+
+    // cleanup
+    test_lock->release_exclusive(test_lock);
+    test_lock->destroy(test_lock);
+}
+
+/* umock_lock_futex_acquire_exclusive */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_011: [ If lock is NULL, umock_lock_futex_acquire_exclusive shall return. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_exclusive_with_NULL_lock_returns)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->acquire_exclusive(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_012: [ umock_lock_futex_acquire_exclusive shall set the writer bit in the lock state if neither a writer nor readers hold the lock. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_exclusive_acquires_the_lock_without_waiting)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->acquire_exclusive(lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->release_exclusive(lock);
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_013: [ While the lock is held, umock_lock_futex_acquire_exclusive shall spin for a number of iterations derived from the spins needed by previous acquires and then set the waiters bit and wait on the lock state by calling syscall with SYS_futex and FUTEX_WAIT_PRIVATE. ]*/
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_010: [ If the last holder releases the lock and the waiters bit is set, the waiters bit shall be cleared and all the waiters shall be woken by calling syscall with SYS_futex and FUTEX_WAKE_PRIVATE. ]*/
+TEST_FUNCTION(umock_lock_futex_acquire_exclusive_while_a_reader_holds_the_lock_waits_until_it_is_released)
+{
+    // arrange
+    test_lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(test_lock);
+    test_lock->acquire_shared(test_lock);
+    reset_all_calls();
+    readers_to_release = 1;
+    on_futex_wait = release_shared_from_another_thread;
+
+    // act
+    test_lock->acquire_exclusive(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(long, SYS_futex, mocked_calls[0].u.mock_syscall.number);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAIT_PRIVATE, mocked_calls[0].u.mock_syscall.futex_op);
+    ASSERT_ARE_EQUAL(uint32_t, 0x40000001, mocked_calls[0].u.mock_syscall.val);
+    ASSERT_ARE_EQUAL(long, SYS_futex, mocked_calls[1].u.mock_syscall.number);
+    ASSERT_ARE_EQUAL(int, FUTEX_WAKE_PRIVATE, mocked_calls[1].u.mock_syscall.futex_op);
+
+    // cleanup
+    test_lock->release_exclusive(test_lock);
+    test_lock->destroy(test_lock);
+}
+
+/* umock_lock_futex_release_exclusive */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_014: [ If lock is NULL, umock_lock_futex_release_exclusive shall return. ]*/
+TEST_FUNCTION(umock_lock_futex_release_exclusive_with_NULL_lock_returns)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->release_exclusive(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_015: [ umock_lock_futex_release_exclusive shall clear the writer bit in the lock state. ]*/
+TEST_FUNCTION(umock_lock_futex_release_exclusive_without_waiters_does_not_wake_anybody)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    lock->acquire_exclusive(lock);
+    reset_all_calls();
+
+    // act
+    lock->release_exclusive(lock);
+    lock->acquire_shared(lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->release_shared(lock);
+    lock->destroy(lock);
+}
+
+/* umock_lock_futex_destroy */
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_016: [ If lock is NULL, umock_lock_futex_destroy shall return. ]*/
+TEST_FUNCTION(umock_lock_futex_destroy_with_NULL_lock_returns)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    lock->destroy(lock);
+}
+
+/* Tests_SRS_UMOCK_LOCK_FACTORY_FUTEX_01_017: [ umock_lock_futex_destroy shall free the memory associated with the lock. ]*/
+TEST_FUNCTION(umock_lock_futex_destroy_frees_the_memory)
+{
+    // arrange
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_factory_futex_create_lock(NULL);
+    ASSERT_IS_NOT_NULL(lock);
+    reset_all_calls();
+
+    // act
+    lock->destroy(lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)lock, mocked_calls[0].u.mock_free.ptr);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
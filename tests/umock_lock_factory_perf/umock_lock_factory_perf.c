@@ -0,0 +1,242 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdio.h>                      // for sprintf
+#include <time.h>                       // for timespec_get
+
+#include <pthread.h>
+
+#include "macro_utils/macro_utils.h" // IWYU pragma: keep
+#include "c_logging/logger.h"
+
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_lock_factory.h"
+#include "umock_c/umock_lock_factory_default.h"
+#include "umock_c/umock_lock_factory_futex.h"
+
+/* Compares the lock factories available on Linux under contention.
+Each scenario runs the same work with the pthread lock factory and with the futex lock factory and logs one line per factory of the form:
+umock_lock_factory_perf scenario=<name> factory=<factory> threads=<count> ops=<count> ns_per_op=<value>
+ns_per_op is the wall clock time divided by the total number of operations done by all the threads. */
+
+#define THREAD_COUNT 8
+#define OPS_PER_THREAD 100000
+#define MOCK_CALLS_PER_THREAD 5000
+
+/* out of 16 operations, how many acquire the lock in shared mode in the mixed scenario */
+#define SHARED_OPS_OUT_OF_16 14
+
+#include "umock_c/umock_c_ENABLE_MOCKS.h" // ============================== ENABLE_MOCKS
+
+MOCK_FUNCTION_WITH_CODE(, int, perf_function, int, a)
+MOCK_FUNCTION_END(0)
+
+#include "umock_c/umock_c_DISABLE_MOCKS.h" // ============================== DISABLE_MOCKS
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void test_on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)sprintf(temp_str, "umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+typedef struct LOCK_FACTORY_TAG
+{
+    const char* name;
+    UMOCK_C_LOCK_FACTORY_CREATE_LOCK_FUNC create_lock;
+} LOCK_FACTORY;
+
+static const LOCK_FACTORY lock_factories[] =
+{
+    { "pthread", umock_lock_factory_create_lock },
+    { "futex", umock_lock_factory_futex_create_lock }
+};
+
+static UMOCK_C_LOCK_HANDLE test_lock;
+/* only changed with the lock held exclusively, so that the work done under the lock is not optimized away */
+static volatile size_t protected_counter;
+
+static double get_time_ns(void)
+{
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000000000.0 + (double)ts.tv_nsec;
+}
+
+static void* exclusive_ops_thread(void* arg)
+{
+    size_t i;
+
+    (void)arg;
+
+    for (i = 0; i < OPS_PER_THREAD; i++)
+    {
+        test_lock->acquire_exclusive(test_lock);
+        protected_counter++;
+        test_lock->release_exclusive(test_lock);
+    }
+
+    return NULL;
+}
+
+static void* mixed_ops_thread(void* arg)
+{
+    size_t i;
+    size_t seen_counter = 0;
+
+    (void)arg;
+
+    for (i = 0; i < OPS_PER_THREAD; i++)
+    {
+        if ((i % 16) < SHARED_OPS_OUT_OF_16)
+        {
+            test_lock->acquire_shared(test_lock);
+            seen_counter += protected_counter;
+            test_lock->release_shared(test_lock);
+        }
+        else
+        {
+            test_lock->acquire_exclusive(test_lock);
+            protected_counter++;
+            test_lock->release_exclusive(test_lock);
+        }
+    }
+
+    return (void*)seen_counter;
+}
+
+static void* mock_calls_thread(void* arg)
+{
+    size_t i;
+
+    (void)arg;
+
+    for (i = 0; i < MOCK_CALLS_PER_THREAD; i++)
+    {
+        (void)perf_function((int)i);
+    }
+
+    return NULL;
+}
+
+static void run_threads(void*(*thread_func)(void*), const char* scenario, const char* factory_name, size_t ops_per_thread)
+{
+    pthread_t threads[THREAD_COUNT];
+    size_t i;
+    double start_time = get_time_ns();
+    double elapsed_ns;
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, pthread_create(&threads[i], NULL, thread_func, NULL));
+    }
+
+    for (i = 0; i < THREAD_COUNT; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, pthread_join(threads[i], NULL));
+    }
+
+    elapsed_ns = get_time_ns() - start_time;
+    LogInfo("umock_lock_factory_perf scenario=%s factory=%s threads=%u ops=%u ns_per_op=%.1f",
+        scenario, factory_name, (unsigned int)THREAD_COUNT, (unsigned int)(THREAD_COUNT * ops_per_thread), elapsed_ns / (double)(THREAD_COUNT * ops_per_thread));
+}
+
+static void run_lock_scenario(void*(*thread_func)(void*), const char* scenario)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(lock_factories) / sizeof(lock_factories[0]); i++)
+    {
+        test_lock = lock_factories[i].create_lock(NULL);
+        ASSERT_IS_NOT_NULL(test_lock);
+        protected_counter = 0;
+
+        run_threads(thread_func, scenario, lock_factories[i].name, OPS_PER_THREAD);
+
+        test_lock->destroy(test_lock);
+        test_lock = NULL;
+    }
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+}
+
+TEST_FUNCTION(umock_lock_factory_perf_exclusive_only)
+{
+    run_lock_scenario(exclusive_ops_thread, "exclusive_only");
+}
+
+TEST_FUNCTION(umock_lock_factory_perf_mostly_shared)
+{
+    run_lock_scenario(mixed_ops_thread, "mostly_shared");
+}
+
+TEST_FUNCTION(umock_lock_factory_perf_mock_calls_from_many_threads)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(lock_factories) / sizeof(lock_factories[0]); i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, lock_factories[i].create_lock, NULL));
+
+        run_threads(mock_calls_thread, "mock_calls", lock_factories[i].name, MOCK_CALLS_PER_THREAD);
+
+        umock_c_deinit();
+    }
+}
+
+TEST_FUNCTION(umock_lock_factory_perf_mock_calls_from_many_threads_with_an_unmatched_expected_call)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(lock_factories) / sizeof(lock_factories[0]); i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, lock_factories[i].create_lock, NULL));
+        /* as long as an expected call could match, every actual call is matched under the call recorder lock */
+        STRICT_EXPECTED_CALL(perf_function(-1));
+
+        run_threads(mock_calls_thread, "mock_calls_with_expected_call", lock_factories[i].name, MOCK_CALLS_PER_THREAD);
+
+        umock_c_deinit();
+    }
+}
+
+TEST_FUNCTION(umock_lock_factory_perf_mock_calls_from_many_threads_recorded_per_thread)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(lock_factories) / sizeof(lock_factories[0]); i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umock_c_init_with_lock_factory(test_on_umock_c_error, lock_factories[i].create_lock, NULL));
+        ASSERT_ARE_EQUAL(int, 0, umock_c_enable_per_thread_call_recording());
+
+        run_threads(mock_calls_thread, "mock_calls_per_thread", lock_factories[i].name, MOCK_CALLS_PER_THREAD);
+
+        /* the calls are only merged when they are looked at, which is not part of the timed section */
+        ASSERT_IS_NOT_NULL(umock_c_get_actual_calls());
+
+        umock_c_deinit();
+    }
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
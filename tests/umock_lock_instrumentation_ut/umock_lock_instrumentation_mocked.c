@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#endif
+
+void* mock_malloc(size_t size);
+void mock_free(void* ptr);
+
+#define umockalloc_malloc(size) mock_malloc(size)
+#define umockalloc_free(ptr) mock_free(ptr)
+
+/* time.h and windows.h are included above, so that only the calls made by the code under test are redirected */
+#if defined(_MSC_VER)
+BOOL mock_QueryPerformanceCounter(LARGE_INTEGER* counter);
+BOOL mock_QueryPerformanceFrequency(LARGE_INTEGER* frequency);
+
+#define QueryPerformanceCounter(counter) mock_QueryPerformanceCounter(counter)
+#define QueryPerformanceFrequency(frequency) mock_QueryPerformanceFrequency(frequency)
+#else
+int mock_clock_gettime(clockid_t clock_id, struct timespec* ts);
+
+#define clock_gettime(clock_id, ts) mock_clock_gettime(clock_id, ts)
+#endif
+
+/* include code under test */
+#include "../../src/umock_lock_instrumentation.c"
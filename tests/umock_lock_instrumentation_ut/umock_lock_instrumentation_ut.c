@@ -0,0 +1,940 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#endif
+
+// TEST_DEFINE_ENUM_TYPE will use wchar.h, which we technically get from testrunnerswitcher.h
+// IWYU pragma: no_include <wchar.h>
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umock_lock_instrumentation.h"
+#include "umock_c/umock_lock_if.h"               // for UMOCK_C_LOCK_IF_TAG
+
+static size_t malloc_call_count;
+static size_t when_shall_malloc_fail;
+static size_t create_lock_call_count;
+static size_t when_shall_create_lock_fail;
+
+/* values returned by the successive clock reads, in ns */
+static uint64_t test_times_ns[32];
+static size_t test_time_count;
+static size_t test_time_index;
+
+typedef struct mock_malloc_CALL_TAG
+{
+    size_t size;
+} mock_malloc_CALL;
+
+typedef struct mock_free_CALL_TAG
+{
+    void* ptr;
+} mock_free_CALL;
+
+typedef struct test_create_lock_CALL_TAG
+{
+    void* params;
+} test_create_lock_CALL;
+
+typedef struct test_lock_CALL_TAG
+{
+    UMOCK_C_LOCK_HANDLE lock;
+} test_lock_CALL;
+
+typedef union TEST_MOCK_CALL_UNION_TAG
+{
+    mock_malloc_CALL mock_malloc;
+    mock_free_CALL mock_free;
+    test_create_lock_CALL test_create_lock;
+    test_lock_CALL test_lock;
+} TEST_MOCK_CALL_UNION;
+
+#define TEST_MOCK_CALL_TYPE_VALUES \
+    TEST_MOCK_CALL_TYPE_mock_malloc, \
+    TEST_MOCK_CALL_TYPE_mock_free, \
+    TEST_MOCK_CALL_TYPE_mock_clock, \
+    TEST_MOCK_CALL_TYPE_test_create_lock, \
+    TEST_MOCK_CALL_TYPE_test_acquire_shared, \
+    TEST_MOCK_CALL_TYPE_test_release_shared, \
+    TEST_MOCK_CALL_TYPE_test_acquire_exclusive, \
+    TEST_MOCK_CALL_TYPE_test_release_exclusive, \
+    TEST_MOCK_CALL_TYPE_test_destroy \
+
+MU_DEFINE_ENUM(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+MU_DEFINE_ENUM_STRINGS(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+TEST_DEFINE_ENUM_TYPE(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_VALUES)
+
+typedef struct TEST_MOCK_CALL_TAG
+{
+    TEST_MOCK_CALL_TYPE call_type;
+    TEST_MOCK_CALL_UNION u;
+} TEST_MOCK_CALL;
+
+static size_t mocked_call_count;
+static TEST_MOCK_CALL* mocked_calls;
+
+static TEST_MOCK_CALL* add_mocked_call(TEST_MOCK_CALL_TYPE call_type)
+{
+    TEST_MOCK_CALL* result;
+    TEST_MOCK_CALL* new_calls = (TEST_MOCK_CALL*)realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        mocked_calls = new_calls;
+        result = &mocked_calls[mocked_call_count];
+        result->call_type = call_type;
+        mocked_call_count++;
+    }
+
+    return result;
+}
+
+void* mock_malloc(size_t size)
+{
+    void* result;
+    TEST_MOCK_CALL* call = add_mocked_call(TEST_MOCK_CALL_TYPE_mock_malloc);
+    if (call != NULL)
+    {
+        call->u.mock_malloc.size = size;
+    }
+
+    malloc_call_count++;
+    if (malloc_call_count == when_shall_malloc_fail)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = malloc(size);
+    }
+    return result;
+}
+
+void mock_free(void* ptr)
+{
+    TEST_MOCK_CALL* call = add_mocked_call(TEST_MOCK_CALL_TYPE_mock_free);
+    if (call != NULL)
+    {
+        call->u.mock_free.ptr = ptr;
+    }
+
+    free(ptr);
+}
+
+static uint64_t get_next_test_time_ns(void)
+{
+    uint64_t time_ns = (test_time_index < test_time_count) ? test_times_ns[test_time_index] : 0;
+
+    (void)add_mocked_call(TEST_MOCK_CALL_TYPE_mock_clock);
+
+    test_time_index++;
+    return time_ns;
+}
+
+#if defined(_MSC_VER)
+BOOL mock_QueryPerformanceCounter(LARGE_INTEGER* counter)
+{
+    counter->QuadPart = (LONGLONG)get_next_test_time_ns();
+    return TRUE;
+}
+
+BOOL mock_QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+    /* 1 tick is 1 ns, so that the test times are the same on all platforms */
+    frequency->QuadPart = 1000000000;
+    return TRUE;
+}
+#else
+int mock_clock_gettime(clockid_t clock_id, struct timespec* ts)
+{
+    uint64_t time_ns;
+
+    ASSERT_ARE_EQUAL(int, (int)CLOCK_MONOTONIC, (int)clock_id);
+    time_ns = get_next_test_time_ns();
+    ts->tv_sec = (time_t)(time_ns / 1000000000);
+    ts->tv_nsec = (long)(time_ns % 1000000000);
+    return 0;
+}
+#endif
+
+static void record_test_lock_call(TEST_MOCK_CALL_TYPE call_type, UMOCK_C_LOCK_HANDLE lock)
+{
+    TEST_MOCK_CALL* call = add_mocked_call(call_type);
+    if (call != NULL)
+    {
+        call->u.test_lock.lock = lock;
+    }
+}
+
+static void test_acquire_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    record_test_lock_call(TEST_MOCK_CALL_TYPE_test_acquire_shared, lock);
+}
+
+static void test_release_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    record_test_lock_call(TEST_MOCK_CALL_TYPE_test_release_shared, lock);
+}
+
+static void test_acquire_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    record_test_lock_call(TEST_MOCK_CALL_TYPE_test_acquire_exclusive, lock);
+}
+
+static void test_release_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    record_test_lock_call(TEST_MOCK_CALL_TYPE_test_release_exclusive, lock);
+}
+
+static void test_destroy(UMOCK_C_LOCK_HANDLE lock)
+{
+    record_test_lock_call(TEST_MOCK_CALL_TYPE_test_destroy, lock);
+    free((void*)lock);
+}
+
+/* the wrapped lock factory, it creates locks that only record the calls made to them */
+static UMOCK_C_LOCK_HANDLE test_create_lock(void* params)
+{
+    UMOCK_C_LOCK_IF* result;
+    TEST_MOCK_CALL* call = add_mocked_call(TEST_MOCK_CALL_TYPE_test_create_lock);
+    if (call != NULL)
+    {
+        call->u.test_create_lock.params = params;
+    }
+
+    create_lock_call_count++;
+    if (create_lock_call_count == when_shall_create_lock_fail)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = (UMOCK_C_LOCK_IF*)malloc(sizeof(UMOCK_C_LOCK_IF));
+        if (result != NULL)
+        {
+            result->acquire_shared = test_acquire_shared;
+            result->release_shared = test_release_shared;
+            result->acquire_exclusive = test_acquire_exclusive;
+            result->release_exclusive = test_release_exclusive;
+            result->destroy = test_destroy;
+        }
+    }
+
+    return result;
+}
+
+static void reset_all_calls(void)
+{
+    malloc_call_count = 0;
+    when_shall_malloc_fail = 0;
+    create_lock_call_count = 0;
+    when_shall_create_lock_fail = 0;
+    test_time_count = 0;
+    test_time_index = 0;
+
+    if (mocked_calls != NULL)
+    {
+        free(mocked_calls);
+        mocked_calls = NULL;
+    }
+
+    mocked_call_count = 0;
+}
+
+static void set_test_times(const uint64_t* times_ns, size_t time_count)
+{
+    (void)memcpy(test_times_ns, times_ns, time_count * sizeof(uint64_t));
+    test_time_count = time_count;
+    test_time_index = 0;
+}
+
+static UMOCK_LOCK_INSTRUMENTATION_HANDLE test_instrumentation;
+static UMOCK_C_LOCK_HANDLE test_lock;
+/* the lock created by test_create_lock that is wrapped by test_lock */
+static UMOCK_C_LOCK_HANDLE test_inner_lock;
+
+static void create_test_instrumentation_and_lock(void)
+{
+    reset_all_calls();
+    test_instrumentation = umock_lock_instrumentation_create(test_create_lock, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(test_instrumentation);
+    test_lock = umock_lock_instrumentation_create_lock(test_instrumentation);
+    ASSERT_IS_NOT_NULL(test_lock);
+
+    /* find the lock made by the wrapped factory, by looking at which lock an acquire hits */
+    reset_all_calls();
+    test_lock->acquire_exclusive(test_lock);
+    test_inner_lock = mocked_calls[1].u.test_lock.lock;
+    test_lock->release_exclusive(test_lock);
+    umock_lock_instrumentation_reset_stats(test_instrumentation);
+    reset_all_calls();
+}
+
+static void destroy_test_instrumentation_and_lock(void)
+{
+    test_lock->destroy(test_lock);
+    umock_lock_instrumentation_destroy(test_instrumentation);
+    test_lock = NULL;
+    test_instrumentation = NULL;
+}
+
+static void assert_lock_call(size_t index, TEST_MOCK_CALL_TYPE call_type, UMOCK_C_LOCK_HANDLE lock)
+{
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, call_type, mocked_calls[index].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)lock, (void*)mocked_calls[index].u.test_lock.lock);
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+    reset_all_calls();
+}
+
+/* umock_lock_instrumentation_create */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_001: [ If lock_factory_create_lock is NULL, umock_lock_instrumentation_create shall fail and return NULL. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_create_with_NULL_lock_factory_create_lock_fails)
+{
+    // arrange
+
+    // act
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(NULL, NULL);
+
+    // assert
+    ASSERT_IS_NULL(instrumentation);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_002: [ umock_lock_instrumentation_create shall allocate memory for the instrumentation. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_004: [ umock_lock_instrumentation_create shall store lock_factory_create_lock and lock_factory_create_lock_params and set all the statistics to 0. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_create_succeeds)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    UMOCK_LOCK_INSTRUMENTATION_STATS zero_stats;
+    (void)memset(&stats, 0xFF, sizeof(stats));
+    (void)memset(&zero_stats, 0, sizeof(zero_stats));
+
+    // act
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(test_create_lock, (void*)0x4242);
+
+    // assert
+    ASSERT_IS_NOT_NULL(instrumentation);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(instrumentation, &stats));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(&zero_stats, &stats, sizeof(stats)));
+
+    // cleanup
+    umock_lock_instrumentation_destroy(instrumentation);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_005: [ If any error occurs, umock_lock_instrumentation_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umock_lock_instrumentation_create_also_fails)
+{
+    // arrange
+    when_shall_malloc_fail = 1;
+
+    // act
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(test_create_lock, NULL);
+
+    // assert
+    ASSERT_IS_NULL(instrumentation);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+}
+
+/* umock_lock_instrumentation_destroy */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_006: [ If instrumentation is NULL, umock_lock_instrumentation_destroy shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_destroy_with_NULL_instrumentation_returns)
+{
+    // arrange
+
+    // act
+    umock_lock_instrumentation_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_007: [ umock_lock_instrumentation_destroy shall free the memory associated with the instrumentation. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_destroy_frees_the_resources)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+    test_lock->destroy(test_lock);
+    reset_all_calls();
+
+    // act
+    umock_lock_instrumentation_destroy(test_instrumentation);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_instrumentation, mocked_calls[0].u.mock_free.ptr);
+}
+
+/* umock_lock_instrumentation_create_lock */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_008: [ If params is NULL, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_create_lock_with_NULL_params_fails)
+{
+    // arrange
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_instrumentation_create_lock(NULL);
+
+    // assert
+    ASSERT_IS_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_009: [ umock_lock_instrumentation_create_lock shall allocate memory for the lock. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_010: [ umock_lock_instrumentation_create_lock shall create the wrapped lock by calling the lock factory that was passed to umock_lock_instrumentation_create. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_011: [ umock_lock_instrumentation_create_lock shall return a lock handle that has the function pointers set to umock_lock_instrumented_acquire_shared, umock_lock_instrumented_release_shared, umock_lock_instrumented_acquire_exclusive, umock_lock_instrumented_release_exclusive and umock_lock_instrumented_destroy. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_create_lock_succeeds)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(test_create_lock, (void*)0x4242);
+    ASSERT_IS_NOT_NULL(instrumentation);
+    reset_all_calls();
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_instrumentation_create_lock(instrumentation);
+
+    // assert
+    ASSERT_IS_NOT_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_create_lock, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, mocked_calls[1].u.test_create_lock.params);
+    ASSERT_IS_NOT_NULL(lock->acquire_exclusive);
+    ASSERT_IS_NOT_NULL(lock->release_exclusive);
+    ASSERT_IS_NOT_NULL(lock->acquire_shared);
+    ASSERT_IS_NOT_NULL(lock->release_shared);
+    ASSERT_IS_NOT_NULL(lock->destroy);
+
+    // cleanup
+    lock->destroy(lock);
+    umock_lock_instrumentation_destroy(instrumentation);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_012: [ If any error occurs, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umock_lock_instrumentation_create_lock_also_fails)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(test_create_lock, NULL);
+    ASSERT_IS_NOT_NULL(instrumentation);
+    reset_all_calls();
+    when_shall_malloc_fail = 1;
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_instrumentation_create_lock(instrumentation);
+
+    // assert
+    ASSERT_IS_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umock_lock_instrumentation_destroy(instrumentation);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_012: [ If any error occurs, umock_lock_instrumentation_create_lock shall fail and return NULL. ]*/
+TEST_FUNCTION(when_creating_the_wrapped_lock_fails_umock_lock_instrumentation_create_lock_also_fails)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_HANDLE instrumentation = umock_lock_instrumentation_create(test_create_lock, NULL);
+    ASSERT_IS_NOT_NULL(instrumentation);
+    reset_all_calls();
+    when_shall_create_lock_fail = 1;
+
+    // act
+    UMOCK_C_LOCK_HANDLE lock = umock_lock_instrumentation_create_lock(instrumentation);
+
+    // assert
+    ASSERT_IS_NULL(lock);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_create_lock, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
+
+    // cleanup
+    umock_lock_instrumentation_destroy(instrumentation);
+}
+
+/* umock_lock_instrumented_acquire_shared */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_013: [ If lock is NULL, umock_lock_instrumented_acquire_shared shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_shared_with_NULL_lock_returns)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->acquire_shared(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_014: [ umock_lock_instrumented_acquire_shared shall acquire the wrapped lock in shared mode and measure how long that took. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_015: [ umock_lock_instrumented_acquire_shared shall increment the shared acquire count and add the wait time to the shared wait total, maximum and histogram. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_034: [ Times shall be read from a monotonic clock: clock_gettime with CLOCK_MONOTONIC, or QueryPerformanceCounter on Windows. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_shared_acquires_the_wrapped_lock_and_records_the_wait)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 1000, 1030 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+
+    // act
+    test_lock->acquire_shared(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[0].call_type);
+    assert_lock_call(1, TEST_MOCK_CALL_TYPE_test_acquire_shared, test_inner_lock);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.acquire_count);
+    ASSERT_ARE_EQUAL(uint64_t, 30, stats.shared.total_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 30, stats.shared.max_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.wait_histogram[4]);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.shared.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.exclusive.acquire_count);
+
+    // cleanup
+    test_lock->release_shared(test_lock);
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_015: [ umock_lock_instrumented_acquire_shared shall increment the shared acquire count and add the wait time to the shared wait total, maximum and histogram. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_shared_puts_waits_in_power_of_2_buckets)
+{
+    // arrange
+    static const uint64_t times_ns[] =
+    {
+        /* 0 ns */
+        1000, 1000, 0,
+        /* 2 ns */
+        1000, 1002, 0,
+        /* 3 ns */
+        1000, 1003, 0,
+        /* 8 s, more than the lower bound of the last bucket */
+        1000, 8000001000, 0,
+        /* the clock going back counts as 0 */
+        1000, 500, 0
+    };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    size_t i;
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+
+    // act
+    for (i = 0; i < 5; i++)
+    {
+        test_lock->acquire_shared(test_lock);
+        test_lock->release_shared(test_lock);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 5, stats.shared.acquire_count);
+    ASSERT_ARE_EQUAL(uint64_t, 8000000005, stats.shared.total_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 8000000000, stats.shared.max_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.shared.wait_histogram[0]);
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.shared.wait_histogram[1]);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.wait_histogram[UMOCK_LOCK_INSTRUMENTATION_HISTOGRAM_BUCKET_COUNT - 1]);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_016: [ umock_lock_instrumented_acquire_shared shall remember the acquire time for the calling thread, unless the calling thread already holds MAX_SHARED_HOLDS_PER_THREAD shared acquisitions. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_shared_more_than_8_times_does_not_measure_the_extra_holds)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    size_t i;
+    create_test_instrumentation_and_lock();
+
+    // act
+    for (i = 0; i < 9; i++)
+    {
+        test_lock->acquire_shared(test_lock);
+    }
+    for (i = 0; i < 9; i++)
+    {
+        test_lock->release_shared(test_lock);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 9, stats.shared.acquire_count);
+    ASSERT_ARE_EQUAL(uint64_t, 8, stats.shared.release_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* umock_lock_instrumented_release_shared */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_017: [ If lock is NULL, umock_lock_instrumented_release_shared shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumented_release_shared_with_NULL_lock_returns)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->release_shared(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_018: [ umock_lock_instrumented_release_shared shall release the wrapped lock in shared mode. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_019: [ If the calling thread remembered an acquire time for the lock, umock_lock_instrumented_release_shared shall increment the shared release count and add the time elapsed since the acquire to the shared hold total, maximum and histogram. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+TEST_FUNCTION(umock_lock_instrumented_release_shared_releases_the_wrapped_lock_and_records_the_hold)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 1000, 1000, 1100 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+    test_lock->acquire_shared(test_lock);
+    mocked_call_count = 0;
+
+    // act
+    test_lock->release_shared(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[0].call_type);
+    assert_lock_call(1, TEST_MOCK_CALL_TYPE_test_release_shared, test_inner_lock);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, 100, stats.shared.total_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 100, stats.shared.max_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.hold_histogram[6]);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.exclusive.release_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_019: [ If the calling thread remembered an acquire time for the lock, umock_lock_instrumented_release_shared shall increment the shared release count and add the time elapsed since the acquire to the shared hold total, maximum and histogram. ]*/
+TEST_FUNCTION(umock_lock_instrumented_release_shared_pairs_the_release_with_the_acquire_of_the_same_lock)
+{
+    // arrange
+    /* lock 1 acquired at 1000, lock 2 acquired at 2000, lock 1 released at 2010, lock 2 released at 2020 */
+    static const uint64_t times_ns[] = { 1000, 1000, 2000, 2000, 2010, 2020 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    UMOCK_C_LOCK_HANDLE other_lock;
+    create_test_instrumentation_and_lock();
+    other_lock = umock_lock_instrumentation_create_lock(test_instrumentation);
+    ASSERT_IS_NOT_NULL(other_lock);
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+    test_lock->acquire_shared(test_lock);
+    other_lock->acquire_shared(other_lock);
+
+    // act
+    test_lock->release_shared(test_lock);
+    other_lock->release_shared(other_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.shared.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1030, stats.shared.total_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1010, stats.shared.max_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.hold_histogram[4]);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.shared.hold_histogram[9]);
+
+    // cleanup
+    other_lock->destroy(other_lock);
+    destroy_test_instrumentation_and_lock();
+}
+
+/* umock_lock_instrumented_acquire_exclusive */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_020: [ If lock is NULL, umock_lock_instrumented_acquire_exclusive shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_exclusive_with_NULL_lock_returns)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->acquire_exclusive(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_021: [ umock_lock_instrumented_acquire_exclusive shall acquire the wrapped lock in exclusive mode and measure how long that took. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_022: [ umock_lock_instrumented_acquire_exclusive shall increment the exclusive acquire count and add the wait time to the exclusive wait total, maximum and histogram. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_034: [ Times shall be read from a monotonic clock: clock_gettime with CLOCK_MONOTONIC, or QueryPerformanceCounter on Windows. ]*/
+TEST_FUNCTION(umock_lock_instrumented_acquire_exclusive_acquires_the_wrapped_lock_and_records_the_wait)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 1000, 1500 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+
+    // act
+    test_lock->acquire_exclusive(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[0].call_type);
+    assert_lock_call(1, TEST_MOCK_CALL_TYPE_test_acquire_exclusive, test_inner_lock);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.exclusive.acquire_count);
+    ASSERT_ARE_EQUAL(uint64_t, 500, stats.exclusive.total_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 500, stats.exclusive.max_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.exclusive.wait_histogram[8]);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.shared.acquire_count);
+
+    // cleanup
+    test_lock->release_exclusive(test_lock);
+    destroy_test_instrumentation_and_lock();
+}
+
+/* umock_lock_instrumented_release_exclusive */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_023: [ If lock is NULL, umock_lock_instrumented_release_exclusive shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumented_release_exclusive_with_NULL_lock_returns)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->release_exclusive(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_024: [ umock_lock_instrumented_release_exclusive shall release the wrapped lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_025: [ umock_lock_instrumented_release_exclusive shall increment the exclusive release count and add the time elapsed since the exclusive acquire to the exclusive hold total, maximum and histogram. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+TEST_FUNCTION(umock_lock_instrumented_release_exclusive_releases_the_wrapped_lock_and_records_the_hold)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 1000, 1000, 2024 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+    test_lock->acquire_exclusive(test_lock);
+    mocked_call_count = 0;
+
+    // act
+    test_lock->release_exclusive(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_clock, mocked_calls[0].call_type);
+    assert_lock_call(1, TEST_MOCK_CALL_TYPE_test_release_exclusive, test_inner_lock);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.exclusive.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, 1024, stats.exclusive.total_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1024, stats.exclusive.max_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 1, stats.exclusive.hold_histogram[10]);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.shared.release_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* umock_lock_instrumented_destroy */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_026: [ If lock is NULL, umock_lock_instrumented_destroy shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumented_destroy_with_NULL_lock_returns)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_027: [ umock_lock_instrumented_destroy shall destroy the wrapped lock and free the memory associated with the lock. ]*/
+TEST_FUNCTION(umock_lock_instrumented_destroy_frees_the_resources)
+{
+    // arrange
+    create_test_instrumentation_and_lock();
+
+    // act
+    test_lock->destroy(test_lock);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    assert_lock_call(0, TEST_MOCK_CALL_TYPE_test_destroy, test_inner_lock);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_lock, mocked_calls[1].u.mock_free.ptr);
+
+    // cleanup
+    umock_lock_instrumentation_destroy(test_instrumentation);
+}
+
+/* umock_lock_instrumentation_get_stats */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_028: [ If instrumentation or stats is NULL, umock_lock_instrumentation_get_stats shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_get_stats_with_NULL_instrumentation_fails)
+{
+    // arrange
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+
+    // act
+    int result = umock_lock_instrumentation_get_stats(NULL, &stats);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_028: [ If instrumentation or stats is NULL, umock_lock_instrumentation_get_stats shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_get_stats_with_NULL_stats_fails)
+{
+    // arrange
+    int result;
+    create_test_instrumentation_and_lock();
+
+    // act
+    result = umock_lock_instrumentation_get_stats(test_instrumentation, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_029: [ umock_lock_instrumentation_get_stats shall copy the statistics of all the locks created with instrumentation to stats, reading each of them atomically. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_030: [ On success umock_lock_instrumentation_get_stats shall return 0. ]*/
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_033: [ The statistics shall be updated with atomic operations, the maximums with a compare and exchange loop, without taking any lock. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_get_stats_adds_up_the_statistics_of_all_the_locks)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 0, 10, 10, 0, 40, 40 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    UMOCK_C_LOCK_HANDLE other_lock;
+    int result;
+    create_test_instrumentation_and_lock();
+    other_lock = umock_lock_instrumentation_create_lock(test_instrumentation);
+    ASSERT_IS_NOT_NULL(other_lock);
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+    test_lock->acquire_exclusive(test_lock);
+    test_lock->release_exclusive(test_lock);
+    other_lock->acquire_exclusive(other_lock);
+    other_lock->release_exclusive(other_lock);
+    mocked_call_count = 0;
+
+    // act
+    result = umock_lock_instrumentation_get_stats(test_instrumentation, &stats);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.exclusive.acquire_count);
+    ASSERT_ARE_EQUAL(uint64_t, 50, stats.exclusive.total_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 40, stats.exclusive.max_wait_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.exclusive.release_count);
+    ASSERT_ARE_EQUAL(uint64_t, 0, stats.exclusive.total_hold_ns);
+    ASSERT_ARE_EQUAL(uint64_t, 2, stats.exclusive.hold_histogram[0]);
+
+    // cleanup
+    other_lock->destroy(other_lock);
+    destroy_test_instrumentation_and_lock();
+}
+
+/* umock_lock_instrumentation_reset_stats */
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_031: [ If instrumentation is NULL, umock_lock_instrumentation_reset_stats shall return. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_reset_stats_with_NULL_instrumentation_returns)
+{
+    // arrange
+
+    // act
+    umock_lock_instrumentation_reset_stats(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCK_LOCK_INSTRUMENTATION_01_032: [ umock_lock_instrumentation_reset_stats shall atomically set each of the statistics to 0. ]*/
+TEST_FUNCTION(umock_lock_instrumentation_reset_stats_sets_all_the_statistics_to_0)
+{
+    // arrange
+    static const uint64_t times_ns[] = { 0, 10, 10, 20 };
+    UMOCK_LOCK_INSTRUMENTATION_STATS stats;
+    UMOCK_LOCK_INSTRUMENTATION_STATS zero_stats;
+    (void)memset(&zero_stats, 0, sizeof(zero_stats));
+    create_test_instrumentation_and_lock();
+    set_test_times(times_ns, sizeof(times_ns) / sizeof(times_ns[0]));
+    test_lock->acquire_shared(test_lock);
+    test_lock->release_shared(test_lock);
+    test_lock->acquire_exclusive(test_lock);
+    test_lock->release_exclusive(test_lock);
+    mocked_call_count = 0;
+
+    // act
+    umock_lock_instrumentation_reset_stats(test_instrumentation);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+    ASSERT_ARE_EQUAL(int, 0, umock_lock_instrumentation_get_stats(test_instrumentation, &stats));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(&zero_stats, &stats, sizeof(stats)));
+
+    // cleanup
+    destroy_test_instrumentation_and_lock();
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
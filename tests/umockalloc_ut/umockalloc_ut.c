@@ -2,9 +2,11 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "testrunnerswitcher.h"
 #include "umock_c/umockalloc.h"
+#include "umock_c/umock_lock_if.h"
 
 typedef struct test_malloc_CALL_TAG
 {
@@ -43,6 +45,18 @@ typedef struct test_free_CALL_TAG
 static test_free_CALL* test_free_calls;
 static size_t test_free_call_count;
 
+/* when set, the allocation mocks record the calls and forward them to the real allocator */
+static int test_use_real_allocator;
+
+static size_t test_lock_acquire_shared_call_count;
+static size_t test_lock_release_shared_call_count;
+static size_t test_lock_acquire_exclusive_call_count;
+static size_t test_lock_release_exclusive_call_count;
+static size_t test_lock_destroy_call_count;
+static size_t test_lock_factory_create_lock_call_count;
+static void* test_lock_factory_create_lock_params;
+static int test_lock_factory_create_lock_fails;
+
 
     void* mock_malloc(size_t size)
     {
@@ -54,7 +68,7 @@ static size_t test_free_call_count;
             test_malloc_call_count++;
         }
 
-        return test_malloc_expected_result;
+        return (test_use_real_allocator != 0) ? malloc(size) : test_malloc_expected_result;
     }
 
     void* mock_calloc(size_t nmemb, size_t size)
@@ -94,8 +108,59 @@ static size_t test_free_call_count;
             test_free_calls[test_free_call_count].ptr = ptr;
             test_free_call_count++;
         }
+
+        if (test_use_real_allocator != 0)
+        {
+            free(ptr);
+        }
     }
 
+static void test_lock_acquire_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    (void)lock;
+    test_lock_acquire_shared_call_count++;
+}
+
+static void test_lock_release_shared(UMOCK_C_LOCK_HANDLE lock)
+{
+    (void)lock;
+    test_lock_release_shared_call_count++;
+}
+
+static void test_lock_acquire_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    (void)lock;
+    test_lock_acquire_exclusive_call_count++;
+}
+
+static void test_lock_release_exclusive(UMOCK_C_LOCK_HANDLE lock)
+{
+    (void)lock;
+    test_lock_release_exclusive_call_count++;
+}
+
+static void test_lock_destroy(UMOCK_C_LOCK_HANDLE lock)
+{
+    (void)lock;
+    test_lock_destroy_call_count++;
+}
+
+static const UMOCK_C_LOCK_IF test_lock =
+{
+    test_lock_acquire_shared,
+    test_lock_release_shared,
+    test_lock_acquire_exclusive,
+    test_lock_release_exclusive,
+    test_lock_destroy
+};
+
+static UMOCK_C_LOCK_HANDLE test_lock_factory_create_lock(void* params)
+{
+    test_lock_factory_create_lock_call_count++;
+    test_lock_factory_create_lock_params = params;
+    return (test_lock_factory_create_lock_fails != 0) ? NULL : &test_lock;
+}
+
 
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
 
@@ -123,10 +188,24 @@ TEST_FUNCTION_INITIALIZE(test_function_init)
     test_realloc_calls = NULL;
     test_realloc_call_count = 0;
     test_realloc_expected_result = (void*)0x4243;
+
+    test_use_real_allocator = 0;
+
+    test_lock_acquire_shared_call_count = 0;
+    test_lock_release_shared_call_count = 0;
+    test_lock_acquire_exclusive_call_count = 0;
+    test_lock_release_exclusive_call_count = 0;
+    test_lock_destroy_call_count = 0;
+    test_lock_factory_create_lock_call_count = 0;
+    test_lock_factory_create_lock_params = NULL;
+    test_lock_factory_create_lock_fails = 0;
 }
 
 TEST_FUNCTION_CLEANUP(test_function_cleanup)
 {
+    umockalloc_set_call_arena(NULL);
+    umockc_set_stringify_buffer_truncation(0);
+
     free(test_malloc_calls);
     test_malloc_calls = NULL;
     test_malloc_call_count = 0;
@@ -357,4 +436,937 @@ TEST_FUNCTION(umockalloc_free_with_NULL_calls_free_with_NULL)
     ASSERT_ARE_EQUAL(void_ptr, NULL, test_free_calls[0].ptr);
 }
 
+/* umockalloc_arena_create */
+
+/* Tests_SRS_UMOCKALLOC_01_008: [ umockalloc_arena_create shall allocate memory for a new arena and on success return a non-NULL handle to it. ]*/
+TEST_FUNCTION(umockalloc_arena_create_without_a_lock_factory_succeeds)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockalloc_arena_create(NULL, NULL);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_arena_destroy(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_009: [ If any error occurs, umockalloc_arena_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_malloc_fails_umockalloc_arena_create_fails)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE result;
+    test_malloc_expected_result = NULL;
+
+    // act
+    result = umockalloc_arena_create(NULL, NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_010: [ If lock_factory_create_lock is not NULL, umockalloc_arena_create shall call it to create the lock used to serialize access to the arena. ]*/
+TEST_FUNCTION(umockalloc_arena_create_with_a_lock_factory_creates_the_lock)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockalloc_arena_create(test_lock_factory_create_lock, (void*)0x4242);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_lock_factory_create_lock_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, test_lock_factory_create_lock_params);
+
+    // cleanup
+    umockalloc_arena_destroy(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_009: [ If any error occurs, umockalloc_arena_create shall fail and return NULL. ]*/
+TEST_FUNCTION(when_creating_the_lock_fails_umockalloc_arena_create_fails)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE result;
+    test_use_real_allocator = 1;
+    test_lock_factory_create_lock_fails = 1;
+
+    // act
+    result = umockalloc_arena_create(test_lock_factory_create_lock, NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_free_call_count);
+}
+
+/* umockalloc_arena_destroy */
+
+/* Tests_SRS_UMOCKALLOC_01_011: [ umockalloc_arena_destroy shall free all the memory blocks of the arena, the lock (if any) and the arena itself. ]*/
+TEST_FUNCTION(umockalloc_arena_destroy_frees_the_blocks_the_lock_and_the_arena)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(test_lock_factory_create_lock, NULL);
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 42));
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 64 * 1024));
+
+    // act
+    umockalloc_arena_destroy(arena);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 3, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, test_free_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_lock_destroy_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_012: [ If arena is NULL, umockalloc_arena_destroy shall do nothing. ]*/
+TEST_FUNCTION(umockalloc_arena_destroy_with_NULL_does_nothing)
+{
+    // arrange
+
+    // act
+    umockalloc_arena_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+}
+
+/* umockalloc_arena_malloc */
+
+/* Tests_SRS_UMOCKALLOC_01_013: [ umockalloc_arena_malloc shall return a pointer to size bytes taken from the current block of the arena. ]*/
+TEST_FUNCTION(umockalloc_arena_malloc_takes_consecutive_allocations_from_one_block)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    unsigned char* result_1;
+    unsigned char* result_2;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+
+    // act
+    result_1 = (unsigned char*)umockalloc_arena_malloc(arena, 3);
+    result_2 = (unsigned char*)umockalloc_arena_malloc(arena, 42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result_1);
+    ASSERT_IS_NOT_NULL(result_2);
+    ASSERT_IS_TRUE(result_2 >= result_1 + 3);
+    ASSERT_ARE_EQUAL(size_t, 0, ((size_t)result_2) % sizeof(void*));
+    ASSERT_ARE_EQUAL(size_t, 2, test_malloc_call_count);
+    (void)memset(result_1, 0x42, 3);
+    (void)memset(result_2, 0x43, 42);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_014: [ If arena is NULL or size is too large, umockalloc_arena_malloc shall fail and return NULL. ]*/
+TEST_FUNCTION(umockalloc_arena_malloc_with_NULL_arena_fails)
+{
+    // arrange
+    void* result;
+
+    // act
+    result = umockalloc_arena_malloc(NULL, 42);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_014: [ If arena is NULL or size is too large, umockalloc_arena_malloc shall fail and return NULL. ]*/
+TEST_FUNCTION(umockalloc_arena_malloc_with_a_size_that_would_overflow_fails)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+
+    // act
+    result = umockalloc_arena_malloc(arena, (size_t)-1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_015: [ When the current block does not have room for size bytes, umockalloc_arena_malloc shall allocate a new block by calling malloc, at least twice as large as the previous one. ]*/
+TEST_FUNCTION(umockalloc_arena_malloc_when_the_block_is_full_allocates_a_larger_block)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 1));
+
+    // act
+    result = umockalloc_arena_malloc(arena, 16 * 1024);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 3, test_malloc_call_count);
+    ASSERT_IS_TRUE(test_malloc_calls[2].size > test_malloc_calls[1].size);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_016: [ If allocating a new block fails, umockalloc_arena_malloc shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_a_block_fails_umockalloc_arena_malloc_fails)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    test_use_real_allocator = 0;
+    test_malloc_expected_result = NULL;
+
+    // act
+    result = umockalloc_arena_malloc(arena, 42);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 2, test_malloc_call_count);
+
+    // cleanup
+    test_use_real_allocator = 1;
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_013: [ umockalloc_arena_malloc shall return a pointer to size bytes taken from the current block of the arena. ]*/
+TEST_FUNCTION(umockalloc_arena_malloc_with_a_lock_acquires_the_lock_exclusively)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(test_lock_factory_create_lock, NULL);
+
+    // act
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 42));
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_lock_acquire_exclusive_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_lock_release_exclusive_call_count);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* umockalloc_arena_owns */
+
+/* Tests_SRS_UMOCKALLOC_01_017: [ umockalloc_arena_owns shall return 1 if ptr points inside one of the blocks of the arena and 0 otherwise. ]*/
+TEST_FUNCTION(umockalloc_arena_owns_tells_arena_memory_apart_from_other_memory)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* arena_memory_1;
+    void* arena_memory_2;
+    int local_variable = 42;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(test_lock_factory_create_lock, NULL);
+    arena_memory_1 = umockalloc_arena_malloc(arena, 42);
+    arena_memory_2 = umockalloc_arena_malloc(arena, 64 * 1024);
+
+    // act
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, umockalloc_arena_owns(arena, arena_memory_1));
+    ASSERT_ARE_EQUAL(int, 1, umockalloc_arena_owns(arena, arena_memory_2));
+    ASSERT_ARE_EQUAL(int, 0, umockalloc_arena_owns(arena, &local_variable));
+    ASSERT_ARE_EQUAL(size_t, 3, test_lock_acquire_shared_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, test_lock_release_shared_call_count);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_018: [ If arena or ptr is NULL, umockalloc_arena_owns shall return 0. ]*/
+TEST_FUNCTION(umockalloc_arena_owns_with_NULL_arguments_returns_0)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 42));
+
+    // act
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, umockalloc_arena_owns(NULL, (void*)0x4242));
+    ASSERT_ARE_EQUAL(int, 0, umockalloc_arena_owns(arena, NULL));
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* umockalloc_arena_reset */
+
+/* Tests_SRS_UMOCKALLOC_01_019: [ umockalloc_arena_reset shall release all the memory allocated from the arena at once, keeping only the most recently allocated block for reuse. ]*/
+TEST_FUNCTION(umockalloc_arena_reset_frees_older_blocks_and_reuses_the_newest_one)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* large_allocation;
+    void* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    ASSERT_IS_NOT_NULL(umockalloc_arena_malloc(arena, 42));
+    large_allocation = umockalloc_arena_malloc(arena, 64 * 1024);
+    ASSERT_IS_NOT_NULL(large_allocation);
+
+    // act
+    umockalloc_arena_reset(arena);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_free_call_count);
+    result = umockalloc_arena_malloc(arena, 42);
+    ASSERT_ARE_EQUAL(void_ptr, large_allocation, result);
+    ASSERT_ARE_EQUAL(size_t, 3, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_022: [ If arena is NULL, umockalloc_arena_reset shall do nothing. ]*/
+TEST_FUNCTION(umockalloc_arena_reset_with_NULL_does_nothing)
+{
+    // arrange
+
+    // act
+    umockalloc_arena_reset(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+}
+
+/* umockalloc_call_malloc */
+
+/* Tests_SRS_UMOCKALLOC_01_025: [ Otherwise umockalloc_call_malloc shall behave like umockalloc_malloc. ]*/
+TEST_FUNCTION(umockalloc_call_malloc_without_a_call_arena_calls_malloc)
+{
+    // arrange
+    void* result;
+    test_malloc_expected_result = (void*)0x4242;
+
+    // act
+    result = umockalloc_call_malloc(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 42, test_malloc_calls[0].size);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_023: [ umockalloc_set_call_arena shall set arena as the arena used by umockalloc_call_malloc. A NULL arena turns off the arena mode. ]*/
+/* Tests_SRS_UMOCKALLOC_01_024: [ If a call arena was set, umockalloc_call_malloc shall allocate size bytes from it by calling umockalloc_arena_malloc. ]*/
+TEST_FUNCTION(umockalloc_call_malloc_with_a_call_arena_allocates_from_the_arena)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* result_1;
+    void* result_2;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    umockalloc_set_call_arena(arena);
+
+    // act
+    result_1 = umockalloc_call_malloc(42);
+    result_2 = umockalloc_call_malloc(42);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, umockalloc_arena_owns(arena, result_1));
+    ASSERT_ARE_EQUAL(int, 1, umockalloc_arena_owns(arena, result_2));
+    ASSERT_ARE_EQUAL(size_t, 2, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_set_call_arena(NULL);
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_023: [ umockalloc_set_call_arena shall set arena as the arena used by umockalloc_call_malloc. A NULL arena turns off the arena mode. ]*/
+TEST_FUNCTION(umockalloc_set_call_arena_with_NULL_turns_off_the_arena_mode)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    umockalloc_set_call_arena(arena);
+    umockalloc_set_call_arena(NULL);
+
+    // act
+    result = umockalloc_call_malloc(42);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(int, 0, umockalloc_arena_owns(arena, result));
+    ASSERT_ARE_EQUAL(size_t, 2, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_free(result);
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_021: [ If ptr was allocated from the call arena, umockalloc_free shall do nothing. ]*/
+TEST_FUNCTION(umockalloc_free_with_call_arena_memory_does_not_call_free)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    void* arena_memory;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    umockalloc_set_call_arena(arena);
+    arena_memory = umockalloc_call_malloc(42);
+
+    // act
+    umockalloc_free(arena_memory);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+
+    // cleanup
+    umockalloc_set_call_arena(NULL);
+    umockalloc_arena_destroy(arena);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_020: [ If ptr was allocated from the call arena, umockalloc_realloc shall allocate a new block of size bytes by calling malloc, copy the contents of the arena memory to it and return it. ]*/
+TEST_FUNCTION(umockalloc_realloc_with_call_arena_memory_moves_it_to_the_heap)
+{
+    // arrange
+    UMOCKALLOC_ARENA_HANDLE arena;
+    unsigned char* arena_memory;
+    unsigned char* result;
+    test_use_real_allocator = 1;
+    arena = umockalloc_arena_create(NULL, NULL);
+    umockalloc_set_call_arena(arena);
+    arena_memory = (unsigned char*)umockalloc_call_malloc(2);
+    arena_memory[0] = 0x42;
+    arena_memory[1] = 0x43;
+
+    // act
+    result = (unsigned char*)umockalloc_realloc(arena_memory, 3);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(int, 0, umockalloc_arena_owns(arena, result));
+    ASSERT_ARE_EQUAL(int, 0x42, (int)result[0]);
+    ASSERT_ARE_EQUAL(int, 0x43, (int)result[1]);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 3, test_malloc_calls[2].size);
+
+    // cleanup
+    umockalloc_free(result);
+    umockalloc_set_call_arena(NULL);
+    umockalloc_arena_destroy(arena);
+}
+
+/* umockc_stringify_buffer */
+
+/* Tests_SRS_UMOCKALLOC_01_026: [ umockc_stringify_buffer shall allocate a string by calling umockalloc_malloc and fill it with the length bytes pointed to by bytes, each formatted as 0x followed by 2 uppercase hex digits, separated by spaces and enclosed in square brackets. ]*/
+/* Tests_SRS_UMOCKALLOC_01_027: [ The hex digits shall be taken from a lookup table rather than formatted with sprintf for each byte. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_stringifies_the_bytes)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x00, 0x09, 0x42, 0xAB, 0xFF };
+    char* result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x00 0x09 0x42 0xAB 0xFF]", result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, sizeof("[0x00 0x09 0x42 0xAB 0xFF]"), test_malloc_calls[0].size);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_026: [ umockc_stringify_buffer shall allocate a string by calling umockalloc_malloc and fill it with the length bytes pointed to by bytes, each formatted as 0x followed by 2 uppercase hex digits, separated by spaces and enclosed in square brackets. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_0_length_returns_empty_brackets)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x42 };
+    char* result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_buffer(bytes, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[]", result);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_028: [ If allocating memory fails, umockc_stringify_buffer shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umockc_stringify_buffer_fails)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x42 };
+    char* result;
+    test_malloc_expected_result = NULL;
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_029: [ If the length of the resulting string does not fit in a size_t, umockc_stringify_buffer shall fail and return NULL. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_a_length_that_would_overflow_fails)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x42 };
+    char* result;
+
+    // act
+    result = umockc_stringify_buffer(bytes, ((size_t)-1) / 4);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_030: [ umockc_set_stringify_buffer_truncation shall set the number of bytes that umockc_stringify_buffer shows at each end of a buffer that is longer than twice that number. An edge_byte_count of 0 turns off the truncation. ]*/
+/* Tests_SRS_UMOCKALLOC_01_031: [ If a truncation was set with umockc_set_stringify_buffer_truncation and length is more than twice edge_byte_count, only the first and the last edge_byte_count bytes shall be stringified, separated by a ...(length bytes)... marker. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_truncation_shows_the_first_and_last_bytes)
+{
+    // arrange
+    unsigned char bytes[1000];
+    char* result;
+    size_t i;
+    for (i = 0; i < sizeof(bytes); i++)
+    {
+        bytes[i] = (unsigned char)i;
+    }
+    test_use_real_allocator = 1;
+    umockc_set_stringify_buffer_truncation(2);
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x00 0x01 ...(1000 bytes)... 0xE6 0xE7]", result);
+    ASSERT_ARE_EQUAL(size_t, sizeof("[0x00 0x01 ...(1000 bytes)... 0xE6 0xE7]"), test_malloc_calls[0].size);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_031: [ If a truncation was set with umockc_set_stringify_buffer_truncation and length is more than twice edge_byte_count, only the first and the last edge_byte_count bytes shall be stringified, separated by a ...(length bytes)... marker. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_truncation_shows_a_buffer_of_twice_the_edge_byte_count_in_full)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01, 0x02, 0x03, 0x04 };
+    char* result;
+    test_use_real_allocator = 1;
+    umockc_set_stringify_buffer_truncation(2);
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x01 0x02 0x03 0x04]", result);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_031: [ If a truncation was set with umockc_set_stringify_buffer_truncation and length is more than twice edge_byte_count, only the first and the last edge_byte_count bytes shall be stringified, separated by a ...(length bytes)... marker. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_truncation_shows_a_buffer_one_byte_longer_than_twice_the_edge_byte_count_truncated)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+    char* result;
+    test_use_real_allocator = 1;
+    umockc_set_stringify_buffer_truncation(2);
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x01 0x02 ...(5 bytes)... 0x04 0x05]", result);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_030: [ umockc_set_stringify_buffer_truncation shall set the number of bytes that umockc_stringify_buffer shows at each end of a buffer that is longer than twice that number. An edge_byte_count of 0 turns off the truncation. ]*/
+TEST_FUNCTION(umockc_set_stringify_buffer_truncation_with_0_turns_off_the_truncation)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01, 0x02, 0x03 };
+    char* result;
+    test_use_real_allocator = 1;
+    umockc_set_stringify_buffer_truncation(1);
+    umockc_set_stringify_buffer_truncation(0);
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x01 0x02 0x03]", result);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_031: [ If a truncation was set with umockc_set_stringify_buffer_truncation and length is more than twice edge_byte_count, only the first and the last edge_byte_count bytes shall be stringified, separated by a ...(length bytes)... marker. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_with_a_huge_edge_byte_count_does_not_truncate)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01, 0x02, 0x03 };
+    char* result;
+    test_use_real_allocator = 1;
+    umockc_set_stringify_buffer_truncation((size_t)-1);
+
+    // act
+    result = umockc_stringify_buffer(bytes, sizeof(bytes));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[0x01 0x02 0x03]", result);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* umockc_compare_buffers */
+
+/* Tests_SRS_UMOCKALLOC_01_032: [ umockc_compare_buffers shall compare the length bytes pointed to by left and right by calling memcmp and return 0 if they are equal. ]*/
+TEST_FUNCTION(umockc_compare_buffers_with_equal_buffers_returns_0)
+{
+    // arrange
+    const unsigned char left[] = { 0x01, 0x02, 0x03 };
+    const unsigned char right[] = { 0x01, 0x02, 0x03 };
+    size_t first_difference_offset = 42;
+    int result;
+
+    // act
+    result = umockc_compare_buffers(left, right, sizeof(left), &first_difference_offset);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 42, first_difference_offset);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_033: [ Otherwise umockc_compare_buffers shall set first_difference_offset to the offset of the first byte that differs and return 1. ]*/
+TEST_FUNCTION(umockc_compare_buffers_with_different_buffers_returns_the_first_difference_offset)
+{
+    // arrange
+    const unsigned char left[] = { 0x01, 0x02, 0x03, 0x04 };
+    const unsigned char right[] = { 0x01, 0x02, 0x42, 0x43 };
+    size_t first_difference_offset;
+    int result;
+
+    // act
+    result = umockc_compare_buffers(left, right, sizeof(left), &first_difference_offset);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 2, first_difference_offset);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_033: [ Otherwise umockc_compare_buffers shall set first_difference_offset to the offset of the first byte that differs and return 1. ]*/
+/* Tests_SRS_UMOCKALLOC_01_034: [ The first difference shall be located by comparing blocks of bytes with memcmp and then the bytes of the first differing block. ]*/
+TEST_FUNCTION(umockc_compare_buffers_finds_the_first_difference_at_any_offset_of_a_large_buffer)
+{
+    // arrange
+    unsigned char left[1000];
+    unsigned char right[1000];
+    size_t i;
+    for (i = 0; i < sizeof(left); i++)
+    {
+        left[i] = (unsigned char)i;
+    }
+
+    for (i = 0; i < sizeof(left); i++)
+    {
+        size_t first_difference_offset;
+        (void)memcpy(right, left, sizeof(right));
+        right[i] ^= 0xFF;
+        if (i + 1 < sizeof(right))
+        {
+            right[sizeof(right) - 1] ^= 0xFF;
+        }
+
+        // act
+        ASSERT_ARE_EQUAL(int, 1, umockc_compare_buffers(left, right, sizeof(left), &first_difference_offset));
+
+        // assert
+        ASSERT_ARE_EQUAL(size_t, i, first_difference_offset);
+    }
+}
+
+/* Tests_SRS_UMOCKALLOC_01_035: [ If left, right or first_difference_offset is NULL, umockc_compare_buffers shall fail and return a negative value. ]*/
+TEST_FUNCTION(umockc_compare_buffers_with_NULL_arguments_fails)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01 };
+    size_t first_difference_offset;
+
+    // act
+    // assert
+    ASSERT_IS_TRUE(umockc_compare_buffers(NULL, bytes, sizeof(bytes), &first_difference_offset) < 0);
+    ASSERT_IS_TRUE(umockc_compare_buffers(bytes, NULL, sizeof(bytes), &first_difference_offset) < 0);
+    ASSERT_IS_TRUE(umockc_compare_buffers(bytes, bytes, sizeof(bytes), NULL) < 0);
+}
+
+/* umockc_stringify_buffer_difference */
+
+/* Tests_SRS_UMOCKALLOC_01_036: [ umockc_stringify_buffer_difference shall allocate by calling umockalloc_malloc a string that contains first_difference_offset, length and the bytes of expected and actual from 8 bytes before up to 8 bytes after first_difference_offset (limited to the buffer), each stringified like umockc_stringify_buffer does. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_difference_shows_a_window_around_the_first_difference)
+{
+    // arrange
+    unsigned char expected[100];
+    unsigned char actual[100];
+    char* result;
+    size_t i;
+    for (i = 0; i < sizeof(expected); i++)
+    {
+        expected[i] = (unsigned char)i;
+    }
+    (void)memcpy(actual, expected, sizeof(actual));
+    actual[50] = 0xFF;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_buffer_difference(expected, actual, sizeof(expected), 50);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr,
+        "differs at offset 50 of 100, bytes 42 to 58: "
+        "expected [0x2A 0x2B 0x2C 0x2D 0x2E 0x2F 0x30 0x31 0x32 0x33 0x34 0x35 0x36 0x37 0x38 0x39 0x3A] "
+        "actual [0x2A 0x2B 0x2C 0x2D 0x2E 0x2F 0x30 0x31 0xFF 0x33 0x34 0x35 0x36 0x37 0x38 0x39 0x3A]",
+        result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, strlen(result) + 1, test_malloc_calls[0].size);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_036: [ umockc_stringify_buffer_difference shall allocate by calling umockalloc_malloc a string that contains first_difference_offset, length and the bytes of expected and actual from 8 bytes before up to 8 bytes after first_difference_offset (limited to the buffer), each stringified like umockc_stringify_buffer does. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_difference_limits_the_window_to_the_buffer)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02, 0x03 };
+    const unsigned char actual[] = { 0x42, 0x02, 0x03 };
+    char* result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_buffer_difference(expected, actual, sizeof(expected), 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "differs at offset 0 of 3, bytes 0 to 2: expected [0x01 0x02 0x03] actual [0x42 0x02 0x03]", result);
+    ASSERT_ARE_EQUAL(size_t, strlen(result) + 1, test_malloc_calls[0].size);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_037: [ If allocating memory fails, umockc_stringify_buffer_difference shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umockc_stringify_buffer_difference_fails)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01 };
+    const unsigned char actual[] = { 0x42 };
+    char* result;
+    test_malloc_expected_result = NULL;
+
+    // act
+    result = umockc_stringify_buffer_difference(expected, actual, sizeof(expected), 0);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_038: [ If expected or actual is NULL or first_difference_offset is not less than length, umockc_stringify_buffer_difference shall fail and return NULL. ]*/
+TEST_FUNCTION(umockc_stringify_buffer_difference_with_invalid_arguments_fails)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01 };
+
+    // act
+    // assert
+    ASSERT_IS_NULL(umockc_stringify_buffer_difference(NULL, bytes, sizeof(bytes), 0));
+    ASSERT_IS_NULL(umockc_stringify_buffer_difference(bytes, NULL, sizeof(bytes), 0));
+    ASSERT_IS_NULL(umockc_stringify_buffer_difference(bytes, bytes, sizeof(bytes), 1));
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* umockc_validate_argument_buffer */
+
+/* Tests_SRS_UMOCKALLOC_01_039: [ umockc_validate_argument_buffer shall compare the length bytes of expected and actual by calling umockc_compare_buffers and return 1 if they are equal. ]*/
+TEST_FUNCTION(umockc_validate_argument_buffer_with_equal_buffers_returns_1)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    const unsigned char actual[] = { 0x01, 0x02 };
+    int result;
+
+    // act
+    result = umockc_validate_argument_buffer(expected, actual, sizeof(expected));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_041: [ If the buffers differ, umockc_validate_argument_buffer shall return 0 without allocating memory or logging. ]*/
+TEST_FUNCTION(umockc_validate_argument_buffer_with_different_buffers_returns_0_without_allocating)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    const unsigned char actual[] = { 0x01, 0x03 };
+    int result;
+
+    // act
+    result = umockc_validate_argument_buffer(expected, actual, sizeof(expected));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_040: [ If actual is NULL, umockc_validate_argument_buffer shall return 0. ]*/
+TEST_FUNCTION(umockc_validate_argument_buffer_with_NULL_actual_returns_0)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    int result;
+
+    // act
+    result = umockc_validate_argument_buffer(expected, NULL, sizeof(expected));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_042: [ If comparing the buffers fails, umockc_validate_argument_buffer shall return 0. ]*/
+TEST_FUNCTION(when_comparing_the_buffers_fails_umockc_validate_argument_buffer_returns_0)
+{
+    // arrange
+    const unsigned char actual[] = { 0x01, 0x02 };
+    int result;
+
+    // act
+    result = umockc_validate_argument_buffer(NULL, actual, sizeof(actual));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* umockc_stringify_argument_buffer_mismatch */
+
+/* Tests_SRS_UMOCKALLOC_01_043: [ If the buffers differ, umockc_stringify_argument_buffer_mismatch shall return a string allocated by calling umockalloc_malloc that names argument_name and contains the difference obtained by calling umockc_stringify_buffer_difference. ]*/
+TEST_FUNCTION(umockc_stringify_argument_buffer_mismatch_with_different_buffers_returns_the_difference)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02, 0x03 };
+    const unsigned char actual[] = { 0x42, 0x02, 0x03 };
+    char* result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_argument_buffer_mismatch("buffer", expected, actual, sizeof(expected));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "ValidateArgumentBuffer mismatch for argument buffer: the buffer differs at offset 0 of 3, bytes 0 to 2: expected [0x01 0x02 0x03] actual [0x42 0x02 0x03]", result);
+    ASSERT_ARE_EQUAL(size_t, 2, test_malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, strlen(result) + 1, test_malloc_calls[1].size);
+    ASSERT_ARE_EQUAL(size_t, 1, test_free_call_count);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_044: [ If actual is NULL, umockc_stringify_argument_buffer_mismatch shall return a string that names argument_name and says that the argument is NULL. ]*/
+TEST_FUNCTION(umockc_stringify_argument_buffer_mismatch_with_NULL_actual_says_the_argument_is_NULL)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    char* result;
+    test_use_real_allocator = 1;
+
+    // act
+    result = umockc_stringify_argument_buffer_mismatch("buffer", expected, NULL, sizeof(expected));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "ValidateArgumentBuffer mismatch for argument buffer: the argument is NULL", result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+
+    // cleanup
+    umockalloc_free(result);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_045: [ If the buffers are equal, umockc_stringify_argument_buffer_mismatch shall return NULL. ]*/
+TEST_FUNCTION(umockc_stringify_argument_buffer_mismatch_with_equal_buffers_returns_NULL)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    const unsigned char actual[] = { 0x01, 0x02 };
+    char* result;
+
+    // act
+    result = umockc_stringify_argument_buffer_mismatch("buffer", expected, actual, sizeof(expected));
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_046: [ If argument_name or expected is NULL, umockc_stringify_argument_buffer_mismatch shall fail and return NULL. ]*/
+TEST_FUNCTION(umockc_stringify_argument_buffer_mismatch_with_invalid_arguments_fails)
+{
+    // arrange
+    const unsigned char bytes[] = { 0x01 };
+
+    // act
+    // assert
+    ASSERT_IS_NULL(umockc_stringify_argument_buffer_mismatch(NULL, bytes, bytes, sizeof(bytes)));
+    ASSERT_IS_NULL(umockc_stringify_argument_buffer_mismatch("buffer", NULL, bytes, sizeof(bytes)));
+    ASSERT_ARE_EQUAL(size_t, 0, test_malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKALLOC_01_047: [ If allocating memory fails, umockc_stringify_argument_buffer_mismatch shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_difference_fails_umockc_stringify_argument_buffer_mismatch_fails)
+{
+    // arrange
+    const unsigned char expected[] = { 0x01, 0x02 };
+    const unsigned char actual[] = { 0x01, 0x03 };
+    char* result;
+    test_malloc_expected_result = NULL;
+
+    // act
+    result = umockc_stringify_argument_buffer_mismatch("buffer", expected, actual, sizeof(expected));
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_malloc_call_count);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,222 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "testrunnerswitcher.h"
+#include "umock_c/umockatomic.h"
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+}
+
+/* umockatomic_increment_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_001: [ umockatomic_increment_uint64 shall atomically increment value and return the incremented value. ]*/
+TEST_FUNCTION(umockatomic_increment_uint64_returns_the_incremented_value)
+{
+    // arrange
+    volatile uint64_t value = 41;
+    uint64_t result;
+
+    // act
+    result = umockatomic_increment_uint64(&value);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 42, result);
+    ASSERT_ARE_EQUAL(uint64_t, 42, value);
+}
+
+/* umockatomic_add_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_002: [ umockatomic_add_uint64 shall atomically add addend to value and return the resulting value. ]*/
+TEST_FUNCTION(umockatomic_add_uint64_returns_the_sum)
+{
+    // arrange
+    volatile uint64_t value = 0x100000000;
+    uint64_t result;
+
+    // act
+    result = umockatomic_add_uint64(&value, 5);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 0x100000005, result);
+    ASSERT_ARE_EQUAL(uint64_t, 0x100000005, value);
+}
+
+/* umockatomic_load_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_003: [ umockatomic_load_uint64 shall atomically read value with acquire semantics and return it. ]*/
+TEST_FUNCTION(umockatomic_load_uint64_returns_the_value)
+{
+    // arrange
+    volatile uint64_t value = 0xFFFFFFFFFFFFFFFE;
+    uint64_t result;
+
+    // act
+    result = umockatomic_load_uint64(&value);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 0xFFFFFFFFFFFFFFFE, result);
+}
+
+/* umockatomic_store_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_004: [ umockatomic_store_uint64 shall atomically write new_value to value with release semantics. ]*/
+TEST_FUNCTION(umockatomic_store_uint64_sets_the_value)
+{
+    // arrange
+    volatile uint64_t value = 1;
+
+    // act
+    umockatomic_store_uint64(&value, 0x123456789A);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 0x123456789A, value);
+}
+
+/* umockatomic_compare_exchange_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_005: [ If value is equal to expected_value, umockatomic_compare_exchange_uint64 shall atomically replace it with new_value and return a non-zero value. ]*/
+TEST_FUNCTION(umockatomic_compare_exchange_uint64_with_the_expected_value_replaces_it)
+{
+    // arrange
+    volatile uint64_t value = 7;
+    int result;
+
+    // act
+    result = umockatomic_compare_exchange_uint64(&value, 7, 8);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 8, value);
+}
+
+/* Tests_SRS_UMOCKATOMIC_01_006: [ Otherwise umockatomic_compare_exchange_uint64 shall leave value unchanged and return 0. ]*/
+TEST_FUNCTION(umockatomic_compare_exchange_uint64_with_another_value_leaves_it_unchanged)
+{
+    // arrange
+    volatile uint64_t value = 7;
+    int result;
+
+    // act
+    result = umockatomic_compare_exchange_uint64(&value, 6, 8);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(uint64_t, 7, value);
+}
+
+/* umockatomic_max_uint64 */
+
+/* Tests_SRS_UMOCKATOMIC_01_007: [ umockatomic_max_uint64 shall replace value with candidate if candidate is greater, by retrying an atomic compare-exchange until it succeeds or value is not smaller than candidate anymore. ]*/
+TEST_FUNCTION(umockatomic_max_uint64_with_a_greater_candidate_replaces_the_value)
+{
+    // arrange
+    volatile uint64_t value = 10;
+
+    // act
+    umockatomic_max_uint64(&value, 11);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 11, value);
+}
+
+/* Tests_SRS_UMOCKATOMIC_01_007: [ umockatomic_max_uint64 shall replace value with candidate if candidate is greater, by retrying an atomic compare-exchange until it succeeds or value is not smaller than candidate anymore. ]*/
+TEST_FUNCTION(umockatomic_max_uint64_with_a_smaller_or_equal_candidate_leaves_the_value_unchanged)
+{
+    // arrange
+    volatile uint64_t value = 10;
+
+    // act
+    umockatomic_max_uint64(&value, 9);
+    umockatomic_max_uint64(&value, 10);
+
+    // assert
+    ASSERT_ARE_EQUAL(uint64_t, 10, value);
+}
+
+/* umockatomic_load_pointer */
+
+/* Tests_SRS_UMOCKATOMIC_01_008: [ umockatomic_load_pointer shall atomically read value with acquire semantics and return it. ]*/
+TEST_FUNCTION(umockatomic_load_pointer_returns_the_pointer)
+{
+    // arrange
+    int target;
+    void* volatile value = &target;
+    void* result;
+
+    // act
+    result = umockatomic_load_pointer(&value);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, &target, result);
+}
+
+/* umockatomic_store_pointer */
+
+/* Tests_SRS_UMOCKATOMIC_01_009: [ umockatomic_store_pointer shall atomically write new_value to value with release semantics. ]*/
+TEST_FUNCTION(umockatomic_store_pointer_sets_the_pointer)
+{
+    // arrange
+    int target;
+    void* volatile value = NULL;
+
+    // act
+    umockatomic_store_pointer(&value, &target);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, &target, value);
+}
+
+/* umockatomic_compare_exchange_pointer */
+
+/* Tests_SRS_UMOCKATOMIC_01_010: [ If value is equal to expected_value, umockatomic_compare_exchange_pointer shall atomically replace it with new_value and return a non-zero value. ]*/
+TEST_FUNCTION(umockatomic_compare_exchange_pointer_with_the_expected_pointer_replaces_it)
+{
+    // arrange
+    int target;
+    void* volatile value = NULL;
+    int result;
+
+    // act
+    result = umockatomic_compare_exchange_pointer(&value, NULL, &target);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, &target, value);
+}
+
+/* Tests_SRS_UMOCKATOMIC_01_011: [ Otherwise umockatomic_compare_exchange_pointer shall leave value unchanged and return 0. ]*/
+TEST_FUNCTION(umockatomic_compare_exchange_pointer_with_another_pointer_leaves_it_unchanged)
+{
+    // arrange
+    int target;
+    int other_target;
+    void* volatile value = &target;
+    int result;
+
+    // act
+    result = umockatomic_compare_exchange_pointer(&value, NULL, &other_target);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, &target, value);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -76,6 +76,7 @@ PARAMETERIZED_TEST_FUNCTION(umockautoignoreargs_is_call_argument_ignored_fails,
     ARGS(const char*, call_str, size_t, arg_idx),
     CASE((NULL, 1), with_NULL_call),
     CASE(("a", 1), when_no_lparen_is_found),
+    CASE(("", 1), with_empty_call),
     CASE(("a()", 1), for_arg_1_when_no_args_in_call),
     CASE(("WRAPPER(a)(IGNORED_ARG(", 1), when_RPAREN_missing_at_end),
     CASE(("WRAPPER(a)(IGNORED_ARG)(", 1), when_extra_LPAREN_at_end),
@@ -130,4 +131,96 @@ PARAMETERIZED_TEST_FUNCTION(umockautoignoreargs_is_call_argument_ignored_succeed
     ASSERT_ARE_EQUAL(int, expected_ignored, is_ignored);
 }
 
+/* umockautoignoreargs_get_ignored_mask */
+
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_014: [ If call or is_argument_ignored is NULL or argument_count is 0, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockautoignoreargs_get_ignored_mask_with_NULL_call_fails)
+{
+    // arrange
+    int result;
+    int is_ignored[1];
+
+    // act
+    result = umockautoignoreargs_get_ignored_mask(NULL, 1, is_ignored);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_014: [ If call or is_argument_ignored is NULL or argument_count is 0, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockautoignoreargs_get_ignored_mask_with_0_argument_count_fails)
+{
+    // arrange
+    int result;
+    int is_ignored[1];
+
+    // act
+    result = umockautoignoreargs_get_ignored_mask("a(IGNORED_ARG)", 0, is_ignored);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_014: [ If call or is_argument_ignored is NULL or argument_count is 0, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockautoignoreargs_get_ignored_mask_with_NULL_is_argument_ignored_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umockautoignoreargs_get_ignored_mask("a(IGNORED_ARG)", 1, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_016: [ umockautoignoreargs_get_ignored_mask shall parse call with the same rules as umockautoignoreargs_is_call_argument_ignored. ]*/
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_017: [ If parsing call fails or call has less than argument_count arguments, umockautoignoreargs_get_ignored_mask shall fail and return a non-zero value. ]*/
+PARAMETERIZED_TEST_FUNCTION(umockautoignoreargs_get_ignored_mask_fails,
+    ARGS(const char*, call_str, size_t, arg_count),
+    CASE(("a", 1), when_no_lparen_is_found),
+    CASE(("", 1), with_empty_call),
+    CASE(("a()", 1), for_1_arg_when_no_args_in_call),
+    CASE(("a(x, y)", 3), for_3_args_when_2_args_in_call),
+    CASE(("WRAPPER(a)(IGNORED_ARG(", 1), when_RPAREN_missing_at_end),
+    CASE(("WRAPPER(a)(IGNORED_ARG)(", 1), when_extra_LPAREN_at_end),
+    CASE(("IGNORED_ARG, (0))", 1), with_not_enough_LPARENs_for_args))
+{
+    // arrange
+    int result;
+    int is_ignored[3];
+
+    // act
+    result = umockautoignoreargs_get_ignored_mask(call_str, arg_count, is_ignored);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_013: [ umockautoignoreargs_get_ignored_mask shall determine for each of the first argument_count arguments of call whether it shall be ignored, parsing call only once. ]*/
+/* Tests_SRS_UMOCKAUTOIGNOREARGS_01_015: [ On success, umockautoignoreargs_get_ignored_mask shall set is_argument_ignored[i] to 1 if argument i + 1 is ignored (as for umockautoignoreargs_is_call_argument_ignored) and to 0 otherwise, and return 0. ]*/
+PARAMETERIZED_TEST_FUNCTION(umockautoignoreargs_get_ignored_mask_succeeds,
+    ARGS(const char*, call_str, size_t, arg_count, int, expected_ignored_1, int, expected_ignored_2, int, expected_ignored_3),
+    CASE(("a(IGNORED_ARG)", 1, 1, -1, -1), with_1_IGNORED_ARG),
+    CASE(("a(xx)", 1, 0, -1, -1), with_1_arg_not_ignored),
+    CASE(("a(\"a\", IGNORED_ARG, 3)", 3, 0, 1, 0), with_IGNORED_ARG_in_the_middle),
+    CASE(("a(IGNORED_ARG, b(1,2), IGNORED_ARG)", 3, 1, 0, 1), with_function_call_arg),
+    CASE(("a( {1,2} , IGNORED_STRUCT_ARG(struct) ,IGNORED_ARG )", 3, 0, 1, 1), with_structure_and_spaces),
+    CASE(("WRAPPER(a)(IGNORED_ARG, (0), x)", 3, 1, 0, 0), with_other_parens_in_call),
+    CASE(("a(IGNORED_ARG, x, y)", 2, 1, 0, -1), with_more_args_than_argument_count))
+{
+    // arrange
+    int result;
+    int is_ignored[3] = { -1, -1, -1 };
+
+    // act
+    result = umockautoignoreargs_get_ignored_mask(call_str, arg_count, is_ignored);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, expected_ignored_1, is_ignored[0]);
+    ASSERT_ARE_EQUAL(int, expected_ignored_2, is_ignored[1]);
+    ASSERT_ARE_EQUAL(int, expected_ignored_3, is_ignored[2]);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -8,8 +8,10 @@ void* mock_realloc(void* ptr, size_t size);
 void mock_free(void* ptr);
 
 #define umockalloc_malloc(size) mock_malloc(size)
+#define umockalloc_call_malloc(size) mock_malloc(size)
 #define umockalloc_realloc(ptr, size) mock_realloc(ptr, size)
 #define umockalloc_free(ptr) mock_free(ptr)
 
 /* include code under test */
 #include "../../src/umockcall.c"
+#include "../../src/umockstringbuilder.c"
@@ -43,6 +43,16 @@ static test_mock_call_data_stringify_CALL* test_mock_call_data_stringify_calls;
 static size_t test_mock_call_data_stringify_call_count;
 static char* test_mock_call_data_stringify_expected_result = NULL;
 
+typedef struct test_mock_call_data_stringify_mismatch_CALL_TAG
+{
+    void* expected_umockcall_data;
+    void* actual_umockcall_data;
+} test_mock_call_data_stringify_mismatch_CALL;
+
+static test_mock_call_data_stringify_mismatch_CALL* test_mock_call_data_stringify_mismatch_calls;
+static size_t test_mock_call_data_stringify_mismatch_call_count;
+static char* test_mock_call_data_stringify_mismatch_expected_result;
+
 void* test_mock_call_data_copy(void* umockcall_data)
 {
     test_mock_call_data_copy_CALL* new_calls = realloc(test_mock_call_data_copy_calls, sizeof(test_mock_call_data_copy_CALL) * (test_mock_call_data_copy_call_count + 1));
@@ -91,6 +101,19 @@ int test_mock_call_data_are_equal(void* left, void* right)
     return test_mock_call_data_are_equal_expected_result;
 }
 
+char* test_mock_call_data_stringify_mismatch(void* expected_umockcall_data, void* actual_umockcall_data)
+{
+    test_mock_call_data_stringify_mismatch_CALL* new_calls = realloc(test_mock_call_data_stringify_mismatch_calls, sizeof(test_mock_call_data_stringify_mismatch_CALL) * (test_mock_call_data_stringify_mismatch_call_count + 1));
+    if (new_calls != NULL)
+    {
+        test_mock_call_data_stringify_mismatch_calls = new_calls;
+        test_mock_call_data_stringify_mismatch_calls[test_mock_call_data_stringify_mismatch_call_count].expected_umockcall_data = expected_umockcall_data;
+        test_mock_call_data_stringify_mismatch_calls[test_mock_call_data_stringify_mismatch_call_count].actual_umockcall_data = actual_umockcall_data;
+        test_mock_call_data_stringify_mismatch_call_count++;
+    }
+    return test_mock_call_data_stringify_mismatch_expected_result;
+}
+
 int another_test_mock_call_data_are_equal(void* left, void* right)
 {
     (void)left;
@@ -178,6 +201,10 @@ TEST_FUNCTION_INITIALIZE(test_function_init)
     test_mock_call_data_stringify_call_count = 0;
     test_mock_call_data_stringify_expected_result = NULL;
 
+    test_mock_call_data_stringify_mismatch_calls = NULL;
+    test_mock_call_data_stringify_mismatch_call_count = 0;
+    test_mock_call_data_stringify_mismatch_expected_result = "mismatch";
+
     reset_malloc_calls();
 }
 
@@ -198,6 +225,10 @@ TEST_FUNCTION_CLEANUP(test_function_cleanup)
     free(test_mock_call_data_stringify_calls);
     test_mock_call_data_stringify_calls = NULL;
     test_mock_call_data_stringify_call_count = 0;
+
+    free(test_mock_call_data_stringify_mismatch_calls);
+    test_mock_call_data_stringify_mismatch_calls = NULL;
+    test_mock_call_data_stringify_mismatch_call_count = 0;
 }
 
 /* umockcall_create */
@@ -317,6 +348,69 @@ TEST_FUNCTION(when_allocating_memory_for_the_function_name_fails_then_umockcall_
     ASSERT_IS_NULL(result);
 }
 
+/* umockcall_create_with_static_function_name */
+
+/* Tests_SRS_UMOCKCALL_01_057: [ umockcall_create_with_static_function_name shall create a new umock call instance like umockcall_create, but it shall keep a reference to function_name instead of copying it. ] */
+TEST_FUNCTION(umockcall_create_with_static_function_name_allocates_only_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    char* stringified;
+    reset_malloc_calls();
+
+    // act
+    result = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, malloc_call_count);
+    test_mock_call_data_stringify_expected_result = (char*)calloc(1, 1);
+    stringified = umockcall_stringify(result);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_function()]", stringified);
+
+    // cleanup
+    free(stringified);
+    umockcall_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_058: [ If any of the arguments are NULL, umockcall_create_with_static_function_name shall fail and return NULL. ] */
+TEST_FUNCTION(umockcall_create_with_static_function_name_with_NULL_function_name_fails)
+{
+    // arrange
+
+    // act
+    UMOCKCALL_HANDLE result = umockcall_create_with_static_function_name(NULL, (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_058: [ If any of the arguments are NULL, umockcall_create_with_static_function_name shall fail and return NULL. ] */
+TEST_FUNCTION(umockcall_create_with_static_function_name_with_NULL_call_data_fails)
+{
+    // arrange
+
+    // act
+    UMOCKCALL_HANDLE result = umockcall_create_with_static_function_name("test_function", NULL, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_059: [ If allocating memory for the umock call instance fails, umockcall_create_with_static_function_name shall return NULL. ] */
+TEST_FUNCTION(when_allocating_memory_for_the_call_fails_then_umockcall_create_with_static_function_name_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
 /* umockcall_destroy */
 
 /* Tests_SRS_UMOCKCALL_01_004: [ umockcall_destroy shall free a previously allocated umock call instance. ] */
@@ -348,6 +442,21 @@ TEST_FUNCTION(umockcall_destroy_with_NULL_argument_does_nothing)
     ASSERT_ARE_EQUAL(size_t, 0, free_call_count);
 }
 
+/* Tests_SRS_UMOCKCALL_01_060: [ umockcall_destroy shall not free the function name of a call created with umockcall_create_with_static_function_name. ]*/
+TEST_FUNCTION(umockcall_destroy_with_a_static_function_name_frees_only_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    reset_malloc_calls();
+
+    // act
+    umockcall_destroy(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_free_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, free_call_count);
+}
+
 /* umockcall_are_equal */
 
 /* Tests_SRS_UMOCKCALL_01_006: [ umockcall_are_equal shall compare the two mock calls and return whether they are equal or not. ] */
@@ -554,6 +663,72 @@ TEST_FUNCTION(when_the_are_equal_function_pointers_are_different_umockcall_are_e
     umockcall_destroy(call2);
 }
 
+/* Tests_SRS_UMOCKCALL_01_061: [ If both calls were created with umockcall_create_with_static_function_name, the function names shall be compared by comparing their pointers. ]*/
+TEST_FUNCTION(umockcall_are_equal_with_2_calls_with_the_same_static_function_name_returns_1)
+{
+    // arrange
+    static const char function_name[] = "test_function";
+    int result;
+    UMOCKCALL_HANDLE call1 = umockcall_create_with_static_function_name(function_name, (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call2 = umockcall_create_with_static_function_name(function_name, (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_are_equal_expected_result = 1;
+
+    // act
+    result = umockcall_are_equal(call1, call2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_are_equal_call_count);
+
+    // cleanup
+    umockcall_destroy(call1);
+    umockcall_destroy(call2);
+}
+
+/* Tests_SRS_UMOCKCALL_01_061: [ If both calls were created with umockcall_create_with_static_function_name, the function names shall be compared by comparing their pointers. ]*/
+TEST_FUNCTION(umockcall_are_equal_with_2_calls_with_different_static_function_names_returns_0)
+{
+    // arrange
+    static const char function_name_1[] = "test_function";
+    static const char function_name_2[] = "test_function";
+    int result;
+    UMOCKCALL_HANDLE call1 = umockcall_create_with_static_function_name(function_name_1, (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call2 = umockcall_create_with_static_function_name(function_name_2, (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_are_equal_expected_result = 1;
+
+    // act
+    result = umockcall_are_equal(call1, call2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_are_equal_call_count);
+
+    // cleanup
+    umockcall_destroy(call1);
+    umockcall_destroy(call2);
+}
+
+/* Tests_SRS_UMOCKCALL_01_025: [ If the function name does not match for the 2 calls, umockcall_are_equal shall return 0. ]*/
+TEST_FUNCTION(umockcall_are_equal_with_a_static_and_a_copied_function_name_compares_the_names)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call1 = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call2 = umockcall_create("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_are_equal_expected_result = 1;
+
+    // act
+    result = umockcall_are_equal(call1, call2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_are_equal_call_count);
+
+    // cleanup
+    umockcall_destroy(call1);
+    umockcall_destroy(call2);
+}
+
 /* umockcall_stringify */
 
 /* Tests_SRS_UMOCKCALL_01_016: [ umockcall_stringify shall return a string representation of the mock call in the form "[function_name(arguments)]". ] */
@@ -650,7 +825,7 @@ TEST_FUNCTION(when_allocating_memory_fails_then_umockcall_stringify_fails)
     ASSERT_IS_NOT_NULL(test_mock_call_data_stringify_expected_result);
     (void)memcpy(test_mock_call_data_stringify_expected_result, "45", sizeof("45"));
     reset_malloc_calls();
-    when_shall_malloc_fail = 1;
+    when_shall_realloc_fail = 1;
 
     // act
     result = umockcall_stringify(call);
@@ -664,623 +839,1562 @@ TEST_FUNCTION(when_allocating_memory_fails_then_umockcall_stringify_fails)
     umockcall_destroy(call);
 }
 
-/* umockcall_get_call_data */
-
-/* Tests_SRS_UMOCKCALL_01_022: [ umockcall_get_call_data shall return the associated umock call data that was passed to umockcall_create. ]*/
-TEST_FUNCTION(umockcall_get_call_data_returns_the_call_data_pointer)
+/* Tests_SRS_UMOCKCALL_01_063: [ umockcall_stringify shall build the string by calling umockcall_stringify_append with an empty string builder. ]*/
+TEST_FUNCTION(umockcall_stringify_allocates_the_result_only_once)
 {
     // arrange
+    char* result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_stringify_expected_result = malloc(strlen("45,46") + 1);
+    ASSERT_IS_NOT_NULL(test_mock_call_data_stringify_expected_result);
+    (void)memcpy(test_mock_call_data_stringify_expected_result, "45,46", sizeof("45,46"));
+    reset_malloc_calls();
 
     // act
-    void* result = umockcall_get_call_data(call);
+    result = umockcall_stringify(call);
 
     // assert
-    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, result);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_function(45,46)]", result);
+    ASSERT_ARE_EQUAL(size_t, 0, malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
 
     // cleanup
+    free(result);
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_023: [ If umockcall is NULL, umockcall_get_call_data shall return NULL. ]*/
-TEST_FUNCTION(umockcall_get_call_data_with_NULL_returns_NULL)
-{
-    // arrange
-
-    // act
-    void* result = umockcall_get_call_data(NULL);
-
-    // assert
-    ASSERT_IS_NULL(result);
-}
-
-/* umockcall_clone */
+/* umockcall_stringify_append */
 
-/* Tests_SRS_UMOCKCALL_01_031: [ umockcall_clone shall clone a umock call and on success it shall return a handle to the newly cloned call. ] */
-/* Tests_SRS_UMOCKCALL_01_033: [ The call data shall be cloned by calling the umockcall_data_copy function passed in umockcall_create and passing as argument the umockcall_data value passed in umockcall_create. ]*/
-/* Tests_SRS_UMOCKCALL_01_035: [ umockcall_clone shall copy also the function name. ]*/
-/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
-TEST_FUNCTION(umockcall_clone_clones_the_call)
+/* Tests_SRS_UMOCKCALL_01_064: [ umockcall_stringify_append shall append the string representation of the mock call in the form "[function_name(arguments)]" to string_builder and on success return 0. ]*/
+TEST_FUNCTION(umockcall_stringify_append_appends_the_stringified_call)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
-    char* stringified;
+    int result;
+    UMOCKSTRINGBUILDER string_builder;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    test_mock_call_data_stringify_expected_result = malloc(strlen("45") + 1);
+    ASSERT_IS_NOT_NULL(test_mock_call_data_stringify_expected_result);
+    (void)memcpy(test_mock_call_data_stringify_expected_result, "45", sizeof("45"));
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "[a()]");
 
     // act
-    result = umockcall_clone(call);
+    result = umockcall_stringify_append(call, &string_builder);
 
     // assert
-    ASSERT_IS_NOT_NULL(result);
-    test_mock_call_data_stringify_expected_result = (char*)calloc(1, 1);
-    stringified = umockcall_stringify(result);
-    ASSERT_ARE_EQUAL(char_ptr, "[test_function()]", stringified);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][test_function(45)]", umockstringbuilder_get_string(&string_builder));
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_stringify_call_count);
 
     // cleanup
-    free(stringified);
+    umockstringbuilder_deinit(&string_builder);
     umockcall_destroy(call);
-    umockcall_destroy(result);
 }
 
-/* Tests_SRS_UMOCKCALL_01_032: [ If umockcall is NULL, umockcall_clone shall return NULL. ]*/
-TEST_FUNCTION(umockcall_clone_with_NULL_handle_returns_NULL)
+/* Tests_SRS_UMOCKCALL_01_065: [ If umockcall or string_builder is NULL, umockcall_stringify_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_stringify_append_with_NULL_umockcall_fails)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    int result;
+    UMOCKSTRINGBUILDER string_builder;
+    umockstringbuilder_init(&string_builder);
 
     // act
-    result = umockcall_clone(NULL);
+    result = umockcall_stringify_append(NULL, &string_builder);
 
     // assert
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(string_builder.buffer);
 }
 
-/* Tests_SRS_UMOCKCALL_01_043: [ If allocating memory for the new umock call fails, umockcall_clone shall return NULL. ]*/
-TEST_FUNCTION(when_allocating_memory_fails_umockcall_clone_fails)
+/* Tests_SRS_UMOCKCALL_01_065: [ If umockcall or string_builder is NULL, umockcall_stringify_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_stringify_append_with_NULL_string_builder_fails)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
+    int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    reset_malloc_calls();
-    when_shall_malloc_fail = 1;
 
     // act
-    result = umockcall_clone(call);
+    result = umockcall_stringify_append(call, NULL);
 
     // assert
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_call_count);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_034: [ If umockcall_data_copy fails then umockcall_clone shall return NULL. ]*/
-TEST_FUNCTION(when_umockcall_data_copy_fails_then_umockcall_clone_clones_the_call)
+/* Tests_SRS_UMOCKCALL_01_066: [ If the underlying umockcall_data_stringify call fails, umockcall_stringify_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_the_underlying_stringify_fails_umockcall_stringify_append_fails)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
+    int result;
+    UMOCKSTRINGBUILDER string_builder;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    test_mock_call_data_copy_expected_result = NULL;
+    test_mock_call_data_stringify_expected_result = NULL;
+    umockstringbuilder_init(&string_builder);
 
     // act
-    result = umockcall_clone(call);
+    result = umockcall_stringify_append(call, &string_builder);
 
     // assert
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
 
     // cleanup
+    umockstringbuilder_deinit(&string_builder);
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_036: [ If allocating memory for the function name fails, umockcall_clone shall return NULL. ]*/
-TEST_FUNCTION(when_allocating_memory_for_the_function_name_fails_umockcall_clone_fails)
+/* Tests_SRS_UMOCKCALL_01_067: [ If appending to string_builder fails, umockcall_stringify_append shall fail, leave the string in string_builder unchanged and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_string_builder_fails_umockcall_stringify_append_fails_and_keeps_the_string)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
+    int result;
+    UMOCKSTRINGBUILDER string_builder;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_stringify_expected_result = malloc(strlen("45") + 1);
+    ASSERT_IS_NOT_NULL(test_mock_call_data_stringify_expected_result);
+    (void)memcpy(test_mock_call_data_stringify_expected_result, "45", sizeof("45"));
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "[a()]");
     reset_malloc_calls();
-    when_shall_malloc_fail = 2;
+    when_shall_realloc_fail = 1;
 
     // act
-    result = umockcall_clone(call);
+    result = umockcall_stringify_append(call, &string_builder);
 
     // assert
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", umockstringbuilder_get_string(&string_builder));
+    ASSERT_ARE_EQUAL(size_t, 1, free_call_count);
 
     // cleanup
+    umockstringbuilder_deinit(&string_builder);
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
-TEST_FUNCTION(umockcall_are_equal_on_2_clones_calls_succeeds)
+/* umockcall_stringify_mismatch */
+
+/* Tests_SRS_UMOCKCALL_01_099: [ umockcall_stringify_mismatch shall call the stringify mismatch function of expected_umockcall, passing to it the call data of expected_umockcall and actual_umockcall, and return its result. ]*/
+TEST_FUNCTION(umockcall_stringify_mismatch_calls_the_stringify_mismatch_function_of_the_expected_call)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
-    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    char* result;
+    UMOCKCALL_HANDLE expected_call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE actual_call = umockcall_create("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(expected_call, test_mock_call_data_stringify_mismatch);
 
     // act
-    result = umockcall_clone(call);
+    result = umockcall_stringify_mismatch(expected_call, actual_call);
 
     // assert
-    ASSERT_IS_NOT_NULL(result);
-    test_mock_call_data_are_equal_expected_result = 1;
-    ASSERT_ARE_EQUAL(int, 1, umockcall_are_equal(result, call));
+    ASSERT_ARE_EQUAL(char_ptr, "mismatch", result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_stringify_mismatch_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, test_mock_call_data_stringify_mismatch_calls[0].expected_umockcall_data);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, test_mock_call_data_stringify_mismatch_calls[0].actual_umockcall_data);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_are_equal_call_count);
 
     // cleanup
-    umockcall_destroy(call);
-    umockcall_destroy(result);
+    umockcall_destroy(expected_call);
+    umockcall_destroy(actual_call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
-TEST_FUNCTION(umockcall_clone_on_a_cloned_call_succeeds)
+/* Tests_SRS_UMOCKCALL_01_099: [ umockcall_stringify_mismatch shall call the stringify mismatch function of expected_umockcall, passing to it the call data of expected_umockcall and actual_umockcall, and return its result. ]*/
+TEST_FUNCTION(when_the_stringify_mismatch_function_returns_NULL_umockcall_stringify_mismatch_returns_NULL)
 {
     // arrange
-    UMOCKCALL_HANDLE result;
-    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    UMOCKCALL_HANDLE call2;
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    call2 = umockcall_clone(call);
-    test_mock_call_data_copy_expected_result = (void*)0x4244;
+    char* result;
+    UMOCKCALL_HANDLE expected_call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE actual_call = umockcall_create("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(expected_call, test_mock_call_data_stringify_mismatch);
+    test_mock_call_data_stringify_mismatch_expected_result = NULL;
 
     // act
-    result = umockcall_clone(call2);
+    result = umockcall_stringify_mismatch(expected_call, actual_call);
 
     // assert
-    ASSERT_IS_NOT_NULL(result);
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_stringify_mismatch_call_count);
 
     // cleanup
-    umockcall_destroy(call);
-    umockcall_destroy(call2);
-    umockcall_destroy(result);
+    umockcall_destroy(expected_call);
+    umockcall_destroy(actual_call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
-TEST_FUNCTION(freeing_a_cloned_call_succeeds)
+/* Tests_SRS_UMOCKCALL_01_100: [ If expected_umockcall or actual_umockcall is NULL, umockcall_stringify_mismatch shall return NULL. ]*/
+TEST_FUNCTION(umockcall_stringify_mismatch_with_NULL_calls_returns_NULL)
 {
     // arrange
-    UMOCKCALL_HANDLE cloned_call;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
+    (void)umockcall_set_stringify_mismatch(call, test_mock_call_data_stringify_mismatch);
 
     // act
-    umockcall_destroy(cloned_call);
-
     // assert
-    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_free_call_count);
+    ASSERT_IS_NULL(umockcall_stringify_mismatch(NULL, call));
+    ASSERT_IS_NULL(umockcall_stringify_mismatch(call, NULL));
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* umockcall_set_fail_call */
-
-/* Tests_SRS_UMOCKCALL_01_038: [ umockcall_set_fail_call shall store the fail_call value, associating it with the umockcall call instance. ]*/
-/* Tests_SRS_UMOCKCALL_01_044: [ On success umockcall_set_fail_call shall return 0. ]*/
-TEST_FUNCTION(umockcall_set_fail_call_sets_the_fail_call_property)
+/* Tests_SRS_UMOCKCALL_01_101: [ If expected_umockcall has no stringify mismatch function, or the 2 calls have different are_equal functions or function names, umockcall_stringify_mismatch shall return NULL. ]*/
+TEST_FUNCTION(umockcall_stringify_mismatch_for_an_expected_call_without_a_stringify_mismatch_function_returns_NULL)
 {
     // arrange
-    int result;
-    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    char* result;
+    UMOCKCALL_HANDLE expected_call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE actual_call = umockcall_create("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(actual_call, test_mock_call_data_stringify_mismatch);
 
     // act
-    result = umockcall_set_fail_call(call, 1);
+    result = umockcall_stringify_mismatch(expected_call, actual_call);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
+
+    // cleanup
+    umockcall_destroy(expected_call);
+    umockcall_destroy(actual_call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_101: [ If expected_umockcall has no stringify mismatch function, or the 2 calls have different are_equal functions or function names, umockcall_stringify_mismatch shall return NULL. ]*/
+TEST_FUNCTION(umockcall_stringify_mismatch_for_calls_of_different_functions_returns_NULL)
+{
+    // arrange
+    char* result;
+    UMOCKCALL_HANDLE expected_call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE actual_call = umockcall_create("another_test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(expected_call, test_mock_call_data_stringify_mismatch);
+
+    // act
+    result = umockcall_stringify_mismatch(expected_call, actual_call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
+
+    // cleanup
+    umockcall_destroy(expected_call);
+    umockcall_destroy(actual_call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_101: [ If expected_umockcall has no stringify mismatch function, or the 2 calls have different are_equal functions or function names, umockcall_stringify_mismatch shall return NULL. ]*/
+TEST_FUNCTION(umockcall_stringify_mismatch_for_calls_with_different_are_equal_functions_returns_NULL)
+{
+    // arrange
+    char* result;
+    UMOCKCALL_HANDLE expected_call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE actual_call = umockcall_create("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, another_test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(expected_call, test_mock_call_data_stringify_mismatch);
+
+    // act
+    result = umockcall_stringify_mismatch(expected_call, actual_call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
+
+    // cleanup
+    umockcall_destroy(expected_call);
+    umockcall_destroy(actual_call);
+}
+
+/* umockcall_get_call_data */
+
+/* Tests_SRS_UMOCKCALL_01_022: [ umockcall_get_call_data shall return the associated umock call data that was passed to umockcall_create. ]*/
+TEST_FUNCTION(umockcall_get_call_data_returns_the_call_data_pointer)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    void* result = umockcall_get_call_data(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_023: [ If umockcall is NULL, umockcall_get_call_data shall return NULL. ]*/
+TEST_FUNCTION(umockcall_get_call_data_with_NULL_returns_NULL)
+{
+    // arrange
+
+    // act
+    void* result = umockcall_get_call_data(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* umockcall_clone */
+
+/* Tests_SRS_UMOCKCALL_01_031: [ umockcall_clone shall clone a umock call and on success it shall return a handle to the newly cloned call. ] */
+/* Tests_SRS_UMOCKCALL_01_033: [ The call data shall be cloned by calling the umockcall_data_copy function passed in umockcall_create and passing as argument the umockcall_data value passed in umockcall_create. ]*/
+/* Tests_SRS_UMOCKCALL_01_035: [ umockcall_clone shall copy also the function name. ]*/
+/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
+TEST_FUNCTION(umockcall_clone_clones_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    char* stringified;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    test_mock_call_data_stringify_expected_result = (char*)calloc(1, 1);
+    stringified = umockcall_stringify(result);
+    ASSERT_ARE_EQUAL(char_ptr, "[test_function()]", stringified);
+
+    // cleanup
+    free(stringified);
+    umockcall_destroy(call);
+    umockcall_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_098: [ umockcall_clone shall also copy the stringify mismatch function. ]*/
+TEST_FUNCTION(umockcall_clone_copies_the_stringify_mismatch_function)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_stringify_mismatch(call, test_mock_call_data_stringify_mismatch);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, "mismatch", umockcall_stringify_mismatch(result, call));
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_stringify_mismatch_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, test_mock_call_data_stringify_mismatch_calls[0].expected_umockcall_data);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_032: [ If umockcall is NULL, umockcall_clone shall return NULL. ]*/
+TEST_FUNCTION(umockcall_clone_with_NULL_handle_returns_NULL)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+
+    // act
+    result = umockcall_clone(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_043: [ If allocating memory for the new umock call fails, umockcall_clone shall return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umockcall_clone_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    reset_malloc_calls();
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_034: [ If umockcall_data_copy fails then umockcall_clone shall return NULL. ]*/
+TEST_FUNCTION(when_umockcall_data_copy_fails_then_umockcall_clone_clones_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = NULL;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_036: [ If allocating memory for the function name fails, umockcall_clone shall return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_function_name_fails_umockcall_clone_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    reset_malloc_calls();
+    when_shall_malloc_fail = 2;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
+TEST_FUNCTION(umockcall_are_equal_on_2_clones_calls_succeeds)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    test_mock_call_data_are_equal_expected_result = 1;
+    ASSERT_ARE_EQUAL(int, 1, umockcall_are_equal(result, call));
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
+TEST_FUNCTION(umockcall_clone_on_a_cloned_call_succeeds)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call2;
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    call2 = umockcall_clone(call);
+    test_mock_call_data_copy_expected_result = (void*)0x4244;
+
+    // act
+    result = umockcall_clone(call2);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(call2);
+    umockcall_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_037: [ umockcall_clone shall also copy all the functions passed to umockcall_create (umockcall_data_copy, umockcall_data_free, umockcall_data_are_equal, umockcall_data_stringify). ]*/
+TEST_FUNCTION(freeing_a_cloned_call_succeeds)
+{
+    // arrange
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+
+    // act
+    umockcall_destroy(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_free_call_count);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_062: [ If umockcall was created with umockcall_create_with_static_function_name, umockcall_clone shall reference the same function name instead of copying it. ]*/
+TEST_FUNCTION(umockcall_clone_of_a_call_with_a_static_function_name_does_not_copy_the_name)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    reset_malloc_calls();
+
+    // act
+    result = umockcall_clone(call);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, malloc_call_count);
+    test_mock_call_data_are_equal_expected_result = 1;
+    ASSERT_ARE_EQUAL(int, 1, umockcall_are_equal(result, call));
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(result);
+}
+
+/* umockcall_share */
+
+/* Tests_SRS_UMOCKCALL_01_068: [ umockcall_share shall return a handle to a call equal to umockcall, owned by the caller and released by calling umockcall_destroy. ]*/
+/* Tests_SRS_UMOCKCALL_01_069: [ If umockcall was created by umockcall_clone, umockcall_share shall add a reference to it and return umockcall. ]*/
+TEST_FUNCTION(umockcall_share_on_a_cloned_call_returns_the_same_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+    reset_malloc_calls();
+
+    // act
+    result = umockcall_share(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, cloned_call, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_copy_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, malloc_call_count);
+
+    // cleanup
+    umockcall_destroy(result);
+    umockcall_destroy(cloned_call);
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_070: [ Otherwise umockcall_share shall return a copy of the call obtained by calling umockcall_clone. ]*/
+TEST_FUNCTION(umockcall_share_on_a_created_call_clones_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+
+    // act
+    result = umockcall_share(call);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, call, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_copy_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, umockcall_get_call_data(result));
+    ASSERT_ARE_EQUAL(int, 0, umockcall_is_shared(call));
+
+    // cleanup
+    umockcall_destroy(result);
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_072: [ If umockcall_clone fails, umockcall_share shall fail and return NULL. ]*/
+TEST_FUNCTION(when_umockcall_clone_fails_umockcall_share_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = NULL;
+
+    // act
+    result = umockcall_share(call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_071: [ If umockcall is NULL, umockcall_share shall fail and return NULL. ]*/
+TEST_FUNCTION(umockcall_share_with_NULL_umockcall_fails)
+{
+    // arrange
+
+    // act
+    UMOCKCALL_HANDLE result = umockcall_share(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_074: [ umockcall_destroy shall release one reference to the call and shall free the call only when the last reference is released. ]*/
+TEST_FUNCTION(umockcall_destroy_frees_a_shared_call_only_when_the_last_reference_is_released)
+{
+    // arrange
+    UMOCKCALL_HANDLE shared_call;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+    shared_call = umockcall_share(cloned_call);
+    umockcall_destroy(call);
+    test_mock_call_data_free_call_count = 0;
+    reset_malloc_calls();
+
+    // act
+    umockcall_destroy(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_free_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, free_call_count);
+    ASSERT_ARE_EQUAL(int, 0, umockcall_is_shared(shared_call));
+    umockcall_destroy(shared_call);
+    ASSERT_ARE_EQUAL(size_t, 1, test_mock_call_data_free_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4243, test_mock_call_data_free_calls[0].umockcall_data);
+}
+
+/* umockcall_is_shared */
+
+/* Tests_SRS_UMOCKCALL_01_075: [ umockcall_is_shared shall return 1 if umockcall has more than one owner and 0 otherwise. ]*/
+TEST_FUNCTION(umockcall_is_shared_returns_1_for_a_shared_call)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE shared_call;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+    shared_call = umockcall_share(cloned_call);
+
+    // act
+    result = umockcall_is_shared(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(shared_call);
+    umockcall_destroy(cloned_call);
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_075: [ umockcall_is_shared shall return 1 if umockcall has more than one owner and 0 otherwise. ]*/
+TEST_FUNCTION(umockcall_is_shared_returns_0_for_a_call_with_one_owner)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    result = umockcall_is_shared(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_076: [ If umockcall is NULL, umockcall_is_shared shall return -1. ]*/
+TEST_FUNCTION(umockcall_is_shared_with_NULL_umockcall_returns_minus_1)
+{
+    // arrange
+
+    // act
+    int result = umockcall_is_shared(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, -1, result);
+}
+
+/* umockcall_set_fail_call */
+
+/* Tests_SRS_UMOCKCALL_01_038: [ umockcall_set_fail_call shall store the fail_call value, associating it with the umockcall call instance. ]*/
+/* Tests_SRS_UMOCKCALL_01_044: [ On success umockcall_set_fail_call shall return 0. ]*/
+TEST_FUNCTION(umockcall_set_fail_call_sets_the_fail_call_property)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    result = umockcall_set_fail_call(call, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(int, 1, umockcall_get_fail_call(call));
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_039: [ If umockcall is NULL, umockcall_set_fail_call shall return a non-zero value. ]*/
-TEST_FUNCTION(umockcall_set_fail_call_with_NULL_fails)
+/* Tests_SRS_UMOCKCALL_01_039: [ If umockcall is NULL, umockcall_set_fail_call shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_fail_call_with_NULL_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcall_set_fail_call(NULL, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_040: [ If a value different than 0 and 1 is passed as fail_call, umockcall_set_fail_call shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_fail_call_with_an_invalid_fail_call_value_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    int result = umockcall_set_fail_call(call, 2);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* umockcall_get_fail_call */
+
+/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_fail_call_retrieves_0)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_fail_call(call, 0);
+
+    // act
+    result = umockcall_get_fail_call(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_fail_call_retrieves_1)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_fail_call(call, 1);
+
+    // act
+    result = umockcall_get_fail_call(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_042: [ If umockcall is NULL, umockcall_get_fail_call shall return -1. ]*/
+TEST_FUNCTION(umockcall_get_fail_call_with_NULL_call_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcall_get_fail_call(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, -1, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_fail_call_on_a_cloned_call_retrieves_1)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_fail_call(call, 1);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+
+    // act
+    result = umockcall_get_fail_call(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_fail_call_on_a_cloned_call_retrieves_0)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_fail_call(call, 0);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+
+    // act
+    result = umockcall_get_fail_call(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
+}
+
+/* umockcall_set_ignore_all_calls */
+
+/* Tests_SRS_UMOCKCALL_01_045: [ umockcall_set_ignore_all_calls shall store the ignore_all_calls value, associating it with the umockcall call instance. ]*/
+/* Tests_SRS_UMOCKCALL_01_046: [ On success umockcall_set_ignore_all_calls shall return 0. ]*/
+TEST_FUNCTION(umockcall_set_ignore_all_calls_sets_the_ignore_all_calls_property)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    int result = umockcall_set_ignore_all_calls(call, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, umockcall_get_ignore_all_calls(call));
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_047: [ If umockcall is NULL, umockcall_set_ignore_all_calls shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_ignore_all_calls_with_NULL_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcall_set_ignore_all_calls(NULL, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_048: [ If a value different than 0 and 1 is passed as ignore_all_calls, umockcall_set_ignore_all_calls shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_ignore_all_calls_with_an_invalid_ignore_all_calls_value_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    int result = umockcall_set_ignore_all_calls(call, 2);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* umockcall_get_ignore_all_calls */
+
+/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_ignore_all_calls_retrieves_0)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_ignore_all_calls(call, 0);
+
+    // act
+    result = umockcall_get_ignore_all_calls(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_ignore_all_calls_retrieves_1)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_ignore_all_calls(call, 1);
+
+    // act
+    result = umockcall_get_ignore_all_calls(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_050: [ If umockcall is NULL, umockcall_get_ignore_all_calls shall return -1. ]*/
+TEST_FUNCTION(umockcall_get_ignore_all_calls_with_NULL_call_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcall_get_ignore_all_calls(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, -1, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_ignore_all_calls_on_a_cloned_call_retrieves_1)
+{
+    // arrange
+    UMOCKCALL_HANDLE cloned_call;
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_ignore_all_calls(call, 1);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+
+    // act
+    result = umockcall_get_ignore_all_calls(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_ignore_all_calls_on_a_cloned_call_retrieves_0)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE cloned_call;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_fail_call(call, 0);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
+
+    // act
+    result = umockcall_get_fail_call(cloned_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
+}
+
+
+/* umockcall_set_call_can_fail */
+
+/* Tests_SRS_UMOCKCALL_31_053: [ umockcall_set_call_can_fail shall store the call_can_fail value, associating it with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_set_call_can_fail_sets_the_can_fail_property)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    int result = umockcall_set_call_can_fail(call, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, umockcall_get_call_can_fail(call));
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_31_051: [ If umockcall is NULL, umockcall_set_call_can_fail shall return -1. ]*/
+TEST_FUNCTION(umockcall_set_call_can_fail_with_NULL_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcall_set_call_can_fail(NULL, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKCALL_31_052: [ If a value different than 0 and 1 is passed as umockcall_set_call_can_fail, umockcall_set_call_can_fail shall return -1. ]*/
+TEST_FUNCTION(umockcall_set_call_can_fail_with_an_invalid_set_can_fail_value_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    int result = umockcall_set_call_can_fail(call, 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, -1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* umockcall_get_call_can_fail */
+
+/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_call_can_fail_retrieves_0)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_call_can_fail(call, 0);
+
+    // act
+    result = umockcall_get_call_can_fail(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_call_can_fail_calls_retrieves_1)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_call_can_fail(call, 1);
+
+    // act
+    result = umockcall_get_call_can_fail(call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 1, result);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_31_054: [ If umockcall is NULL, umockcall_get_call_can_fail shall return -1. ]*/
+TEST_FUNCTION(umockcall_get_call_can_fail_with_NULL_call_fails)
 {
     // arrange
 
     // act
-    int result = umockcall_set_fail_call(NULL, 1);
+    int result = umockcall_get_call_can_fail(NULL);
 
     // assert
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, -1, result);
 }
 
-/* Tests_SRS_UMOCKCALL_01_040: [ If a value different than 0 and 1 is passed as fail_call, umockcall_set_fail_call shall return a non-zero value. ]*/
-TEST_FUNCTION(umockcall_set_fail_call_with_an_invalid_fail_call_value_fails)
+/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_call_can_fail_on_a_cloned_call_retrieves_1)
 {
     // arrange
+    UMOCKCALL_HANDLE cloned_call;
+    int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_call_can_fail(call, 1);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
 
     // act
-    int result = umockcall_set_fail_call(call, 2);
+    result = umockcall_get_call_can_fail(cloned_call);
 
     // assert
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, result);
 
     // cleanup
     umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
 }
 
-/* umockcall_get_fail_call */
-
-/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_fail_call_retrieves_0)
+/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_get_call_can_fail_on_a_cloned_call_retrieves_0)
 {
     // arrange
     int result;
+    UMOCKCALL_HANDLE cloned_call;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_fail_call(call, 0);
+    (void)umockcall_set_call_can_fail(call, 0);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
 
     // act
-    result = umockcall_get_fail_call(call);
+    result = umockcall_get_call_can_fail(cloned_call);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
 
     // cleanup
     umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_fail_call_retrieves_1)
+/* umockcall_set_has_call_results */
+
+/* Tests_SRS_UMOCKCALL_01_093: [ umockcall_create and umockcall_create_with_static_function_name shall set has_call_results to 0. ]*/
+TEST_FUNCTION(umockcall_create_sets_has_call_results_to_0)
 {
     // arrange
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_fail_call(call, 1);
 
     // act
-    result = umockcall_get_fail_call(call);
+    result = umockcall_get_has_call_results(call);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_042: [ If umockcall is NULL, umockcall_get_fail_call shall return -1. ]*/
-TEST_FUNCTION(umockcall_get_fail_call_with_NULL_call_fails)
+/* Tests_SRS_UMOCKCALL_01_088: [ umockcall_set_has_call_results shall store the has_call_results value, associating it with the umockcall call instance, and on success return 0. ]*/
+/* Tests_SRS_UMOCKCALL_01_091: [ umockcall_get_has_call_results shall retrieve the has_call_results value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_set_has_call_results_sets_the_has_call_results_property)
 {
     // arrange
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    int result = umockcall_get_fail_call(NULL);
+    int result = umockcall_set_has_call_results(call, 1);
 
     // assert
-    ASSERT_ARE_EQUAL(int, -1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, umockcall_get_has_call_results(call));
+
+    // cleanup
+    umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_fail_call_on_a_cloned_call_retrieves_1)
+/* Tests_SRS_UMOCKCALL_01_088: [ umockcall_set_has_call_results shall store the has_call_results value, associating it with the umockcall call instance, and on success return 0. ]*/
+/* Tests_SRS_UMOCKCALL_01_091: [ umockcall_get_has_call_results shall retrieve the has_call_results value, associated with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_set_has_call_results_with_0_clears_the_has_call_results_property)
 {
     // arrange
     int result;
-    UMOCKCALL_HANDLE cloned_call;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_fail_call(call, 1);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
+    (void)umockcall_set_has_call_results(call, 1);
 
     // act
-    result = umockcall_get_fail_call(cloned_call);
+    result = umockcall_set_has_call_results(call, 0);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_has_call_results(call));
 
     // cleanup
     umockcall_destroy(call);
-    umockcall_destroy(cloned_call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_fail_call_on_a_cloned_call_retrieves_0)
+/* Tests_SRS_UMOCKCALL_01_089: [ If umockcall is NULL, umockcall_set_has_call_results shall return -1. ]*/
+TEST_FUNCTION(umockcall_set_has_call_results_with_NULL_fails)
 {
     // arrange
-    int result;
-    UMOCKCALL_HANDLE cloned_call;
-    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_fail_call(call, 0);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
 
     // act
-    result = umockcall_get_fail_call(cloned_call);
+    int result = umockcall_set_has_call_results(NULL, 1);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
-
-    // cleanup
-    umockcall_destroy(call);
-    umockcall_destroy(cloned_call);
+    ASSERT_ARE_EQUAL(int, -1, result);
 }
 
-/* umockcall_set_ignore_all_calls */
-
-/* Tests_SRS_UMOCKCALL_01_045: [ umockcall_set_ignore_all_calls shall store the ignore_all_calls value, associating it with the umockcall call instance. ]*/
-/* Tests_SRS_UMOCKCALL_01_046: [ On success umockcall_set_ignore_all_calls shall return 0. ]*/
-TEST_FUNCTION(umockcall_set_ignore_all_calls_sets_the_ignore_all_calls_property)
+/* Tests_SRS_UMOCKCALL_01_090: [ If a value different than 0 and 1 is passed as has_call_results, umockcall_set_has_call_results shall return -1. ]*/
+TEST_FUNCTION(umockcall_set_has_call_results_with_an_invalid_value_fails)
 {
     // arrange
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    int result = umockcall_set_ignore_all_calls(call, 1);
+    int result = umockcall_set_has_call_results(call, 2);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(int, 1, umockcall_get_ignore_all_calls(call));
+    ASSERT_ARE_EQUAL(int, -1, result);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_047: [ If umockcall is NULL, umockcall_set_ignore_all_calls shall return a non-zero value. ]*/
-TEST_FUNCTION(umockcall_set_ignore_all_calls_with_NULL_fails)
+/* umockcall_get_has_call_results */
+
+/* Tests_SRS_UMOCKCALL_01_092: [ If umockcall is NULL, umockcall_get_has_call_results shall return -1. ]*/
+TEST_FUNCTION(umockcall_get_has_call_results_with_NULL_call_fails)
 {
     // arrange
 
     // act
-    int result = umockcall_set_ignore_all_calls(NULL, 1);
+    int result = umockcall_get_has_call_results(NULL);
 
     // assert
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, -1, result);
 }
 
-/* Tests_SRS_UMOCKCALL_01_048: [ If a value different than 0 and 1 is passed as ignore_all_calls, umockcall_set_ignore_all_calls shall return a non-zero value. ]*/
-TEST_FUNCTION(umockcall_set_ignore_all_calls_with_an_invalid_ignore_all_calls_value_fails)
+/* Tests_SRS_UMOCKCALL_01_094: [ umockcall_clone shall also copy has_call_results. ]*/
+TEST_FUNCTION(umockcall_get_has_call_results_on_a_cloned_call_retrieves_1)
 {
     // arrange
+    UMOCKCALL_HANDLE cloned_call;
+    int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    (void)umockcall_set_has_call_results(call, 1);
+    test_mock_call_data_copy_expected_result = (void*)0x4243;
+    cloned_call = umockcall_clone(call);
 
     // act
-    int result = umockcall_set_ignore_all_calls(call, 2);
+    result = umockcall_get_has_call_results(cloned_call);
 
     // assert
-    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, result);
 
     // cleanup
     umockcall_destroy(call);
+    umockcall_destroy(cloned_call);
 }
 
-/* umockcall_get_ignore_all_calls */
+/* umockcall_set_stringify_mismatch */
 
-/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_ignore_all_calls_retrieves_0)
+/* Tests_SRS_UMOCKCALL_01_095: [ umockcall_create and umockcall_create_with_static_function_name shall create the call without a stringify mismatch function. ]*/
+TEST_FUNCTION(umockcall_create_with_static_function_name_creates_the_call_without_a_stringify_mismatch_function)
+{
+    // arrange
+    char* result;
+    UMOCKCALL_HANDLE call = umockcall_create_with_static_function_name("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    result = umockcall_stringify_mismatch(call, call);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_096: [ umockcall_set_stringify_mismatch shall store umockcall_data_stringify_mismatch, associating it with the umockcall call instance, and on success return 0. ]*/
+TEST_FUNCTION(umockcall_set_stringify_mismatch_sets_the_stringify_mismatch_function)
 {
     // arrange
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_ignore_all_calls(call, 0);
 
     // act
-    result = umockcall_get_ignore_all_calls(call);
+    result = umockcall_set_stringify_mismatch(call, test_mock_call_data_stringify_mismatch);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "mismatch", umockcall_stringify_mismatch(call, call));
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_ignore_all_calls_retrieves_1)
+/* Tests_SRS_UMOCKCALL_01_096: [ umockcall_set_stringify_mismatch shall store umockcall_data_stringify_mismatch, associating it with the umockcall call instance, and on success return 0. ]*/
+TEST_FUNCTION(umockcall_set_stringify_mismatch_with_NULL_removes_the_stringify_mismatch_function)
 {
     // arrange
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_ignore_all_calls(call, 1);
+    (void)umockcall_set_stringify_mismatch(call, test_mock_call_data_stringify_mismatch);
 
     // act
-    result = umockcall_get_ignore_all_calls(call);
+    result = umockcall_set_stringify_mismatch(call, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(umockcall_stringify_mismatch(call, call));
+    ASSERT_ARE_EQUAL(size_t, 0, test_mock_call_data_stringify_mismatch_call_count);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_050: [ If umockcall is NULL, umockcall_get_ignore_all_calls shall return -1. ]*/
-TEST_FUNCTION(umockcall_get_ignore_all_calls_with_NULL_call_fails)
+/* Tests_SRS_UMOCKCALL_01_097: [ If umockcall is NULL, umockcall_set_stringify_mismatch shall return -1. ]*/
+TEST_FUNCTION(umockcall_set_stringify_mismatch_with_NULL_umockcall_fails)
 {
     // arrange
 
     // act
-    int result = umockcall_get_ignore_all_calls(NULL);
+    int result = umockcall_set_stringify_mismatch(NULL, test_mock_call_data_stringify_mismatch);
 
     // assert
     ASSERT_ARE_EQUAL(int, -1, result);
 }
 
-/* Tests_SRS_UMOCKCALL_01_041: [ umockcall_get_fail_call shall retrieve the fail_call value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_ignore_all_calls_on_a_cloned_call_retrieves_1)
+/* umockcall_set_repeat_count */
+
+/* Tests_SRS_UMOCKCALL_01_077: [ umockcall_create and umockcall_create_with_static_function_name shall set the minimum and maximum repeat counts of the call to 1. ]*/
+TEST_FUNCTION(umockcall_create_sets_the_repeat_count_to_1)
 {
     // arrange
-    UMOCKCALL_HANDLE cloned_call;
+    size_t min_repeat_count;
+    size_t max_repeat_count;
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_ignore_all_calls(call, 1);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
 
     // act
-    result = umockcall_get_ignore_all_calls(cloned_call);
+    result = umockcall_get_repeat_count(call, &min_repeat_count, &max_repeat_count);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, min_repeat_count);
+    ASSERT_ARE_EQUAL(size_t, 1, max_repeat_count);
 
     // cleanup
     umockcall_destroy(call);
-    umockcall_destroy(cloned_call);
 }
 
-/* Tests_SRS_UMOCKCALL_01_049: [ umockcall_get_ignore_all_calls shall retrieve the ignore_all_calls value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_ignore_all_calls_on_a_cloned_call_retrieves_0)
+/* Tests_SRS_UMOCKCALL_01_078: [ umockcall_set_repeat_count shall store the min_repeat_count and max_repeat_count values, associating them with the umockcall call instance. ]*/
+/* Tests_SRS_UMOCKCALL_01_079: [ On success umockcall_set_repeat_count shall return 0. ]*/
+/* Tests_SRS_UMOCKCALL_01_082: [ umockcall_get_repeat_count shall retrieve the min_repeat_count and max_repeat_count values associated with the umockcall call instance and on success return 0. ]*/
+TEST_FUNCTION(umockcall_set_repeat_count_sets_the_repeat_count)
 {
     // arrange
+    size_t min_repeat_count;
+    size_t max_repeat_count;
     int result;
-    UMOCKCALL_HANDLE cloned_call;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_fail_call(call, 0);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
 
     // act
-    result = umockcall_get_fail_call(cloned_call);
+    result = umockcall_set_repeat_count(call, 3, 42);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_repeat_count(call, &min_repeat_count, &max_repeat_count));
+    ASSERT_ARE_EQUAL(size_t, 3, min_repeat_count);
+    ASSERT_ARE_EQUAL(size_t, 42, max_repeat_count);
 
     // cleanup
     umockcall_destroy(call);
-    umockcall_destroy(cloned_call);
 }
 
-
-/* umockcall_set_call_can_fail */
-
-/* Tests_SRS_UMOCKCALL_31_053: [ umockcall_set_call_can_fail shall store the call_can_fail value, associating it with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_set_call_can_fail_sets_the_can_fail_property)
+/* Tests_SRS_UMOCKCALL_01_078: [ umockcall_set_repeat_count shall store the min_repeat_count and max_repeat_count values, associating them with the umockcall call instance. ]*/
+TEST_FUNCTION(umockcall_set_repeat_count_with_0_min_and_unlimited_max_succeeds)
 {
     // arrange
+    size_t min_repeat_count;
+    size_t max_repeat_count;
+    int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    int result = umockcall_set_call_can_fail(call, 1);
+    result = umockcall_set_repeat_count(call, 0, UMOCKCALL_UNLIMITED_REPEAT_COUNT);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(int, 1, umockcall_get_call_can_fail(call));
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_repeat_count(call, &min_repeat_count, &max_repeat_count));
+    ASSERT_ARE_EQUAL(size_t, 0, min_repeat_count);
+    ASSERT_ARE_EQUAL(size_t, UMOCKCALL_UNLIMITED_REPEAT_COUNT, max_repeat_count);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_31_051: [ If umockcall is NULL, umockcall_set_call_can_fail shall return -1. ]*/
-TEST_FUNCTION(umockcall_set_call_can_fail_with_NULL_fails)
+/* Tests_SRS_UMOCKCALL_01_080: [ If umockcall is NULL, umockcall_set_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_repeat_count_with_NULL_call_fails)
 {
     // arrange
 
     // act
-    int result = umockcall_set_call_can_fail(NULL, 1);
+    int result = umockcall_set_repeat_count(NULL, 1, 1);
 
     // assert
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
 }
 
-/* Tests_SRS_UMOCKCALL_31_052: [ If a value different than 0 and 1 is passed as umockcall_set_call_can_fail, umockcall_set_call_can_fail shall return -1. ]*/
-TEST_FUNCTION(umockcall_set_call_can_fail_with_an_invalid_set_can_fail_value_fails)
+/* Tests_SRS_UMOCKCALL_01_081: [ If max_repeat_count is 0 or min_repeat_count is greater than max_repeat_count, umockcall_set_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_repeat_count_with_0_max_fails)
 {
     // arrange
+    size_t min_repeat_count;
+    size_t max_repeat_count;
+    int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    int result = umockcall_set_call_can_fail(call, 2);
+    result = umockcall_set_repeat_count(call, 0, 0);
 
     // assert
-    ASSERT_ARE_EQUAL(int, -1, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_repeat_count(call, &min_repeat_count, &max_repeat_count));
+    ASSERT_ARE_EQUAL(size_t, 1, min_repeat_count);
+    ASSERT_ARE_EQUAL(size_t, 1, max_repeat_count);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* umockcall_get_call_can_fail */
-
-/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_call_can_fail_retrieves_0)
+/* Tests_SRS_UMOCKCALL_01_081: [ If max_repeat_count is 0 or min_repeat_count is greater than max_repeat_count, umockcall_set_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_set_repeat_count_with_min_greater_than_max_fails)
 {
     // arrange
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_call_can_fail(call, 0);
 
     // act
-    result = umockcall_get_call_can_fail(call);
+    result = umockcall_set_repeat_count(call, 3, 2);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_call_can_fail_calls_retrieves_1)
+/* umockcall_get_repeat_count */
+
+/* Tests_SRS_UMOCKCALL_01_083: [ If any of the arguments is NULL, umockcall_get_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_get_repeat_count_with_NULL_call_fails)
+{
+    // arrange
+    size_t min_repeat_count;
+    size_t max_repeat_count;
+
+    // act
+    int result = umockcall_get_repeat_count(NULL, &min_repeat_count, &max_repeat_count);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_083: [ If any of the arguments is NULL, umockcall_get_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_get_repeat_count_with_NULL_min_repeat_count_fails)
 {
     // arrange
+    size_t max_repeat_count;
     int result;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_call_can_fail(call, 1);
 
     // act
-    result = umockcall_get_call_can_fail(call);
+    result = umockcall_get_repeat_count(call, NULL, &max_repeat_count);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_31_054: [ If umockcall is NULL, umockcall_get_call_can_fail shall return -1. ]*/
-TEST_FUNCTION(umockcall_get_call_can_fail_with_NULL_call_fails)
+/* Tests_SRS_UMOCKCALL_01_083: [ If any of the arguments is NULL, umockcall_get_repeat_count shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_get_repeat_count_with_NULL_max_repeat_count_fails)
 {
     // arrange
+    size_t min_repeat_count;
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    int result = umockcall_get_call_can_fail(NULL);
+    result = umockcall_get_repeat_count(call, &min_repeat_count, NULL);
 
     // assert
-    ASSERT_ARE_EQUAL(int, -1, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcall_destroy(call);
 }
 
-/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_call_can_fail_on_a_cloned_call_retrieves_1)
+/* Tests_SRS_UMOCKCALL_01_084: [ umockcall_clone shall also copy the minimum and maximum repeat counts. ]*/
+TEST_FUNCTION(umockcall_get_repeat_count_on_a_cloned_call_retrieves_the_repeat_count)
 {
     // arrange
-    UMOCKCALL_HANDLE cloned_call;
+    size_t min_repeat_count;
+    size_t max_repeat_count;
     int result;
+    UMOCKCALL_HANDLE cloned_call;
     UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_call_can_fail(call, 1);
+    (void)umockcall_set_repeat_count(call, 2, 5);
     test_mock_call_data_copy_expected_result = (void*)0x4243;
     cloned_call = umockcall_clone(call);
 
     // act
-    result = umockcall_get_call_can_fail(cloned_call);
+    result = umockcall_get_repeat_count(cloned_call, &min_repeat_count, &max_repeat_count);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 1, result);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, min_repeat_count);
+    ASSERT_ARE_EQUAL(size_t, 5, max_repeat_count);
 
     // cleanup
     umockcall_destroy(call);
     umockcall_destroy(cloned_call);
 }
 
-/* Tests_SRS_UMOCKCALL_31_055: [ umockcall_get_call_can_fail shall retrieve the call_can_fail value, associated with the umockcall call instance. ]*/
-TEST_FUNCTION(umockcall_get_call_can_fail_on_a_cloned_call_retrieves_0)
+/* umockcall_get_function_name_hash */
+
+/* Tests_SRS_UMOCKCALL_01_085: [ umockcall_get_function_name_hash shall compute the FNV-1a hash of the function name of umockcall, store it in function_name_hash and on success return 0. ]*/
+TEST_FUNCTION(umockcall_get_function_name_hash_computes_the_FNV_1a_hash_of_the_function_name)
 {
     // arrange
+    size_t function_name_hash;
     int result;
-    UMOCKCALL_HANDLE cloned_call;
-    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
-    (void)umockcall_set_call_can_fail(call, 0);
-    test_mock_call_data_copy_expected_result = (void*)0x4243;
-    cloned_call = umockcall_clone(call);
+    UMOCKCALL_HANDLE call = umockcall_create("a", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
 
     // act
-    result = umockcall_get_call_can_fail(cloned_call);
+    result = umockcall_get_function_name_hash(call, &function_name_hash);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, (((size_t)2166136261U) ^ (size_t)'a') * (size_t)16777619U, function_name_hash);
+
+    // cleanup
+    umockcall_destroy(call);
+}
+
+/* Tests_SRS_UMOCKCALL_01_086: [ Calls with equal function names shall have equal hashes. ]*/
+TEST_FUNCTION(umockcall_get_function_name_hash_for_calls_with_the_same_function_name_returns_the_same_hash)
+{
+    // arrange
+    size_t function_name_hash_1;
+    size_t function_name_hash_2;
+    size_t function_name_hash_3;
+    UMOCKCALL_HANDLE call_1 = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call_2 = umockcall_create_with_static_function_name("test_function", (void*)0x4243, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+    UMOCKCALL_HANDLE call_3 = umockcall_create("test_function_2", (void*)0x4244, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_function_name_hash(call_1, &function_name_hash_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_function_name_hash(call_2, &function_name_hash_2));
+    ASSERT_ARE_EQUAL(int, 0, umockcall_get_function_name_hash(call_3, &function_name_hash_3));
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, function_name_hash_1, function_name_hash_2);
+    ASSERT_ARE_NOT_EQUAL(size_t, function_name_hash_1, function_name_hash_3);
+
+    // cleanup
+    umockcall_destroy(call_1);
+    umockcall_destroy(call_2);
+    umockcall_destroy(call_3);
+}
+
+/* Tests_SRS_UMOCKCALL_01_087: [ If any of the arguments is NULL, umockcall_get_function_name_hash shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_get_function_name_hash_with_NULL_call_fails)
+{
+    // arrange
+    size_t function_name_hash;
+    int result;
+
+    // act
+    result = umockcall_get_function_name_hash(NULL, &function_name_hash);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKCALL_01_087: [ If any of the arguments is NULL, umockcall_get_function_name_hash shall return a non-zero value. ]*/
+TEST_FUNCTION(umockcall_get_function_name_hash_with_NULL_function_name_hash_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALL_HANDLE call = umockcall_create("test_function", (void*)0x4242, test_mock_call_data_copy, test_mock_call_data_free, test_mock_call_data_stringify, test_mock_call_data_are_equal);
+
+    // act
+    result = umockcall_get_function_name_hash(call, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
 
     // cleanup
     umockcall_destroy(call);
-    umockcall_destroy(cloned_call);
 }
 
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
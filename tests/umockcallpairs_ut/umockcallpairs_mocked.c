@@ -4,10 +4,12 @@
 #include <stddef.h>
 
 void* mock_malloc(size_t size);
+void* mock_calloc(size_t nmemb, size_t size);
 void* mock_realloc(void* ptr, size_t size);
 void mock_free(void* ptr);
 
 #define umockalloc_malloc(size) mock_malloc(size)
+#define umockalloc_calloc(nmemb, size) mock_calloc(nmemb, size)
 #define umockalloc_realloc(ptr, size) mock_realloc(ptr, size)
 #define umockalloc_free(ptr) mock_free(ptr)
 
@@ -5,6 +5,8 @@
 #include <string.h>                  // for memcpy, strlen
 
 #include "testrunnerswitcher.h"
+#include "umock_c/umocktypes.h"
+#include "umock_c/umocktypes_c.h"
 #include "umock_c/umockcallpairs.h"
 
 typedef struct umocktypes_are_equal_CALL_TAG
@@ -42,6 +44,43 @@ typedef struct umocktypes_free_CALL_TAG
 static umocktypes_free_CALL* umocktypes_free_calls;
 static size_t umocktypes_free_call_count;
 
+static size_t umocktypes_get_handlers_call_count;
+static const UMOCKTYPE_HANDLERS* umocktypes_get_handlers_call_result;
+
+/* the pointer fast path only compares the handler function pointers, the stubs are never called */
+char* umocktypes_stringify_void_ptr(void** value)
+{
+    (void)value;
+    return NULL;
+}
+
+int umocktypes_are_equal_void_ptr(void** left, void** right)
+{
+    (void)left;
+    (void)right;
+    return -1;
+}
+
+int umocktypes_copy_void_ptr(void** destination, void** source)
+{
+    (void)destination;
+    (void)source;
+    return -1;
+}
+
+void umocktypes_free_void_ptr(void** value)
+{
+    (void)value;
+}
+
+static const UMOCKTYPE_HANDLERS void_ptr_handlers =
+{
+    (UMOCKTYPE_STRINGIFY_FUNC)umocktypes_stringify_void_ptr,
+    (UMOCKTYPE_COPY_FUNC)umocktypes_copy_void_ptr,
+    (UMOCKTYPE_FREE_FUNC)umocktypes_free_void_ptr,
+    (UMOCKTYPE_ARE_EQUAL_FUNC)umocktypes_are_equal_void_ptr
+};
+
 
     int umocktypes_are_equal(const char* type, const void* left, const void* right)
     {
@@ -101,7 +140,14 @@ static size_t umocktypes_free_call_count;
         return result;
     }
 
-    void umocktypes_free(const char* type, const void* value)
+    const UMOCKTYPE_HANDLERS* umocktypes_get_handlers(const char* type)
+    {
+        (void)type;
+        umocktypes_get_handlers_call_count++;
+        return umocktypes_get_handlers_call_result;
+    }
+
+    void umocktypes_free(const char* type, void* value)
     {
         umocktypes_free_CALL* new_calls = realloc(umocktypes_free_calls, sizeof(umocktypes_free_CALL) * (umocktypes_free_call_count + 1));
         if (new_calls != NULL)
@@ -167,10 +213,12 @@ static size_t umocktypes_free_call_count;
     }
 
     static size_t malloc_call_count;
+    static size_t calloc_call_count;
     static size_t realloc_call_count;
     static size_t free_call_count;
 
     static size_t when_shall_malloc_fail;
+    static size_t when_shall_calloc_fail;
     static size_t when_shall_realloc_fail;
 
     void* mock_malloc(size_t size)
@@ -188,6 +236,21 @@ static size_t umocktypes_free_call_count;
         return result;
     }
 
+    void* mock_calloc(size_t nmemb, size_t size)
+    {
+        void* result;
+        calloc_call_count++;
+        if (calloc_call_count == when_shall_calloc_fail)
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = calloc(nmemb, size);
+        }
+        return result;
+    }
+
     void* mock_realloc(void* ptr, size_t size)
     {
         void* result;
@@ -214,6 +277,8 @@ void reset_malloc_calls(void)
 {
     malloc_call_count = 0;
     when_shall_malloc_fail = 0;
+    calloc_call_count = 0;
+    when_shall_calloc_fail = 0;
     realloc_call_count = 0;
     when_shall_realloc_fail = 0;
     free_call_count = 0;
@@ -225,6 +290,7 @@ static void reset_all_calls(void)
     reset_umocktypes_are_equal_calls();
     reset_umocktypes_copy_calls();
     reset_umocktypes_free_calls();
+    umocktypes_get_handlers_call_count = 0;
 }
 
 BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -242,6 +308,7 @@ TEST_FUNCTION_INITIALIZE(test_function_init)
     reset_all_calls();
     umocktypes_copy_call_result = 0;
     umocktypes_are_equal_call_result = 1;
+    umocktypes_get_handlers_call_result = NULL;
 }
 
 TEST_FUNCTION_CLEANUP(test_function_cleanup)
@@ -437,6 +504,186 @@ TEST_FUNCTION(when_realloc_fails_a_subsequent_create_and_destroy_succeeds)
     ASSERT_ARE_EQUAL(void_ptr, copied_handle, umocktypes_free_calls[0].value);
 }
 
+/* Tests_SRS_UMOCKCALLPAIRS_01_016: [ The PAIRED_HANDLES array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_does_not_reallocate_for_every_handle)
+{
+    // arrange
+    size_t i;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+
+    // act
+    for (i = 0; i < 64; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 64, paired_handles.paired_handle_count);
+    ASSERT_IS_TRUE(paired_handles.paired_handle_capacity >= 64);
+    ASSERT_IS_TRUE(realloc_call_count <= 8);
+
+    // cleanup
+    for (i = 0; i < 64; i++)
+    {
+        free(paired_handles.paired_handles[i].handle_type);
+        free(paired_handles.paired_handles[i].handle_value);
+    }
+    free(paired_handles.paired_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_012: [ If the paired handles array is empty after removing the entry, the paired_handles field shall be freed and set to NULL. ]*/
+/* Tests_SRS_UMOCKCALLPAIRS_01_016: [ The PAIRED_HANDLES array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_after_all_handles_were_destroyed_grows_the_array_again)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_destroy_paired_call(&paired_handles, &handle));
+    reset_all_calls();
+
+    // act
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.paired_handle_count);
+
+    // cleanup
+    free(paired_handles.paired_handles[0].handle_type);
+    free(paired_handles.paired_handles[0].handle_value);
+    free(paired_handles.paired_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_017: [ If umocktypes_get_handlers returns the void* handlers for handle_type and handle_type_size is the size of a pointer, umockcallpairs_track_create_paired_call shall store the handle value inline in a hash set keyed by the pointer value, without allocating memory for the handle and without calling umocktypes_copy. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_for_a_pointer_handle_stores_it_in_the_hash_set)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+
+    // act
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, umocktypes_get_handlers_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, calloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypes_copy_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.paired_handle_count);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.pointer_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_017: [ If umocktypes_get_handlers returns the void* handlers for handle_type and handle_type_size is the size of a pointer, umockcallpairs_track_create_paired_call shall store the handle value inline in a hash set keyed by the pointer value, without allocating memory for the handle and without calling umocktypes_copy. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_with_void_ptr_handlers_but_a_different_size_uses_the_array)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+
+    // act
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle) - 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, umocktypes_copy_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.paired_handle_count);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.paired_handles[0].handle_type);
+    free(paired_handles.paired_handles[0].handle_value);
+    free(paired_handles.paired_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_018: [ If the same pointer handle value is already tracked, umockcallpairs_track_create_paired_call shall increment the count kept for it. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_for_the_same_pointer_handle_twice_uses_one_slot)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+
+    // act
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, calloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.pointer_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_019: [ The hash set shall be grown to double its capacity whenever adding a new handle value would make more than half of its slots used. ]*/
+TEST_FUNCTION(umockcallpairs_track_create_paired_call_grows_the_hash_set_when_it_is_half_full)
+{
+    // arrange
+    int result;
+    size_t i;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    size_t initial_capacity;
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    initial_capacity = paired_handles.pointer_handle_capacity;
+    for (i = 1; i < initial_capacity / 2; i++)
+    {
+        handle = (void*)(0x4242 + i);
+        ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    }
+    ASSERT_ARE_EQUAL(size_t, initial_capacity, paired_handles.pointer_handle_capacity);
+    reset_all_calls();
+
+    // act
+    handle = (void*)(0x4242 + i);
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle));
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, calloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, free_call_count);
+    ASSERT_ARE_EQUAL(size_t, initial_capacity * 2, paired_handles.pointer_handle_capacity);
+    ASSERT_ARE_EQUAL(size_t, initial_capacity / 2 + 1, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.pointer_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_020: [ If growing the hash set fails, umockcallpairs_track_create_paired_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_hash_set_fails_umockcallpairs_track_create_paired_call_fails)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    when_shall_calloc_fail = 1;
+
+    // act
+    result = umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle));
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(paired_handles.pointer_handles);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_used_slot_count);
+}
+
 /* umockcallpairs_track_destroy_paired_call */
 
 /* Tests_SRS_UMOCKCALLPAIRS_01_008: [ umockcallpairs_track_destroy_paired_call shall remove from the paired handles array pointed by the paired_handles field the entry that is associated with the handle passed in the handle argument. ]*/
@@ -627,4 +874,133 @@ TEST_FUNCTION(when_the_handle_is_not_found_umockcallpairs_track_destroy_paired_c
     free(paired_handles.paired_handles);
 }
 
+/* Tests_SRS_UMOCKCALLPAIRS_01_021: [ If the hash set of pointer handles is not empty, umockcallpairs_track_destroy_paired_call shall first look up the handle value in it, comparing the pointer values bitwise. ]*/
+/* Tests_SRS_UMOCKCALLPAIRS_01_022: [ If the handle value is found in the hash set, umockcallpairs_track_destroy_paired_call shall decrement its count, remove it from the hash set when the count reaches 0 and return 0. ]*/
+/* Tests_SRS_UMOCKCALLPAIRS_01_023: [ If the hash set is empty after removing the handle value, it shall be freed and the pointer_handles field shall be set to NULL. ]*/
+TEST_FUNCTION(umockcallpairs_track_destroy_paired_call_removes_a_tracked_pointer_handle)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    reset_all_calls();
+
+    // act
+    result = umockcallpairs_track_destroy_paired_call(&paired_handles, &handle);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypes_are_equal_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypes_free_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, free_call_count);
+    ASSERT_IS_NULL(paired_handles.pointer_handles);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_used_slot_count);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_capacity);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_022: [ If the handle value is found in the hash set, umockcallpairs_track_destroy_paired_call shall decrement its count, remove it from the hash set when the count reaches 0 and return 0. ]*/
+TEST_FUNCTION(umockcallpairs_track_destroy_paired_call_for_a_pointer_handle_created_twice_keeps_it_until_the_second_destroy)
+{
+    // arrange
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle = (void*)0x4242;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    reset_all_calls();
+
+    // act
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_destroy_paired_call(&paired_handles, &handle));
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.pointer_handle_used_slot_count);
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_destroy_paired_call(&paired_handles, &handle));
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_used_slot_count);
+    ASSERT_IS_NULL(paired_handles.pointer_handles);
+    ASSERT_ARE_NOT_EQUAL(int, 0, umockcallpairs_track_destroy_paired_call(&paired_handles, &handle));
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_021: [ If the hash set of pointer handles is not empty, umockcallpairs_track_destroy_paired_call shall first look up the handle value in it, comparing the pointer values bitwise. ]*/
+/* Tests_SRS_UMOCKCALLPAIRS_01_022: [ If the handle value is found in the hash set, umockcallpairs_track_destroy_paired_call shall decrement its count, remove it from the hash set when the count reaches 0 and return 0. ]*/
+TEST_FUNCTION(umockcallpairs_track_destroy_paired_call_finds_all_pointer_handles_when_destroyed_in_a_different_order)
+{
+    // arrange
+    size_t i;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    /* handles 16 bytes apart, as allocations usually are, which collide in the low bits */
+    for (i = 0; i < 1000; i++)
+    {
+        handle = (void*)(0x10000 + (i * 16));
+        ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    }
+
+    // act
+    for (i = 0; i < 1000; i++)
+    {
+        /* 7 and 1000 are coprime, so every handle is destroyed exactly once */
+        handle = (void*)(0x10000 + (((i * 7) % 1000) * 16));
+        ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_destroy_paired_call(&paired_handles, &handle));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.pointer_handle_used_slot_count);
+    ASSERT_IS_NULL(paired_handles.pointer_handles);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypes_are_equal_call_count);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_024: [ If the handle value is not found in the hash set, umockcallpairs_track_destroy_paired_call shall look it up in the PAIRED_HANDLES array. ]*/
+TEST_FUNCTION(when_the_handle_is_not_in_the_hash_set_umockcallpairs_track_destroy_paired_call_looks_it_up_in_the_array)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* pointer_handle = (void*)0x4242;
+    void* handle = (void*)0x4243;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &pointer_handle, "void*", sizeof(pointer_handle)));
+    umocktypes_get_handlers_call_result = NULL;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle, "void*", sizeof(handle)));
+    reset_all_calls();
+
+    // act
+    result = umockcallpairs_track_destroy_paired_call(&paired_handles, &handle);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, umocktypes_are_equal_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, paired_handles.paired_handle_count);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.pointer_handles);
+}
+
+/* Tests_SRS_UMOCKCALLPAIRS_01_015: [ If the handle is not found in the array then umockcallpairs_track_destroy_paired_call shall fail and return a non-zero value. ]*/
+/* Tests_SRS_UMOCKCALLPAIRS_01_024: [ If the handle value is not found in the hash set, umockcallpairs_track_destroy_paired_call shall look it up in the PAIRED_HANDLES array. ]*/
+TEST_FUNCTION(when_the_handle_is_neither_in_the_hash_set_nor_in_the_array_umockcallpairs_track_destroy_paired_call_fails)
+{
+    // arrange
+    int result;
+    PAIRED_HANDLES paired_handles = { NULL, 0 };
+    void* handle1 = (void*)0x4242;
+    void* handle2 = (void*)0x4243;
+    umocktypes_get_handlers_call_result = &void_ptr_handlers;
+    ASSERT_ARE_EQUAL(int, 0, umockcallpairs_track_create_paired_call(&paired_handles, &handle1, "void*", sizeof(handle1)));
+    reset_all_calls();
+
+    // act
+    result = umockcallpairs_track_destroy_paired_call(&paired_handles, &handle2);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, paired_handles.pointer_handle_used_slot_count);
+
+    // cleanup
+    free(paired_handles.pointer_handles);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
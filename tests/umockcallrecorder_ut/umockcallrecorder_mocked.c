@@ -13,3 +13,4 @@ void mock_free(void* ptr);
 
 /* include code under test */
 #include "../../src/umockcallrecorder.c"
+#include "../../src/umockstringbuilder.c"
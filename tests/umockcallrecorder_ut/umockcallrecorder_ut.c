@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>                     // for strcpy, strlen
 
@@ -14,6 +15,7 @@
 
 static UMOCKCALL_HANDLE test_expected_umockcall_1 = (UMOCKCALL_HANDLE)0x4242;
 static UMOCKCALL_HANDLE test_expected_umockcall_2 = (UMOCKCALL_HANDLE)0x4243;
+static UMOCKCALL_HANDLE test_expected_umockcall_3 = (UMOCKCALL_HANDLE)0x4246;
 static UMOCKCALL_HANDLE test_actual_umockcall_1 = (UMOCKCALL_HANDLE)0x4244;
 static UMOCKCALL_HANDLE test_actual_umockcall_2 = (UMOCKCALL_HANDLE)0x4245;
 
@@ -23,6 +25,7 @@ typedef struct umockcall_get_ignore_all_calls_CALL_TAG
 } umockcall_get_ignore_all_calls_CALL;
 
 static int umockcall_get_ignore_all_calls_call_result;
+static UMOCKCALL_HANDLE umockcall_get_ignore_all_calls_ignore_all_call;
 
 typedef struct umockcall_are_equal_CALL_TAG
 {
@@ -31,6 +34,8 @@ typedef struct umockcall_are_equal_CALL_TAG
 } umockcall_are_equal_CALL;
 
 static int umockcall_are_equal_call_result;
+/* when set, only this expected call is equal to the actual calls */
+static UMOCKCALL_HANDLE umockcall_are_equal_only_matching_call;
 
 typedef struct umockcall_clone_CALL_TAG
 {
@@ -41,6 +46,21 @@ static size_t umockcall_clone_call_count;
 static size_t when_shall_umockcall_clone_fail;
 static UMOCKCALL_HANDLE umockcall_clone_call_result;
 
+typedef struct umockcall_share_CALL_TAG
+{
+    UMOCKCALL_HANDLE umockcall;
+} umockcall_share_CALL;
+
+static size_t umockcall_share_call_count;
+static size_t when_shall_umockcall_share_fail;
+
+typedef struct umockcall_is_shared_CALL_TAG
+{
+    UMOCKCALL_HANDLE umockcall;
+} umockcall_is_shared_CALL;
+
+static int umockcall_is_shared_call_result;
+
 typedef struct umockcall_set_fail_call_CALL_TAG
 {
     UMOCKCALL_HANDLE umockcall;
@@ -61,12 +81,12 @@ typedef struct umockcall_destroy_CALL_TAG
     UMOCKCALL_HANDLE umockcall;
 } umockcall_destroy_CALL;
 
-typedef struct umockcall_stringify_CALL_TAG
+typedef struct umockcall_stringify_append_CALL_TAG
 {
     UMOCKCALL_HANDLE umockcall;
-} umockcall_stringify_CALL;
+} umockcall_stringify_append_CALL;
 
-static char* umockcall_stringify_call_result;
+static char* umockcall_stringify_append_call_result;
 
 typedef struct umockcall_get_call_can_fail_CALL_TAG
 {
@@ -75,6 +95,39 @@ typedef struct umockcall_get_call_can_fail_CALL_TAG
 
 static int umockcall_get_call_can_fail_result;
 
+typedef struct umockcall_get_has_call_results_CALL_TAG
+{
+    UMOCKCALL_HANDLE umockcall;
+} umockcall_get_has_call_results_CALL;
+
+static int umockcall_get_has_call_results_call_result;
+
+typedef struct umockcall_stringify_mismatch_CALL_TAG
+{
+    UMOCKCALL_HANDLE expected_umockcall;
+    UMOCKCALL_HANDLE actual_umockcall;
+} umockcall_stringify_mismatch_CALL;
+
+static const char* umockcall_stringify_mismatch_call_result;
+
+typedef struct umockcall_get_repeat_count_CALL_TAG
+{
+    UMOCKCALL_HANDLE umockcall;
+} umockcall_get_repeat_count_CALL;
+
+static int umockcall_get_repeat_count_call_result;
+static UMOCKCALL_HANDLE umockcall_get_repeat_count_repeated_call;
+static size_t umockcall_get_repeat_count_min_repeat_count;
+static size_t umockcall_get_repeat_count_max_repeat_count;
+
+typedef struct umockcall_get_function_name_hash_CALL_TAG
+{
+    UMOCKCALL_HANDLE umockcall;
+} umockcall_get_function_name_hash_CALL;
+
+static int umockcall_get_function_name_hash_call_result;
+static UMOCKCALL_HANDLE umockcall_get_function_name_hash_other_function_call;
+
 typedef struct test_lock_acquire_shared_CALL_TAG
 {
     UMOCK_C_LOCK_HANDLE lock;
@@ -101,6 +154,9 @@ typedef struct test_lock_destroy_CALL_TAG
 } test_lock_destroy_CALL;
 
 static size_t malloc_call_count;
+/* lets a test add an expected call from within an allocation, as another thread would */
+static UMOCKCALLRECORDER_HANDLE malloc_add_expected_call_recorder;
+static UMOCKCALL_HANDLE malloc_add_expected_call;
 static size_t realloc_call_count;
 
 static size_t when_shall_malloc_fail;
@@ -134,11 +190,17 @@ typedef union TEST_MOCK_CALL_UNION_TAG
     umockcall_get_ignore_all_calls_CALL umockcall_get_ignore_all_calls;
     umockcall_are_equal_CALL umockcall_are_equal;
     umockcall_clone_CALL umockcall_clone;
+    umockcall_share_CALL umockcall_share;
+    umockcall_is_shared_CALL umockcall_is_shared;
     umockcall_set_fail_call_CALL umockcall_set_fail_call;
     umockcall_get_fail_call_CALL umockcall_get_fail_call;
     umockcall_destroy_CALL umockcall_destroy;
-    umockcall_stringify_CALL umockcall_stringify;
+    umockcall_stringify_append_CALL umockcall_stringify_append;
     umockcall_get_call_can_fail_CALL umockcall_get_call_can_fail;
+    umockcall_get_has_call_results_CALL umockcall_get_has_call_results;
+    umockcall_stringify_mismatch_CALL umockcall_stringify_mismatch;
+    umockcall_get_repeat_count_CALL umockcall_get_repeat_count;
+    umockcall_get_function_name_hash_CALL umockcall_get_function_name_hash;
     mock_malloc_CALL mock_malloc;
     mock_realloc_CALL mock_realloc;
     mock_free_CALL mock_free;
@@ -154,11 +216,17 @@ typedef union TEST_MOCK_CALL_UNION_TAG
     TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, \
     TEST_MOCK_CALL_TYPE_umockcall_are_equal, \
     TEST_MOCK_CALL_TYPE_umockcall_clone, \
+    TEST_MOCK_CALL_TYPE_umockcall_share, \
+    TEST_MOCK_CALL_TYPE_umockcall_is_shared, \
     TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, \
     TEST_MOCK_CALL_TYPE_umockcall_get_fail_call, \
     TEST_MOCK_CALL_TYPE_umockcall_destroy, \
-    TEST_MOCK_CALL_TYPE_umockcall_stringify, \
+    TEST_MOCK_CALL_TYPE_umockcall_stringify_append, \
     TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, \
+    TEST_MOCK_CALL_TYPE_umockcall_get_has_call_results, \
+    TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, \
+    TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, \
+    TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, \
     TEST_MOCK_CALL_TYPE_mock_malloc, \
     TEST_MOCK_CALL_TYPE_mock_realloc, \
     TEST_MOCK_CALL_TYPE_mock_free, \
@@ -193,7 +261,7 @@ int umockcall_get_ignore_all_calls(UMOCKCALL_HANDLE call)
         mocked_call_count++;
     }
 
-    return umockcall_get_ignore_all_calls_call_result;
+    return ((umockcall_get_ignore_all_calls_ignore_all_call != NULL) && (call == umockcall_get_ignore_all_calls_ignore_all_call)) ? 1 : umockcall_get_ignore_all_calls_call_result;
 }
 
 int umockcall_are_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right)
@@ -208,7 +276,7 @@ int umockcall_are_equal(UMOCKCALL_HANDLE left, UMOCKCALL_HANDLE right)
         mocked_call_count++;
     }
 
-    return umockcall_are_equal_call_result;
+    return (umockcall_are_equal_only_matching_call != NULL) ? ((left == umockcall_are_equal_only_matching_call) ? 1 : 0) : umockcall_are_equal_call_result;
 }
 
 void umockcall_destroy(UMOCKCALL_HANDLE umockcall)
@@ -248,6 +316,45 @@ UMOCKCALL_HANDLE umockcall_clone(UMOCKCALL_HANDLE umockcall)
     return result;
 }
 
+UMOCKCALL_HANDLE umockcall_share(UMOCKCALL_HANDLE umockcall)
+{
+    UMOCKCALL_HANDLE result;
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_share;
+        mocked_calls[mocked_call_count].u.umockcall_share.umockcall = umockcall;
+        umockcall_share_call_count++;
+        mocked_call_count++;
+    }
+
+    if ((when_shall_umockcall_share_fail > 0) && (when_shall_umockcall_share_fail == umockcall_share_call_count))
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = umockcall;
+    }
+
+    return result;
+}
+
+int umockcall_is_shared(UMOCKCALL_HANDLE umockcall)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_is_shared;
+        mocked_calls[mocked_call_count].u.umockcall_is_shared.umockcall = umockcall;
+        mocked_call_count++;
+    }
+
+    return umockcall_is_shared_call_result;
+}
+
 int umockcall_set_fail_call(UMOCKCALL_HANDLE umockcall, int fail_call)
 {
     TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
@@ -277,7 +384,60 @@ int umockcall_get_fail_call(UMOCKCALL_HANDLE umockcall)
     return umockcall_get_fail_call_call_result;
 }
 
-char* umockcall_stringify(UMOCKCALL_HANDLE umockcall)
+int umockcall_stringify_append(UMOCKCALL_HANDLE umockcall, UMOCKSTRINGBUILDER* string_builder)
+{
+    int result;
+
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_stringify_append;
+        mocked_calls[mocked_call_count].u.umockcall_stringify_append.umockcall = umockcall;
+        mocked_call_count++;
+    }
+
+    if (umockcall_stringify_append_call_result == NULL)
+    {
+        result = MU_FAILURE;
+    }
+    else
+    {
+        result = umockstringbuilder_append_string(string_builder, umockcall_stringify_append_call_result);
+    }
+
+    return result;
+}
+
+int umockcall_get_call_can_fail(UMOCKCALL_HANDLE umockcall)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail;
+        mocked_calls[mocked_call_count].u.umockcall_get_call_can_fail.umockcall = umockcall;
+        mocked_call_count++;
+    }
+
+    return umockcall_get_call_can_fail_result;
+}
+
+int umockcall_get_has_call_results(UMOCKCALL_HANDLE umockcall)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_get_has_call_results;
+        mocked_calls[mocked_call_count].u.umockcall_get_has_call_results.umockcall = umockcall;
+        mocked_call_count++;
+    }
+
+    return umockcall_get_has_call_results_call_result;
+}
+
+char* umockcall_stringify_mismatch(UMOCKCALL_HANDLE expected_umockcall, UMOCKCALL_HANDLE actual_umockcall)
 {
     char* result;
 
@@ -285,39 +445,68 @@ char* umockcall_stringify(UMOCKCALL_HANDLE umockcall)
     if (new_calls != NULL)
     {
         mocked_calls = new_calls;
-        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_stringify;
-        mocked_calls[mocked_call_count].u.umockcall_stringify.umockcall = umockcall;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch;
+        mocked_calls[mocked_call_count].u.umockcall_stringify_mismatch.expected_umockcall = expected_umockcall;
+        mocked_calls[mocked_call_count].u.umockcall_stringify_mismatch.actual_umockcall = actual_umockcall;
         mocked_call_count++;
     }
 
-    if (umockcall_stringify_call_result == NULL)
+    if (umockcall_stringify_mismatch_call_result == NULL)
     {
         result = NULL;
     }
     else
     {
-        result = malloc(strlen(umockcall_stringify_call_result) + 1);
+        result = (char*)malloc(strlen(umockcall_stringify_mismatch_call_result) + 1);
         if (result != NULL)
         {
-            (void)strcpy(result, umockcall_stringify_call_result);
+            (void)strcpy(result, umockcall_stringify_mismatch_call_result);
         }
     }
 
     return result;
 }
 
-int umockcall_get_call_can_fail(UMOCKCALL_HANDLE umockcall)
+int umockcall_get_repeat_count(UMOCKCALL_HANDLE umockcall, size_t* min_repeat_count, size_t* max_repeat_count)
 {
     TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
     if (new_calls != NULL)
     {
         mocked_calls = new_calls;
-        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail;
-        mocked_calls[mocked_call_count].u.umockcall_get_call_can_fail.umockcall = umockcall;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count;
+        mocked_calls[mocked_call_count].u.umockcall_get_repeat_count.umockcall = umockcall;
         mocked_call_count++;
     }
 
-    return umockcall_get_call_can_fail_result;
+    if ((umockcall_get_repeat_count_repeated_call != NULL) && (umockcall == umockcall_get_repeat_count_repeated_call))
+    {
+        *min_repeat_count = umockcall_get_repeat_count_min_repeat_count;
+        *max_repeat_count = umockcall_get_repeat_count_max_repeat_count;
+    }
+    else
+    {
+        *min_repeat_count = 1;
+        *max_repeat_count = 1;
+    }
+
+    return umockcall_get_repeat_count_call_result;
+}
+
+int umockcall_get_function_name_hash(UMOCKCALL_HANDLE umockcall, size_t* function_name_hash)
+{
+    TEST_MOCK_CALL* new_calls = realloc(mocked_calls, sizeof(TEST_MOCK_CALL) * (mocked_call_count + 1));
+    if (new_calls != NULL)
+    {
+        mocked_calls = new_calls;
+        mocked_calls[mocked_call_count].call_type = TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash;
+        mocked_calls[mocked_call_count].u.umockcall_get_function_name_hash.umockcall = umockcall;
+        mocked_call_count++;
+    }
+
+    /* all calls are calls to the same function, except umockcall_get_function_name_hash_other_function_call */
+    *function_name_hash = ((umockcall_get_function_name_hash_other_function_call != NULL) && (umockcall == umockcall_get_function_name_hash_other_function_call)) ? 0x43 : 0x42;
+
+    return umockcall_get_function_name_hash_call_result;
 }
 
 
@@ -334,6 +523,13 @@ int umockcall_get_call_can_fail(UMOCKCALL_HANDLE umockcall)
             mocked_call_count++;
         }
 
+        if (malloc_add_expected_call_recorder != NULL)
+        {
+            UMOCKCALLRECORDER_HANDLE call_recorder = malloc_add_expected_call_recorder;
+            malloc_add_expected_call_recorder = NULL;
+            (void)umockcallrecorder_add_expected_call(call_recorder, malloc_add_expected_call);
+        }
+
         malloc_call_count++;
         if (malloc_call_count == when_shall_malloc_fail)
         {
@@ -476,17 +672,33 @@ static void reset_all_calls(void)
 {
     malloc_call_count = 0;
     when_shall_malloc_fail = 0;
+    malloc_add_expected_call_recorder = NULL;
+    malloc_add_expected_call = NULL;
     realloc_call_count = 0;
     when_shall_realloc_fail = 0;
 
     umockcall_clone_call_count = 0;
     when_shall_umockcall_clone_fail = 0;
+    umockcall_share_call_count = 0;
+    when_shall_umockcall_share_fail = 0;
+    umockcall_is_shared_call_result = 0;
 
     umockcall_set_fail_call_call_result = 0;
+    umockcall_get_fail_call_call_result = 0;
+    umockcall_get_has_call_results_call_result = 0;
+    umockcall_stringify_mismatch_call_result = NULL;
     umockcall_get_call_can_fail_result = 0;
 
     umockcall_are_equal_call_result = 1;
+    umockcall_are_equal_only_matching_call = NULL;
     umockcall_get_ignore_all_calls_call_result = 0;
+    umockcall_get_ignore_all_calls_ignore_all_call = NULL;
+    umockcall_get_repeat_count_call_result = 0;
+    umockcall_get_repeat_count_repeated_call = NULL;
+    umockcall_get_repeat_count_min_repeat_count = 1;
+    umockcall_get_repeat_count_max_repeat_count = 1;
+    umockcall_get_function_name_hash_call_result = 0;
+    umockcall_get_function_name_hash_other_function_call = NULL;
 
     test_lock_factory_create_lock_result = test_lock_handle;
 
@@ -754,6 +966,151 @@ TEST_FUNCTION(umockcallrecorder_reset_all_calls_with_lock_functions_locks_and_un
     umockcallrecorder_destroy(call_recorder);
 }
 
+/* umockcallrecorder_reserve */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_103: [ umockcallrecorder_reserve shall make sure that the call recorder can hold at least expected_call_count expected calls and actual_call_count actual calls without reallocating its call arrays. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_108: [ On success umockcallrecorder_reserve shall return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_reserve_grows_both_call_arrays)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+
+    // act
+    int result = umockcallrecorder_reserve(call_recorder, 100, 50);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_IS_TRUE(mocked_calls[0].u.mock_realloc.size >= 100 * sizeof(void*));
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_IS_TRUE(mocked_calls[1].u.mock_realloc.size >= 50 * sizeof(UMOCKCALL_HANDLE));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_103: [ umockcallrecorder_reserve shall make sure that the call recorder can hold at least expected_call_count expected calls and actual_call_count actual calls without reallocating its call arrays. ]*/
+TEST_FUNCTION(after_umockcallrecorder_reserve_adding_the_reserved_calls_does_not_reallocate)
+{
+    // arrange
+    size_t i;
+    UMOCKCALL_HANDLE matched_call;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_reserve(call_recorder, 20, 20));
+    umockcall_are_equal_call_result = 0;
+    reset_all_calls();
+
+    // act
+    for (i = 0; i < 20; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, realloc_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_103: [ umockcallrecorder_reserve shall make sure that the call recorder can hold at least expected_call_count expected calls and actual_call_count actual calls without reallocating its call arrays. ]*/
+TEST_FUNCTION(umockcallrecorder_reserve_with_counts_already_available_does_not_reallocate)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_reserve(call_recorder, 10, 10));
+    reset_all_calls();
+
+    // act
+    int result = umockcallrecorder_reserve(call_recorder, 5, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_104: [ If umock_call_recorder is NULL, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_reserve_with_NULL_call_recorder_fails)
+{
+    // arrange
+
+    // act
+    int result = umockcallrecorder_reserve(NULL, 1, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_107: [ If growing any of the call arrays fails, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_expected_calls_fails_umockcallrecorder_reserve_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_reserve(call_recorder, 10, 10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_107: [ If growing any of the call arrays fails, umockcallrecorder_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_actual_calls_fails_umockcallrecorder_reserve_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+    when_shall_realloc_fail = 2;
+
+    // act
+    result = umockcallrecorder_reserve(call_recorder, 10, 10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, realloc_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_105: [ If a lock was created for the call recorder, umockcallrecorder_reserve shall acquire the lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_106: [ If a lock was created for the call recorder, umockcallrecorder_reserve shall release the exclusive lock. ]*/
+TEST_FUNCTION(umockcallrecorder_reserve_with_lock_functions_locks_and_unlocks)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    reset_all_calls();
+
+    // act
+    int result = umockcallrecorder_reserve(call_recorder, 10, 10);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
 /* umockcallrecorder_add_expected_call */
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_008: [ umockcallrecorder_add_expected_call shall add the mock_call call to the expected call list maintained by the call recorder identified by umock_call_recorder. ]*/
@@ -842,6 +1199,27 @@ TEST_FUNCTION(umockcallrecorder_add_expected_call_with_locks_setup_locks_and_unl
     umockcallrecorder_destroy(call_recorder);
 }
 
+/* Tests_SRS_UMOCKCALLRECORDER_01_101: [ The expected calls array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+TEST_FUNCTION(umockcallrecorder_add_expected_call_does_not_reallocate_for_every_call)
+{
+    // arrange
+    size_t i;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+
+    // act
+    for (i = 0; i < 64; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    }
+
+    // assert
+    ASSERT_IS_TRUE(realloc_call_count <= 8);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
 /* umockcallrecorder_add_actual_call */
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_014: [ umockcallrecorder_add_actual_call shall check whether the call mock_call matches any of the expected calls maintained by umock_call_recorder. ]*/
@@ -883,12 +1261,14 @@ TEST_FUNCTION(umockcallrecorder_add_actual_call_with_a_call_that_does_not_match_
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -960,20 +1340,42 @@ TEST_FUNCTION(when_allocating_memory_for_the_actual_calls_fails_umockcallrecorde
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
-TEST_FUNCTION(when_umockcall_are_equal_fails_then_umockcallrecorder_add_actual_call_fails)
+/* Tests_SRS_UMOCKCALLRECORDER_01_102: [ The actual calls array shall only be reallocated when it is full, and its capacity shall be grown geometrically. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_does_not_reallocate_for_every_unexpected_call)
 {
     // arrange
-    int result;
+    size_t i;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_are_equal_call_result = -1;
 
     // act
-    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
-
+    for (i = 0; i < 64; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    }
+
+    // assert
+    ASSERT_IS_TRUE(realloc_call_count <= 8);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_021: [ If umockcall_are_equal fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_umockcall_are_equal_fails_then_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_are_equal_call_result = -1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
     // assert
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
@@ -1003,12 +1405,14 @@ TEST_FUNCTION(when_the_actual_call_matches_the_expected_call_then_the_matched_ca
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1032,12 +1436,14 @@ TEST_FUNCTION(when_the_actual_call_matches_the_1st_of_2_expected_call_then_the_m
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1063,13 +1469,15 @@ TEST_FUNCTION(when_the_actual_call_matches_the_2nd_of_2_expected_call_then_the_m
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
-    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[2].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[2].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[3].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1114,12 +1522,15 @@ TEST_FUNCTION(only_the_first_expected_call_is_checked_for_match)
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
     ASSERT_IS_NULL(matched_call);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1132,7 +1543,7 @@ TEST_FUNCTION(if_matching_fails_subsequent_actual_calls_are_not_matched)
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_are_equal_call_result = 0;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
@@ -1159,7 +1570,7 @@ TEST_FUNCTION(if_expected_call_has_ignore_all_calls_the_actual_call_is_not_recor
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_are_equal_call_result = 1;
     umockcall_get_ignore_all_calls_call_result = 1;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
@@ -1183,7 +1594,7 @@ TEST_FUNCTION(if_expected_call_has_ignore_all_calls_2_actual_calls_are_not_recor
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_are_equal_call_result = 1;
     umockcall_get_ignore_all_calls_call_result = 1;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
@@ -1209,7 +1620,7 @@ TEST_FUNCTION(if_expected_call_has_ignore_all_calls_and_umockcall_get_ignore_all
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
     int add_call_result;
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_are_equal_call_result = 1;
     umockcall_get_ignore_all_calls_call_result = -1;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
@@ -1227,6 +1638,121 @@ TEST_FUNCTION(if_expected_call_has_ignore_all_calls_and_umockcall_get_ignore_all
     umockcallrecorder_destroy(call_recorder);
 }
 
+/* Tests_SRS_UMOCKCALLRECORDER_01_100: [ Afterwards the expected calls starting with the first unmatched expected call shall be compared in order, skipping matched calls, up to and including the first unmatched call that does not have ignore_all_calls set. ]*/
+TEST_FUNCTION(matching_the_3rd_of_3_expected_calls_does_not_walk_again_all_the_matched_calls)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+    reset_all_calls();
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_3, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[0].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_3, mocked_calls[1].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_3, mocked_calls[2].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_3, mocked_calls[3].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_099: [ The expected calls before the first unmatched expected call that have ignore_all_calls set shall be compared first, in the order they were added. ]*/
+TEST_FUNCTION(an_expected_call_with_ignore_all_calls_before_the_first_unmatched_call_is_compared_first)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[0].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[1].u.umockcall_are_equal.right);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_099: [ The expected calls before the first unmatched expected call that have ignore_all_calls set shall be compared first, in the order they were added. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_100: [ Afterwards the expected calls starting with the first unmatched expected call shall be compared in order, skipping matched calls, up to and including the first unmatched call that does not have ignore_all_calls set. ]*/
+TEST_FUNCTION(an_actual_call_not_matching_the_ignore_all_calls_expected_call_is_compared_with_the_first_unmatched_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 0;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[0].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[2].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[3].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[4].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[5].u.umockcall_stringify_mismatch.expected_umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[6].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
 /* Tests_SRS_UMOCKCALLRECORDER_01_071: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall acquire the lock in exclusive mode. ]*/
 /* Tests_SRS_UMOCKCALLRECORDER_01_070: [ If a lock was created for the call recorder, umockcallrecorder_add_actual_call shall release the exclusive lock. ]*/
 TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_set_locks_and_unlocks)
@@ -1244,14 +1770,17 @@ TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_set_locks_an
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_are_equal.left);
     ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[2].u.umockcall_are_equal.right);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[3].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[6].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1276,7 +1805,7 @@ TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_no_calls_returns_an_empty_
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_022: [ umockcallrecorder_get_actual_calls shall return a pointer to the string representation of all the actual calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
 TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_1_call_returns_one_stringified_call)
 {
     // arrange
@@ -1285,24 +1814,23 @@ TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_1_call_returns_one_stringi
     UMOCKCALL_HANDLE matched_call;
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_actual_calls(call_recorder);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_022: [ umockcallrecorder_get_actual_calls shall return a pointer to the string representation of all the actual calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
 TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_2_calls_returns_the_stringified_calls)
 {
     // arrange
@@ -1312,33 +1840,111 @@ TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_2_calls_returns_the_string
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_actual_calls(call_recorder);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", result);
-    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_110: [ umockcallrecorder_get_actual_calls shall build the string in a string builder owned by the call recorder, reusing the memory allocated by previous calls. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_114: [ umockcallrecorder_get_actual_calls shall stringify only the actual calls that were not stringified by a previous call and append them to the previously built string. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_a_second_time_does_not_stringify_the_calls_again)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_actual_calls(call_recorder);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_114: [ umockcallrecorder_get_actual_calls shall stringify only the actual calls that were not stringified by a previous call and append them to the previously built string. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_only_stringifies_the_calls_added_since_the_previous_call)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_actual_calls(call_recorder);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[b()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][b()]", result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[0].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_113: [ umockcallrecorder_reset_all_calls shall discard the cached stringified calls. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_after_reset_all_calls_does_not_report_the_old_calls)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_actual_calls(call_recorder);
+    (void)umockcallrecorder_reset_all_calls(call_recorder);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[b()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[b()]", result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[0].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_025: [ If umockcall_stringify fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_025: [ If umockcall_stringify_append fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
 TEST_FUNCTION(when_stringifying_one_call_fails_then_umockcallrecorder_get_actual_calls_fails)
 {
     // arrange
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    umockcall_stringify_call_result = NULL;
+    umockcall_stringify_append_call_result = NULL;
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
 
     // act
@@ -1395,7 +2001,7 @@ TEST_FUNCTION(when_allocating_memory_for_the_resulting_string_fails_then_umockca
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
 
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     when_shall_realloc_fail = 1;
 
     // act
@@ -1403,17 +2009,16 @@ TEST_FUNCTION(when_allocating_memory_for_the_resulting_string_fails_then_umockca
 
     // assert
     ASSERT_IS_NULL(result);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_022: [ umockcallrecorder_get_actual_calls shall return a pointer to the string representation of all the actual calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_023: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
 TEST_FUNCTION(umockcallrecorder_get_actual_calls_when_the_actual_call_does_not_match_the_expected_should_return_the_actual_call)
 {
     // arrange
@@ -1424,7 +2029,7 @@ TEST_FUNCTION(umockcallrecorder_get_actual_calls_when_the_actual_call_does_not_m
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_actual_calls(call_recorder);
@@ -1445,20 +2050,21 @@ TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_lock_functions_setup_locks
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
     UMOCKCALL_HANDLE matched_call;
     ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    // merge the actual call that was logged without taking the lock
+    ASSERT_IS_NOT_NULL(umockcallrecorder_get_expected_calls(call_recorder));
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_actual_calls(call_recorder);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
-    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1483,7 +2089,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_no_calls_returns_an_empt
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
 TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_1_call_returns_one_stringified_call)
 {
     // arrange
@@ -1491,7 +2097,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_1_call_returns_one_strin
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
@@ -1505,7 +2111,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_1_call_returns_one_strin
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
 TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_2_calls_returns_the_stringified_calls)
 {
     // arrange
@@ -1514,7 +2120,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_2_calls_returns_the_stri
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
@@ -1527,121 +2133,263 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_2_calls_returns_the_stri
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_030: [ If umockcall_stringify fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-TEST_FUNCTION(when_stringifying_one_call_fails_then_umockcallrecorder_get_expected_calls_fails)
+/* Tests_SRS_UMOCKCALLRECORDER_01_109: [ umockcallrecorder_get_expected_calls shall build the string in a string builder owned by the call recorder, reusing the memory allocated by previous calls. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_111: [ umockcallrecorder_get_expected_calls shall stringify only the expected calls that were not stringified by a previous call, except for the last expected call, which shall be stringified every time. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_a_second_time_only_stringifies_the_last_expected_call)
 {
     // arrange
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
-    umockcall_stringify_call_result = NULL;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    reset_all_calls();
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
 
     // assert
-    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[1].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[2].u.umockcall_stringify_append.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_029: [ If the umock_call_recorder is NULL, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_NULL_call_recorder_fails)
-{
-    // arrange
-
-    // act
-    const char* result = umockcallrecorder_get_expected_calls(NULL);
-
-    // assert
-    ASSERT_IS_NULL(result);
-}
-
-/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-TEST_FUNCTION(when_allocating_memory_for_the_resulting_string__for_no_calls_fails_then_umockcallrecorder_get_expected_calls_fails)
+/* Tests_SRS_UMOCKCALLRECORDER_01_111: [ umockcallrecorder_get_expected_calls shall stringify only the expected calls that were not stringified by a previous call, except for the last expected call, which shall be stringified every time. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_picks_up_changes_to_the_last_expected_call)
 {
     // arrange
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    umockcall_stringify_append_call_result = "[a(42)]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
     reset_all_calls();
-
-    when_shall_realloc_fail = 1;
+    umockcall_stringify_append_call_result = "[b()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
 
     // assert
-    ASSERT_IS_NULL(result);
-    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][b()][b()]", result);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[2].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_3, mocked_calls[5].u.umockcall_stringify_append.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-TEST_FUNCTION(when_allocating_memory_for_the_resulting_string_fails_then_umockcallrecorder_get_expected_calls_fails)
+/* Tests_SRS_UMOCKCALLRECORDER_01_112: [ Cached expected calls that were matched since the previous call shall be removed from the start of the string without stringifying any call. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_drops_the_matched_cached_calls)
 {
     // arrange
     const char* result;
+    UMOCKCALL_HANDLE matched_call;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
-    umockcall_stringify_call_result = "[a()]";
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-
-    when_shall_realloc_fail = 1;
+    umockcall_stringify_append_call_result = "[c()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
 
     // assert
-    ASSERT_IS_NULL(result);
-    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][c()]", result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_3, mocked_calls[2].u.umockcall_stringify_append.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
-TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_a_matched_expected_call_yields_no_calls_in_the_string)
+/* Tests_SRS_UMOCKCALLRECORDER_01_112: [ Cached expected calls that were matched since the previous call shall be removed from the start of the string without stringifying any call. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_when_all_cached_calls_are_matched_yields_only_the_last_call)
 {
     // arrange
     const char* result;
-    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     UMOCKCALL_HANDLE matched_call;
-    umockcall_are_equal_call_result = 1;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[c()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, "", result);
+    ASSERT_ARE_EQUAL(char_ptr, "[c()]", result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify. ]*/
-TEST_FUNCTION(umockcallrecorder_get_expected_calls_when_the_actual_call_does_not_match_the_expected_should_return_the_expected_call)
+/* Tests_SRS_UMOCKCALLRECORDER_01_113: [ umockcallrecorder_reset_all_calls shall discard the cached stringified calls. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_after_reset_all_calls_does_not_report_the_old_calls)
 {
     // arrange
     const char* result;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
-    UMOCKCALL_HANDLE matched_call;
-    umockcall_are_equal_call_result = 0;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
-    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_get_expected_calls(call_recorder);
+    (void)umockcallrecorder_reset_all_calls(call_recorder);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[c()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
 
     // assert
-    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
+    ASSERT_ARE_EQUAL(char_ptr, "[c()]", result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_030: [ If umockcall_stringify_append fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(when_stringifying_one_call_fails_then_umockcallrecorder_get_expected_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    umockcall_stringify_append_call_result = NULL;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_029: [ If the umock_call_recorder is NULL, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_NULL_call_recorder_fails)
+{
+    // arrange
+
+    // act
+    const char* result = umockcallrecorder_get_expected_calls(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_resulting_string__for_no_calls_fails_then_umockcallrecorder_get_expected_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_resulting_string_fails_then_umockcallrecorder_get_expected_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    umockcall_stringify_append_call_result = "[a()]";
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, realloc_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_031: [ If allocating memory for the resulting string fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_a_matched_expected_call_yields_no_calls_in_the_string)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_027: [ umockcallrecorder_get_expected_calls shall return a pointer to the string representation of all the expected calls. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_028: [ The string for each call shall be obtained by calling umockcall_stringify_append. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_when_the_actual_call_does_not_match_the_expected_should_return_the_expected_call)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    umockcall_are_equal_call_result = 0;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1657,7 +2405,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_1_expectd_call_with_igno
     umockcall_are_equal_call_result = 0;
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_get_ignore_all_calls_call_result = 1;
 
     // act
@@ -1678,7 +2426,7 @@ TEST_FUNCTION(when_getting_the_ignore_all_cals_fails_umockcallrecorder_get_expec
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
     umockcall_are_equal_call_result = 0;
     umockcall_get_ignore_all_calls_call_result = -1;
 
@@ -1701,7 +2449,7 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_lock_functions_setup_loc
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
     ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
     reset_all_calls();
-    umockcall_stringify_call_result = "[a()]";
+    umockcall_stringify_append_call_result = "[a()]";
 
     // act
     result = umockcallrecorder_get_expected_calls(call_recorder);
@@ -1711,9 +2459,10 @@ TEST_FUNCTION(umockcallrecorder_get_expected_calls_with_lock_functions_setup_loc
     ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[5].call_type);
 
     // cleanup
@@ -1764,7 +2513,9 @@ TEST_FUNCTION(umockcallrecorder_get_last_expected_call_with_1_expected_call_retu
 
     // assert
     ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, result);
-    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_is_shared.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1789,8 +2540,8 @@ TEST_FUNCTION(umockcallrecorder_get_last_expected_call_with_2_expected_calls_ret
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_01_079: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall acquire the lock in shared mode. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_080: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall release the shared lock. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_079: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall acquire the lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_080: [ If a lock was created for the call recorder, umockcallrecorder_get_last_expected_call shall release the exclusive lock. ]*/
 TEST_FUNCTION(umockcallrecorder_get_last_expected_call_with_lock_functions_setup_locks_and_unlocks)
 {
     // arrange
@@ -1804,9 +2555,81 @@ TEST_FUNCTION(umockcallrecorder_get_last_expected_call_with_lock_functions_setup
 
     // assert
     ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_115: [ Since the caller can change the returned call, if the last expected call is shared with another call recorder (as indicated by umockcall_is_shared), umockcallrecorder_get_last_expected_call shall replace it with a copy obtained by calling umockcall_clone and release the shared call by calling umockcall_destroy. ]*/
+TEST_FUNCTION(umockcallrecorder_get_last_expected_call_on_a_shared_call_returns_a_copy_of_the_call)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_is_shared_call_result = 1;
+    umockcall_clone_call_result = test_expected_umockcall_3;
+
+    // act
+    result = umockcallrecorder_get_last_expected_call(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_3, result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[1].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_destroy.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_116: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_get_last_expected_call shall fail and return NULL. ]*/
+TEST_FUNCTION(when_umockcall_is_shared_fails_umockcallrecorder_get_last_expected_call_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_is_shared_call_result = -1;
+
+    // act
+    result = umockcallrecorder_get_last_expected_call(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_116: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_get_last_expected_call shall fail and return NULL. ]*/
+TEST_FUNCTION(when_copying_the_shared_call_fails_umockcallrecorder_get_last_expected_call_fails)
+{
+    // arrange
+    UMOCKCALL_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_is_shared_call_result = 1;
+    umockcall_clone_call_result = NULL;
+
+    // act
+    result = umockcallrecorder_get_last_expected_call(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
     ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_shared, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_shared, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[1].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -1863,7 +2686,7 @@ TEST_FUNCTION(when_allocating_memory_for_call_recorder_fails_umockcallrecorder_c
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_038: [ umockcallrecorder_clone shall clone all the expected calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be cloned by calling umockcall_clone. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be shared with the new call recorder by calling umockcall_share. ]*/
 TEST_FUNCTION(umockcallrecorder_clone_with_one_expected_call_clones_the_expected_call)
 {
     // arrange
@@ -1871,7 +2694,6 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_expected_call_clones_the_expected
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -1881,8 +2703,8 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_expected_call_clones_the_expected
     ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[3].call_type);
 
     // cleanup
@@ -1891,7 +2713,7 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_expected_call_clones_the_expected
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_038: [ umockcallrecorder_clone shall clone all the expected calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be cloned by calling umockcall_clone. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_039: [ Each expected call shall be shared with the new call recorder by calling umockcall_share. ]*/
 TEST_FUNCTION(umockcallrecorder_clone_with_2_expected_calls_clones_the_expected_call)
 {
     // arrange
@@ -1900,7 +2722,6 @@ TEST_FUNCTION(umockcallrecorder_clone_with_2_expected_calls_clones_the_expected_
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -1910,10 +2731,10 @@ TEST_FUNCTION(umockcallrecorder_clone_with_2_expected_calls_clones_the_expected_
     ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_clone.umockcall);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[3].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_share.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[3].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[4].call_type);
 
     // cleanup
@@ -1929,7 +2750,7 @@ TEST_FUNCTION(when_cloning_the_expected_call_fails_umockcallrecorder_clone_fails
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_clone_call_result = NULL;
+    when_shall_umockcall_share_fail = 1;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -1939,8 +2760,8 @@ TEST_FUNCTION(when_cloning_the_expected_call_fails_umockcallrecorder_clone_fails
     ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
 
@@ -1957,8 +2778,7 @@ TEST_FUNCTION(when_cloning_the_1st_out_of_2_expected_calls_fails_umockcallrecord
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
-    when_shall_umockcall_clone_fail = 1;
+    when_shall_umockcall_share_fail = 1;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -1968,8 +2788,8 @@ TEST_FUNCTION(when_cloning_the_1st_out_of_2_expected_calls_fails_umockcallrecord
     ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
 
@@ -1986,8 +2806,7 @@ TEST_FUNCTION(when_cloning_the_2nd_out_of_2_expected_calls_fails_umockcallrecord
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
-    when_shall_umockcall_clone_fail = 2;
+    when_shall_umockcall_share_fail = 2;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -1997,10 +2816,10 @@ TEST_FUNCTION(when_cloning_the_2nd_out_of_2_expected_calls_fails_umockcallrecord
     ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_clone.umockcall);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[3].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_share.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[3].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[5].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
@@ -2017,7 +2836,6 @@ TEST_FUNCTION(when_allocating_memory_for_expected_calls_fails_umockcallrecorder_
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
     when_shall_malloc_fail = 2;
 
     // act
@@ -2035,7 +2853,7 @@ TEST_FUNCTION(when_allocating_memory_for_expected_calls_fails_umockcallrecorder_
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_041: [ umockcallrecorder_clone shall clone all the actual calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be cloned by calling umockcall_clone. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be shared with the new call recorder by calling umockcall_share. ]*/
 TEST_FUNCTION(umockcallrecorder_clone_with_one_actual_call_succeeds)
 {
     // arrange
@@ -2044,7 +2862,6 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_actual_call_succeeds)
     UMOCKCALL_HANDLE matched_call;
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2056,8 +2873,8 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_actual_call_succeeds)
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_share.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2065,7 +2882,7 @@ TEST_FUNCTION(umockcallrecorder_clone_with_one_actual_call_succeeds)
 }
 
 /* Tests_SRS_UMOCKCALLRECORDER_01_041: [ umockcallrecorder_clone shall clone all the actual calls. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be cloned by calling umockcall_clone. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_042: [ Each actual call shall be shared with the new call recorder by calling umockcall_share. ]*/
 TEST_FUNCTION(umockcallrecorder_clone_with_2_actual_calls_succeeds)
 {
     // arrange
@@ -2075,7 +2892,6 @@ TEST_FUNCTION(umockcallrecorder_clone_with_2_actual_calls_succeeds)
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2087,10 +2903,10 @@ TEST_FUNCTION(umockcallrecorder_clone_with_2_actual_calls_succeeds)
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_clone.umockcall);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[4].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[4].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_share.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[4].u.umockcall_share.umockcall);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2106,7 +2922,7 @@ TEST_FUNCTION(when_cloning_actual_call_fails_umockcallrecorder_clone_fails)
     UMOCKCALL_HANDLE matched_call;
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_clone_call_result = NULL;
+    when_shall_umockcall_share_fail = 1;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2117,8 +2933,8 @@ TEST_FUNCTION(when_cloning_actual_call_fails_umockcallrecorder_clone_fails)
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[5].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
@@ -2137,7 +2953,7 @@ TEST_FUNCTION(when_cloning_the_1st_of_2_actual_calls_fails_umockcallrecorder_clo
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
     reset_all_calls();
-    umockcall_clone_call_result = NULL;
+    when_shall_umockcall_share_fail = 1;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2148,8 +2964,8 @@ TEST_FUNCTION(when_cloning_the_1st_of_2_actual_calls_fails_umockcallrecorder_clo
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[5].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
@@ -2168,8 +2984,7 @@ TEST_FUNCTION(when_cloning_the_2nd_of_2_actual_calls_fails_umockcallrecorder_clo
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
     (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
     reset_all_calls();
-    when_shall_umockcall_clone_fail = 2;
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
+    when_shall_umockcall_share_fail = 2;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2180,10 +2995,10 @@ TEST_FUNCTION(when_cloning_the_2nd_of_2_actual_calls_fails_umockcallrecorder_clo
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[3].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_clone.umockcall);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[4].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[4].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[3].u.umockcall_share.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[4].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[5].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[7].call_type);
@@ -2202,7 +3017,6 @@ TEST_FUNCTION(when_allocating_memory_for_actual_calls_fails_umockcallrecorder_cl
     UMOCKCALL_HANDLE matched_call;
     (void)umockcallrecorder_add_actual_call(call_recorder, test_expected_umockcall_1, &matched_call);
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
     when_shall_malloc_fail = 2;
 
     // act
@@ -2229,8 +3043,9 @@ TEST_FUNCTION(umockcallrecorder_clone_with_lock_functions_setup_locks_and_unlock
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, (void*)0x4242);
     UMOCKCALL_HANDLE matched_call;
     ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    // merge the actual call that was logged without taking the lock
+    ASSERT_IS_NOT_NULL(umockcallrecorder_get_expected_calls(call_recorder));
     reset_all_calls();
-    umockcall_clone_call_result = (UMOCKCALL_HANDLE)0x4245;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2245,8 +3060,8 @@ TEST_FUNCTION(umockcallrecorder_clone_with_lock_functions_setup_locks_and_unlock
     ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, mocked_calls[2].u.test_lock_factory_create_lock.params);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[3].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[4].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[5].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[5].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[5].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_shared, mocked_calls[6].call_type);
 
     // cleanup
@@ -2262,6 +3077,8 @@ TEST_FUNCTION(when_creating_the_new_lock_fails_umockcallrecorder_clone_fails)
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, (void*)0x4242);
     UMOCKCALL_HANDLE matched_call;
     ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    // merge the actual call that was logged without taking the lock
+    ASSERT_IS_NOT_NULL(umockcallrecorder_get_expected_calls(call_recorder));
     reset_all_calls();
     test_lock_factory_create_lock_result = NULL;
 
@@ -2291,8 +3108,10 @@ TEST_FUNCTION(when_cloning_the_call_fails_the_newly_created_lock_gets_destroyed)
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, (void*)0x4242);
     UMOCKCALL_HANDLE matched_call;
     ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    // merge the actual call that was logged without taking the lock
+    ASSERT_IS_NOT_NULL(umockcallrecorder_get_expected_calls(call_recorder));
     reset_all_calls();
-    umockcall_clone_call_result = NULL;
+    when_shall_umockcall_share_fail = 1;
 
     // act
     result = umockcallrecorder_clone(call_recorder);
@@ -2307,8 +3126,8 @@ TEST_FUNCTION(when_cloning_the_call_fails_the_newly_created_lock_gets_destroyed)
     ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, mocked_calls[2].u.test_lock_factory_create_lock.params);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[3].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[4].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[5].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[5].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[5].u.umockcall_share.umockcall);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[7].call_type);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_destroy, mocked_calls[8].call_type);
@@ -2435,10 +3254,12 @@ TEST_FUNCTION(umockcallrecorder_fail_call_sets_fail_call_to_1_for_the_first_call
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_set_fail_call.umockcall);
-    ASSERT_ARE_EQUAL(int, 1, mocked_calls[0].u.umockcall_set_fail_call.fail_call);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[1].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[1].u.umockcall_set_fail_call.fail_call);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2460,10 +3281,12 @@ TEST_FUNCTION(umockcallrecorder_fail_call_sets_fail_call_to_1_for_the_second_cal
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_set_fail_call.umockcall);
-    ASSERT_ARE_EQUAL(int, 1, mocked_calls[0].u.umockcall_set_fail_call.fail_call);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[1].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[1].u.umockcall_set_fail_call.fail_call);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2486,10 +3309,12 @@ TEST_FUNCTION(two_umockcallrecorder_fail_call_calls_succeed)
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_set_fail_call.umockcall);
-    ASSERT_ARE_EQUAL(int, 1, mocked_calls[0].u.umockcall_set_fail_call.fail_call);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[1].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[1].u.umockcall_set_fail_call.fail_call);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2560,10 +3385,12 @@ TEST_FUNCTION(when_umockcall_set_fail_call_fails_then_umockcallrecorder_fail_cal
 
     // assert
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_set_fail_call.umockcall);
-    ASSERT_ARE_EQUAL(int, 1, mocked_calls[0].u.umockcall_set_fail_call.fail_call);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[1].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[1].u.umockcall_set_fail_call.fail_call);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
@@ -2584,104 +3411,182 @@ TEST_FUNCTION(umockcallrecorder_fail_call_with_lock_functions_set_locks_and_unlo
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
     ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[1].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[1].u.umockcall_set_fail_call.umockcall);
-    ASSERT_ARE_EQUAL(int, 1, mocked_calls[1].u.umockcall_set_fail_call.fail_call);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[2].u.umockcall_set_fail_call.fail_call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* umockcallrecorder_can_call_fail */
-
-/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
-TEST_FUNCTION(umockcallrecorder_can_call_fail_index_0_caller_sets_0)
+/* Tests_SRS_UMOCKCALLRECORDER_01_117: [ If the expected call is shared with another call recorder (as indicated by umockcall_is_shared), umockcallrecorder_fail_call shall first replace it with a copy obtained by calling umockcall_clone and release the shared call by calling umockcall_destroy. ]*/
+TEST_FUNCTION(umockcallrecorder_fail_call_on_a_shared_call_fails_a_copy_of_the_call)
 {
     // arrange
     int result;
-    int can_call_fail;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
-    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
+    umockcall_is_shared_call_result = 1;
+    umockcall_clone_call_result = test_expected_umockcall_3;
 
     // act
-    umockcall_get_call_can_fail_result = 0;
-    result = umockcallrecorder_can_call_fail(call_recorder, 0, &can_call_fail);
+    result = umockcallrecorder_fail_call(call_recorder, 0);
 
     // assert
     ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(int, 0, can_call_fail);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_is_shared.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[1].u.umockcall_clone.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_set_fail_call, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_3, mocked_calls[3].u.umockcall_set_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(int, 1, mocked_calls[3].u.umockcall_set_fail_call.fail_call);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
-TEST_FUNCTION(umockcallrecorder_can_call_fail_index_0_caller_sets_1)
+/* Tests_SRS_UMOCKCALLRECORDER_01_118: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_fail_call shall return a non-zero value. ]*/
+TEST_FUNCTION(when_umockcall_is_shared_fails_umockcallrecorder_fail_call_fails)
 {
     // arrange
     int result;
-    int can_call_fail;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
-    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
+    umockcall_is_shared_call_result = -1;
 
     // act
-    umockcall_get_call_can_fail_result = 1;
-    result = umockcallrecorder_can_call_fail(call_recorder, 0, &can_call_fail);
+    result = umockcallrecorder_fail_call(call_recorder, 0);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(int, 1, can_call_fail);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
-/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
-TEST_FUNCTION(umockcallrecorder_can_call_fail_index_1_caller_sets_1)
+/* Tests_SRS_UMOCKCALLRECORDER_01_118: [ If umockcall_is_shared or umockcall_clone fails, umockcallrecorder_fail_call shall return a non-zero value. ]*/
+TEST_FUNCTION(when_copying_the_shared_call_fails_umockcallrecorder_fail_call_fails)
 {
     // arrange
     int result;
-    int can_call_fail;
     UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
     (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
-    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
     reset_all_calls();
+    umockcall_is_shared_call_result = 1;
+    umockcall_clone_call_result = NULL;
 
     // act
-    umockcall_get_call_can_fail_result = 1;
-    result = umockcallrecorder_can_call_fail(call_recorder, 1, &can_call_fail);
+    result = umockcallrecorder_fail_call(call_recorder, 0);
 
     // assert
-    ASSERT_ARE_EQUAL(int, 0, result);
-    ASSERT_ARE_EQUAL(int, 1, can_call_fail);
-    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
-    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
-    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_is_shared, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_clone, mocked_calls[1].call_type);
 
     // cleanup
     umockcallrecorder_destroy(call_recorder);
 }
 
-/* Tests_SRS_UMOCKCALLRECORDER_31_056: [ If umock_call_recorder or call_can_fail is NULL, umockcallrecorder_can_call_fail shall return a non-zero value. ]*/
+/* umockcallrecorder_can_call_fail */
+
+/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_can_call_fail_index_0_caller_sets_0)
+{
+    // arrange
+    int result;
+    int can_call_fail;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+
+    // act
+    umockcall_get_call_can_fail_result = 0;
+    result = umockcallrecorder_can_call_fail(call_recorder, 0, &can_call_fail);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, can_call_fail);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_can_call_fail_index_0_caller_sets_1)
+{
+    // arrange
+    int result;
+    int can_call_fail;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+
+    // act
+    umockcall_get_call_can_fail_result = 1;
+    result = umockcallrecorder_can_call_fail(call_recorder, 0, &can_call_fail);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, can_call_fail);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_31_061: [ umockcallrecorder_can_call_fail shall determine whether given call can fail or not by calling umockcall_get_call_can_fail. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_059: [ umockcallrecorder_can_call_fail shall return in the can_call_fail argument whether the call can fail or not. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_31_060: [ On success umockcallrecorder_can_call_fail shall return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_can_call_fail_index_1_caller_sets_1)
+{
+    // arrange
+    int result;
+    int can_call_fail;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+
+    // act
+    umockcall_get_call_can_fail_result = 1;
+    result = umockcallrecorder_can_call_fail(call_recorder, 1, &can_call_fail);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 1, can_call_fail);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_call_can_fail, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[0].u.umockcall_get_call_can_fail.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_31_056: [ If umock_call_recorder or call_can_fail is NULL, umockcallrecorder_can_call_fail shall return a non-zero value. ]*/
 TEST_FUNCTION(umockcallrecorder_can_call_fail_with_NULL_call_recorder_fails)
 {
     // arrange
@@ -2788,4 +3693,2560 @@ TEST_FUNCTION(umockcallrecorder_can_call_fail_with_lock_functions_setup_locks_an
     umockcallrecorder_destroy(call_recorder);
 }
 
+/* umockcallrecorder_enable_per_thread_actual_calls */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_119: [ If umock_call_recorder is NULL, umockcallrecorder_enable_per_thread_actual_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_enable_per_thread_actual_calls_with_NULL_call_recorder_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umockcallrecorder_enable_per_thread_actual_calls(NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_121: [ umockcallrecorder_enable_per_thread_actual_calls shall make all subsequent umockcallrecorder_add_actual_call calls record the actual calls per thread and return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_enable_per_thread_actual_calls_succeeds)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_enable_per_thread_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_122: [ If recording per thread is already enabled, umockcallrecorder_enable_per_thread_actual_calls shall leave it enabled and return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_enable_per_thread_actual_calls_twice_succeeds)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_enable_per_thread_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // the buffer registered before is still used by this thread
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call));
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_120: [ If a lock was created for the call recorder, umockcallrecorder_enable_per_thread_actual_calls shall acquire the lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_123: [ If a lock was created for the call recorder, umockcallrecorder_enable_per_thread_actual_calls shall release the exclusive lock. ]*/
+TEST_FUNCTION(umockcallrecorder_enable_per_thread_actual_calls_with_lock_functions_set_locks_and_unlocks)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_enable_per_thread_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_124: [ umockcallrecorder_add_actual_call shall append mock_call to the buffer of the calling thread, together with a sequence number obtained by atomically incrementing a counter shared by all the threads of the call recorder. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_125: [ The first time a thread adds an actual call, umockcallrecorder_add_actual_call shall look up or create the buffer of the thread while holding the call recorder lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_127: [ When recording per thread is enabled, umockcallrecorder_add_actual_call shall set matched_call to NULL, as the call is only matched against the expected calls when merged. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_per_thread_buffers_the_call_without_matching_it)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call = test_expected_umockcall_2;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_124: [ umockcallrecorder_add_actual_call shall append mock_call to the buffer of the calling thread, together with a sequence number obtained by atomically incrementing a counter shared by all the threads of the call recorder. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_per_thread_a_second_time_reuses_the_thread_buffer)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_125: [ The first time a thread adds an actual call, umockcallrecorder_add_actual_call shall look up or create the buffer of the thread while holding the call recorder lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_126: [ If lock_factory_create_lock was given to umockcallrecorder_create, each thread buffer shall have its own lock created by calling lock_factory_create_lock. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_per_thread_with_lock_functions_creates_a_lock_for_the_thread)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, (void*)0x4247);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 8, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_factory_create_lock, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)0x4247, mocked_calls[3].u.test_lock_factory_create_lock.params);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[6].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[7].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_124: [ umockcallrecorder_add_actual_call shall append mock_call to the buffer of the calling thread, together with a sequence number obtained by atomically incrementing a counter shared by all the threads of the call recorder. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_per_thread_a_second_time_only_locks_the_thread_buffer)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_128: [ If creating or growing the buffer of the thread fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_thread_buffer_fails_umockcallrecorder_add_actual_call_per_thread_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    reset_all_calls();
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_128: [ If creating or growing the buffer of the thread fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_creating_the_thread_lock_fails_umockcallrecorder_add_actual_call_per_thread_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    reset_all_calls();
+    test_lock_factory_create_lock_result = NULL;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_factory_create_lock, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[5].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_128: [ If creating or growing the buffer of the thread fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_thread_buffer_fails_umockcallrecorder_add_actual_call_per_thread_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    reset_all_calls();
+    when_shall_realloc_fail = 2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_129: [ The calls buffered by all the threads shall be merged in the order of their sequence numbers, each call being matched against the expected calls exactly like umockcallrecorder_add_actual_call does when recording per thread is not enabled. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_merges_the_per_thread_calls_in_order)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[1].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[3].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_129: [ The calls buffered by all the threads shall be merged in the order of their sequence numbers, each call being matched against the expected calls exactly like umockcallrecorder_add_actual_call does when recording per thread is not enabled. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_matches_the_per_thread_calls)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+    ASSERT_ARE_EQUAL(size_t, 8, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_are_equal.right);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[3].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_fail_call, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[4].u.umockcall_get_fail_call.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_has_call_results, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[5].u.umockcall_get_has_call_results.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[6].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[7].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_182: [ If a buffered call matches an expected call that has fail_call set or that hands values back to the actual call (umockcall_get_has_call_results returns a non-zero value), the remaining calls shall still be merged and the function that triggered the merge shall fail, since the call was made without seeing the expected call it matched. ]*/
+TEST_FUNCTION(when_a_per_thread_call_matches_an_expected_call_with_call_results_umockcallrecorder_get_expected_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call));
+    reset_all_calls();
+    umockcall_get_has_call_results_call_result = 1;
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_has_call_results, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[5].u.umockcall_get_has_call_results.umockcall);
+    // the call that does not match any expected call is still merged
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", umockcallrecorder_get_actual_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_182: [ If a buffered call matches an expected call that has fail_call set or that hands values back to the actual call (umockcall_get_has_call_results returns a non-zero value), the remaining calls shall still be merged and the function that triggered the merge shall fail, since the call was made without seeing the expected call it matched. ]*/
+TEST_FUNCTION(when_a_per_thread_call_matches_an_expected_call_that_has_fail_call_set_umockcallrecorder_get_actual_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_fail_call_call_result = 1;
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_fail_call, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[4].u.umockcall_get_fail_call.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_182: [ If a buffered call matches an expected call that has fail_call set or that hands values back to the actual call (umockcall_get_has_call_results returns a non-zero value), the remaining calls shall still be merged and the function that triggered the merge shall fail, since the call was made without seeing the expected call it matched. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_after_a_failed_merge_of_a_call_with_call_results_succeeds)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    umockcall_get_has_call_results_call_result = 1;
+    ASSERT_IS_NULL(umockcallrecorder_get_actual_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_129: [ The calls buffered by all the threads shall be merged in the order of their sequence numbers, each call being matched against the expected calls exactly like umockcallrecorder_add_actual_call does when recording per thread is not enabled. ]*/
+TEST_FUNCTION(umockcallrecorder_add_expected_call_merges_the_per_thread_calls_before_adding_the_expected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // the actual call is recorded as unexpected, without being compared with the expected call added after it
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_130: [ While merging, the lock of each thread buffer shall be held, so that no call is appended during the merge. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_with_lock_functions_locks_the_thread_buffers_while_merging)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
+    ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[6].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+TEST_FUNCTION(when_matching_a_per_thread_call_fails_umockcallrecorder_get_actual_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_are_equal_call_result = -1;
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[2].u.umockcall_destroy.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_132: [ umockcallrecorder_reset_all_calls shall free the actual calls buffered by the threads and not yet merged. ]*/
+TEST_FUNCTION(umockcallrecorder_reset_all_calls_frees_the_per_thread_calls)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_reset_all_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[0].u.umockcall_destroy.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_133: [ umockcallrecorder_destroy shall free the buffers of the threads and destroy their locks. ]*/
+TEST_FUNCTION(umockcallrecorder_destroy_frees_the_thread_buffers_and_their_locks)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    umockcallrecorder_destroy(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 9, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_destroy, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[6].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_destroy, mocked_calls[7].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[8].call_type);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_134: [ If recording per thread is enabled, umockcallrecorder_clone shall first merge the calls buffered by the threads while holding the lock of umock_call_recorder in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_135: [ If recording per thread is enabled for umock_call_recorder, it shall also be enabled for the cloned call recorder. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_merges_the_per_thread_calls_and_keeps_recording_per_thread)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_enable_per_thread_actual_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[4].u.umockcall_share.umockcall);
+
+    // the clone buffers the actual calls too
+    reset_all_calls();
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(result, test_actual_umockcall_2, &matched_call));
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_136: [ If a lock was created for the call recorder, recording per thread is not enabled and no expected call can match, umockcallrecorder_add_actual_call shall set matched_call to NULL and append mock_call to the unexpected actual calls log without acquiring the lock. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_139: [ A segment shall be allocated by the first thread that needs it and published by an atomic compare-exchange, a thread that loses the race shall free its segment and use the published one. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_and_no_expected_calls_does_not_take_the_lock)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call = test_expected_umockcall_2;
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(size_t, 64 * sizeof(UMOCKCALL_HANDLE), mocked_calls[0].u.mock_malloc.size);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_138: [ The call shall be stored in the next slot of the log, the slot being reserved by an atomic compare-exchange of the log call count, so that many threads can record calls concurrently. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_and_no_expected_calls_a_second_time_reuses_the_log_segment)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_140: [ If allocating a segment of the unexpected actual calls log fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_log_segment_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    reset_all_calls();
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_138: [ The call shall be stored in the next slot of the log, the slot being reserved by an atomic compare-exchange of the log call count, so that many threads can record calls concurrently. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+TEST_FUNCTION(umockcallrecorder_get_actual_calls_returns_the_calls_logged_in_more_than_one_segment_in_order)
+{
+    // arrange
+    const char* result;
+    size_t i;
+    size_t stringified_call_count = 0;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    reset_all_calls();
+    for (i = 0; i < 65; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, (UMOCKCALL_HANDLE)(uintptr_t)(0x5000 + i), &matched_call));
+    }
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(size_t, 64 * sizeof(UMOCKCALL_HANDLE), mocked_calls[0].u.mock_malloc.size);
+    ASSERT_ARE_EQUAL(size_t, 128 * sizeof(UMOCKCALL_HANDLE), mocked_calls[1].u.mock_malloc.size);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    for (i = 0; i < mocked_call_count; i++)
+    {
+        if (mocked_calls[i].call_type == TEST_MOCK_CALL_TYPE_umockcall_stringify_append)
+        {
+            ASSERT_ARE_EQUAL(void_ptr, (void*)(uintptr_t)(0x5000 + stringified_call_count), mocked_calls[i].u.umockcall_stringify_append.umockcall);
+            stringified_call_count++;
+        }
+    }
+    ASSERT_ARE_EQUAL(size_t, 65, stringified_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_137: [ The number of expected calls that an actual call could match (the expected calls starting with the first unmatched expected call plus the expected calls before it that have ignore_all_calls set) shall be kept in a counter that is updated atomically whenever expected calls are added, matched, reset or cloned. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_does_not_take_the_lock_once_all_expected_calls_are_matched)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    umockcall_are_equal_call_result = 1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    // this call finds out that the expected call was matched
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_137: [ The number of expected calls that an actual call could match (the expected calls starting with the first unmatched expected call plus the expected calls before it that have ignore_all_calls set) shall be kept in a counter that is updated atomically whenever expected calls are added, matched, reset or cloned. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_with_lock_functions_takes_the_lock_while_an_ignore_all_calls_expected_call_is_there)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[3].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[5].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+TEST_FUNCTION(umockcallrecorder_add_expected_call_merges_the_logged_calls_before_adding_the_expected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    // the actual call is recorded as unexpected, without being compared with the expected call added after it
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_181: [ A call in the unexpected actual calls log shall never match an expected call, since it was logged when no expected call could match and any expected call added meanwhile was added after it. ]*/
+TEST_FUNCTION(an_expected_call_added_after_add_actual_call_checked_that_no_expected_call_can_match_is_not_matched_by_the_logged_call)
+{
+    // arrange
+    const char* result;
+    size_t i;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    reset_all_calls();
+    // the expected call is added while the log segment is allocated, after the check and before the call is logged
+    malloc_add_expected_call_recorder = call_recorder;
+    malloc_add_expected_call = test_expected_umockcall_1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_IS_NULL(malloc_add_expected_call_recorder);
+    ASSERT_IS_NULL(matched_call);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
+    for (i = 0; i < mocked_call_count; i++)
+    {
+        ASSERT_ARE_NOT_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[i].call_type);
+    }
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", umockcallrecorder_get_expected_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_141: [ The calls in the unexpected actual calls log shall be merged in the order of their slots, each call being appended to the actual calls without being matched against the expected calls. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_with_the_lock_merges_the_logged_calls_first)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", result);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[1].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_2, mocked_calls[3].u.umockcall_stringify_append.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_142: [ Once all the calls in the log are merged, the log shall be rewound by an atomic compare-exchange of the log call count with 0, so that its segments are reused. ]*/
+TEST_FUNCTION(umockcallrecorder_add_actual_call_after_the_log_was_merged_reuses_the_log_segment)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_IS_NOT_NULL(umockcallrecorder_get_expected_calls(call_recorder));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", umockcallrecorder_get_actual_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_131: [ If matching a buffered call fails, the call shall be freed by calling umockcall_destroy, the remaining calls shall still be merged and the function that triggered the merge shall fail. ]*/
+TEST_FUNCTION(when_adding_a_logged_call_to_the_actual_calls_fails_umockcallrecorder_get_actual_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[2].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_143: [ umockcallrecorder_reset_all_calls shall free the actual calls in the unexpected actual calls log that were not yet merged. ]*/
+TEST_FUNCTION(umockcallrecorder_reset_all_calls_frees_the_logged_calls)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_reset_all_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[1].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_144: [ umockcallrecorder_destroy shall free the segments of the unexpected actual calls log. ]*/
+TEST_FUNCTION(umockcallrecorder_destroy_frees_the_logged_calls_and_the_log_segments)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    umockcallrecorder_destroy(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[0].u.umockcall_destroy.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_145: [ If the unexpected actual calls log has calls that were not merged, umockcallrecorder_clone shall first merge them while holding the lock of umock_call_recorder in exclusive mode. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_merges_the_logged_calls)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 10, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_shared, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_share, mocked_calls[8].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, test_actual_umockcall_1, mocked_calls[8].u.umockcall_share.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_shared, mocked_calls[9].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_146: [ umockcallrecorder_add_actual_call shall count the actual calls matched with each expected call and shall consider the expected call matched once it was matched max_repeat_count times, max_repeat_count being obtained by calling umockcall_get_repeat_count. ]*/
+TEST_FUNCTION(an_expected_call_with_a_repeat_count_is_matched_by_as_many_actual_calls)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(char_ptr, "", umockcallrecorder_get_expected_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_146: [ umockcallrecorder_add_actual_call shall count the actual calls matched with each expected call and shall consider the expected call matched once it was matched max_repeat_count times, max_repeat_count being obtained by calling umockcall_get_repeat_count. ]*/
+TEST_FUNCTION(an_actual_call_after_max_repeat_count_matches_is_an_unexpected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = 2;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = 2;
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_147: [ If the actual call does not match the first unmatched expected call and that expected call was already matched at least min_repeat_count times, the expected call shall be considered matched and the actual call shall be compared with the expected calls after it. ]*/
+TEST_FUNCTION(an_actual_call_not_matching_a_repeated_call_matched_min_repeat_count_times_is_compared_with_the_next_expected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 1;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 1;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[4].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[5].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[6].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_147: [ If the actual call does not match the first unmatched expected call and that expected call was already matched at least min_repeat_count times, the expected call shall be considered matched and the actual call shall be compared with the expected calls after it. ]*/
+TEST_FUNCTION(an_actual_call_not_matching_a_repeated_call_matched_less_than_min_repeat_count_times_is_an_unexpected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = 2;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = 2;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_147: [ If the actual call does not match the first unmatched expected call and that expected call was already matched at least min_repeat_count times, the expected call shall be considered matched and the actual call shall be compared with the expected calls after it. ]*/
+TEST_FUNCTION(an_expected_call_with_0_min_repeat_count_can_be_skipped)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 0;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(char_ptr, "", umockcallrecorder_get_expected_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_148: [ If umockcall_get_repeat_count fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_repeat_count_of_the_matched_call_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_get_repeat_count_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_148: [ If umockcall_get_repeat_count fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_repeat_count_of_a_not_matching_call_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_are_equal_call_result = 0;
+    umockcall_get_repeat_count_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_150: [ For an expected call whose repeat count is not exactly 1, the stringified call shall be followed by " N remaining", where N is the number of calls still needed to reach min_repeat_count. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_reports_the_remaining_count_of_a_repeated_call)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] 2 remaining", result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_append, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_149: [ Expected calls that were matched at least min_repeat_count times shall not be reported in the expected call list. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_does_not_report_a_repeated_call_matched_min_repeat_count_times)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 2;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_149: [ Expected calls that were matched at least min_repeat_count times shall not be reported in the expected call list. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_does_not_report_a_repeated_call_with_0_min_repeat_count)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 0;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_152: [ When the number of remaining calls of an expected call that was already stringified changes, umockcallrecorder_get_expected_calls shall stringify that call and the calls after it again. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_updates_the_remaining_count_of_a_cached_call)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] 3 remaining[a()]", umockcallrecorder_get_expected_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] 2 remaining[a()]", result);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, mocked_calls[2].u.umockcall_stringify_append.umockcall);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, mocked_calls[5].u.umockcall_stringify_append.umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_151: [ If umockcall_get_repeat_count fails, umockcallrecorder_get_expected_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(when_getting_the_repeat_count_fails_umockcallrecorder_get_expected_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+    umockcall_get_repeat_count_call_result = 1;
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_153: [ umockcallrecorder_clone shall also copy the number of actual calls matched with each expected call. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_copies_the_match_count_of_the_expected_calls)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 3;
+    umockcall_get_repeat_count_max_repeat_count = 3;
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] 2 remaining", umockcallrecorder_get_expected_calls(result));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* umockcallrecorder_begin_unordered_expected_calls */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_154: [ If umock_call_recorder is NULL, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_begin_unordered_expected_calls_with_NULL_call_recorder_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umockcallrecorder_begin_unordered_expected_calls(NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_156: [ umockcallrecorder_begin_unordered_expected_calls shall open a new unordered group, to which all the expected calls added until umockcallrecorder_end_unordered_expected_calls is called are added, and return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_begin_unordered_expected_calls_succeeds)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_begin_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_157: [ If an unordered group is already open, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_begin_unordered_expected_calls_while_a_group_is_open_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_begin_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_158: [ If allocating memory for the unordered group fails, umockcallrecorder_begin_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_unordered_group_fails_umockcallrecorder_begin_unordered_expected_calls_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    reset_all_calls();
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_begin_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+
+    // no group is open
+    ASSERT_ARE_NOT_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_155: [ If a lock was created for the call recorder, umockcallrecorder_begin_unordered_expected_calls shall acquire the lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_159: [ If a lock was created for the call recorder, umockcallrecorder_begin_unordered_expected_calls shall release the exclusive lock. ]*/
+TEST_FUNCTION(umockcallrecorder_begin_unordered_expected_calls_with_lock_functions_set_locks_and_unlocks)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_begin_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[2].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* umockcallrecorder_end_unordered_expected_calls */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_160: [ If umock_call_recorder is NULL, umockcallrecorder_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_end_unordered_expected_calls_with_NULL_call_recorder_fails)
+{
+    // arrange
+    int result;
+
+    // act
+    result = umockcallrecorder_end_unordered_expected_calls(NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_162: [ umockcallrecorder_end_unordered_expected_calls shall close the open unordered group, so that the expected calls added afterwards are matched in order again, and return 0. ]*/
+TEST_FUNCTION(umockcallrecorder_end_unordered_expected_calls_succeeds)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_end_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // the expected calls added afterwards are not added to the group
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1));
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_163: [ If no unordered group is open, umockcallrecorder_end_unordered_expected_calls shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockcallrecorder_end_unordered_expected_calls_without_an_open_group_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_end_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, mocked_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_161: [ If a lock was created for the call recorder, umockcallrecorder_end_unordered_expected_calls shall acquire the lock in exclusive mode. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_164: [ If a lock was created for the call recorder, umockcallrecorder_end_unordered_expected_calls shall release the exclusive lock. ]*/
+TEST_FUNCTION(umockcallrecorder_end_unordered_expected_calls_with_lock_functions_set_locks_and_unlocks)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(test_lock_factory_create_lock, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_end_unordered_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_acquire_exclusive, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_test_lock_release_exclusive, mocked_calls[1].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* unordered groups */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_165: [ If an unordered group is open, umockcallrecorder_add_expected_call shall add mock_call to the group, indexing it by the hash of its function name obtained by calling umockcall_get_function_name_hash. ]*/
+TEST_FUNCTION(umockcallrecorder_add_expected_call_adds_the_call_to_the_open_unordered_group)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[3].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_166: [ If adding mock_call to the open unordered group fails, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_function_name_hash_fails_umockcallrecorder_add_expected_call_fails)
+{
+    // arrange
+    int result;
+    size_t expected_call_count;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    umockcall_get_function_name_hash_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_get_expected_call_count(call_recorder, &expected_call_count));
+    ASSERT_ARE_EQUAL(size_t, 0, expected_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_166: [ If adding mock_call to the open unordered group fails, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_buckets_of_the_unordered_group_fails_umockcallrecorder_add_expected_call_fails)
+{
+    // arrange
+    int result;
+    size_t expected_call_count;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_get_expected_call_count(call_recorder, &expected_call_count));
+    ASSERT_ARE_EQUAL(size_t, 0, expected_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_166: [ If adding mock_call to the open unordered group fails, umockcallrecorder_add_expected_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_calls_of_the_unordered_group_fails_umockcallrecorder_add_expected_call_fails)
+{
+    // arrange
+    int result;
+    size_t expected_call_count;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    when_shall_realloc_fail = 2;
+
+    // act
+    result = umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_get_expected_call_count(call_recorder, &expected_call_count));
+    ASSERT_ARE_EQUAL(size_t, 0, expected_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_167: [ When the first unmatched expected call is in an unordered group, the actual call shall only be compared with the calls of the group that have the same function name hash and can still be matched, in the order they were added, the first equal call being the matched call. ]*/
+TEST_FUNCTION(an_actual_call_matching_the_second_call_of_an_unordered_group_is_matched)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 7, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_1, mocked_calls[0].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[4].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[5].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[6].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_167: [ When the first unmatched expected call is in an unordered group, the actual call shall only be compared with the calls of the group that have the same function name hash and can still be matched, in the order they were added, the first equal call being the matched call. ]*/
+TEST_FUNCTION(an_actual_call_is_not_compared_with_the_calls_of_an_unordered_group_with_a_different_function_name_hash)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    umockcall_get_function_name_hash_other_function_call = test_expected_umockcall_1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    umockcall_get_function_name_hash_other_function_call = test_expected_umockcall_1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[1].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[2].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_167: [ When the first unmatched expected call is in an unordered group, the actual call shall only be compared with the calls of the group that have the same function name hash and can still be matched, in the order they were added, the first equal call being the matched call. ]*/
+TEST_FUNCTION(a_matched_call_of_an_unordered_group_is_not_compared_again)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[1].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[2].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[3].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[5].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_167: [ When the first unmatched expected call is in an unordered group, the actual call shall only be compared with the calls of the group that have the same function name hash and can still be matched, in the order they were added, the first equal call being the matched call. ]*/
+TEST_FUNCTION(the_calls_of_an_unordered_group_that_outgrows_its_index_are_still_matched)
+{
+    // arrange
+    size_t i;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    for (i = 0; i < 20; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_expected_call(call_recorder, (UMOCKCALL_HANDLE)(0x5000 + i)));
+    }
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+
+    // act
+    // assert
+    for (i = 0; i < 20; i++)
+    {
+        /* match the calls in reverse order */
+        umockcall_are_equal_only_matching_call = (UMOCKCALL_HANDLE)(0x5000 + 19 - i);
+        ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(0x5000 + 19 - i), matched_call);
+    }
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_168: [ If the actual call does not match any call of the unordered group and every call of the group was matched at least min_repeat_count times or has ignore_all_calls set, the group shall be done, all its calls shall be considered matched and the actual call shall be compared with the expected calls after the group. ]*/
+TEST_FUNCTION(an_actual_call_not_matching_a_satisfied_unordered_group_is_compared_with_the_next_expected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 1;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_get_repeat_count_repeated_call = test_expected_umockcall_1;
+    umockcall_get_repeat_count_min_repeat_count = 1;
+    umockcall_get_repeat_count_max_repeat_count = UMOCKCALL_UNLIMITED_REPEAT_COUNT;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 10, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[4].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[6].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[7].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[7].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[8].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[9].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_168: [ If the actual call does not match any call of the unordered group and every call of the group was matched at least min_repeat_count times or has ignore_all_calls set, the group shall be done, all its calls shall be considered matched and the actual call shall be compared with the expected calls after the group. ]*/
+TEST_FUNCTION(an_actual_call_not_matching_an_unsatisfied_unordered_group_is_an_unexpected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_3);
+    reset_all_calls();
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_3;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 8, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[5].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[6].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[6].u.umockcall_get_repeat_count.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[7].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_169: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_function_name_hash_of_the_actual_call_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    umockcall_get_function_name_hash_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_170: [ When an expected call of an unordered group that was already stringified is matched, umockcallrecorder_get_expected_calls shall stringify that call and the calls after it again. ]*/
+TEST_FUNCTION(umockcallrecorder_get_expected_calls_does_not_report_a_call_of_an_unordered_group_matched_out_of_order)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()][a()]", umockcallrecorder_get_expected_calls(call_recorder));
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_expected_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_171: [ umockcallrecorder_clone shall copy the unordered groups and which unordered group is open, if any. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_copies_the_unordered_groups)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(result, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    // the group is still open in the clone
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(result));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+TEST_FUNCTION(when_copying_the_unordered_groups_fails_umockcallrecorder_clone_fails)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    reset_all_calls();
+    /* the 1st malloc is the call recorder, the 2nd the expected calls, the 3rd the groups and the 4th the calls of the group */
+    when_shall_malloc_fail = 4;
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_172: [ umockcallrecorder_reset_all_calls shall free the unordered groups and close the open unordered group, if any. ]*/
+TEST_FUNCTION(umockcallrecorder_reset_all_calls_frees_the_unordered_groups)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_reset_all_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
+    // no group is open anymore
+    ASSERT_ARE_NOT_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_173: [ When an expected call that has ignore_all_calls set ends up before the first unmatched expected call, umockcallrecorder_add_actual_call shall obtain the hash of its function name by calling umockcall_get_function_name_hash and add it to the index of the ignore_all_calls expected calls. ]*/
+TEST_FUNCTION(an_expected_call_with_ignore_all_calls_that_is_passed_is_indexed_by_its_function_name_hash)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_1, mocked_calls[2].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_malloc, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[5].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_174: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_function_name_hash_of_an_ignore_all_calls_expected_call_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    umockcall_get_function_name_hash_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_176: [ If growing the index fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_the_ignore_all_calls_index_fails_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    when_shall_malloc_fail = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_178: [ The actual call shall only be compared with the ignore_all_calls expected calls that have the same function name hash. ]*/
+TEST_FUNCTION(an_actual_call_is_not_compared_with_the_ignore_all_calls_expected_calls_with_a_different_function_name_hash)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_get_function_name_hash_other_function_call = test_actual_umockcall_2;
+    umockcall_are_equal_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[0].u.umockcall_get_function_name_hash.umockcall);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[1].u.umockcall_get_ignore_all_calls.call);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[2].u.umockcall_are_equal.left);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_repeat_count, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[4].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_169: [ If umockcall_get_function_name_hash fails, umockcallrecorder_add_actual_call shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_getting_the_function_name_hash_of_the_actual_call_fails_with_an_indexed_ignore_all_calls_call_umockcallrecorder_add_actual_call_fails)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    umockcall_get_function_name_hash_call_result = 1;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_177: [ The hash of the function name of the actual call shall be obtained by calling umockcall_get_function_name_hash at most once per actual call, and only when it is needed to look up the ignore_all_calls expected calls or an unordered group. ]*/
+TEST_FUNCTION(the_function_name_hash_of_the_actual_call_is_obtained_once_for_the_ignore_all_calls_index_and_an_unordered_group)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    size_t i;
+    size_t hash_call_count = 0;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_2;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_2, matched_call);
+    for (i = 0; i < mocked_call_count; i++)
+    {
+        if (mocked_calls[i].call_type == TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash)
+        {
+            hash_call_count++;
+        }
+    }
+    ASSERT_ARE_EQUAL(size_t, 1, hash_call_count);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_175: [ The index shall have at least as many buckets as indexed calls, its buckets being reallocated geometrically when it is full. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_099: [ The expected calls before the first unmatched expected call that have ignore_all_calls set shall be compared first, in the order they were added. ]*/
+TEST_FUNCTION(growing_the_ignore_all_calls_index_keeps_the_calls_in_the_order_they_were_added)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    size_t i;
+    size_t malloc_count = 0;
+    for (i = 0; i < 20; i++)
+    {
+        (void)umockcallrecorder_add_expected_call(call_recorder, (UMOCKCALL_HANDLE)(0x5000 + i));
+    }
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_call_result = 1;
+    umockcall_are_equal_call_result = 0;
+    // all the expected calls are passed and indexed
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    for (i = 0; i < mocked_call_count; i++)
+    {
+        if (mocked_calls[i].call_type == TEST_MOCK_CALL_TYPE_mock_malloc)
+        {
+            malloc_count++;
+        }
+    }
+    ASSERT_IS_TRUE(malloc_count <= 3);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_call_result = 1;
+    umockcall_are_equal_call_result = 0;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 21, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_function_name_hash, mocked_calls[0].call_type);
+    for (i = 0; i < 20; i++)
+    {
+        ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1 + i].call_type);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(0x5000 + i), mocked_calls[1 + i].u.umockcall_are_equal.left);
+    }
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_179: [ umockcallrecorder_clone shall copy the index of the ignore_all_calls expected calls. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_copies_the_ignore_all_calls_index)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(result, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+TEST_FUNCTION(when_copying_the_ignore_all_calls_index_fails_umockcallrecorder_clone_fails)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_call_result = 1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+    /* the 1st malloc is the call recorder, the 2nd the expected calls and the 3rd the ignore all calls index */
+    when_shall_malloc_fail = 3;
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_180: [ umockcallrecorder_reset_all_calls shall free the index of the ignore_all_calls expected calls. ]*/
+TEST_FUNCTION(umockcallrecorder_reset_all_calls_frees_the_ignore_all_calls_index)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_reset_all_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
+    // a new call with ignore_all_calls set is indexed again
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_get_ignore_all_calls_ignore_all_call = test_expected_umockcall_1;
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    ASSERT_ARE_EQUAL(void_ptr, test_expected_umockcall_1, matched_call);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* mismatch description of the first actual call */
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+/* Tests_SRS_UMOCKCALLRECORDER_01_184: [ If a mismatch description was kept for the first actual call, the stringified first actual call shall be followed by a space and the description. ]*/
+TEST_FUNCTION(the_mismatch_description_of_the_first_actual_call_is_appended_to_the_actual_calls_string)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] mismatch", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+TEST_FUNCTION(the_mismatch_of_the_first_actual_call_is_described_against_the_first_unmatched_expected_call)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    umockcall_are_equal_only_matching_call = test_expected_umockcall_1;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_are_equal_call_result = 0;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(matched_call);
+    ASSERT_ARE_EQUAL(size_t, 6, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_stringify_mismatch, mocked_calls[4].call_type);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_expected_umockcall_2, mocked_calls[4].u.umockcall_stringify_mismatch.expected_umockcall);
+    ASSERT_ARE_EQUAL(void_ptr, (void*)test_actual_umockcall_2, mocked_calls[4].u.umockcall_stringify_mismatch.actual_umockcall);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+TEST_FUNCTION(the_second_unexpected_actual_call_is_not_described)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_are_equal_call_result = 0;
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_2, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 2, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_get_ignore_all_calls, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_are_equal, mocked_calls[1].call_type);
+    // the description of the first actual call is kept
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] mismatch[a()]", umockcallrecorder_get_actual_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+TEST_FUNCTION(an_unexpected_actual_call_with_no_expected_calls_is_not_described)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_realloc, mocked_calls[0].call_type);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_183: [ If the unexpected call is the first actual call and the first unmatched expected call is not part of an unordered group, umockcallrecorder_add_actual_call shall describe why the 2 calls differ by calling umockcall_stringify_mismatch and keep the description. ]*/
+TEST_FUNCTION(an_unexpected_actual_call_is_not_described_against_an_unordered_group)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_begin_unordered_expected_calls(call_recorder));
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_2);
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_end_unordered_expected_calls(call_recorder));
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    umockcall_stringify_append_call_result = "[a()]";
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_026: [ If allocating memory for the resulting string fails, umockcallrecorder_get_actual_calls shall fail and return NULL. ]*/
+TEST_FUNCTION(when_appending_the_mismatch_description_fails_umockcallrecorder_get_actual_calls_fails)
+{
+    // arrange
+    const char* result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    umockcall_stringify_append_call_result = "[a()]";
+    /* the 1st realloc makes room for the call, the 2nd for the description */
+    when_shall_realloc_fail = 2;
+
+    // act
+    result = umockcallrecorder_get_actual_calls(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    // the call is not left behind half stringified
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] mismatch", umockcallrecorder_get_actual_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_185: [ umockcallrecorder_reset_all_calls shall free the mismatch description of the first actual call. ]*/
+TEST_FUNCTION(umockcallrecorder_reset_all_calls_frees_the_mismatch_description)
+{
+    // arrange
+    int result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_reset_all_calls(call_recorder);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 5, mocked_call_count);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[0].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[1].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_umockcall_destroy, mocked_calls[2].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[3].call_type);
+    ASSERT_ARE_EQUAL(TEST_MOCK_CALL_TYPE, TEST_MOCK_CALL_TYPE_mock_free, mocked_calls[4].call_type);
+    // a new unexpected call is reported without the old description
+    (void)umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call);
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()]", umockcallrecorder_get_actual_calls(call_recorder));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_186: [ umockcallrecorder_clone shall copy the mismatch description of the first actual call. ]*/
+TEST_FUNCTION(umockcallrecorder_clone_copies_the_mismatch_description)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    umockcall_stringify_append_call_result = "[a()]";
+    ASSERT_ARE_EQUAL(char_ptr, "[a()] mismatch", umockcallrecorder_get_actual_calls(result));
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+    umockcallrecorder_destroy(result);
+}
+
+/* Tests_SRS_UMOCKCALLRECORDER_01_052: [ If any error occurs, umockcallrecorder_clone shall fail and return NULL. ]*/
+TEST_FUNCTION(when_copying_the_mismatch_description_fails_umockcallrecorder_clone_fails)
+{
+    // arrange
+    UMOCKCALLRECORDER_HANDLE result;
+    UMOCKCALLRECORDER_HANDLE call_recorder = umockcallrecorder_create(NULL, NULL);
+    UMOCKCALL_HANDLE matched_call;
+    (void)umockcallrecorder_add_expected_call(call_recorder, test_expected_umockcall_1);
+    umockcall_are_equal_call_result = 0;
+    umockcall_stringify_mismatch_call_result = "mismatch";
+    ASSERT_ARE_EQUAL(int, 0, umockcallrecorder_add_actual_call(call_recorder, test_actual_umockcall_1, &matched_call));
+    reset_all_calls();
+    /* the 1st malloc is the call recorder, the 2nd the expected calls, the 3rd the actual calls and the 4th the description */
+    when_shall_malloc_fail = 4;
+
+    // act
+    result = umockcallrecorder_clone(call_recorder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+
+    // cleanup
+    umockcallrecorder_destroy(call_recorder);
+}
+
 END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -0,0 +1,706 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "testrunnerswitcher.h"
+#include "umock_c/umockstringbuilder.h"
+
+typedef struct test_realloc_CALL_TAG
+{
+    void* ptr;
+    size_t size;
+} test_realloc_CALL;
+
+static test_realloc_CALL* test_realloc_calls;
+static size_t test_realloc_call_count;
+static size_t when_shall_realloc_fail;
+static size_t test_free_call_count;
+
+
+    void* mock_realloc(void* ptr, size_t size)
+    {
+        void* result;
+
+        test_realloc_CALL* new_calls = realloc(test_realloc_calls, sizeof(test_realloc_CALL) * (test_realloc_call_count + 1));
+        if (new_calls != NULL)
+        {
+            test_realloc_calls = new_calls;
+            test_realloc_calls[test_realloc_call_count].ptr = ptr;
+            test_realloc_calls[test_realloc_call_count].size = size;
+            test_realloc_call_count++;
+        }
+
+        if (when_shall_realloc_fail == test_realloc_call_count)
+        {
+            result = NULL;
+        }
+        else
+        {
+            result = realloc(ptr, size);
+        }
+
+        return result;
+    }
+
+    void mock_free(void* ptr)
+    {
+        test_free_call_count++;
+        free(ptr);
+    }
+
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+    when_shall_realloc_fail = 0;
+
+    test_realloc_calls = NULL;
+    test_realloc_call_count = 0;
+    test_free_call_count = 0;
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+    free(test_realloc_calls);
+    test_realloc_calls = NULL;
+    test_realloc_call_count = 0;
+}
+
+/* umockstringbuilder_init */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_001: [ umockstringbuilder_init shall initialize string_builder to an empty string without allocating any memory. ]*/
+TEST_FUNCTION(umockstringbuilder_init_initializes_an_empty_string_builder)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    string_builder.buffer = (char*)0x4242;
+    string_builder.length = 42;
+    string_builder.capacity = 43;
+
+    // act
+    umockstringbuilder_init(&string_builder);
+
+    // assert
+    ASSERT_IS_NULL(string_builder.buffer);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.capacity);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_002: [ If string_builder is NULL, umockstringbuilder_init shall return. ]*/
+TEST_FUNCTION(umockstringbuilder_init_with_NULL_string_builder_returns)
+{
+    // arrange
+
+    // act
+    umockstringbuilder_init(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* umockstringbuilder_deinit */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_003: [ umockstringbuilder_deinit shall free the memory held by string_builder and leave it as an empty string. ]*/
+TEST_FUNCTION(umockstringbuilder_deinit_frees_the_buffer)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "abc");
+
+    // act
+    umockstringbuilder_deinit(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 1, test_free_call_count);
+    ASSERT_IS_NULL(string_builder.buffer);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.capacity);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_003: [ umockstringbuilder_deinit shall free the memory held by string_builder and leave it as an empty string. ]*/
+TEST_FUNCTION(umockstringbuilder_deinit_without_any_memory_does_not_free)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    umockstringbuilder_deinit(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_004: [ If string_builder is NULL, umockstringbuilder_deinit shall return. ]*/
+TEST_FUNCTION(umockstringbuilder_deinit_with_NULL_string_builder_returns)
+{
+    // arrange
+
+    // act
+    umockstringbuilder_deinit(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+}
+
+/* umockstringbuilder_clear */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_005: [ umockstringbuilder_clear shall set the length of the string held by string_builder to 0, keeping the allocated memory so that it can be reused. ]*/
+TEST_FUNCTION(umockstringbuilder_clear_empties_the_string_and_keeps_the_memory)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    size_t capacity;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "abcdef");
+    capacity = string_builder.capacity;
+    test_realloc_call_count = 0;
+
+    // act
+    umockstringbuilder_clear(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+    ASSERT_ARE_EQUAL(size_t, capacity, string_builder.capacity);
+    ASSERT_ARE_EQUAL(char_ptr, "", umockstringbuilder_get_string(&string_builder));
+    ASSERT_ARE_EQUAL(int, 0, umockstringbuilder_append_string(&string_builder, "xyz"));
+    ASSERT_ARE_EQUAL(char_ptr, "xyz", umockstringbuilder_get_string(&string_builder));
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_006: [ If string_builder is NULL, umockstringbuilder_clear shall return. ]*/
+TEST_FUNCTION(umockstringbuilder_clear_with_NULL_string_builder_returns)
+{
+    // arrange
+
+    // act
+    umockstringbuilder_clear(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* umockstringbuilder_reserve */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_007: [ umockstringbuilder_reserve shall make sure that additional_length characters can be appended to string_builder without any further allocation and on success return 0. ]*/
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_010: [ Otherwise umockstringbuilder_reserve shall grow the buffer by calling umockalloc_realloc to the larger of the needed size and twice the current capacity. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_on_an_empty_builder_allocates_exactly_the_needed_size)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, 10);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_call_count);
+    ASSERT_IS_NULL(test_realloc_calls[0].ptr);
+    ASSERT_ARE_EQUAL(size_t, 11, test_realloc_calls[0].size);
+    ASSERT_ARE_EQUAL(size_t, 11, string_builder.capacity);
+    ASSERT_ARE_EQUAL(int, 0, umockstringbuilder_append_string(&string_builder, "0123456789"));
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_call_count);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_010: [ Otherwise umockstringbuilder_reserve shall grow the buffer by calling umockalloc_realloc to the larger of the needed size and twice the current capacity. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_doubles_the_capacity_when_that_is_enough)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "0123456789");
+    test_realloc_call_count = 0;
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 22, test_realloc_calls[0].size);
+    ASSERT_ARE_EQUAL(size_t, 22, string_builder.capacity);
+    ASSERT_ARE_EQUAL(char_ptr, "0123456789", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_010: [ Otherwise umockstringbuilder_reserve shall grow the buffer by calling umockalloc_realloc to the larger of the needed size and twice the current capacity. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_uses_the_needed_size_when_it_is_larger_than_double_the_capacity)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "ab");
+    test_realloc_call_count = 0;
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, 100);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 103, test_realloc_calls[0].size);
+    ASSERT_ARE_EQUAL(char_ptr, "ab", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_009: [ If string_builder already has room for additional_length more characters (plus the NULL terminator), umockstringbuilder_reserve shall succeed without allocating memory. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_with_enough_room_does_not_allocate)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_reserve(&string_builder, 10);
+    (void)umockstringbuilder_append_string(&string_builder, "abc");
+    test_realloc_call_count = 0;
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, 7);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_008: [ If string_builder is NULL, umockstringbuilder_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_with_NULL_string_builder_fails)
+{
+    // arrange
+
+    // act
+    int result = umockstringbuilder_reserve(NULL, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_012: [ If the needed size does not fit in a size_t, umockstringbuilder_reserve shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockstringbuilder_reserve_with_a_size_that_overflows_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "a");
+    test_realloc_call_count = 0;
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, SIZE_MAX - 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_011: [ If umockalloc_realloc fails, umockstringbuilder_reserve shall fail, leave string_builder unchanged and return a non-zero value. ]*/
+TEST_FUNCTION(when_realloc_fails_umockstringbuilder_reserve_fails_and_keeps_the_string)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    char* buffer;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "abc");
+    buffer = string_builder.buffer;
+    when_shall_realloc_fail = 2;
+
+    // act
+    result = umockstringbuilder_reserve(&string_builder, 10);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(void_ptr, buffer, string_builder.buffer);
+    ASSERT_ARE_EQUAL(size_t, 3, string_builder.length);
+    ASSERT_ARE_EQUAL(size_t, 4, string_builder.capacity);
+    ASSERT_ARE_EQUAL(char_ptr, "abc", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* umockstringbuilder_append */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_013: [ umockstringbuilder_append shall append source_length characters from source at the end of the string held by string_builder, keep the string NULL terminated and on success return 0. ]*/
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_015: [ umockstringbuilder_append shall make room for the new characters by calling umockstringbuilder_reserve. ]*/
+TEST_FUNCTION(umockstringbuilder_append_appends_the_characters)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result_1;
+    int result_2;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result_1 = umockstringbuilder_append(&string_builder, "abcdef", 3);
+    result_2 = umockstringbuilder_append(&string_builder, "xyz", 2);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result_1);
+    ASSERT_ARE_EQUAL(int, 0, result_2);
+    ASSERT_ARE_EQUAL(size_t, 5, string_builder.length);
+    ASSERT_ARE_EQUAL(char_ptr, "abcxy", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_013: [ umockstringbuilder_append shall append source_length characters from source at the end of the string held by string_builder, keep the string NULL terminated and on success return 0. ]*/
+TEST_FUNCTION(umockstringbuilder_append_with_0_length_and_NULL_source_succeeds)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_append(&string_builder, NULL, 0);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+    ASSERT_ARE_EQUAL(char_ptr, "", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_010: [ Otherwise umockstringbuilder_reserve shall grow the buffer by calling umockalloc_realloc to the larger of the needed size and twice the current capacity. ]*/
+TEST_FUNCTION(appending_many_pieces_only_reallocates_a_logarithmic_number_of_times)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    size_t i;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    for (i = 0; i < 10000; i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, umockstringbuilder_append(&string_builder, "[a()]", 5));
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 50000, string_builder.length);
+    ASSERT_IS_TRUE(test_realloc_call_count <= 20);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(string_builder.buffer + 49995, "[a()]", 6));
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_014: [ If string_builder is NULL or source is NULL while source_length is non-zero, umockstringbuilder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockstringbuilder_append_with_NULL_string_builder_fails)
+{
+    // arrange
+
+    // act
+    int result = umockstringbuilder_append(NULL, "a", 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_014: [ If string_builder is NULL or source is NULL while source_length is non-zero, umockstringbuilder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockstringbuilder_append_with_NULL_source_and_non_zero_length_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_append(&string_builder, NULL, 1);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_016: [ If umockstringbuilder_reserve fails, umockstringbuilder_append shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_reserve_fails_umockstringbuilder_append_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockstringbuilder_append(&string_builder, "abc", 3);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(string_builder.buffer);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+}
+
+/* umockstringbuilder_append_string */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_017: [ umockstringbuilder_append_string shall append the NULL terminated string source by calling umockstringbuilder_append and return its result. ]*/
+TEST_FUNCTION(umockstringbuilder_append_string_appends_the_string)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "ab");
+
+    // act
+    result = umockstringbuilder_append_string(&string_builder, "cd");
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "abcd", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_018: [ If source is NULL, umockstringbuilder_append_string shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(umockstringbuilder_append_string_with_NULL_source_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_append_string(&string_builder, NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_017: [ umockstringbuilder_append_string shall append the NULL terminated string source by calling umockstringbuilder_append and return its result. ]*/
+TEST_FUNCTION(when_append_fails_umockstringbuilder_append_string_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockstringbuilder_append_string(&string_builder, "abc");
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* umockstringbuilder_append_char */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_019: [ umockstringbuilder_append_char shall append the character c by calling umockstringbuilder_append and return its result. ]*/
+TEST_FUNCTION(umockstringbuilder_append_char_appends_the_character)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    int result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "ab");
+
+    // act
+    result = umockstringbuilder_append_char(&string_builder, ',');
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "ab,", string_builder.buffer);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_019: [ umockstringbuilder_append_char shall append the character c by calling umockstringbuilder_append and return its result. ]*/
+TEST_FUNCTION(umockstringbuilder_append_char_with_NULL_string_builder_fails)
+{
+    // arrange
+
+    // act
+    int result = umockstringbuilder_append_char(NULL, ',');
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* umockstringbuilder_get_string */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_020: [ umockstringbuilder_get_string shall return the NULL terminated string held by string_builder. The string remains owned by string_builder. ]*/
+TEST_FUNCTION(umockstringbuilder_get_string_returns_the_string)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    const char* result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "abc");
+    test_realloc_call_count = 0;
+
+    // act
+    result = umockstringbuilder_get_string(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "abc", result);
+    ASSERT_ARE_EQUAL(void_ptr, string_builder.buffer, result);
+    ASSERT_ARE_EQUAL(size_t, 0, test_realloc_call_count);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_022: [ If no memory was allocated yet for string_builder, umockstringbuilder_get_string shall allocate memory for an empty string by calling umockstringbuilder_reserve. ]*/
+TEST_FUNCTION(umockstringbuilder_get_string_on_an_empty_builder_allocates_an_empty_string)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    const char* result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_get_string(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, test_realloc_calls[0].size);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_021: [ If string_builder is NULL, umockstringbuilder_get_string shall fail and return NULL. ]*/
+TEST_FUNCTION(umockstringbuilder_get_string_with_NULL_string_builder_fails)
+{
+    // arrange
+
+    // act
+    const char* result = umockstringbuilder_get_string(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_023: [ If umockstringbuilder_reserve fails, umockstringbuilder_get_string shall fail and return NULL. ]*/
+TEST_FUNCTION(when_reserve_fails_umockstringbuilder_get_string_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    const char* result;
+    umockstringbuilder_init(&string_builder);
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockstringbuilder_get_string(&string_builder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* umockstringbuilder_detach */
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_024: [ umockstringbuilder_detach shall return the NULL terminated string held by string_builder, transfer its ownership to the caller and leave string_builder as an empty string that holds no memory. ]*/
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_025: [ umockstringbuilder_detach shall obtain the string by calling umockstringbuilder_get_string. ]*/
+TEST_FUNCTION(umockstringbuilder_detach_returns_the_string_and_empties_the_builder)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    char* result;
+    umockstringbuilder_init(&string_builder);
+    (void)umockstringbuilder_append_string(&string_builder, "abc");
+
+    // act
+    result = umockstringbuilder_detach(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "abc", result);
+    ASSERT_IS_NULL(string_builder.buffer);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.length);
+    ASSERT_ARE_EQUAL(size_t, 0, string_builder.capacity);
+
+    // cleanup
+    umockstringbuilder_deinit(&string_builder);
+    ASSERT_ARE_EQUAL(size_t, 0, test_free_call_count);
+    free(result);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_024: [ umockstringbuilder_detach shall return the NULL terminated string held by string_builder, transfer its ownership to the caller and leave string_builder as an empty string that holds no memory. ]*/
+TEST_FUNCTION(umockstringbuilder_detach_on_an_empty_builder_returns_an_empty_string)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    char* result;
+    umockstringbuilder_init(&string_builder);
+
+    // act
+    result = umockstringbuilder_detach(&string_builder);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "", result);
+
+    // cleanup
+    free(result);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_026: [ If umockstringbuilder_get_string fails, umockstringbuilder_detach shall fail and return NULL. ]*/
+TEST_FUNCTION(umockstringbuilder_detach_with_NULL_string_builder_fails)
+{
+    // arrange
+
+    // act
+    char* result = umockstringbuilder_detach(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKSTRINGBUILDER_01_026: [ If umockstringbuilder_get_string fails, umockstringbuilder_detach shall fail and return NULL. ]*/
+TEST_FUNCTION(when_allocating_fails_umockstringbuilder_detach_fails)
+{
+    // arrange
+    UMOCKSTRINGBUILDER string_builder;
+    char* result;
+    umockstringbuilder_init(&string_builder);
+    when_shall_realloc_fail = 1;
+
+    // act
+    result = umockstringbuilder_detach(&string_builder);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
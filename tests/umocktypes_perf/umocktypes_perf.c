@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include <stdio.h>                      // for sprintf
+#include <stdlib.h>
+#include <time.h>                       // for timespec_get
+
+#include "macro_utils/macro_utils.h" // IWYU pragma: keep
+#include "c_logging/logger.h"
+
+#include "testrunnerswitcher.h"
+
+#include "umock_c/umocktypes.h"
+
+/* Measures the cost of looking up a registered type (umocktypes_are_equal) as the number of registered types grows */
+
+#define LOOKUP_ITERATIONS 1000000
+#define TYPE_NAME_LENGTH 32
+
+static char* perf_stringify(const void* value)
+{
+    (void)value;
+    return NULL;
+}
+
+static int perf_are_equal(const void* left, const void* right)
+{
+    return (*(const int*)left == *(const int*)right) ? 1 : 0;
+}
+
+static int perf_copy(void* destination, const void* source)
+{
+    *(int*)destination = *(const int*)source;
+    return 0;
+}
+
+static void perf_free(void* value)
+{
+    (void)value;
+}
+
+static double get_time_ns(void)
+{
+    struct timespec ts;
+    (void)timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1000000000.0 + (double)ts.tv_nsec;
+}
+
+static void measure_lookup_with_registered_types(size_t type_count)
+{
+    char (*type_names)[TYPE_NAME_LENGTH] = malloc(type_count * TYPE_NAME_LENGTH);
+    size_t i;
+    int left = 42;
+    int right = 43;
+    int equal_count = 0;
+    double start_time;
+    double elapsed_ns;
+
+    ASSERT_IS_NOT_NULL(type_names);
+    ASSERT_ARE_EQUAL(int, 0, umocktypes_init());
+
+    for (i = 0; i < type_count; i++)
+    {
+        (void)sprintf(type_names[i], "PERF_TYPE_%u", (unsigned int)i);
+        ASSERT_ARE_EQUAL(int, 0, umocktypes_register_type(type_names[i], perf_stringify, perf_are_equal, perf_copy, perf_free));
+    }
+
+    start_time = get_time_ns();
+    for (i = 0; i < LOOKUP_ITERATIONS; i++)
+    {
+        /* spread the lookups over all the registered types, the last registered one is the worst case for a linear scan */
+        equal_count += umocktypes_are_equal(type_names[type_count - 1 - (i % type_count)], &left, &right);
+    }
+    elapsed_ns = get_time_ns() - start_time;
+
+    ASSERT_ARE_EQUAL(int, 0, equal_count);
+
+    LogInfo("umocktypes_are_equal with %u registered types: %.1f ns/lookup (%u lookups)",
+        (unsigned int)type_count, elapsed_ns / LOOKUP_ITERATIONS, (unsigned int)LOOKUP_ITERATIONS);
+
+    umocktypes_deinit();
+    free(type_names);
+}
+
+BEGIN_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+}
+
+TEST_FUNCTION_INITIALIZE(test_function_init)
+{
+}
+
+TEST_FUNCTION_CLEANUP(test_function_cleanup)
+{
+}
+
+TEST_FUNCTION(umocktypes_lookup_with_10_registered_types)
+{
+    measure_lookup_with_registered_types(10);
+}
+
+TEST_FUNCTION(umocktypes_lookup_with_100_registered_types)
+{
+    measure_lookup_with_registered_types(100);
+}
+
+TEST_FUNCTION(umocktypes_lookup_with_1000_registered_types)
+{
+    measure_lookup_with_registered_types(1000);
+}
+
+END_TEST_SUITE(TEST_SUITE_NAME_FROM_CMAKE)
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -128,6 +129,7 @@ static size_t when_shall_realloc_fail;
     char* umocktypename_normalize(const char* type_name)
     {
         char* result;
+        const char* call_result;
 
         umocktypename_normalize_CALL* new_calls = realloc(umocktypename_normalize_calls, sizeof(umocktypename_normalize_CALL) * (umocktypename_normalize_call_count + 1));
         if (new_calls != NULL)
@@ -140,11 +142,13 @@ static size_t when_shall_realloc_fail;
             umocktypename_normalize_call_count++;
         }
 
-        if (umocktypename_normalize_call_result[umocktypename_normalize_call_count - 1] != NULL)
+        /* past the configured results the type name is returned as is */
+        call_result = (umocktypename_normalize_call_count <= umocktypename_normalize_max_calls) ? umocktypename_normalize_call_result[umocktypename_normalize_call_count - 1] : type_name;
+        if (call_result != NULL)
         {
-            size_t result_length = strlen(umocktypename_normalize_call_result[umocktypename_normalize_call_count - 1]);
+            size_t result_length = strlen(call_result);
             result = malloc(result_length + 1);
-            (void)memcpy(result, umocktypename_normalize_call_result[umocktypename_normalize_call_count - 1], result_length + 1);
+            (void)memcpy(result, call_result, result_length + 1);
         }
         else
         {
@@ -704,7 +708,7 @@ TEST_FUNCTION(when_allocating_memory_fails_umocktypes_register_type_fails)
     (void)umocktypes_init();
     umocktypename_normalize_call_result[0] = "char*";
 
-    when_shall_realloc_fail = 1;
+    when_shall_malloc_fail = 1;
 
     // act
     result = umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
@@ -713,6 +717,57 @@ TEST_FUNCTION(when_allocating_memory_fails_umocktypes_register_type_fails)
     ASSERT_ARE_NOT_EQUAL(int, 0, result);
 }
 
+/* Tests_SRS_UMOCKTYPES_01_012: [ If an error occurs allocating memory for the newly registered type, umocktypes_register_type shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_type_entry_fails_umocktypes_register_type_fails)
+{
+    // arrange
+    int result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+
+    when_shall_malloc_fail = 2;
+
+    // act
+    result = umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_067: [ The registered types shall be stored in a hash table keyed on the normalized type name, so that looking up a type does not depend on the number of registered types. ]*/
+TEST_FUNCTION(umocktypes_register_type_with_many_types_keeps_all_types_registered)
+{
+    // arrange
+    char type_names[200][32];
+    size_t i;
+    int result = 0;
+    (void)umocktypes_init();
+    for (i = 0; i < 200; i++)
+    {
+        (void)sprintf(type_names[i], "test_type_%u", (unsigned int)i);
+    }
+    for (i = 0; i < umocktypename_normalize_max_calls; i++)
+    {
+        umocktypename_normalize_call_result[i] = type_names[i];
+    }
+    for (i = 0; i < 200; i++)
+    {
+        result |= umocktypes_register_type(type_names[i], test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    }
+    ASSERT_ARE_EQUAL(int, 0, result);
+    test_copy_func_testtype_call_result = 0;
+
+    // act
+    for (i = 0; i < 200; i++)
+    {
+        result |= umocktypes_copy(type_names[i], (void*)0x4242, (void*)0x4243);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 200, test_copy_func_testtype_call_count);
+}
+
 /* umocktypes_register_alias_type */
 
 /* Tests_SRS_UMOCKTYPES_01_053: [ umocktypes_register_alias_type shall register a new alias type for the type "is_type". ]*/
@@ -844,6 +899,28 @@ TEST_FUNCTION(when_umocktypename_normalize_fails_for_type_then_umocktypes_regist
     ASSERT_ARE_EQUAL(size_t, 3, umocktypename_normalize_call_count);
 }
 
+/* Tests_SRS_UMOCKTYPES_01_068: [ If allocating memory for the alias type fails, umocktypes_register_alias_type shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_umocktypes_register_alias_type_fails)
+{
+    // arrange
+    int result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    umocktypes_register_type("char*", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+
+    umocktypename_normalize_call_result[1] = "char*";
+    umocktypename_normalize_call_result[2] = "PSTR";
+
+    when_shall_malloc_fail = malloc_call_count + 1;
+
+    // act
+    result = umocktypes_register_alias_type("PSTR", "char*");
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, umocktypename_normalize_call_count);
+}
+
 /* Tests_SRS_UMOCKTYPES_01_061: [ If umocktypes_register_alias_type is called when the module is not initialized, umocktypes_register_type shall fail and return a non zero value. ] */
 TEST_FUNCTION(umocktypes_register_alias_when_module_is_not_initialized_fails)
 {
@@ -887,6 +964,165 @@ TEST_FUNCTION(umocktypes_stringify_calls_the_underlying_stringify)
     free(result);
 }
 
+/* Tests_SRS_UMOCKTYPES_01_069: [ If the same type string was resolved before, the handlers it was resolved to shall be used without normalizing the type string again. ]*/
+/* Tests_SRS_UMOCKTYPES_01_070: [ Once a type string was resolved to registered handlers, the type string and the handlers shall be cached. ]*/
+TEST_FUNCTION(umocktypes_stringify_2_times_for_the_same_type_normalizes_the_type_only_once)
+{
+    // arrange
+    char* result1;
+    char* result2;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    test_stringify_func_testtype_call_result = "blahblah";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+    umocktypename_normalize_call_result[0] = "char*";
+    result1 = umocktypes_stringify("char *", test_value_1);
+    reset_umocktypename_normalize_calls();
+    malloc_call_count = 0;
+
+    // act
+    result2 = umocktypes_stringify("char *", test_value_2);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "blahblah", result2);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypename_normalize_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, malloc_call_count);
+    ASSERT_ARE_EQUAL(size_t, 2, test_stringify_func_testtype_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, test_value_2, test_stringify_func_testtype_calls[1].value);
+
+    // cleanup
+    free(result1);
+    free(result2);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_069: [ If the same type string was resolved before, the handlers it was resolved to shall be used without normalizing the type string again. ]*/
+TEST_FUNCTION(umocktypes_stringify_with_a_differently_spelled_type_normalizes_the_type)
+{
+    // arrange
+    char* result1;
+    char* result2;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    test_stringify_func_testtype_call_result = "blahblah";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+    umocktypename_normalize_call_result[0] = "char*";
+    umocktypename_normalize_call_result[1] = "char*";
+    result1 = umocktypes_stringify("char *", test_value_1);
+
+    // act
+    result2 = umocktypes_stringify("char*", test_value_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "blahblah", result2);
+    ASSERT_ARE_EQUAL(size_t, 2, umocktypename_normalize_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "char*", umocktypename_normalize_calls[1].type_name);
+
+    // cleanup
+    free(result1);
+    free(result2);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_071: [ Registering a new type or alias type shall discard all cached type strings. ]*/
+TEST_FUNCTION(umocktypes_stringify_after_registering_a_type_normalizes_the_type_again)
+{
+    // arrange
+    char* result1;
+    char* result2;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "void*";
+    umocktypename_normalize_call_result[1] = "char*";
+    umocktypename_normalize_call_result[2] = "int";
+    umocktypename_normalize_call_result[3] = "char*";
+    test_stringify_func_testtype_call_result = "blahblah";
+    (void)umocktypes_register_type("void*", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    result1 = umocktypes_stringify("char *", test_value_1);
+    (void)umocktypes_register_type("int", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+
+    // act
+    result2 = umocktypes_stringify("char *", test_value_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "blahblah", result2);
+    ASSERT_ARE_EQUAL(size_t, 4, umocktypename_normalize_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "char *", umocktypename_normalize_calls[3].type_name);
+
+    // cleanup
+    free(result1);
+    free(result2);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_084: [ If half of the cache slots are used, the cache shall be replaced by a cache with twice as many slots holding the same entries. ]*/
+/* Tests_SRS_UMOCKTYPES_01_085: [ A replaced cache shall only be freed when all cached type strings are discarded, since other threads can still be reading it. ]*/
+TEST_FUNCTION(umocktypes_stringify_caches_more_type_strings_than_half_of_the_initial_cache_slots)
+{
+    // arrange
+    char type_name[32];
+    char* result;
+    size_t i;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "void*";
+    test_stringify_func_testtype_call_result = "blahblah";
+    umocktypename_normalize_call_result[1] = "test_type_0*";
+    umocktypename_normalize_call_result[2] = "test_type_1*";
+    umocktypename_normalize_call_result[3] = "test_type_2*";
+    umocktypename_normalize_call_result[4] = "test_type_3*";
+    (void)umocktypes_register_type("void*", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+
+    /* the normalize mock returns the type names as they are past the configured results, all of them fall back to void* */
+    for (i = 0; i < 300; i++)
+    {
+        (void)sprintf(type_name, "test_type_%zu*", i);
+        result = umocktypes_stringify(type_name, test_value_1);
+        ASSERT_ARE_EQUAL(char_ptr, "blahblah", result);
+        free(result);
+    }
+    reset_umocktypename_normalize_calls();
+    malloc_call_count = 0;
+
+    // act
+    for (i = 0; i < 300; i++)
+    {
+        (void)sprintf(type_name, "test_type_%zu*", i);
+        result = umocktypes_stringify(type_name, test_value_1);
+        ASSERT_ARE_EQUAL(char_ptr, "blahblah", result);
+        free(result);
+    }
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypename_normalize_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, malloc_call_count);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_070: [ Once a type string was resolved to registered handlers, the type string and the handlers shall be cached. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_cache_fails_umocktypes_stringify_still_succeeds)
+{
+    // arrange
+    char* result1;
+    char* result2;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    umocktypename_normalize_call_result[1] = "char*";
+    umocktypename_normalize_call_result[2] = "char*";
+    test_stringify_func_testtype_call_result = "blahblah";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    when_shall_malloc_fail = malloc_call_count + 1;
+
+    // act
+    result1 = umocktypes_stringify("char *", test_value_1);
+    result2 = umocktypes_stringify("char *", test_value_1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, "blahblah", result1);
+    ASSERT_ARE_EQUAL(char_ptr, "blahblah", result2);
+    ASSERT_ARE_EQUAL(size_t, 3, umocktypename_normalize_call_count);
+
+    // cleanup
+    free(result1);
+    free(result2);
+}
+
 /* Tests_SRS_UMOCKTYPES_01_016: [ If any of the arguments is NULL, umocktypes_stringify shall fail and return NULL. ]*/
 TEST_FUNCTION(umocktypes_stringify_with_NULL_value_fails)
 {
@@ -1708,6 +1944,198 @@ TEST_FUNCTION(umocktypes_free_with_a_non_pointer_type_that_is_not_registered_doe
     ASSERT_ARE_EQUAL(size_t, 0, test_free_func_testtype_call_count);
 }
 
+/* umocktypes_get_handlers */
+
+/* Tests_SRS_UMOCKTYPES_01_076: [ umocktypes_get_handlers shall resolve type the same way umocktypes_stringify, umocktypes_are_equal, umocktypes_copy and umocktypes_free do (normalization and the void* fallback for pointer types). ]*/
+/* Tests_SRS_UMOCKTYPES_01_079: [ On success umocktypes_get_handlers shall return the handlers registered for type. The handlers stay valid until the value returned by umocktypes_get_generation changes. ]*/
+TEST_FUNCTION(umocktypes_get_handlers_returns_the_registered_handlers)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+
+    umocktypename_normalize_call_result[0] = "char*";
+
+    // act
+    result = umocktypes_get_handlers("char *");
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 1, umocktypename_normalize_call_count);
+    ASSERT_ARE_EQUAL(char_ptr, "char *", umocktypename_normalize_calls[0].type_name);
+    ASSERT_IS_TRUE(result->stringify_func == test_stringify_func_testtype);
+    ASSERT_IS_TRUE(result->are_equal_func == test_are_equal_func_testtype);
+    ASSERT_IS_TRUE(result->copy_func == test_copy_func_testtype);
+    ASSERT_IS_TRUE(result->free_func == test_free_func_testtype);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_076: [ umocktypes_get_handlers shall resolve type the same way umocktypes_stringify, umocktypes_are_equal, umocktypes_copy and umocktypes_free do (normalization and the void* fallback for pointer types). ]*/
+TEST_FUNCTION(umocktypes_get_handlers_with_a_pointer_type_that_was_not_registered_defaults_to_void_ptr)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "void*";
+    (void)umocktypes_register_type("void*", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+
+    umocktypename_normalize_call_result[0] = "const char*";
+
+    // act
+    result = umocktypes_get_handlers("const char *");
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_IS_TRUE(result->stringify_func == test_stringify_func_testtype);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_074: [ If type is NULL, umocktypes_get_handlers shall fail and return NULL. ]*/
+TEST_FUNCTION(umocktypes_get_handlers_with_NULL_type_fails)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+    (void)umocktypes_init();
+
+    // act
+    result = umocktypes_get_handlers(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypename_normalize_call_count);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_075: [ If umocktypes_get_handlers is called when the module is not initialized, umocktypes_get_handlers shall fail and return NULL. ]*/
+TEST_FUNCTION(umocktypes_get_handlers_when_the_module_is_not_initialized_fails)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+
+    // act
+    result = umocktypes_get_handlers("char*");
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(size_t, 0, umocktypename_normalize_call_count);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_077: [ If normalizing the typename fails, umocktypes_get_handlers shall fail and return NULL. ]*/
+TEST_FUNCTION(when_normalizing_the_type_fails_umocktypes_get_handlers_fails)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+
+    umocktypename_normalize_call_result[0] = NULL;
+
+    // act
+    result = umocktypes_get_handlers("char *");
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* Tests_SRS_UMOCKTYPES_01_078: [ If type can not be found in the registered types list maintained by the module, umocktypes_get_handlers shall return NULL. ]*/
+TEST_FUNCTION(umocktypes_get_handlers_with_a_type_that_was_not_registered_returns_NULL)
+{
+    // arrange
+    const UMOCKTYPE_HANDLERS* result;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "void*";
+    (void)umocktypes_register_type("void*", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+
+    umocktypename_normalize_call_result[0] = "char";
+
+    // act
+    result = umocktypes_get_handlers("char");
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* umocktypes_get_generation */
+
+/* Tests_SRS_UMOCKTYPES_01_072: [ umocktypes_get_generation shall return a value that changes every time the module is initialized, deinitialized or a new type or alias type is registered. ]*/
+TEST_FUNCTION(umocktypes_get_generation_changes_when_a_type_is_registered)
+{
+    // arrange
+    size_t generation;
+    (void)umocktypes_init();
+    generation = umocktypes_get_generation();
+    umocktypename_normalize_call_result[0] = "char*";
+
+    // act
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(size_t, generation, umocktypes_get_generation());
+}
+
+/* Tests_SRS_UMOCKTYPES_01_072: [ umocktypes_get_generation shall return a value that changes every time the module is initialized, deinitialized or a new type or alias type is registered. ]*/
+TEST_FUNCTION(umocktypes_get_generation_changes_when_an_alias_type_is_registered)
+{
+    // arrange
+    size_t generation;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+    generation = umocktypes_get_generation();
+    umocktypename_normalize_call_result[0] = "char*";
+    umocktypename_normalize_call_result[1] = "PSTR";
+
+    // act
+    (void)umocktypes_register_alias_type("PSTR", "char *");
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(size_t, generation, umocktypes_get_generation());
+}
+
+/* Tests_SRS_UMOCKTYPES_01_072: [ umocktypes_get_generation shall return a value that changes every time the module is initialized, deinitialized or a new type or alias type is registered. ]*/
+TEST_FUNCTION(umocktypes_get_generation_does_not_change_when_resolving_types)
+{
+    // arrange
+    size_t generation;
+    (void)umocktypes_init();
+    umocktypename_normalize_call_result[0] = "char*";
+    (void)umocktypes_register_type("char *", test_stringify_func_testtype, test_are_equal_func_testtype, test_copy_func_testtype, test_free_func_testtype);
+    reset_umocktypename_normalize_calls();
+    generation = umocktypes_get_generation();
+    umocktypename_normalize_call_result[0] = "char*";
+
+    // act
+    (void)umocktypes_get_handlers("char *");
+
+    // assert
+    ASSERT_ARE_EQUAL(size_t, generation, umocktypes_get_generation());
+}
+
+/* Tests_SRS_UMOCKTYPES_01_072: [ umocktypes_get_generation shall return a value that changes every time the module is initialized, deinitialized or a new type or alias type is registered. ]*/
+/* Tests_SRS_UMOCKTYPES_01_073: [ umocktypes_deinit shall change the value returned by umocktypes_get_generation. ]*/
+TEST_FUNCTION(umocktypes_get_generation_changes_on_deinit_and_init)
+{
+    // arrange
+    size_t generation_before_deinit;
+    size_t generation_after_deinit;
+    (void)umocktypes_init();
+    generation_before_deinit = umocktypes_get_generation();
+
+    // act
+    umocktypes_deinit();
+    generation_after_deinit = umocktypes_get_generation();
+    (void)umocktypes_init();
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(size_t, generation_before_deinit, generation_after_deinit);
+    ASSERT_ARE_NOT_EQUAL(size_t, generation_after_deinit, umocktypes_get_generation());
+}
+
 /* Tests_SRS_UMOCK_C_LIB_01_179: [ IMPLEMENT_UMOCK_C_ENUM_TYPE and IMPLEMENT_UMOCK_C_ENUM_STRINGIFY_WITHOUT_INVALID shall implement umock_c handlers for an enum type. ]*/
 TEST_FUNCTION(stringify_for_enum_returns_the_desired_string)
 {